@@ -1,27 +1,193 @@
 // include/RocksDBStorage.hpp
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <string>
 #include <memory>
+#include <thread>
+#include <vector>
 #include <unordered_map>
 #include <functional>
+#include "rocksdb/compaction_filter.h"
 #include "rocksdb/db.h"
 #include "rocksdb/options.h"
 #include "rocksdb/slice.h"
+#include "rocksdb/statistics.h"
 #include "rocksdb/status.h"
+#include "rocksdb/transaction_log.h"
+#include "rocksdb/write_batch.h"
+#include "RucksDBCache.hpp"
+#include "RucksDBMetrics.hpp"
 
 namespace duckdb {
 
 using string = std::string;
 
+class RucksDBMemoryBudget;
+
+// PRIMARY owns the DB; READ_ONLY sees it as of open; SECONDARY follows a primary
+// in another process by replaying its MANIFEST/WAL every catch_up_interval_ms
+enum class RucksDBOpenMode : uint8_t { PRIMARY, READ_ONLY, SECONDARY };
+
+// How table rows are spread over shards: HASH by row id, or RANGE in blocks of shard_block_rows
+// consecutive rows, so each block is one sequential key range on one shard
+enum class RucksDBShardingMode : uint8_t { HASH, RANGE };
+
+// Tunables for a RocksDBStorage instance
+struct RocksDBStorageOptions {
+    RucksDBOpenMode mode = RucksDBOpenMode::PRIMARY;
+    // Secondary's own info-log/MANIFEST directory (defaults to <db>_secondary_<pid>)
+    string secondary_path;
+    size_t catch_up_interval_ms = 1000;
+    
+    // In-process cache of hot values/decoded rows in front of RocksDB (0 disables it)
+    size_t cache_size = 0;
+    size_t cache_shards = 16;
+    
+    // Knobs for the asynchronous ingest queue used by put_async/InsertDataAsync
+    size_t ingest_queue_capacity = 65536;
+    size_t ingest_max_batch_size = 1024;
+    size_t ingest_max_latency_us = 1000;
+    size_t ingest_threads = 1;
+    
+    // Instrumentation: RocksDB tickers/histograms, and PerfContext sampled every Nth operation (0 disables)
+    bool enable_statistics = true;
+    size_t perf_sample_rate = 64;
+    
+    // Start Chrome-trace event recording at open (see RucksDBTracer)
+    bool trace = false;
+    size_t trace_buffer_events = 65536;
+    
+    // Default bandwidth cap for CreateBackup in bytes/s (0 = unlimited)
+    uint64_t backup_rate_limit = 0;
+    
+    // How long obsolete WAL files stay archived for change capture (0 = deleted once flushed,
+    // so a change stream can only resume from sequences still in the live WAL)
+    uint64_t wal_ttl_seconds = 0;
+    
+    // Extra RocksDB instances (e.g. one per NVMe device, comma-separated in Parse) that table
+    // rows are sharded across; catalog metadata always stays on this instance
+    std::vector<string> shard_paths;
+    RucksDBShardingMode sharding = RucksDBShardingMode::HASH;
+    size_t shard_block_rows = 16384;
+    
+    // Integrated BlobDB: values of at least min_blob_size bytes are written to blob files rather
+    // than SST files, so compactions move only small references to them
+    bool enable_blob_files = false;
+    uint64_t min_blob_size = 4096;
+    uint64_t blob_file_size = 256ULL << 20;
+    bool enable_blob_garbage_collection = true;
+    // Fraction of the oldest blob files whose live values compactions relocate
+    double blob_garbage_collection_age_cutoff = 0.25;
+    
+    // Column values whose encoding reaches this size are stored under their own key beside the
+    // row (0 keeps rows whole), so scans that do not project them never read them. Pairs with
+    // enable_blob_files when min_blob_size <= large_value_size.
+    size_t large_value_size = 0;
+    
+    // Read path: async_io lets a MultiGet read the blocks of its batch in parallel (io_uring on
+    // Linux builds with coroutine support) and iterators prefetch ahead; use_direct_reads opens
+    // table files with O_DIRECT, bypassing the page cache
+    bool async_io = true;
+    bool use_direct_reads = false;
+    // Iterator readahead in bytes; 0 leaves it adaptive, growing from 8KB on sequential reads
+    size_t readahead_size = 0;
+    // Table scans read the next vector of rows in the background while the current one is processed
+    bool scan_prefetch = true;
+    
+    // Write path: threads committing appends at once insert into the memtable concurrently, and
+    // with pipelined writes the next group's WAL write overlaps the previous group's memtable inserts
+    bool pipelined_writes = true;
+    
+    // Open and recovery. Table files are all opened up front, by file_opening_threads threads;
+    // skip_stats_update_on_db_open spares reading every file's properties for compaction
+    // statistics. Recovered memtables stay in memory instead of being flushed before the open
+    // returns, unless flush_on_recovery. max_total_wal_size bounds the WAL a restart replays by
+    // flushing memtables backed by the oldest log (0 leaves RocksDB's default).
+    size_t file_opening_threads = 16;
+    bool skip_stats_update_on_db_open = true;
+    bool flush_on_recovery = false;
+    uint64_t max_total_wal_size = 0;
+    
+    // Memory shared by RocksDB and DuckDB (see RucksDBMemoryBudget; 0 leaves both on their own
+    // defaults). RocksDB gets rocksdb_memory_share of it while DuckDB has room.
+    uint64_t memory_budget = 0;
+    double rocksdb_memory_share = 0.5;
+    
+    // Parses "key=value;key=value", sizes accept KB/MB/GB suffixes
+    static RocksDBStorageOptions Parse(const string &options);
+};
+
+// Decides during compaction whether a stored key/value has expired and can be dropped
+using RucksDBExpiryCheck = std::function<bool(const rocksdb::Slice &key, const rocksdb::Slice &value)>;
+
+// Compaction filter installed on every open; drops what the current expiry check accepts
+class RucksDBCompactionFilter : public rocksdb::CompactionFilter {
+private:
+    std::shared_ptr<const RucksDBExpiryCheck> check_;
+    
+public:
+    void SetExpiryCheck(std::shared_ptr<const RucksDBExpiryCheck> check);
+    bool Filter(int level, const rocksdb::Slice &key, const rocksdb::Slice &existing_value,
+                std::string *new_value, bool *value_changed) const override;
+    const char *Name() const override { return "RucksDBCompactionFilter"; }
+};
+
+struct RucksDBReplicationStatus {
+    RucksDBOpenMode mode = RucksDBOpenMode::PRIMARY;
+    uint64_t catch_ups = 0;
+    uint64_t catch_up_failures = 0;
+    // Time since the data was last known to match the primary (0 for a primary)
+    uint64_t staleness_ms = 0;
+    uint64_t latest_sequence = 0;
+};
+
+struct RucksDBBackupInfo {
+    uint32_t backup_id = 0;
+    int64_t timestamp = 0;
+    uint64_t size = 0;
+    uint32_t file_count = 0;
+};
+
 class RocksDBStorage {
 private:
     std::unique_ptr<rocksdb::DB> db_;
     string db_path_;
     std::unordered_map<string, size_t> table_row_counts_;
+    RocksDBStorageOptions options_;
+    std::unique_ptr<RucksDBCache> cache_;
+    std::shared_ptr<rocksdb::Statistics> statistics_;
+    std::unique_ptr<RucksDBMetrics> metrics_;
+    
+    // Secondary catch-up
+    std::thread catch_up_thread_;
+    std::mutex catch_up_lock_;
+    std::condition_variable catch_up_cv_;
+    bool stop_catch_up_ = false;
+    std::atomic<uint64_t> catch_ups_{0};
+    std::atomic<uint64_t> catch_up_failures_{0};
+    std::atomic<uint64_t> catch_up_epoch_{0};
+    std::atomic<int64_t> synced_at_us_{0};
+    
+    // Data shards opened from options_.shard_paths
+    std::vector<std::unique_ptr<RocksDBStorage>> shards_;
+    
+    // Referenced by the open DB's options, so it must outlive db_
+    std::unique_ptr<RucksDBCompactionFilter> compaction_filter_;
+    
+    // Built from options_ once at open
+    rocksdb::ReadOptions read_options_;
+    
+    // Budget this instance's block cache and memtables count against; null when unbudgeted
+    std::shared_ptr<RucksDBMemoryBudget> memory_budget_;
+    
+    void CatchUpLoop();
     
 public:
-    RocksDBStorage(const string &path);
+    RocksDBStorage(const string &path, const RocksDBStorageOptions &options = RocksDBStorageOptions());
     ~RocksDBStorage();
     
     void Initialize();
@@ -29,9 +195,30 @@ public:
     // Storage operations
     void WriteData(const string &key, const string &value);
     bool ReadData(const string &key, string &value);
+    // Reads straight from RocksDB, for callers that cache their own decoded form
+    bool ReadDataUncached(const string &key, string &value);
+    // Batched point reads through DB::MultiGet; keys sorted ascending let RocksDB skip re-sorting
+    void MultiReadDataUncached(const std::vector<string> &keys, std::vector<string> &values,
+                               std::vector<bool> &found, bool sorted = false);
     void DeleteData(const string &key);
+    // Adds an aggregate delta (see RucksDBMergeOperator.hpp) without reading the current value
+    void MergeData(const string &key, const string &operand);
+    void ApplyBatch(rocksdb::WriteBatch &batch);
+    void Flush();
+    // Evicts every unpinned block of this instance and its shards from RocksDB's block cache,
+    // e.g. to measure reads from a cold cache
+    void DropBlockCache();
+    // Both throw when the iterator fails, rather than ending early
     void IteratePrefix(const string &prefix, 
                       std::function<bool(const string&, const string&)> callback);
+    // Keys in [start, end) in order, as of snapshot when given; end bounds the iterator, so
+    // blocks past it are never read
+    void IterateRange(const string &start, const string &end,
+                      std::function<bool(const string&, const string&)> callback,
+                      const rocksdb::Snapshot *snapshot = nullptr);
+    // A consistent view for reads that span several calls; released when the last reference
+    // goes, which must be before this storage closes
+    std::shared_ptr<const rocksdb::Snapshot> GetSnapshot();
     
     // Table management
     void CreateTable(const string &table_name);
@@ -39,7 +226,53 @@ public:
     size_t GetTableRowCount(const string &table_name);
     void SetTableRowCount(const string &table_name, size_t count);
     
+    bool IsReadOnly() const { return options_.mode != RucksDBOpenMode::PRIMARY; }
+    
+    // This instance followed by the data shards; a single element when sharding is off
+    std::vector<RocksDBStorage*> GetShards();
+    // Secondary only: replays the primary's new MANIFEST/WAL entries and drops cached values.
+    // Runs periodically in the background, but may be called to force a refresh.
+    bool TryCatchUp();
+    // Bumped on every successful catch-up, so metadata caches know to reload
+    uint64_t GetCatchUpEpoch() const { return catch_up_epoch_.load(); }
+    RucksDBReplicationStatus GetReplicationStatus();
+    
     rocksdb::DB* GetDB() { return db_.get(); }
+    const string &GetPath() const { return db_path_; }
+    const RocksDBStorageOptions &GetOptions() const { return options_; }
+    
+    // Optional cache; null when disabled. Writes through this class invalidate it.
+    RucksDBCache* GetCache() { return cache_.get(); }
+    RucksDBCacheStatistics GetCacheStatistics();
+    RucksDBMemoryBudget* GetMemoryBudget() { return memory_budget_.get(); }
+    std::shared_ptr<RucksDBMemoryBudget> GetSharedMemoryBudget() { return memory_budget_; }
+    
+    // Latency histograms for this instance's operations, storage-wide and per table
+    RucksDBMetrics &GetMetrics() { return *metrics_; }
+    // RocksDB's own tickers and histograms; null when enable_statistics is off
+    rocksdb::Statistics* GetStatistics() { return statistics_.get(); }
+    // DB::GetProperty, e.g. "rocksdb.stats" or "rocksdb.estimate-num-keys"
+    bool GetProperty(const string &property, string &value);
+    
+    // Expiry rule applied by compactions here and on every shard (null removes it)
+    void SetExpiryCheck(RucksDBExpiryCheck check);
+    // Compacts the keys under prefix on every shard, so the expiry check drops them now
+    void CompactPrefix(const string &prefix);
+    
+    // Sequence number of the last committed write
+    uint64_t GetLatestSequence();
+    // WAL batches from the one containing sequence onwards; throws when the WAL no longer has it
+    std::unique_ptr<rocksdb::TransactionLogIterator> GetUpdatesSince(uint64_t sequence);
+    
+    // Consistent snapshot of the live DB in checkpoint_dir (must not exist). SST files are
+    // hard-linked when on the same filesystem, so this takes constant time regardless of DB size.
+    void CreateCheckpoint(const string &checkpoint_dir);
+    // Incremental backup into backup_dir: only SST files not already in an earlier backup are
+    // copied, throttled to rate_limit bytes/s (0 uses the backup_rate_limit option). Writers are not blocked.
+    RucksDBBackupInfo CreateBackup(const string &backup_dir, uint64_t rate_limit = 0, uint32_t keep_backups = 0);
+    static std::vector<RucksDBBackupInfo> ListBackups(const string &backup_dir);
+    // Restores into the data directory of a closed storage at path (backup_id 0 = latest)
+    static void RestoreBackup(const string &backup_dir, const string &path, uint32_t backup_id = 0);
 };
 
 // Global storage instance
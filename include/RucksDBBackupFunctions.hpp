@@ -0,0 +1,22 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// SQL access to snapshots and backups of the RucksDB storage:
+//   CALL rucksdb_checkpoint('dir')               hard-link snapshot into a new directory
+//   CALL rucksdb_backup('dir' [, bytes_per_sec])  incremental, rate-limited backup
+//   SELECT * FROM rucksdb_backups('dir')         backups present in a backup directory
+// Checkpoint and backup accept database := 'name' to snapshot an attached instance. Only the
+// instance's primary RocksDB is captured, not the shard databases of a sharded instance.
+struct RucksDBBackupFunctions {
+    static void RegisterFunctions(DatabaseInstance& db);
+
+    static TableFunction GetCheckpointFunction();
+    static TableFunctionSet GetBackupFunction();
+    static TableFunction GetListBackupsFunction();
+};
+
+} // namespace duckdb
\ No newline at end of file
@@ -0,0 +1,89 @@
+// include/RucksDBCache.hpp
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace duckdb {
+
+using string = std::string;
+
+// Base for anything the cache can hold (raw values, decoded rows, decoded segments)
+struct RucksDBCachedValue {
+    virtual ~RucksDBCachedValue() = default;
+};
+
+// Raw RocksDB value bytes
+struct RucksDBCachedBytes : public RucksDBCachedValue {
+    explicit RucksDBCachedBytes(string value_p) : value(std::move(value_p)) {}
+    string value;
+};
+
+struct RucksDBCacheStatistics {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t inserts = 0;
+    uint64_t evictions = 0;
+    uint64_t invalidations = 0;
+    size_t usage = 0;
+    size_t capacity = 0;
+};
+
+// Sharded, lock-striped cache with CLOCK eviction under a fixed memory budget
+class RucksDBCache {
+public:
+    using Handle = std::shared_ptr<const RucksDBCachedValue>;
+
+private:
+    struct Slot {
+        string key;
+        Handle value;
+        size_t charge = 0;
+        bool referenced = false;
+        bool occupied = false;
+    };
+
+    struct Shard {
+        std::mutex lock;
+        std::unordered_map<string, size_t> index;
+        std::vector<Slot> slots;
+        std::vector<size_t> free_slots;
+        size_t clock_hand = 0;
+        size_t usage = 0;
+        // Bumped on every invalidation so readers can detect a racing write
+        uint64_t version = 0;
+    };
+
+    size_t shard_capacity_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> inserts_{0};
+    std::atomic<uint64_t> evictions_{0};
+    std::atomic<uint64_t> invalidations_{0};
+
+    Shard& GetShard(const string& key);
+    void EvictSlot(Shard& shard, size_t slot_idx);
+    bool MakeRoom(Shard& shard, size_t charge);
+
+public:
+    RucksDBCache(size_t capacity, size_t shard_count);
+
+    Handle Lookup(const string& key);
+    // Version to pass to Insert; read it before going to RocksDB on a miss
+    uint64_t GetVersion(const string& key);
+    // Skips the insert when the key was invalidated after 'version' was read
+    bool Insert(const string& key, Handle value, size_t charge, uint64_t version);
+    void Erase(const string& key);
+    void Clear();
+
+    RucksDBCacheStatistics GetStatistics();
+};
+
+} // namespace duckdb
\ No newline at end of file
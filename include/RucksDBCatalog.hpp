@@ -0,0 +1,150 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/catalog/catalog.hpp"
+#include "duckdb/catalog/catalog_entry/schema_catalog_entry.hpp"
+#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+#include "duckdb/storage/storage_extension.hpp"
+#include "duckdb/transaction/transaction.hpp"
+#include "duckdb/transaction/transaction_manager.hpp"
+#include "RucksDBExtension.hpp"
+#include <atomic>
+#include <mutex>
+
+namespace duckdb {
+
+class RucksDBCatalog;
+
+// Table entry backed by a RucksDBTableStorage. Entries are built from the schema alone, so
+// listing a catalog of many tables loads none of them; the storage is loaded on first use.
+class RucksDBTableEntry : public TableCatalogEntry {
+private:
+    RucksDBTableRegistry& registry_;
+    std::atomic<RucksDBTableStorage*> storage_{nullptr};
+
+public:
+    RucksDBTableEntry(Catalog& catalog, SchemaCatalogEntry& schema, CreateTableInfo& info,
+                      RucksDBTableRegistry& registry);
+
+    unique_ptr<BaseStatistics> GetStatistics(ClientContext& context, column_t column_id) override;
+    TableFunction GetScanFunction(ClientContext& context, unique_ptr<FunctionData>& bind_data) override;
+    TableStorageInfo GetStorageInfo(ClientContext& context) override;
+
+    RucksDBTableStorage& GetStorage();
+};
+
+// The single "main" schema of an attached RocksDB database
+class RucksDBSchemaEntry : public SchemaCatalogEntry {
+private:
+    RucksDBTableRegistry& registry_;
+    std::mutex entry_lock_;
+    std::unordered_map<string, unique_ptr<RucksDBTableEntry>> tables_;
+    // Entries of dropped tables, which plans bound before the drop still hold
+    vector<unique_ptr<RucksDBTableEntry>> dropped_tables_;
+
+    optional_ptr<CatalogEntry> LoadTableEntry(const string& name);
+    // Drops the table's data and retires its entry; entry_lock_ must be held
+    void DropTable(const string& name);
+
+public:
+    RucksDBSchemaEntry(Catalog& catalog, CreateSchemaInfo& info, RucksDBTableRegistry& registry);
+
+    optional_ptr<CatalogEntry> CreateTable(CatalogTransaction transaction, BoundCreateTableInfo& info) override;
+    optional_ptr<CatalogEntry> CreateFunction(CatalogTransaction transaction, CreateFunctionInfo& info) override;
+    optional_ptr<CatalogEntry> CreateIndex(CatalogTransaction transaction, CreateIndexInfo& info,
+                                           TableCatalogEntry& table) override;
+    optional_ptr<CatalogEntry> CreateView(CatalogTransaction transaction, CreateViewInfo& info) override;
+    optional_ptr<CatalogEntry> CreateSequence(CatalogTransaction transaction, CreateSequenceInfo& info) override;
+    optional_ptr<CatalogEntry> CreateTableFunction(CatalogTransaction transaction,
+                                                   CreateTableFunctionInfo& info) override;
+    optional_ptr<CatalogEntry> CreateCopyFunction(CatalogTransaction transaction,
+                                                  CreateCopyFunctionInfo& info) override;
+    optional_ptr<CatalogEntry> CreatePragmaFunction(CatalogTransaction transaction,
+                                                    CreatePragmaFunctionInfo& info) override;
+    optional_ptr<CatalogEntry> CreateCollation(CatalogTransaction transaction, CreateCollationInfo& info) override;
+    optional_ptr<CatalogEntry> CreateType(CatalogTransaction transaction, CreateTypeInfo& info) override;
+    void Alter(CatalogTransaction transaction, AlterInfo& info) override;
+    void Scan(ClientContext& context, CatalogType type, const std::function<void(CatalogEntry&)>& callback) override;
+    void Scan(CatalogType type, const std::function<void(CatalogEntry&)>& callback) override;
+    void DropEntry(ClientContext& context, DropInfo& info) override;
+    optional_ptr<CatalogEntry> GetEntry(CatalogTransaction transaction, CatalogType type, const string& name) override;
+};
+
+// Catalog for a database attached with ATTACH 'path' AS name (TYPE rucksdb [, OPTIONS '...']).
+// OPTIONS takes the same key=value;... string as rucksdb_init_with_options, e.g. shard_paths.
+// The attached storage is registered as a RucksDB instance under the attached name.
+class RucksDBCatalog : public Catalog {
+private:
+    string path_;
+    AccessMode access_mode_;
+    // Owned only when the path is not the one opened through rucksdb_init
+    unique_ptr<RocksDBStorage> owned_storage_;
+    unique_ptr<RucksDBTableRegistry> owned_registry_;
+    RocksDBStorage* storage_;
+    RucksDBTableRegistry* registry_;
+    unique_ptr<RucksDBSchemaEntry> main_schema_;
+
+public:
+    RucksDBCatalog(AttachedDatabase& db, const string& path, AccessMode access_mode,
+                   const string& options = string());
+    ~RucksDBCatalog() override;
+
+    void Initialize(bool load_builtin) override;
+    string GetCatalogType() override { return "rucksdb"; }
+
+    optional_ptr<CatalogEntry> CreateSchema(CatalogTransaction transaction, CreateSchemaInfo& info) override;
+    void ScanSchemas(ClientContext& context, std::function<void(SchemaCatalogEntry&)> callback) override;
+    optional_ptr<SchemaCatalogEntry> GetSchema(CatalogTransaction transaction, const string& schema_name,
+                                               OnEntryNotFound if_not_found,
+                                               QueryErrorContext error_context = QueryErrorContext()) override;
+
+    unique_ptr<PhysicalOperator> PlanCreateTableAs(ClientContext& context, LogicalCreateTable& op,
+                                                   unique_ptr<PhysicalOperator> plan) override;
+    unique_ptr<PhysicalOperator> PlanInsert(ClientContext& context, LogicalInsert& op,
+                                            unique_ptr<PhysicalOperator> plan) override;
+    unique_ptr<PhysicalOperator> PlanDelete(ClientContext& context, LogicalDelete& op,
+                                            unique_ptr<PhysicalOperator> plan) override;
+    unique_ptr<PhysicalOperator> PlanUpdate(ClientContext& context, LogicalUpdate& op,
+                                            unique_ptr<PhysicalOperator> plan) override;
+    unique_ptr<LogicalOperator> BindCreateIndex(Binder& binder, CreateStatement& stmt, TableCatalogEntry& table,
+                                                unique_ptr<LogicalOperator> plan) override;
+
+    DatabaseSize GetDatabaseSize(ClientContext& context) override;
+    bool InMemory() override { return false; }
+    string GetDBPath() override { return path_; }
+
+    RocksDBStorage& GetStorage() { return *storage_; }
+    RucksDBTableRegistry& GetRegistry() { return *registry_; }
+
+private:
+    void DropSchema(ClientContext& context, DropInfo& info) override;
+};
+
+// RocksDB writes are applied as they happen; the transaction only scopes catalog access
+class RucksDBTransaction : public Transaction {
+public:
+    RucksDBTransaction(TransactionManager& manager, ClientContext& context) : Transaction(manager, context) {}
+};
+
+class RucksDBTransactionManager : public TransactionManager {
+private:
+    RucksDBCatalog& catalog_;
+    std::mutex transaction_lock_;
+    reference_map_t<Transaction, unique_ptr<RucksDBTransaction>> transactions_;
+
+public:
+    RucksDBTransactionManager(AttachedDatabase& db, RucksDBCatalog& catalog);
+
+    Transaction& StartTransaction(ClientContext& context) override;
+    ErrorData CommitTransaction(ClientContext& context, Transaction& transaction) override;
+    void RollbackTransaction(Transaction& transaction) override;
+    void Checkpoint(ClientContext& context, bool force = false) override;
+};
+
+// Storage extension registered under TYPE rucksdb
+class RucksDBStorageExtension : public StorageExtension {
+public:
+    RucksDBStorageExtension();
+};
+
+} // namespace duckdb
\ No newline at end of file
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// SQL access to change capture:
+//   SELECT * FROM rucksdb_changes('t', since_seq [, database := 'name'])
+// returns (sequence, change, row_id, <table columns>) for every row written or deleted at or
+// after since_seq, up to the latest sequence when the scan started. Resume from max(sequence) + 1.
+struct RucksDBChangeFunctions {
+    static void RegisterFunctions(DatabaseInstance& db);
+
+    static TableFunction GetChangesFunction();
+};
+
+} // namespace duckdb
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "RocksDBStorage.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+namespace duckdb {
+
+// Row-level change decoded from a RocksDB WAL record. Inserts and updates are both
+// UPSERTs (a Put of the full row); values is empty for DELETEs.
+enum class RucksDBChangeType : uint8_t { UPSERT, DELETE };
+
+struct RucksDBRowChange {
+    uint64_t sequence = 0;
+    RucksDBChangeType type = RucksDBChangeType::UPSERT;
+    idx_t row_id = 0;
+    vector<Value> values;
+};
+
+const char* RucksDBChangeTypeName(RucksDBChangeType type);
+
+// Pull-based change capture for one table, built on DB::GetUpdatesSince. Work is
+// proportional to the WAL written since the resume point, not to the table size.
+// Resuming is only possible while the WAL still holds the sequence (see wal_ttl_seconds).
+class RucksDBChangeStream {
+private:
+    RocksDBStorage* storage_;
+    string table_name_;
+    uint64_t next_sequence_;
+    std::unique_ptr<rocksdb::TransactionLogIterator> iterator_;
+
+public:
+    // Streams changes committed at or after since_sequence
+    RucksDBChangeStream(RocksDBStorage* storage, const string& table_name, uint64_t since_sequence);
+
+    // Appends the changes of whole write batches up to until_sequence (inclusive) until at least
+    // max_changes were added. Returns the number appended; 0 means caught up.
+    idx_t Read(vector<RucksDBRowChange>& changes, idx_t max_changes,
+               uint64_t until_sequence = std::numeric_limits<uint64_t>::max());
+
+    // Sequence to pass as since_sequence to resume after the last change read
+    uint64_t GetNextSequence() const { return next_sequence_; }
+};
+
+// Push-based subscription: polls a change stream on a background thread and hands every
+// non-empty set of changes to the callback, in commit order, on that thread. If the callback
+// throws, the same changes are delivered again on the next poll.
+class RucksDBChangeSubscription {
+public:
+    using Callback = std::function<void(const vector<RucksDBRowChange>& changes)>;
+
+private:
+    // Serializes Poll between the background thread and direct callers
+    std::mutex poll_lock_;
+    RocksDBStorage* storage_;
+    string table_name_;
+    RucksDBChangeStream stream_;
+    Callback callback_;
+    size_t poll_interval_ms_;
+    std::atomic<uint64_t> next_sequence_;
+
+    std::thread thread_;
+    std::mutex lock_;
+    std::condition_variable cv_;
+    bool stop_ = false;
+    std::atomic<uint64_t> failures_{0};
+    string last_error_;
+
+    void PollLoop();
+
+public:
+    RucksDBChangeSubscription(RocksDBStorage* storage, const string& table_name, uint64_t since_sequence,
+                              Callback callback, size_t poll_interval_ms = 100);
+    ~RucksDBChangeSubscription();
+
+    // Delivers pending changes on the calling thread, returns how many were delivered
+    idx_t Poll();
+    void Start();
+    void Stop();
+
+    // Polls that threw, e.g. because the WAL no longer held the resume sequence
+    uint64_t GetFailureCount() const { return failures_.load(); }
+    string GetLastError();
+    uint64_t GetNextSequence() const { return next_sequence_.load(); }
+};
+
+} // namespace duckdb
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/parser/column_definition.hpp"
+
+namespace duckdb {
+
+// Predicates of one scan on the key columns of a clustered table, as encoded values (see
+// RucksDBClusterDefinition::EncodeValue); an empty string means no bound. Bounds are inclusive:
+// a strict comparison widens to its inclusive form, and the filter stays in the plan.
+struct RucksDBClusterBounds {
+    vector<string> equal;
+    vector<string> lower;
+    vector<string> upper;
+
+    explicit RucksDBClusterBounds(idx_t key_count) : equal(key_count), lower(key_count), upper(key_count) {
+    }
+
+    // Keeps the first equality and the tightest lower and upper bound of each column
+    void AddEqual(idx_t key, const string& encoded);
+    void AddLower(idx_t key, const string& encoded);
+    void AddUpper(idx_t key, const string& encoded);
+};
+
+// Range of clustered entry keys a scan reads, upper exclusive. key_columns is the clustering key
+// the range was built for, so a scan planned before the table was re-keyed falls back to row order.
+struct RucksDBClusterRange {
+    string key_columns;
+    string lower;
+    string upper;
+};
+
+// Clustering key declared on a RucksDB table. Each row is copied under
+// cluster_<encoded table><encoded key><row id>, so the copies sort by the key: rows that share a
+// key prefix sit in the same blocks, and a range on the leading key columns is one bounded seek.
+// Row ids still name rows for deletes, updates and indexes; the copy holds the row's stored
+// encoding and is kept in step with it.
+struct RucksDBClusterDefinition {
+    vector<string> key_columns;
+
+    // Resolved by Bind
+    vector<idx_t> key_indexes;
+    vector<LogicalType> key_types;
+
+    void Bind(const vector<ColumnDefinition>& columns);
+
+    // Comma-separated key columns, in key order
+    string Serialize() const;
+    static RucksDBClusterDefinition Deserialize(const string& data);
+
+    string EncodeKey(const vector<Value>& row) const;
+    string EncodeKey(DataChunk& chunk, idx_t row) const;
+    // Appends an encoding of value as type whose byte order is the value order: NULL first, then
+    // integers, dates and timestamps as sign-flipped big-endian, doubles with their bits flipped
+    // to sort as unsigned, and strings with 0x00 escaped and a 0x00 0x01 terminator, so that no
+    // encoding is a prefix of another.
+    static void EncodeValue(const Value& value, const LogicalType& type, string& out);
+
+    static string GetPrefix(const string& table_name);
+    static string GetEntryKey(const string& table_name, const string& key, idx_t row_id);
+    static idx_t ParseRowId(const string& entry_key);
+
+    // The entry keys holding every row that matches bounds, false when bounds do not constrain
+    // the leading key column
+    bool GetRange(const string& table_name, const RucksDBClusterBounds& bounds, RucksDBClusterRange& range) const;
+};
+
+} // namespace duckdb
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// SQL access to clustered tables (see RucksDBClusterDefinition):
+//   CALL rucksdb_set_clustering('events', 'tenant_id, ts')   '' as key makes the table plain again
+//   CALL rucksdb_recluster('events')   compacts the clustered copies into key-ordered files now
+// Filters on the leading key columns of a clustered table, such as tenant_id = 7 AND ts >= '2024-01-01',
+// make rocksdb_scan read only that key range. Both accept database := 'name' for attached instances.
+struct RucksDBClusterFunctions {
+    static void RegisterFunctions(DatabaseInstance& db);
+
+    static TableFunction GetSetClusteringFunction();
+    static TableFunction GetReclusterFunction();
+};
+
+} // namespace duckdb
@@ -6,12 +6,27 @@
 #include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
 #include "duckdb/function/table_function.hpp"
 #include "RocksDBStorage.hpp"
+#include "RucksDBStatistics.hpp"
+#include "RucksDBCluster.hpp"
+#include "RucksDBRollup.hpp"
+#include "RucksDBTTL.hpp"
+#include "RucksDBTextIndex.hpp"
+#include "RucksDBTiered.hpp"
+#include "RucksDBVectorIndex.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <shared_mutex>
 #include <sstream>
+#include <thread>
 
 namespace duckdb {
 
 // Forward declarations
 class RucksDBTableStorage;
+struct RucksDBScanState;
 
 // Extension main class
 class RucksDBExtension : public Extension {
@@ -27,45 +42,249 @@ private:
     RocksDBStorage* storage_;
     static constexpr char SCHEMA_PREFIX[] = "schema_";
     static constexpr char TABLE_META_PREFIX[] = "table_meta_";
+    static constexpr char TABLE_NEXT_ROW_PREFIX[] = "table_next_row_";
+    static constexpr char TABLE_STATS_PREFIX[] = "table_stats_";
+    static constexpr char ROLLUP_PREFIX[] = "rollup_def_";
+    static constexpr char TTL_PREFIX[] = "table_ttl_";
+    static constexpr char VECTOR_INDEX_PREFIX[] = "vindex_def_";
+    static constexpr char TEXT_INDEX_PREFIX[] = "ftidx_def_";
+    static constexpr char TIER_PREFIX[] = "table_tier_";
+    static constexpr char CLUSTER_PREFIX[] = "table_cluster_";
+    // Every table's schema record in one value, and the count of creates and drops it reflects
+    static constexpr char CATALOG_SNAPSHOT_KEY[] = "catalog_snapshot";
+    static constexpr char CATALOG_VERSION_KEY[] = "catalog_version";
+    
+    // A persisted schema record, parsed the first time the table's columns are asked for
+    struct TableSchema {
+        string data;
+        bool parsed = false;
+        vector<ColumnDefinition> columns;
+    };
+    
+    // Schemas loaded once at startup and kept coherent on create/drop
+    std::mutex schema_lock_;
+    std::unordered_map<string, TableSchema> schemas_;
+    // Creates and drops so far (persisted under CATALOG_VERSION_KEY) and as of the stored snapshot
+    int64_t catalog_version_ = 0;
+    int64_t snapshot_version_ = -1;
+    
+    static string SerializeSchema(const vector<ColumnDefinition>& columns);
+    static vector<ColumnDefinition> ParseSchema(const string& schema_data);
+    bool LoadSnapshot(const string& snapshot);
+    void SaveSnapshotLocked();
     
 public:
-    RucksDBSchema(RocksDBStorage* storage) : storage_(storage) {}
+    RucksDBSchema(RocksDBStorage* storage);
+    
+    // (Re)reads every persisted schema, e.g. after a secondary caught up with its primary. The
+    // snapshot answers in a single read unless a create or drop came after it; otherwise every
+    // schema key is scanned and, on a primary, the snapshot rewritten.
+    void LoadSchemas();
+    // Rewrites the snapshot if a create or drop came after it; run when the registry closes
+    void SaveSnapshot();
     
     void CreateTable(const string& table_name, const vector<ColumnDefinition>& columns);
     void DropTable(const string& table_name);
     vector<ColumnDefinition> GetTableSchema(const string& table_name);
     bool TableExists(const string& table_name);
+    vector<string> ListTables();
     
-    // Metadata operations
-    void StoreTableMetadata(const string& table_name, idx_t row_count);
+    // Metadata operations. A table keeps two counts: its live rows, and the high-water mark of
+    // committed row ids, which leaves room for ids reserved by appends that never committed.
+    void StoreTableMetadata(const string& table_name, idx_t next_row, idx_t row_count);
     idx_t LoadTableRowCount(const string& table_name);
+    // False for tables written before the high-water mark was kept
+    bool LoadTableNextRow(const string& table_name, idx_t& next_row);
+    // Adds a row count delta through the merge operator, so appenders never read the count
+    void MergeTableRowCount(rocksdb::WriteBatch& batch, const string& table_name, int64_t delta);
+    // Raises the high-water mark through the merge operator, so commits may land in any order
+    void MergeTableNextRow(rocksdb::WriteBatch& batch, const string& table_name, idx_t next_row);
+    void ApplyBatch(rocksdb::WriteBatch& batch) { storage_->ApplyBatch(batch); }
+    RocksDBStorage* GetStorage() { return storage_; }
+    void StoreTableStatistics(const string& table_name, const RucksDBTableStatistics& stats);
+    bool LoadTableStatistics(const string& table_name, const vector<LogicalType>& types,
+                             RucksDBTableStatistics& stats);
+    
+    // Rollup definitions and their aggregated groups
+    void StoreRollup(const RucksDBRollupDefinition& rollup);
+    void DropRollup(const string& rollup_name);
+    vector<RucksDBRollupDefinition> LoadRollups();
+    
+    // TTL declarations; dropping one also forgets the table's partition index
+    void StoreTableTTL(const string& table_name, const RucksDBTableTTL& ttl);
+    void DropTableTTL(const string& table_name);
+    bool LoadTableTTL(const string& table_name, RucksDBTableTTL& ttl);
+    std::unordered_map<string, RucksDBTableTTL> LoadTableTTLs();
+    
+    // Vector index definitions; dropping one also deletes its graph
+    void StoreVectorIndex(const RucksDBVectorIndexDefinition& index);
+    void DropVectorIndex(const string& index_name);
+    vector<RucksDBVectorIndexDefinition> LoadVectorIndexes();
+    
+    // Text index definitions; dropping one also deletes its posting lists
+    void StoreTextIndex(const RucksDBTextIndexDefinition& index);
+    void DropTextIndex(const string& index_name);
+    vector<RucksDBTextIndexDefinition> LoadTextIndexes();
+    
+    // Tier declarations; dropping one also deletes the hot chunk log and the key index
+    void StoreTableTier(const string& table_name, const RucksDBTierDefinition& tier);
+    void DropTableTier(const string& table_name);
+    bool LoadTableTier(const string& table_name, RucksDBTierDefinition& tier);
+    
+    // Clustering keys; dropping one also deletes the clustered copies of the table's rows
+    void StoreTableCluster(const string& table_name, const RucksDBClusterDefinition& cluster);
+    void DropTableCluster(const string& table_name);
+    bool LoadTableCluster(const string& table_name, RucksDBClusterDefinition& cluster);
+};
+
+// Decoded row held in the storage cache. Out-of-line values are not cached: their columns hold
+// NULL and are listed in large_columns.
+struct RucksDBCachedRow : public RucksDBCachedValue {
+    vector<Value> values;
+    vector<idx_t> large_columns;
+};
+
+// Rows [start_row, start_row + count) read together for a scan; found is false for gaps
+struct RucksDBRowBatch {
+    idx_t start_row = 0;
+    idx_t count = 0;
+    vector<vector<Value>> rows;
+    vector<bool> found;
 };
 
 // Columnar storage in RocksDB
 class RucksDBColumnarStorage {
 private:
+    // Metadata instance; row data lives on shards_ (storage_ first)
     RocksDBStorage* storage_;
-    
-    string GetColumnKey(const string& table_name, idx_t col_idx, idx_t row_id);
-    string GetRowKey(const string& table_name, idx_t row_id);
+    vector<RocksDBStorage*> shards_;
+    RucksDBShardingMode sharding_;
+    idx_t shard_block_rows_;
+    idx_t large_value_size_;
+    bool scan_prefetch_;
+    
+    idx_t ShardIndex(idx_t row_id);
+    RocksDBStorage* GetShard(idx_t row_id);
+    
+    // Row codec. Values of at least large_value_size_ bytes are put into batch under their column
+    // key and leave a LARGE placeholder in the row; ttl stamps them with the row's partition.
+    string EncodeRow(const string& table_name, idx_t row_id, const vector<Value>& values,
+                     rocksdb::WriteBatch& batch, const RucksDBTableTTL* ttl);
+    // Returns the row's encoding
+    string PutRow(const string& table_name, idx_t row_id, const vector<Value>& values,
+                rocksdb::WriteBatch& batch, const RucksDBTableTTL* ttl);
+    
+    // Reads a row as stored, leaving out-of-line columns NULL and listing them in large_columns
+    bool ReadStoredRow(const string& table_name, idx_t row_id, vector<Value>& values, vector<idx_t>& large_columns);
+    // Reads out-of-line values of one shard into their targets with a single sorted MultiGet
+    void ReadLargeValues(RocksDBStorage* shard, vector<std::pair<string, Value*>>& targets);
     
 public:
-    RucksDBColumnarStorage(RocksDBStorage* storage) : storage_(storage) {}
+    RucksDBColumnarStorage(RocksDBStorage* storage);
+    
+    // Row key layout and decoding, shared with readers of raw RocksDB data such as change capture
+    static string GetRowKey(const string& table_name, idx_t row_id);
+    static bool ParseRowKey(const string& table_name, const string& key, idx_t& row_id);
+    // large_columns, when given, receives the columns stored out of line (left NULL in values)
+    static void DecodeRow(const string& data, vector<Value>& values, vector<idx_t>* large_columns = nullptr);
+    
+    // Out-of-line values sit under their row key, so table drops and compactions cover them
+    static string GetColumnKey(const string& table_name, idx_t col_idx, idx_t row_id);
+    static bool ParseColumnKey(const string& table_name, const string& key, idx_t& row_id, idx_t& col_idx);
+    // Stored as "<ttl partition>|<value>", the partition empty when written without a TTL
+    static string DecodeLargeValue(const string& data);
+    static bool GetLargeValuePartition(const rocksdb::Slice& data, int64_t& partition);
     
     // Row-based operations (simpler for initial implementation)
-    void WriteRow(const string& table_name, idx_t row_id, const DataChunk& chunk, idx_t chunk_row);
+    void WriteRow(const string& table_name, idx_t row_id, const DataChunk& chunk, idx_t chunk_row,
+                  const RucksDBTableTTL* ttl = nullptr);
+    // Rows in partitions of ttl that expired by now are treated as missing. Out-of-line values are
+    // only read for the projected columns.
     bool ReadRow(const string& table_name, idx_t row_id, DataChunk& result, idx_t result_row, 
-                const vector<column_t>& column_ids);
+                const vector<column_t>& column_ids, const RucksDBTableTTL* ttl = nullptr, int64_t now = 0);
     void DeleteRow(const string& table_name, idx_t row_id);
+    bool ReadRowValues(const string& table_name, idx_t row_id, vector<Value>& values);
+    // Batched ReadRowValues: one sorted MultiGet per shard for the rows not cached. With column_ids,
+    // only the out-of-line values of those columns are read.
+    void ReadRowsValues(const string& table_name, const vector<idx_t>& row_ids,
+                        vector<vector<Value>>& rows, vector<bool>& found,
+                        const vector<column_t>* column_ids = nullptr);
+    // encoded, when given, receives the row as stored
+    void WriteRowValues(const string& table_name, idx_t row_id, const vector<Value>& values,
+                        const RucksDBTableTTL* ttl = nullptr, string* encoded = nullptr);
+    // The row as stored, uncached, e.g. to copy it under another key
+    bool ReadRowData(const string& table_name, idx_t row_id, string& data);
     
     // Batch operations
-    void WriteChunk(const string& table_name, idx_t start_row, const DataChunk& chunk);
-    idx_t ReadChunk(const string& table_name, idx_t start_row, idx_t max_count, 
-                   DataChunk& result, const vector<column_t>& column_ids);
-                   
-    // Scan operations
-    idx_t ScanRows(const string& table_name, idx_t start_row, idx_t max_count,
-                  DataChunk& result, const vector<column_t>& column_ids);
+    void WriteChunk(const string& table_name, idx_t start_row, const DataChunk& chunk,
+                    const RucksDBTableTTL* ttl = nullptr);
+    // Encodes rows [start_row, start_row + chunk.size()) into batches, one per shard, without
+    // writing them. Only touches batches, so appending threads encode concurrently. encoded_rows,
+    // when given, receives each row's encoding.
+    void EncodeChunk(const string& table_name, idx_t start_row, const DataChunk& chunk,
+                     vector<rocksdb::WriteBatch>& batches, const RucksDBTableTTL* ttl = nullptr,
+                     vector<string>* encoded_rows = nullptr);
+    void DeleteRows(const string& table_name, const vector<idx_t>& row_ids);
+    
+    // Scan operations: reads live rows from next_row up to end_row, advancing next_row past every
+    // row id examined (deleted rows leave gaps). Row ids are read a batch at a time with ReadRowBatch.
+    idx_t ScanRows(const string& table_name, idx_t& next_row, idx_t end_row,
+                  DataChunk& result, const vector<column_t>& column_ids,
+                  const RucksDBTableTTL* ttl = nullptr, int64_t now = 0, const RucksDBHotSnapshot* hot = nullptr);
+    // Reads count row ids from start_row for a scan of column_ids
+    void ReadRowBatch(const string& table_name, idx_t start_row, idx_t count, const vector<column_t>& column_ids,
+                      RucksDBRowBatch& batch);
+    // Appends the live rows of batch to result from result_row on, leaving out rows shadowed by
+    // hot; returns how many were added
+    idx_t EmitRows(const RucksDBRowBatch& batch, DataChunk& result, idx_t result_row,
+                   const vector<column_t>& column_ids, const RucksDBTableTTL* ttl = nullptr, int64_t now = 0,
+                   const RucksDBHotSnapshot* hot = nullptr);
+    // Reads up to a vector of rows from the clustered copies in [next_key, end_key), in key order,
+    // as of snapshot. next_key is moved past the last row read, and cleared once the range is done.
+    idx_t ScanClusterRange(const string& table_name, string& next_key, const string& end_key,
+                           const rocksdb::Snapshot* snapshot, DataChunk& result, const vector<column_t>& column_ids);
+    bool PrefetchScans() const { return scan_prefetch_; }
+    // Removes every row of a table from all shards
+    void DropTableData(const string& table_name);
+    // Compacts a table's rows on all shards, letting the compaction filter drop expired ones
+    void CompactTableData(const string& table_name);
+    
+    idx_t ShardCount() const { return shards_.size(); }
+    // Applies per-shard batches, concurrently when more than one shard has writes
+    void ApplyShardBatches(vector<rocksdb::WriteBatch>& batches);
+    // Scan morsel size; range shards are aligned to it so a morsel never spans two shards
+    idx_t GetMorselSize() const;
+    
+    RucksDBOperationSet& GetTableMetrics(const string& table_name) {
+        return storage_->GetMetrics().GetTableOperations(table_name);
+    }
+};
+
+// Rollups and indexes maintained on every write to a table. A set is never changed once
+// published; declaring or dropping one, or reloading after a secondary caught up, publishes a copy.
+struct RucksDBTableMetadata {
+    // Bound rollups over the table
+    vector<RucksDBRollupDefinition> rollups;
+    // Vector indexes over the table's columns, updated on append and update
+    vector<std::shared_ptr<RucksDBVectorIndex>> vector_indexes;
+    // Bound text indexes over the table's VARCHAR columns, merged into on append and update
+    vector<RucksDBTextIndexDefinition> text_indexes;
+};
+
+// One appending thread's uncommitted rows: encoded into a batch per shard, along with the
+// partition, index, rollup and statistics deltas they imply
+struct RucksDBAppendState {
+    vector<rocksdb::WriteBatch> batches;
+    rocksdb::WriteBatch deltas;
+    // The rollups and indexes the rows are written with; rollups refers into it
+    std::shared_ptr<const RucksDBTableMetadata> metadata;
+    vector<RucksDBRollupAccumulator> rollups;
+    RucksDBTableStatistics stats;
+    idx_t rows = 0;
+    // One past the highest row id reserved since the last commit
+    idx_t next_row = 0;
+    // Held on the table's write lock from the first row reserved until the rows are committed
+    std::shared_lock<std::shared_mutex> writing;
 };
 
 // Custom table storage for RocksDB
@@ -75,195 +294,211 @@ private:
     RucksDBSchema* schema_;
     RucksDBColumnarStorage* storage_;
     vector<ColumnDefinition> columns_;
-    idx_t row_count_;
+    // Next row id. Advanced when appends reserve row ids, before their rows are committed, so it
+    // also covers ids of appends that failed; rows are counted by stats_ once committed.
+    std::atomic<idx_t> row_count_;
+    RucksDBTableStatistics stats_;
+    // Appending threads merge their statistics and row counts into stats_ under this
+    mutable std::mutex stats_lock_;
+    vector<Value> values_buffer_;
+    RucksDBOperationSet* metrics_;
+    // Like hot_, only read and replaced through std::atomic_load/atomic_store, so a write or a
+    // query keeps the set it started with while Reload publishes a new one. Replaced under the
+    // registry's tables_lock_.
+    std::shared_ptr<const RucksDBTableMetadata> metadata_;
+    std::shared_ptr<const RucksDBTableMetadata> GetMetadata() const { return std::atomic_load(&metadata_); }
+    // Publishes a copy of the current set after change has been applied to it
+    void UpdateMetadata(const std::function<void(RucksDBTableMetadata&)>& change);
+    
+    // Set when the table declares a TTL; partitions_ then tracks which rows each time partition holds.
+    // Like hot_, only read and replaced through std::atomic_load/atomic_store.
+    std::shared_ptr<const RucksDBTableTTL> ttl_;
+    RucksDBPartitionIndex partitions_;
+    
+    // Inserts the vectors of appended rows into every vector index
+    void IndexChunk(const RucksDBTableMetadata& metadata, const DataChunk& chunk, idx_t start_row,
+                    rocksdb::WriteBatch& batch);
+    
+    // Set when the table is tiered: appends land here and SealHotRows moves them into RocksDB.
+    // Tiering can be set or cleared while other threads append and scan, so hot_ is only read and
+    // replaced through std::atomic_load/atomic_store, and users hold their own reference.
+    std::shared_ptr<RucksDBHotTier> hot_;
+    // Serializes sealing between the background mover and appends that fall too far behind
+    std::mutex seal_lock_;
+    
+    // Set when the table declares a clustering key: every row also has a copy in key order.
+    // Like hot_, only read and replaced through std::atomic_load/atomic_store.
+    std::shared_ptr<const RucksDBClusterDefinition> cluster_;
+    // Held shared by appends, updates and deletes, and exclusively while SetCluster or SetTTL index
+    // the existing rows, so no row is written or committed without its clustered copy or partition
+    std::shared_mutex write_lock_;
+    // Set under write_lock_ when the table is dropped; plans bound before then still reach this
+    // storage, and their writes fail rather than leave rows behind
+    std::atomic<bool> dropped_{false};
+    void CheckNotDropped() const;
+    
+    // The accumulators refer to metadata's rollups, which must outlive them
+    vector<RucksDBRollupAccumulator> StartRollupDeltas(const RucksDBTableMetadata& metadata);
+    // Adds the row count delta and accumulated rollup deltas to deltas and writes it
+    void ApplyDeltas(rocksdb::WriteBatch& deltas, int64_t added_rows, vector<RucksDBRollupAccumulator>& accumulators);
+    // Reserves row ids for chunk and encodes it into state, returns the first row id. Writes the
+    // caller adds to state.deltas afterwards are committed together with these rows.
+    idx_t AppendRows(DataChunk& chunk, RucksDBAppendState& state);
+    // Writes the rows of state, then its deltas with the row count, and merges its statistics
+    void CommitAppend(RucksDBAppendState& state);
+    // Deletes the live rows among row_ids, returns how many there were
+    idx_t DeleteRowIds(const vector<idx_t>& row_ids);
+    // Writes the newest row of each key in chunks, replacing sealed rows of the same keys
+    idx_t SealChunks(const RucksDBTierDefinition& tier, const vector<std::shared_ptr<const DataChunk>>& chunks,
+                     const vector<string>& log_keys);
     
 public:
     RucksDBTableStorage(const string& table_name, RucksDBSchema* schema, 
                        RucksDBColumnarStorage* storage);
     
     void Initialize(const vector<ColumnDefinition>& columns);
+    // Re-reads row count, statistics and rollups written by another process
+    void Reload();
+    // Waits for writes in flight to commit and fails later ones; called before the data is dropped
+    void MarkDropped();
+    void AddRollup(RucksDBRollupDefinition rollup);
+    void RemoveRollup(const string& rollup_name);
+    // Starts tracking partitions of a bound TTL, indexing the existing rows; returns the partitions
+    idx_t SetTTL(const RucksDBTableTTL& ttl);
+    void ClearTTL();
+    // Forgets expired partitions, returns the rows they held
+    idx_t DropExpiredPartitions(idx_t& partitions);
+    // Registers an index and builds it from the existing rows, returns the rows indexed
+    idx_t AddVectorIndex(std::shared_ptr<RucksDBVectorIndex> index);
+    void RemoveVectorIndex(const string& index_name);
+    // Index over column, or null when the column has none
+    std::shared_ptr<RucksDBVectorIndex> GetVectorIndex(const string& column);
+    bool HasVectorIndexes() const { return !GetMetadata()->vector_indexes.empty(); }
+    // Registers a bound text index and indexes the existing rows, returns the rows indexed
+    idx_t AddTextIndex(const RucksDBTextIndexDefinition& index);
+    void RemoveTextIndex(const string& index_name);
+    // False when column has no text index
+    bool GetTextIndex(const string& column, RucksDBTextIndexDefinition& index);
+    // Makes the table tiered, indexing the keys of its existing rows; returns the rows indexed
+    idx_t SetTier(const RucksDBTierDefinition& tier);
+    // Seals every hot row and makes the table plain again, returns the rows sealed
+    idx_t ClearTier();
+    // Moves full row groups of the hot tier into RocksDB (the whole hot tier when force), returns
+    // the rows written
+    idx_t SealHotRows(bool force);
+    std::shared_ptr<RucksDBHotTier> GetHotTier() const { return std::atomic_load(&hot_); }
+    // Clusters the table by a bound key, copying the existing rows; returns the rows copied
+    idx_t SetCluster(const RucksDBClusterDefinition& cluster);
+    void ClearCluster();
+    std::shared_ptr<const RucksDBClusterDefinition> GetCluster() const { return std::atomic_load(&cluster_); }
     
     // Data operations
     void Append(DataChunk& chunk);
+    // Parallel appends: each thread initializes its own state, appends chunks to it and finalizes
+    // it. Threads reserve row ids and encode independently; a state commits once it holds 16MB
+    // of encoded rows and when finalized.
+    void InitializeAppend(RucksDBAppendState& state);
+    void Append(DataChunk& chunk, RucksDBAppendState& state);
+    void FinalizeAppend(RucksDBAppendState& state);
     void Delete(const Vector& row_ids, idx_t count);
     void Update(const Vector& row_ids, const vector<column_t>& column_ids, DataChunk& data);
     
     // Scan operations
-    void InitializeScan(TableScanState& state, const vector<column_t>& column_ids);
-    void Scan(DataChunk& result, TableScanState& state, const vector<column_t>& column_ids);
+    // Scans row ids [start_row, end_row), clamped to the table's row count
+    void InitializeScan(RucksDBScanState& state, const vector<column_t>& column_ids,
+                        idx_t start_row, idx_t end_row);
+    void Scan(DataChunk& result, RucksDBScanState& state, const vector<column_t>& column_ids);
+    // Scans the clustered copies, see RucksDBColumnarStorage::ScanClusterRange
+    void ScanCluster(DataChunk& result, string& next_key, const string& end_key, const rocksdb::Snapshot* snapshot,
+                     const vector<column_t>& column_ids);
+    // Snapshot of the storage holding the clustered copies
+    std::shared_ptr<const rocksdb::Snapshot> GetClusterSnapshot() { return schema_->GetStorage()->GetSnapshot(); }
+    // Values of one live row, false when it was deleted, has expired or is superseded by a hot row.
+    // Hot rows themselves have no row id until they are sealed.
+    bool FetchRow(idx_t row_id, vector<Value>& values);
+    // FetchRow for many rows at once, through MultiGet
+    void FetchRows(const vector<idx_t>& row_ids, vector<vector<Value>>& rows, vector<bool>& found);
     
     // Metadata
     idx_t GetRowCount() const { return row_count_; }
+    // Committed rows less deleted ones, plus hot rows, counting keys held in both tiers twice
+    idx_t GetLiveRowCount() const {
+        auto hot = GetHotTier();
+        std::lock_guard<std::mutex> guard(stats_lock_);
+        return stats_.GetRowCount() + (hot ? hot->GetRowCount() : 0);
+    }
     const vector<ColumnDefinition>& GetColumns() const { return columns_; }
     const string& GetTableName() const { return table_name_; }
+    // A copy, as appending threads merge into the statistics concurrently
+    RucksDBTableStatistics GetStatistics() const {
+        std::lock_guard<std::mutex> guard(stats_lock_);
+        return stats_;
+    }
+    // Statistics reported to the optimizer for one column, null when they are not known to hold
+    unique_ptr<BaseStatistics> GetColumnStatistics(column_t column_id, const LogicalType& type) const;
+    idx_t GetMorselSize() const { return storage_->GetMorselSize(); }
+    std::shared_ptr<const RucksDBTableTTL> GetTTL() const { return std::atomic_load(&ttl_); }
+    // Rows below this id are all expired, so scans start here
+    idx_t GetFirstLiveRow();
 };
 
-// Scan state for RocksDB tables
-struct RucksDBScanState : public TableScanState {
-    idx_t current_row = 0;
-    idx_t total_rows = 0;
-    string table_name;
-    vector<column_t> column_ids;
-    bool finished = false;
-};
-
-// Table function for scanning RocksDB tables
-struct RocksDBTableFunction {
-    static void RegisterFunction(DatabaseInstance& db);
-    
-    static unique_ptr<FunctionData> Bind(ClientContext& context, TableFunctionBindInput& input,
-                                       vector<LogicalType>& return_types, vector<string>& names);
-    
-    static unique_ptr<GlobalTableFunctionState> InitGlobal(ClientContext& context, 
-                                                          TableFunctionInitInput& input);
-    
-    static unique_ptr<LocalTableFunctionState> InitLocal(ExecutionContext& context, 
-                                                        TableFunctionInitInput& input,
-                                                        GlobalTableFunctionState* global_state);
-    
-    static void Execute(ClientContext& context, TableFunctionInput& data, DataChunk& output);
-};
-
-// Bind data for RocksDB table function
-struct RocksDBBindData : public TableFunctionData {
-    string table_name;
-    vector<LogicalType> types;
-    vector<string> names;
-    RucksDBTableStorage* table_storage;
-};
-
-// Global state for RocksDB table function
-struct RocksDBGlobalState : public GlobalTableFunctionState {
-    string table_name;
-    idx_t total_rows;
-};
-
-// Global registry for RocksDB tables
-class RucksDBTableRegistry {
-private:
-    std::unordered_map<string, unique_ptr<RucksDBTableStorage>> tables_;
-    unique_ptr<RucksDBSchema> schema_;
-    unique_ptr<RucksDBColumnarStorage> storage_;
-    
-public:
-    RucksDBTableRegistry(RocksDBStorage* storage);
-    
-    void CreateTable(const string& name, const vector<ColumnDefinition>& columns);
-    void DropTable(const string& name);
-    RucksDBTableStorage* GetTable(const string& name);
-    bool TableExists(const string& name);
-    
-    vector<string> ListTables();
-};
-
-// Global registry instance
-extern unique_ptr<RucksDBTableRegistry> g_table_registry;
-
-} // namespace duckdb
-
-namespace duckdb {
-
-// Forward declarations
-class RucksDBTableStorage;
-class RucksDBTransaction;
-
-// Extension main class
-class RucksDBExtension : public Extension {
-public:
-    void Load(DuckDB &db) override;
-    std::string Name() override { return "rucksdb"; }
-    std::string Version() const override { return "1.0.0"; }
-};
-
-// Schema management for RocksDB tables
-class RucksDBSchema {
-private:
-    RocksDBStorage* storage_;
-    static constexpr char SCHEMA_PREFIX[] = "schema_";
-    static constexpr char TABLE_META_PREFIX[] = "table_meta_";
-    
-public:
-    RucksDBSchema(RocksDBStorage* storage) : storage_(storage) {}
-    
-    void CreateTable(const string& table_name, const vector<ColumnDefinition>& columns);
-    void DropTable(const string& table_name);
-    vector<ColumnDefinition> GetTableSchema(const string& table_name);
-    bool TableExists(const string& table_name);
-    
-    // Metadata operations
-    void StoreTableMetadata(const string& table_name, idx_t row_count);
-    idx_t LoadTableRowCount(const string& table_name);
-};
-
-// Columnar storage in RocksDB
-class RucksDBColumnarStorage {
-private:
-    RocksDBStorage* storage_;
-    
-    string GetColumnKey(const string& table_name, idx_t col_idx, idx_t row_id);
-    string GetRowKey(const string& table_name, idx_t row_id);
-    
-public:
-    RucksDBColumnarStorage(RocksDBStorage* storage) : storage_(storage) {}
-    
-    // Row-based operations (simpler for initial implementation)
-    void WriteRow(const string& table_name, idx_t row_id, const DataChunk& chunk, idx_t chunk_row);
-    bool ReadRow(const string& table_name, idx_t row_id, DataChunk& result, idx_t result_row, 
-                const vector<column_t>& column_ids);
-    void DeleteRow(const string& table_name, idx_t row_id);
-    
-    // Batch operations
-    void WriteChunk(const string& table_name, idx_t start_row, const DataChunk& chunk);
-    idx_t ReadChunk(const string& table_name, idx_t start_row, idx_t max_count, 
-                   DataChunk& result, const vector<column_t>& column_ids);
-                   
-    // Scan operations
-    idx_t ScanRows(const string& table_name, idx_t start_row, idx_t max_count,
-                  DataChunk& result, const vector<column_t>& column_ids);
-};
-
-// Custom table storage for RocksDB
-class RucksDBTableStorage {
+// Reads row batches on one background thread that lives as long as its scan state, so a scan
+// starts a thread once instead of once per vector
+class RucksDBScanPrefetcher {
 private:
+    std::thread worker_;
+    std::mutex lock_;
+    std::condition_variable cv_;
+    bool stop_ = false;
+    // A read is requested and not yet taken by Wait; done once its batch (or error) is set
+    bool requested_ = false;
+    bool done_ = false;
+    RucksDBColumnarStorage* storage_ = nullptr;
     string table_name_;
-    RocksDBSchema* schema_;
-    RucksDBColumnarStorage* storage_;
-    vector<ColumnDefinition> columns_;
-    idx_t row_count_;
-    
-public:
-    RucksDBTableStorage(const string& table_name, RocksDBSchema* schema, 
-                       RucksDBColumnarStorage* storage);
-    
-    void Initialize(const vector<ColumnDefinition>& columns);
-    
-    // Data operations
-    void Append(DataChunk& chunk);
-    void Delete(const Vector& row_ids, idx_t count);
-    void Update(const Vector& row_ids, const vector<column_t>& column_ids, DataChunk& data);
+    idx_t start_row_ = 0;
+    idx_t count_ = 0;
+    vector<column_t> column_ids_;
+    RucksDBRowBatch batch_;
+    std::exception_ptr error_;
     
-    // Scan operations
-    void InitializeScan(TableScanState& state, const vector<column_t>& column_ids);
-    void Scan(DataChunk& result, TableScanState& state, const vector<column_t>& column_ids);
+    void Run();
     
-    // Metadata
-    idx_t GetRowCount() const { return row_count_; }
-    const vector<ColumnDefinition>& GetColumns() const { return columns_; }
-    const string& GetTableName() const { return table_name_; }
+public:
+    ~RucksDBScanPrefetcher();
+    
+    // Starts reading count row ids from start_row; the previous read must have been waited for
+    void Start(RucksDBColumnarStorage* storage, const string& table_name, idx_t start_row, idx_t count,
+               const vector<column_t>& column_ids);
+    // Whether a read was started and not yet waited for
+    bool Pending();
+    // Waits for the started read and moves its batch out, rethrowing its error
+    void Wait(RucksDBRowBatch& batch);
 };
 
 // Scan state for RocksDB tables
-struct RucksDBScanState : public TableScanState {
+struct RucksDBScanState : public LocalTableFunctionState {
     idx_t current_row = 0;
     idx_t total_rows = 0;
     string table_name;
     vector<column_t> column_ids;
     bool finished = false;
+    
+    // Run-ahead read of the vector after the current one, in flight while DuckDB processes it
+    bool prefetch = false;
+    RucksDBScanPrefetcher pending;
+    // The following morsel, claimed before this one ends so its first vector can be prefetched
+    bool queued = false;
+    idx_t queued_start = 0;
+    idx_t queued_end = 0;
+    
+    // Hot rows of a tiered table as of the scan's start; sealed rows with their keys are skipped
+    const RucksDBHotSnapshot* hot = nullptr;
 };
 
 // Table function for scanning RocksDB tables
 struct RocksDBTableFunction {
     static void RegisterFunction(DatabaseInstance& db);
+    static TableFunction GetFunction();
     
     static unique_ptr<FunctionData> Bind(ClientContext& context, TableFunctionBindInput& input,
                                        vector<LogicalType>& return_types, vector<string>& names);
@@ -276,6 +511,11 @@ struct RocksDBTableFunction {
                                                         GlobalTableFunctionState* global_state);
     
     static void Execute(ClientContext& context, TableFunctionInput& data, DataChunk& output);
+    
+    // Optimizer hooks
+    static unique_ptr<NodeStatistics> Cardinality(ClientContext& context, const FunctionData* bind_data);
+    static unique_ptr<BaseStatistics> Statistics(ClientContext& context, const FunctionData* bind_data,
+                                                 column_t column_index);
 };
 
 // Bind data for RocksDB table function
@@ -284,52 +524,115 @@ struct RocksDBBindData : public TableFunctionData {
     vector<LogicalType> types;
     vector<string> names;
     RucksDBTableStorage* table_storage;
+    // rocksdb_scan(..., prefetch := ...); NULL uses the instance's scan_prefetch option
+    Value prefetch;
+    // Set by RucksDBClusterPushdown when filters bound the clustering key of the table
+    std::shared_ptr<const RucksDBClusterRange> cluster_range;
 };
 
 // Global state for RocksDB table function
 struct RocksDBGlobalState : public GlobalTableFunctionState {
     string table_name;
     idx_t total_rows;
-};
-
-// Transaction support
-class RucksDBTransaction {
-private:
-    rocksdb::TransactionDB* txn_db_;
-    rocksdb::Transaction* txn_;
-    bool active_;
-    
-public:
-    RucksDBTransaction(rocksdb::TransactionDB* txn_db);
-    ~RucksDBTransaction();
-    
-    void Begin();
-    void Commit();
-    void Rollback();
-    
-    bool Put(const string& key, const string& value);
-    bool Get(const string& key, string& value);
-    bool Delete(const string& key);
-    
-    bool IsActive() const { return active_; }
+    idx_t morsel_size;
+    // Start of the next unclaimed morsel
+    std::atomic<idx_t> next_row{0};
+    // Tiered tables: hot chunks are claimed one at a time once the sealed rows are all claimed
+    std::shared_ptr<const RucksDBHotSnapshot> hot;
+    std::atomic<idx_t> next_hot_chunk{0};
+    // Clustered range scans walk one key range in order on a single thread
+    bool clustered = false;
+    string cluster_next_key;
+    string cluster_end_key;
+    // Every vector resumes the range from this view, so copies that an UPDATE of the key moves
+    // ahead of the cursor, or that an INSERT from this scan adds, are not read again
+    std::shared_ptr<const rocksdb::Snapshot> cluster_snapshot;
+    
+    idx_t MaxThreads() const override {
+        if (clustered) {
+            return 1;
+        }
+        idx_t hot_chunks = hot ? hot->chunks.size() : 0;
+        return std::max<idx_t>(1, (total_rows + morsel_size - 1) / morsel_size + hot_chunks);
+    }
 };
 
 // Global registry for RocksDB tables
 class RucksDBTableRegistry {
 private:
+    std::mutex tables_lock_;
     std::unordered_map<string, unique_ptr<RucksDBTableStorage>> tables_;
+    // Storages of dropped tables. Plans bound before the drop still point at them, so they stay
+    // allocated as long as the registry.
+    vector<unique_ptr<RucksDBTableStorage>> dropped_tables_;
     unique_ptr<RucksDBSchema> schema_;
     unique_ptr<RucksDBColumnarStorage> storage_;
+    RocksDBStorage* rocksdb_;
+    uint64_t catch_up_epoch_;
+    
+    // Background mover sealing the hot tiers of loaded tiered tables. mover_lock_ is held while it
+    // seals, so tables are not dropped or re-tiered under it; take it before tables_lock_.
+    std::mutex mover_lock_;
+    std::condition_variable mover_cv_;
+    std::thread mover_;
+    std::once_flag mover_started_;
+    bool mover_stop_ = false;
+    void StartMover();
+    void MoverLoop();
+    
+    // Reloads cached metadata once a secondary storage has caught up; tables_lock_ must be held
+    void RefreshIfStale();
     
 public:
     RucksDBTableRegistry(RocksDBStorage* storage);
+    ~RucksDBTableRegistry();
     
     void CreateTable(const string& name, const vector<ColumnDefinition>& columns);
     void DropTable(const string& name);
+    // Loads the table's storage on first access: statistics, indexes, rollups and hot tier
     RucksDBTableStorage* GetTable(const string& name);
     bool TableExists(const string& name);
+    // Columns from the schema alone, without loading the table
+    vector<ColumnDefinition> GetTableColumns(const string& name);
     
     vector<string> ListTables();
+    
+    // Declares a rollup and backfills it from the existing rows, returns the rows aggregated
+    idx_t CreateRollup(RucksDBRollupDefinition rollup);
+    void DropRollup(const string& name);
+    // Bound definition; throws for unknown rollups
+    RucksDBRollupDefinition GetRollup(const string& name);
+    
+    // Declares a TTL and indexes the existing rows, returns the partitions found
+    idx_t SetTableTTL(const string& table_name, RucksDBTableTTL ttl);
+    void ClearTableTTL(const string& table_name);
+    // Drops expired partitions and compacts their rows away, returns the rows dropped
+    idx_t ExpireTable(const string& table_name, idx_t& partitions);
+    // Points the storage's compaction filter at the TTLs of all tables
+    void InstallExpiryCheck();
+    
+    // Declares an HNSW index over a vector column and builds it, returns the rows indexed
+    idx_t CreateVectorIndex(RucksDBVectorIndexDefinition index);
+    void DropVectorIndex(const string& name);
+    
+    // Declares an inverted index over a VARCHAR column and builds it, returns the rows indexed
+    idx_t CreateTextIndex(RucksDBTextIndexDefinition index);
+    void DropTextIndex(const string& name);
+    
+    // Makes a table tiered (re-keying it if it already was), returns the existing rows indexed
+    idx_t SetTableTier(const string& table_name, RucksDBTierDefinition tier);
+    // Seals the hot tier and makes the table plain again, returns the rows sealed
+    idx_t ClearTableTier(const string& table_name);
+    // Seals the whole hot tier now, returns the rows written
+    idx_t SealTable(const string& table_name);
+    
+    // Clusters a table by a key (re-keying it if it already was), returns the rows copied
+    idx_t SetTableClustering(const string& table_name, RucksDBClusterDefinition cluster);
+    void ClearTableClustering(const string& table_name);
+    // Compacts the clustered copies now, merging the key runs of separate appends into sorted
+    // files; returns the table's live rows
+    idx_t ReclusterTable(const string& table_name);
+    RocksDBStorage* GetStorage() { return rocksdb_; }
 };
 
 // Global registry instance
@@ -0,0 +1,109 @@
+// include/RucksDBIngestQueue.hpp
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "RocksDBStorage.hpp"
+#include "RucksDBHistogram.hpp"
+
+namespace duckdb {
+
+struct RucksDBIngestOptions {
+    // Pending writes per worker before producers block
+    size_t queue_capacity = 65536;
+    // Writes coalesced into one WriteBatch
+    size_t max_batch_size = 1024;
+    // Longest a write waits for its batch to fill up
+    std::chrono::microseconds max_latency{1000};
+    // Workers; keys are hash-partitioned so writes to one key stay ordered
+    size_t worker_threads = 1;
+};
+
+struct RucksDBIngestStatistics {
+    uint64_t enqueued = 0;
+    uint64_t completed = 0;
+    uint64_t failed = 0;
+    uint64_t batches = 0;
+    uint64_t enqueue_p50_ns = 0;
+    uint64_t enqueue_p99_ns = 0;
+    uint64_t commit_p50_ns = 0;
+    uint64_t commit_p99_ns = 0;
+    double throughput = 0; // completed writes per second since the queue started
+};
+
+// Asynchronous, pipelined write path: bounded queues drained by background
+// workers into coalesced WriteBatches
+class RucksDBIngestQueue {
+public:
+    using Callback = std::function<void(bool success, const string &error)>;
+
+private:
+    struct Item {
+        string key;
+        string value;
+        bool is_delete = false;
+        bool has_promise = false;
+        std::promise<bool> promise;
+        Callback callback;
+        std::chrono::steady_clock::time_point enqueue_time;
+    };
+
+    struct Partition {
+        std::mutex lock;
+        std::condition_variable not_empty;
+        std::condition_variable not_full;
+        std::condition_variable drained;
+        std::deque<Item> items;
+        size_t in_flight = 0;
+        std::thread worker;
+    };
+
+    RocksDBStorage *storage_;
+    RucksDBIngestOptions options_;
+    std::vector<std::unique_ptr<Partition>> partitions_;
+    std::atomic<bool> stop_{false};
+    std::atomic<int> flush_waiters_{0};
+    std::chrono::steady_clock::time_point start_time_;
+
+    std::atomic<uint64_t> enqueued_{0};
+    std::atomic<uint64_t> completed_{0};
+    std::atomic<uint64_t> failed_{0};
+    std::atomic<uint64_t> batches_{0};
+    RucksDBHistogram enqueue_latency_;
+    RucksDBHistogram commit_latency_;
+
+    Partition &GetPartition(const string &key);
+    void Enqueue(Item item);
+    void WorkerLoop(Partition &partition);
+
+public:
+    RucksDBIngestQueue(RocksDBStorage *storage, const RucksDBIngestOptions &options = RucksDBIngestOptions());
+    // Drains pending writes before joining the workers
+    ~RucksDBIngestQueue();
+
+    std::future<bool> PutAsync(const string &key, const string &value);
+    void PutAsync(const string &key, const string &value, Callback callback);
+    std::future<bool> DeleteAsync(const string &key);
+    void DeleteAsync(const string &key, Callback callback);
+
+    // Blocks until every write enqueued before the call has been committed
+    void Flush();
+    void Shutdown();
+
+    RucksDBIngestStatistics GetStatistics();
+};
+
+// Global ingest queue over g_rocksdb_storage, started on first async write
+extern std::unique_ptr<RucksDBIngestQueue> g_ingest_queue;
+RucksDBIngestQueue &GetGlobalIngestQueue();
+
+} // namespace duckdb
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "RocksDBStorage.hpp"
+#include <mutex>
+
+namespace duckdb {
+
+class RucksDBTableRegistry;
+
+// One open RucksDB database: its storage and the table registry over it
+struct RucksDBInstance {
+    RocksDBStorage* storage = nullptr;
+    RucksDBTableRegistry* registry = nullptr;
+};
+
+// Named RucksDB databases visible to the SQL table functions. The unnamed default is the one
+// opened by rucksdb_init; every ATTACH ... (TYPE rucksdb) registers under its attached name,
+// and C++ callers can Open any number of additional instances.
+class RucksDBInstanceRegistry {
+public:
+    // Registers an instance owned elsewhere (e.g. by an attached catalog)
+    static void Register(const string& name, RocksDBStorage* storage, RucksDBTableRegistry* registry);
+    static void Unregister(const string& name);
+
+    // Opens and owns a new instance, independent of g_rocksdb_storage
+    static RucksDBInstance Open(const string& name, const string& path,
+                                const RocksDBStorageOptions& options = RocksDBStorageOptions());
+    static void Close(const string& name);
+
+    // Empty name returns the default instance; unknown names throw
+    static RucksDBInstance Get(const string& name);
+    // Resolves the optional "database" named parameter of a table function
+    static RucksDBInstance Get(TableFunctionBindInput& input);
+    static vector<string> List();
+};
+
+} // namespace duckdb
\ No newline at end of file
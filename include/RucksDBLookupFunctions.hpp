@@ -0,0 +1,21 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// Index-nested-loop join against a RucksDB table, as a table in-out function:
+//   SELECT * FROM rocksdb_lookup((SELECT order_id AS row_id, note FROM recent), 'orders')
+// The first input column holds the probe keys (row ids, the primary key of RucksDB tables).
+// Each input vector is sorted by key and resolved with one MultiGet per shard, so the cost
+// follows the number of probes rather than the table size. Output is every input column
+// followed by the matched row's columns; probes without a live row are dropped (inner join).
+// Accepts database := 'name' for attached instances.
+struct RucksDBLookupFunctions {
+    static void RegisterFunctions(DatabaseInstance& db);
+
+    static TableFunction GetLookupFunction();
+};
+
+} // namespace duckdb
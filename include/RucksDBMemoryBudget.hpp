@@ -0,0 +1,80 @@
+// include/RucksDBMemoryBudget.hpp
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "rocksdb/cache.h"
+#include "rocksdb/options.h"
+#include "rocksdb/write_buffer_manager.h"
+
+namespace duckdb {
+
+class DatabaseInstance;
+
+struct RucksDBMemoryStatistics {
+    uint64_t budget = 0;
+    // Block cache capacity, which memtables are charged to as well
+    uint64_t rocksdb_capacity = 0;
+    uint64_t rocksdb_usage = 0;
+    uint64_t memtable_usage = 0;
+    // DuckDB's buffer manager (0 until a DuckDB instance is attached)
+    uint64_t duckdb_limit = 0;
+    uint64_t duckdb_used = 0;
+    // Times the cache gave memory to DuckDB and took it back
+    uint64_t shrinks = 0;
+    uint64_t grows = 0;
+};
+
+// One memory budget for RocksDB and DuckDB together. Every RocksDB instance and shard on the
+// budget shares one block cache, and memtables are charged to that cache through a
+// WriteBufferManager, so the cache capacity bounds all of RocksDB's memory. DuckDB's memory
+// limit is set to the rest of the budget. A background thread then moves memory between the
+// two: when DuckDB nears its limit (a large hash join, say) the cache gives up a step, down to
+// a floor that keeps the memtables and hot index blocks, and it grows back once DuckDB's usage drops.
+class RucksDBMemoryBudget {
+private:
+    uint64_t budget_;
+    // RocksDB's share when DuckDB is not under pressure, and how far it may shrink
+    uint64_t rocksdb_target_;
+    uint64_t rocksdb_floor_;
+    uint64_t memtable_limit_;
+    uint64_t step_;
+
+    std::shared_ptr<rocksdb::Cache> cache_;
+    std::shared_ptr<rocksdb::WriteBufferManager> write_buffer_manager_;
+
+    std::mutex lock_;
+    std::weak_ptr<DatabaseInstance> duckdb_;
+    std::atomic<uint64_t> shrinks_{0};
+    std::atomic<uint64_t> grows_{0};
+
+    std::thread rebalance_thread_;
+    std::condition_variable rebalance_cv_;
+    bool stop_ = false;
+
+    void RebalanceLoop();
+
+public:
+    // rocksdb_share is the fraction of budget RocksDB gets while DuckDB has room
+    RucksDBMemoryBudget(uint64_t budget, double rocksdb_share);
+    ~RucksDBMemoryBudget();
+
+    // Points options at the shared block cache and write buffer manager
+    void Configure(rocksdb::Options &options);
+    // Limits DuckDB to the rest of the budget and starts rebalancing against it; the budget follows
+    // one DuckDB instance, the one attached last
+    void AttachDuckDB(std::shared_ptr<DatabaseInstance> db);
+    // One rebalancing step, normally run by the background thread
+    void Rebalance();
+    RucksDBMemoryStatistics GetStatistics();
+
+    // The budget configured through rucksdb_init, joined by instances opened without their own
+    static std::shared_ptr<RucksDBMemoryBudget> GetDefault();
+    static void SetDefault(std::shared_ptr<RucksDBMemoryBudget> budget);
+};
+
+} // namespace duckdb
@@ -0,0 +1,55 @@
+// include/RucksDBMergeOperator.hpp
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "rocksdb/merge_operator.h"
+#include "rocksdb/slice.h"
+
+namespace duckdb {
+
+using string = std::string;
+
+// Associative aggregates that RocksDB combines itself through Merge, so writers
+// add deltas without reading the current value first. COUNT is a SUM of ones.
+enum class RucksDBAggregateKind : uint8_t { SUM = 0, MIN, MAX, HLL };
+
+struct RucksDBAggregateValue {
+    RucksDBAggregateKind kind = RucksDBAggregateKind::SUM;
+    bool is_double = false;
+    // MIN/MAX that have not seen a value yet
+    bool empty = true;
+    int64_t int_value = 0;
+    double double_value = 0;
+    // HLL registers (see RucksDBHyperLogLog), combined by taking the per-register maximum
+    string registers;
+
+    void Merge(const RucksDBAggregateValue &other);
+};
+
+// A merge record is a fixed list of aggregates, e.g. one per rollup column. Plain decimal
+// strings (row counts written before merges were used) decode as a single integer SUM.
+string EncodeAggregates(const std::vector<RucksDBAggregateValue> &values);
+bool DecodeAggregates(const rocksdb::Slice &data, std::vector<RucksDBAggregateValue> &values);
+
+// Single integer SUM, e.g. a row count delta, or a MIN/MAX such as a row id high-water mark
+string EncodeCounter(int64_t delta, RucksDBAggregateKind kind = RucksDBAggregateKind::SUM);
+int64_t DecodeCounter(const string &data);
+
+// Posting list of a text index term: sorted, distinct row ids stored as a count, the last id,
+// then varint deltas. Merging two lists is a union; operands appended in row id order are
+// spliced together without decoding.
+string EncodePostings(const std::vector<uint64_t> &row_ids);
+bool DecodePostings(const rocksdb::Slice &data, std::vector<uint64_t> &row_ids);
+bool MergePostings(const rocksdb::Slice &existing, const rocksdb::Slice &operand, string &merged);
+
+// Merge operator installed on every RucksDB database; handles aggregates and posting lists
+class RucksDBAggregateMergeOperator : public rocksdb::AssociativeMergeOperator {
+public:
+    bool Merge(const rocksdb::Slice &key, const rocksdb::Slice *existing_value, const rocksdb::Slice &value,
+               std::string *new_value, rocksdb::Logger *logger) const override;
+    const char *Name() const override { return "RucksDBAggregateMergeOperator"; }
+};
+
+} // namespace duckdb
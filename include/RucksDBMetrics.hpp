@@ -0,0 +1,104 @@
+// include/RucksDBMetrics.hpp
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "RucksDBHistogram.hpp"
+
+namespace duckdb {
+
+using string = std::string;
+
+enum class RucksDBOperation : uint8_t { PUT = 0, GET, DELETE, SCAN, APPEND, BATCH, MERGE };
+static constexpr size_t RUCKSDB_OPERATION_COUNT = 7;
+
+const char *RucksDBOperationName(RucksDBOperation op);
+
+// Latency, call and row counters for one operation
+struct RucksDBOperationMetrics {
+    RucksDBHistogram latency_ns;
+    std::atomic<uint64_t> rows{0};
+    std::atomic<uint64_t> bytes{0};
+};
+
+struct RucksDBOperationSet {
+    RucksDBOperationMetrics ops[RUCKSDB_OPERATION_COUNT];
+
+    RucksDBOperationMetrics &Get(RucksDBOperation op) { return ops[size_t(op)]; }
+};
+
+// Totals of the PerfContext/IOStatsContext counters over the sampled operations
+struct RucksDBPerfSample {
+    std::atomic<uint64_t> samples{0};
+    std::atomic<uint64_t> block_cache_hit_count{0};
+    std::atomic<uint64_t> block_read_count{0};
+    std::atomic<uint64_t> block_read_byte{0};
+    std::atomic<uint64_t> block_read_time_ns{0};
+    std::atomic<uint64_t> get_from_memtable_count{0};
+    std::atomic<uint64_t> internal_key_skipped_count{0};
+    std::atomic<uint64_t> internal_delete_skipped_count{0};
+    std::atomic<uint64_t> write_wal_time_ns{0};
+    std::atomic<uint64_t> write_memtable_time_ns{0};
+    std::atomic<uint64_t> io_bytes_read{0};
+    std::atomic<uint64_t> io_bytes_written{0};
+};
+
+// Process-side instrumentation for one RocksDBStorage: storage-wide and
+// per-table latency histograms plus sampled RocksDB perf counters
+class RucksDBMetrics {
+private:
+    RucksDBOperationSet storage_ops_;
+    RucksDBPerfSample perf_;
+    // Every Nth storage operation on a thread collects PerfContext counters (0 disables)
+    size_t perf_sample_rate_;
+
+    std::mutex tables_lock_;
+    // Entries are never removed so callers may keep references across drops
+    std::unordered_map<string, std::unique_ptr<RucksDBOperationSet>> tables_;
+
+public:
+    explicit RucksDBMetrics(size_t perf_sample_rate = 64) : perf_sample_rate_(perf_sample_rate) {}
+
+    void Record(RucksDBOperation op, uint64_t nanos, uint64_t rows = 1, uint64_t bytes = 0);
+    void RecordTable(const string &table_name, RucksDBOperation op, uint64_t nanos, uint64_t rows = 1,
+                     uint64_t bytes = 0);
+
+    RucksDBOperationSet &GetStorageOperations() { return storage_ops_; }
+    RucksDBOperationSet &GetTableOperations(const string &table_name);
+    std::vector<string> ListTables();
+    const RucksDBPerfSample &GetPerfSample() const { return perf_; }
+
+    // PerfContext sampling; StartSample returns whether this operation is sampled
+    bool StartSample();
+    void EndSample();
+
+    void Reset();
+};
+
+// Times a scope and records it against a storage-wide or per-table operation; a null target disables it
+class RucksDBOperationTimer {
+private:
+    RucksDBMetrics *metrics_;
+    RucksDBOperationSet *set_;
+    RucksDBOperation op_;
+    std::chrono::steady_clock::time_point start_;
+    bool sampled_;
+
+public:
+    uint64_t rows = 1;
+    uint64_t bytes = 0;
+
+    // Storage-wide, with PerfContext sampling
+    RucksDBOperationTimer(RucksDBMetrics *metrics, RucksDBOperation op);
+    // Per-table; these wrap storage-level operations, so they do not sample
+    RucksDBOperationTimer(RucksDBOperationSet *set, RucksDBOperation op);
+    ~RucksDBOperationTimer();
+};
+
+} // namespace duckdb
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/optimizer/optimizer_extension.hpp"
+#include "duckdb/planner/operator/logical_aggregate.hpp"
+#include "duckdb/planner/operator/logical_filter.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
+#include "duckdb/planner/expression/bound_aggregate_expression.hpp"
+
+namespace duckdb {
+
+struct RocksDBBindData;
+struct RucksDBClusterBounds;
+struct RucksDBClusterDefinition;
+
+// Optimizer extension that answers ungrouped COUNT/MIN/MAX over rocksdb_scan
+// from table metadata and column statistics instead of scanning the table
+class RucksDBAggregatePushdown : public OptimizerExtension {
+public:
+    RucksDBAggregatePushdown() {
+        optimize_function = Optimize;
+    }
+
+    static void Optimize(OptimizerExtensionInput& input, unique_ptr<LogicalOperator>& plan);
+
+private:
+    static bool TryRewriteAggregate(OptimizerExtensionInput& input, unique_ptr<LogicalOperator>& op);
+    static bool ComputeAggregate(const BoundAggregateExpression& aggr, const LogicalGet& get,
+                                 const RocksDBBindData& bind_data, Value& result);
+};
+
+// Optimizer extension that turns filters on the leading clustering key columns of a clustered
+// table into a key range for rocksdb_scan, read with one bounded iterator seek. The filter stays
+// in the plan, as the range may hold more rows than it matches.
+class RucksDBClusterPushdown : public OptimizerExtension {
+public:
+    RucksDBClusterPushdown() {
+        optimize_function = Optimize;
+    }
+
+    static void Optimize(OptimizerExtensionInput& input, unique_ptr<LogicalOperator>& plan);
+
+private:
+    static void PushRange(LogicalFilter& filter, LogicalGet& get);
+    static void AddBounds(const Expression& expr, const LogicalGet& get, const RucksDBClusterDefinition& cluster,
+                          RucksDBClusterBounds& bounds);
+};
+
+} // namespace duckdb
\ No newline at end of file
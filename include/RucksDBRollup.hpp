@@ -0,0 +1,86 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/parser/column_definition.hpp"
+#include "RucksDBMergeOperator.hpp"
+#include "RucksDBStatistics.hpp"
+#include "rocksdb/write_batch.h"
+#include <unordered_map>
+
+namespace duckdb {
+
+// One aggregate column of a rollup, e.g. sum(amount). COUNT is a SUM of ones without a column.
+struct RucksDBRollupAggregate {
+    RucksDBAggregateKind kind = RucksDBAggregateKind::SUM;
+    bool is_count = false;
+    string column;
+    // Resolved by Bind
+    idx_t column_index = 0;
+    LogicalType type;
+
+    bool IsDouble() const;
+    string OutputName() const;
+    LogicalType OutputType() const;
+};
+
+// Materialized rollup over a RucksDB table: aggregates grouped by key columns, optionally
+// bucketing a TIMESTAMP or integer time column into fixed-width buckets (e.g. per minute).
+// Maintained on append through merge operands, so neither the base rows nor the current
+// aggregates are read. Deletes and updates retract COUNT and SUM; MIN, MAX and distinct
+// counts only grow.
+struct RucksDBRollupDefinition {
+    string name;
+    string table_name;
+    string time_column;
+    int64_t bucket_seconds = 0;
+    vector<string> group_by;
+    vector<RucksDBRollupAggregate> aggregates;
+
+    // Resolved by Bind: time column first (if any), then group_by
+    vector<idx_t> key_indexes;
+    vector<LogicalType> key_types;
+    vector<string> key_names;
+
+    // "count, sum(amount), min(amount), max(amount), hll(user_id)"
+    static vector<RucksDBRollupAggregate> ParseAggregates(const string& spec);
+    static vector<string> ParseColumnList(const string& list);
+
+    // Resolves and validates column references against the table
+    void Bind(const vector<ColumnDefinition>& columns);
+
+    string Serialize() const;
+    static RucksDBRollupDefinition Deserialize(const string& data);
+
+    // RocksDB keys of the aggregated groups, all under GetDataPrefix()
+    string GetDataPrefix() const;
+    static string GetDataPrefix(const string& rollup_name);
+    // Splits a group key back into key column values
+    vector<Value> DecodeGroupKey(const string& key) const;
+};
+
+// Accumulates the deltas of a batch of rows per group and writes them as merge operands
+class RucksDBRollupAccumulator {
+private:
+    struct GroupState {
+        vector<RucksDBAggregateValue> values;
+        vector<unique_ptr<RucksDBHyperLogLog>> sketches;
+    };
+
+    const RucksDBRollupDefinition& rollup_;
+    std::unordered_map<string, GroupState> groups_;
+    string key_buffer_;
+
+public:
+    explicit RucksDBRollupAccumulator(const RucksDBRollupDefinition& rollup) : rollup_(rollup) {
+    }
+
+    // sign is +1 for an added row, -1 for a removed one
+    void Add(const vector<Value>& row, int64_t sign);
+    void Add(const DataChunk& chunk, int64_t sign);
+
+    idx_t GroupCount() const { return groups_.size(); }
+    // Adds one Merge per touched group and clears the accumulator
+    void Write(rocksdb::WriteBatch& batch);
+};
+
+} // namespace duckdb
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// SQL access to materialized rollups (see RucksDBRollupDefinition):
+//   CALL rucksdb_create_rollup('orders_per_minute', 'orders', 'count, sum(amount), hll(customer)',
+//                              group_by := 'region', time_column := 'ts', bucket_seconds := 60)
+//   CALL rucksdb_drop_rollup('orders_per_minute')
+//   SELECT * FROM rucksdb_rollup('orders_per_minute')   reads the groups, never the base table
+// All three accept database := 'name' for attached instances.
+struct RucksDBRollupFunctions {
+    static void RegisterFunctions(DatabaseInstance& db);
+
+    static TableFunction GetCreateRollupFunction();
+    static TableFunction GetDropRollupFunction();
+    static TableFunction GetRollupFunction();
+};
+
+} // namespace duckdb
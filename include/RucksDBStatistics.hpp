@@ -0,0 +1,79 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/storage/statistics/base_statistics.hpp"
+#include <array>
+
+namespace duckdb {
+
+// Fixed-size HyperLogLog sketch for distinct-count estimation
+class RucksDBHyperLogLog {
+public:
+    static constexpr idx_t PRECISION = 10;
+    static constexpr idx_t REGISTER_COUNT = idx_t(1) << PRECISION;
+
+private:
+    std::array<uint8_t, REGISTER_COUNT> registers_;
+
+public:
+    RucksDBHyperLogLog() { registers_.fill(0); }
+
+    void Add(hash_t hash);
+    void Merge(const RucksDBHyperLogLog& other);
+    idx_t Count() const;
+
+    string Serialize() const;
+    bool Deserialize(const string& data);
+};
+
+// Per-column statistics maintained incrementally on append
+struct RucksDBColumnStatistics {
+    Value min;
+    Value max;
+    idx_t null_count = 0;
+    idx_t valid_count = 0;
+    RucksDBHyperLogLog distinct;
+
+    void Update(const Value& value);
+    unique_ptr<BaseStatistics> ToBaseStatistics(const LogicalType& type) const;
+};
+
+// Statistics for a whole RocksDB table, persisted next to the table metadata
+class RucksDBTableStatistics {
+private:
+    vector<RucksDBColumnStatistics> columns_;
+    idx_t deleted_count_ = 0;
+    // Live rows described, i.e. rows added less rows deleted. The statistics are written after
+    // the rows and row count commit, so a record whose count differs from the table's is stale.
+    idx_t row_count_ = 0;
+    // Cleared by deletes and updates: min/max stay valid bounds but may no longer be tight
+    bool exact_ = true;
+    // Set when the statistics may not describe the committed rows at all, so that not even their
+    // bounds and null counts hold
+    bool stale_ = false;
+
+public:
+    void Initialize(idx_t column_count);
+    void Update(const DataChunk& chunk);
+    // Adds statistics gathered separately, e.g. by another appending thread
+    void Merge(const RucksDBTableStatistics& other);
+    void RecordDelete(idx_t count);
+    void RecordUpdate(const vector<column_t>& column_ids, const DataChunk& data);
+
+    idx_t GetDeletedCount() const { return deleted_count_; }
+    idx_t GetRowCount() const { return row_count_; }
+    bool IsExact() const { return exact_; }
+    bool IsStale() const { return stale_; }
+    // For statistics that may not describe the committed rows: they are no longer reported, and
+    // the table's row count is taken as the one they describe from here on
+    void MarkStale(idx_t row_count);
+
+    idx_t ColumnCount() const { return columns_.size(); }
+    const RucksDBColumnStatistics& GetColumn(idx_t col_idx) const { return columns_[col_idx]; }
+
+    // Simple length-prefixed serialization (values are stored as strings and cast back on load)
+    string Serialize() const;
+    bool Deserialize(const string& data, const vector<LogicalType>& types);
+};
+
+} // namespace duckdb
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "RucksDBInstance.hpp"
+
+namespace duckdb {
+
+// SQL access to RucksDB instrumentation:
+//   rucksdb_stats()                      storage-wide latencies, perf counters, cache, ingest and RocksDB tickers
+//   rucksdb_table_stats('t')             per-operation latency histograms of one table
+//   rucksdb_rocksdb_property('rocksdb.stats')  raw DB::GetProperty output
+//   CALL rucksdb_trace_start([events_per_thread]) / rucksdb_trace_stop()
+//   CALL rucksdb_trace_dump('file.json')  Chrome trace of the buffered events
+// The storage functions take an optional database := 'name' naming an attached or opened
+// RucksDB instance; without it they report on the default rucksdb_init storage.
+struct RucksDBStatsFunctions {
+    static void RegisterFunctions(DatabaseInstance& db);
+
+    static TableFunction GetStatsFunction();
+    static TableFunction GetTableStatsFunction();
+    static TableFunction GetPropertyFunction();
+    static TableFunctionSet GetTraceStartFunction();
+    static TableFunction GetTraceStopFunction();
+    static TableFunction GetTraceDumpFunction();
+
+    // Shared by every function that materializes its rows into a RucksDBStatsState
+    static void ExecuteRows(ClientContext& context, TableFunctionInput& data, DataChunk& output);
+};
+
+// Rows are materialized at init and handed out a vector at a time
+struct RucksDBStatsBindData : public TableFunctionData {
+    string argument;
+    RucksDBInstance instance;
+};
+
+struct RucksDBStatsState : public GlobalTableFunctionState {
+    vector<vector<Value>> rows;
+    idx_t offset = 0;
+};
+
+} // namespace duckdb
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/parser/column_definition.hpp"
+#include "RocksDBStorage.hpp"
+#include <map>
+#include <mutex>
+
+namespace duckdb {
+
+// Time-to-live of a table, declared on a TIMESTAMP column (or an integer column holding epoch
+// seconds). Rows are grouped into fixed-width time partitions, and a partition expires as a
+// whole once its newest possible row is older than the TTL, so rows live between ttl_seconds
+// and ttl_seconds + partition_seconds. Rows with a NULL time never expire.
+struct RucksDBTableTTL {
+    static constexpr int64_t NULL_PARTITION = std::numeric_limits<int64_t>::max();
+
+    string column;
+    int64_t ttl_seconds = 0;
+    int64_t partition_seconds = 3600;
+
+    // Resolved by Bind
+    idx_t column_index = 0;
+    LogicalType type;
+
+    void Bind(const vector<ColumnDefinition>& columns);
+
+    string Serialize() const;
+    static RucksDBTableTTL Deserialize(const string& data);
+
+    // Start (epoch seconds) of the partition holding a time value
+    int64_t PartitionOf(const Value& value) const;
+    bool IsExpired(int64_t partition, int64_t now) const {
+        return partition != NULL_PARTITION && partition + partition_seconds + ttl_seconds <= now;
+    }
+    bool IsExpiredRow(const vector<Value>& row, int64_t now) const;
+
+    static int64_t Now();
+};
+
+// Row ids covered by one time partition. Appends are mostly in time order, so partitions are
+// mostly disjoint ranges, but late rows may widen an older partition.
+struct RucksDBPartition {
+    idx_t first_row = 0;
+    idx_t end_row = 0;
+    idx_t rows = 0;
+};
+
+// Per-table partition index, persisted as one merge-maintained record per partition
+class RucksDBPartitionIndex {
+private:
+    std::mutex lock_;
+    std::map<int64_t, RucksDBPartition> partitions_;
+
+public:
+    static string GetPrefix(const string& table_name);
+    static string GetKey(const string& table_name, int64_t partition);
+
+    void Load(RocksDBStorage* storage, const string& table_name);
+    void Clear();
+
+    // Records rows [start_row, start_row + chunk.size()) and adds the matching merges to batch
+    void Add(const string& table_name, const RucksDBTableTTL& ttl, const DataChunk& chunk, idx_t start_row,
+             rocksdb::WriteBatch& batch);
+    void Add(const string& table_name, int64_t partition, const RucksDBPartition& delta, rocksdb::WriteBatch& batch);
+
+    // Every row below this id is in an expired partition, so scans can start here
+    idx_t FirstLiveRow(const RucksDBTableTTL& ttl, int64_t now, idx_t row_count);
+    // Forgets expired partitions, deleting their records in batch; returns the rows they held
+    idx_t DropExpired(const string& table_name, const RucksDBTableTTL& ttl, int64_t now, idx_t& partitions,
+                      rocksdb::WriteBatch& batch);
+};
+
+} // namespace duckdb
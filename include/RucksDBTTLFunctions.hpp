@@ -0,0 +1,20 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// SQL access to table TTLs (see RucksDBTableTTL):
+//   CALL rucksdb_set_ttl('events', 'ts', 86400, partition_seconds := 3600)   0 seconds clears the TTL
+//   CALL rucksdb_expire('events')   drops expired partitions and compacts their rows away
+// Expired rows are hidden from scans as soon as their partition expires; rucksdb_expire only
+// reclaims their space. Both accept database := 'name' for attached instances.
+struct RucksDBTTLFunctions {
+    static void RegisterFunctions(DatabaseInstance& db);
+
+    static TableFunction GetSetTTLFunction();
+    static TableFunction GetExpireFunction();
+};
+
+} // namespace duckdb
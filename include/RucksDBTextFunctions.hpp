@@ -0,0 +1,23 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// SQL access to text indexes (see RucksDBTextIndexDefinition and RucksDBTextQuery):
+//   CALL rucksdb_create_text_index('logs_message', 'logs', 'message')
+//   CALL rucksdb_drop_text_index('logs_message')
+//   SELECT * FROM rucksdb_text_search('logs', 'message', 'disk full OR timeout*')
+// rucksdb_text_search returns the matching rows plus their row_id, in row id order. Postings
+// are resolved first and the rows fetched a vector at a time with MultiGet; columns without an
+// index fall back to a full scan. All three accept database := 'name' for attached instances.
+struct RucksDBTextFunctions {
+    static void RegisterFunctions(DatabaseInstance& db);
+
+    static TableFunction GetCreateTextIndexFunction();
+    static TableFunction GetDropTextIndexFunction();
+    static TableFunction GetTextSearchFunction();
+};
+
+} // namespace duckdb
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/parser/column_definition.hpp"
+#include "RocksDBStorage.hpp"
+#include "rocksdb/write_batch.h"
+
+namespace duckdb {
+
+// Inverted index over a VARCHAR column: one posting list (see EncodePostings) per term, kept
+// up to date by merging each append's row ids into it. Postings are never retracted; deleted
+// rows are skipped when fetched and updated rows are re-checked against the query.
+struct RucksDBTextIndexDefinition {
+    string name;
+    string table_name;
+    string column;
+
+    // Resolved by Bind
+    idx_t column_index = 0;
+
+    void Bind(const vector<ColumnDefinition>& columns);
+
+    string Serialize() const;
+    static RucksDBTextIndexDefinition Deserialize(const string& data);
+
+    // Term keys all sit under GetTermPrefix(), so prefix queries are a single range scan
+    string GetTermPrefix() const;
+    static string GetTermPrefix(const string& index_name);
+    string GetTermKey(const string& term) const;
+
+    // Lowercased runs of letters and digits; terms longer than 64 bytes are cut
+    static void Tokenize(const string& text, vector<string>& terms);
+
+    // Adds one merge per distinct term of rows [start_row, start_row + chunk.size())
+    void IndexChunk(const DataChunk& chunk, idx_t start_row, rocksdb::WriteBatch& batch) const;
+    // Adds the terms of single rows, e.g. backfills and updates
+    void IndexRows(const vector<idx_t>& row_ids, const vector<string>& texts, rocksdb::WriteBatch& batch) const;
+};
+
+// Query over terms: "error disk" and "error AND disk" require both, "error OR warn" either,
+// "time*" any term starting with "time". AND binds tighter than OR.
+struct RucksDBTextQuery {
+    struct Term {
+        string text;
+        bool prefix = false;
+    };
+    // OR of ANDs
+    vector<vector<Term>> clauses;
+
+    static RucksDBTextQuery Parse(const string& query);
+
+    // Row ids whose postings satisfy the query, ascending
+    vector<idx_t> Evaluate(RocksDBStorage& storage, const RucksDBTextIndexDefinition& index) const;
+    // Whether text satisfies the query, used to drop stale postings and for unindexed columns
+    bool Matches(const string& text) const;
+};
+
+} // namespace duckdb
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/parser/column_definition.hpp"
+#include "RocksDBStorage.hpp"
+#include <deque>
+#include <mutex>
+#include <unordered_set>
+
+namespace duckdb {
+
+// Tiering declared on a RucksDB table: inserts go to an in-memory hot tier and are sealed into
+// RocksDB rows a row group at a time. Rows are identified by key_column, and the newest row of a
+// key wins, so an update in the hot window is an insert of the same key.
+struct RucksDBTierDefinition {
+    string key_column;
+    // Rows the hot tier collects before the oldest of them are sealed
+    idx_t row_group_size = 122880;
+
+    // Resolved by Bind
+    idx_t key_index = 0;
+
+    void Bind(const vector<ColumnDefinition>& columns);
+
+    string Serialize() const;
+    static RucksDBTierDefinition Deserialize(const string& data);
+
+    // Keys are compared in text form, as sealed rows may decode to another type than was inserted
+    static string KeyOf(const Value& value);
+};
+
+// Hot rows as of the start of a scan. Chunks are shared with the hot tier and never modified.
+struct RucksDBHotSnapshot {
+    vector<std::shared_ptr<const DataChunk>> chunks;
+    // visible[c][r] is set when row r of chunk c is the newest row of its key
+    vector<vector<bool>> visible;
+    idx_t visible_rows = 0;
+    // Keys held in the hot tier; sealed rows with these keys are older versions
+    std::unordered_set<string> keys;
+    idx_t key_index = 0;
+
+    // Whether a sealed row is replaced by a hot row
+    bool Shadows(const vector<Value>& row) const;
+    // Writes the visible rows of one chunk to result, returns how many. Hot rows have no row id yet,
+    // so COLUMN_IDENTIFIER_ROW_ID reads as NULL.
+    idx_t Emit(idx_t chunk_idx, DataChunk& result, const vector<column_t>& column_ids) const;
+};
+
+// In-memory delta of a tiered table, kept as DuckDB chunks in insertion order. Each appended chunk
+// is also logged to RocksDB as one record in DuckDB's binary format, so a restart replays the hot
+// tier; sealing deletes the records of the chunks it moved.
+class RucksDBHotTier {
+private:
+    struct HotChunk {
+        std::shared_ptr<const DataChunk> data;
+        uint64_t sequence;
+    };
+
+    RocksDBStorage* storage_;
+    string table_name_;
+    RucksDBTierDefinition definition_;
+
+    std::mutex lock_;
+    std::deque<HotChunk> chunks_;
+    idx_t rows_ = 0;
+    uint64_t next_sequence_ = 0;
+    // Built by the first scan after a change and shared by the scans that follow
+    std::shared_ptr<const RucksDBHotSnapshot> snapshot_;
+
+    string GetLogKey(uint64_t sequence) const;
+
+public:
+    RucksDBHotTier(RocksDBStorage* storage, const string& table_name, RucksDBTierDefinition definition);
+
+    // Hot chunk log, in sequence order
+    static string GetLogPrefix(const string& table_name);
+    // Sealed row id of each key, so sealing a newer row deletes the older one
+    static string GetKeyPrefix(const string& table_name);
+    static string GetKeyIndexKey(const string& table_name, const string& key);
+
+    // Replays the chunks logged before a restart
+    void Load();
+    void Append(DataChunk& chunk);
+    std::shared_ptr<const RucksDBHotSnapshot> Snapshot();
+
+    // The oldest chunks holding at least row_group_size rows, or every chunk when force; false
+    // when there is nothing to seal. The chunks stay visible until PopChunks.
+    bool PeekRowGroup(bool force, vector<std::shared_ptr<const DataChunk>>& chunks, vector<string>& log_keys);
+    // Drops the count oldest chunks once their rows are written to RocksDB
+    void PopChunks(idx_t count);
+
+    idx_t GetRowCount();
+    const RucksDBTierDefinition& GetDefinition() const { return definition_; }
+};
+
+} // namespace duckdb
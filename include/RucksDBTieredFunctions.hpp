@@ -0,0 +1,21 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// SQL access to tiered tables (see RucksDBHotTier):
+//   CALL rucksdb_set_tiering('events', 'id', row_group_size := 122880)   '' as key seals and untiers
+//   CALL rucksdb_seal('events')   moves every hot row into RocksDB now
+// Inserts into a tiered table stay in memory until the background mover seals them a row group at
+// a time; rocksdb_scan and SQL over the table read both tiers, the newest row of each key winning.
+// Both accept database := 'name' for attached instances.
+struct RucksDBTieredFunctions {
+    static void RegisterFunctions(DatabaseInstance& db);
+
+    static TableFunction GetSetTieringFunction();
+    static TableFunction GetSealFunction();
+};
+
+} // namespace duckdb
@@ -0,0 +1,71 @@
+// include/RucksDBTrace.hpp
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include "rocksdb/listener.h"
+
+namespace duckdb {
+
+using string = std::string;
+
+// Opt-in event tracing into per-thread ring buffers, dumped as Chrome trace
+// JSON (chrome://tracing, Perfetto). While disabled a scope costs one relaxed
+// atomic load.
+class RucksDBTracer {
+private:
+    static std::atomic<bool> enabled_;
+
+public:
+    static bool IsEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    // Starts tracing; each thread keeps its most recent events_per_thread events
+    static void Enable(size_t events_per_thread = 65536);
+    static void Disable();
+    static void Clear();
+
+    // name and category must be string literals or otherwise outlive the tracer
+    static void Record(const char *name, const char *category, std::chrono::steady_clock::time_point start,
+                       std::chrono::steady_clock::time_point end, uint64_t arg = 0);
+
+    // Writes every buffered event as Chrome trace JSON, returns the number of events written
+    static size_t DumpChromeTrace(const string &path);
+};
+
+// Records the enclosing scope as one complete ("X") event
+class RucksDBTraceScope {
+private:
+    const char *name_;
+    const char *category_;
+    bool active_;
+    std::chrono::steady_clock::time_point start_;
+
+public:
+    // Shown as "arg" in the event details, e.g. rows produced
+    uint64_t arg = 0;
+
+    RucksDBTraceScope(const char *name, const char *category)
+        : name_(name), category_(category), active_(RucksDBTracer::IsEnabled()) {
+        if (active_) {
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+    ~RucksDBTraceScope() {
+        if (active_) {
+            RucksDBTracer::Record(name_, category_, start_, std::chrono::steady_clock::now(), arg);
+        }
+    }
+};
+
+// Traces RocksDB background flushes and compactions
+class RucksDBTraceListener : public rocksdb::EventListener {
+public:
+    void OnFlushBegin(rocksdb::DB *db, const rocksdb::FlushJobInfo &info) override;
+    void OnFlushCompleted(rocksdb::DB *db, const rocksdb::FlushJobInfo &info) override;
+    void OnCompactionBegin(rocksdb::DB *db, const rocksdb::CompactionJobInfo &info) override;
+    void OnCompactionCompleted(rocksdb::DB *db, const rocksdb::CompactionJobInfo &info) override;
+};
+
+} // namespace duckdb
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// SQL access to vector indexes (see RucksDBVectorIndex):
+//   CALL rucksdb_create_vector_index('docs_embedding', 'docs', 'embedding', metric := 'cosine', m := 16)
+//   CALL rucksdb_drop_vector_index('docs_embedding')
+//   SELECT * FROM rocksdb_knn('docs', 'embedding', [0.1, 0.2, 0.3]::FLOAT[3], 10, ef := 64)
+// rocksdb_knn returns the k nearest rows with their distance, closest first. Columns without an
+// index are searched exhaustively with the same distance kernels (L2 unless metric := is given).
+// All three accept database := 'name' for attached instances.
+struct RucksDBVectorFunctions {
+    static void RegisterFunctions(DatabaseInstance& db);
+
+    static TableFunction GetCreateVectorIndexFunction();
+    static TableFunction GetDropVectorIndexFunction();
+    static TableFunction GetKnnFunction();
+};
+
+} // namespace duckdb
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/parser/column_definition.hpp"
+#include "RocksDBStorage.hpp"
+#include "rocksdb/write_batch.h"
+#include <mutex>
+#include <unordered_map>
+
+namespace duckdb {
+
+enum class RucksDBVectorMetric : uint8_t {
+    // Euclidean distance, as array_distance
+    L2,
+    // 1 - cosine similarity, as array_cosine_distance
+    COSINE,
+    // Negative inner product, as array_negative_inner_product
+    INNER_PRODUCT
+};
+
+// Distance kernels over float vectors. AVX2/FMA is picked at runtime on x86-64 and NEON is used
+// on AArch64, with a scalar fallback elsewhere.
+struct RucksDBVectorDistance {
+    static float L2Squared(const float* a, const float* b, idx_t dims);
+    static float Dot(const float* a, const float* b, idx_t dims);
+    // Name of the kernel set in use, e.g. "avx2"
+    static const char* KernelName();
+};
+
+// Declared ANN index over a FLOAT[N] (or numeric list) column of a RucksDB table
+struct RucksDBVectorIndexDefinition {
+    string name;
+    string table_name;
+    string column;
+    RucksDBVectorMetric metric = RucksDBVectorMetric::L2;
+    // Links per node above level 0; level 0 keeps twice as many
+    idx_t m = 16;
+    idx_t ef_construction = 200;
+    // 0 until known: fixed by ARRAY columns, taken from the first vector of LIST columns
+    idx_t dims = 0;
+
+    // Resolved by Bind
+    idx_t column_index = 0;
+    LogicalType type;
+
+    static RucksDBVectorMetric ParseMetric(const string& metric);
+    static string MetricName(RucksDBVectorMetric metric);
+
+    void Bind(const vector<ColumnDefinition>& columns);
+
+    string Serialize() const;
+    static RucksDBVectorIndexDefinition Deserialize(const string& data);
+
+    // Reads a vector value (ARRAY, LIST or its text form) into floats; false for NULL
+    static bool ExtractVector(const Value& value, vector<float>& result);
+};
+
+struct RucksDBVectorMatch {
+    idx_t row_id;
+    float distance;
+};
+
+// HNSW graph over one indexed column. Every node is persisted as its own RocksDB record (vector
+// and per-level links), written in the batch of the rows it indexes. Nothing is read when the
+// index is opened: the entry point is read on first use and nodes are loaded into memory as
+// searches and inserts reach them, so a cold index warms up with the part of the graph queried.
+// Deleted rows stay in the graph and are skipped when their rows are read back.
+class RucksDBVectorIndex {
+public:
+    struct Node {
+        vector<float> values;
+        // neighbors[level] for levels 0..node level
+        vector<vector<idx_t>> neighbors;
+    };
+
+private:
+    RocksDBStorage* storage_;
+    RucksDBVectorIndexDefinition definition_;
+
+    // Inserts are serialized; searches only take cache_lock_ briefly
+    std::mutex write_lock_;
+    std::mutex cache_lock_;
+    // Nodes are immutable once cached, writers replace them
+    std::unordered_map<idx_t, std::shared_ptr<const Node>> nodes_;
+    bool loaded_ = false;
+    idx_t entry_point_ = 0;
+    int64_t max_level_ = -1;
+    idx_t count_ = 0;
+
+    void EnsureLoaded();
+    std::shared_ptr<const Node> GetNode(idx_t row_id);
+    void PutNode(idx_t row_id, std::shared_ptr<const Node> node, rocksdb::WriteBatch& batch);
+    void WriteMeta(rocksdb::WriteBatch& batch);
+
+    float Distance(const float* a, const float* b) const;
+    void Normalize(vector<float>& values) const;
+    idx_t GreedyClosest(const float* query, idx_t entry, int64_t from_level, int64_t to_level);
+    // Best ef nodes reachable on level from entry, closest first
+    vector<std::pair<float, idx_t>> SearchLayer(const float* query, idx_t entry, idx_t ef, int64_t level);
+    // Picks up to m diverse neighbors from candidates sorted by distance; pending stands in for
+    // the node being inserted, which is not cached yet
+    vector<idx_t> SelectNeighbors(const vector<std::pair<float, idx_t>>& candidates, idx_t m,
+                                  idx_t pending_id = 0, const std::shared_ptr<const Node>& pending = nullptr);
+
+public:
+    RucksDBVectorIndex(RocksDBStorage* storage, RucksDBVectorIndexDefinition definition);
+
+    static string GetMetaKey(const string& index_name);
+    static string GetNodePrefix(const string& index_name);
+    static string GetNodeKey(const string& index_name, idx_t row_id);
+
+    // Adds (or re-links) a row, putting every touched node into batch
+    void Insert(idx_t row_id, const vector<float>& values, rocksdb::WriteBatch& batch);
+    // Up to ef (at least k) nearest rows, closest first
+    vector<RucksDBVectorMatch> Search(const vector<float>& query, idx_t k, idx_t ef);
+
+    const RucksDBVectorIndexDefinition& GetDefinition() const { return definition_; }
+    // Exact distance for brute-force fallbacks, in the metric's reported units
+    static float ComputeDistance(RucksDBVectorMetric metric, const vector<float>& a, const vector<float>& b);
+    idx_t CachedNodes();
+};
+
+} // namespace duckdb
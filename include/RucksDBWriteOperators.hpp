@@ -0,0 +1,87 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/execution/physical_operator.hpp"
+#include "duckdb/planner/parsed_data/bound_create_table_info.hpp"
+#include "RucksDBCatalog.hpp"
+
+namespace duckdb {
+
+// INSERT / CREATE TABLE AS sink: appends whole chunks through RucksDBTableStorage::Append. When
+// insertion order need not be preserved, each thread encodes into its own append state and commits
+// it in Combine.
+class RucksDBInsert : public PhysicalOperator {
+public:
+    // INSERT INTO an existing table
+    RucksDBInsert(LogicalOperator& op, TableCatalogEntry& table, physical_index_vector_t<idx_t> column_index_map,
+                  vector<unique_ptr<Expression>> bound_defaults);
+    // CREATE TABLE AS
+    RucksDBInsert(LogicalOperator& op, SchemaCatalogEntry& schema, unique_ptr<BoundCreateTableInfo> info);
+
+    optional_ptr<TableCatalogEntry> table;
+    optional_ptr<SchemaCatalogEntry> schema;
+    unique_ptr<BoundCreateTableInfo> info;
+    physical_index_vector_t<idx_t> column_index_map;
+    vector<unique_ptr<Expression>> bound_defaults;
+    // Set by the planner when rows may be appended in any order
+    bool parallel = false;
+
+public:
+    // Source interface
+    SourceResultType GetData(ExecutionContext& context, DataChunk& chunk, OperatorSourceInput& input) const override;
+    bool IsSource() const override { return true; }
+
+    // Sink interface
+    unique_ptr<GlobalSinkState> GetGlobalSinkState(ClientContext& context) const override;
+    unique_ptr<LocalSinkState> GetLocalSinkState(ExecutionContext& context) const override;
+    SinkResultType Sink(ExecutionContext& context, DataChunk& chunk, OperatorSinkInput& input) const override;
+    SinkCombineResultType Combine(ExecutionContext& context, OperatorSinkCombineInput& input) const override;
+    bool IsSink() const override { return true; }
+    bool ParallelSink() const override { return parallel; }
+
+    string GetName() const override { return "RUCKSDB_INSERT"; }
+};
+
+// DELETE sink: removes rows by the row id produced by rocksdb_scan
+class RucksDBDelete : public PhysicalOperator {
+public:
+    RucksDBDelete(LogicalOperator& op, TableCatalogEntry& table, idx_t row_id_index);
+
+    TableCatalogEntry& table;
+    idx_t row_id_index;
+
+public:
+    SourceResultType GetData(ExecutionContext& context, DataChunk& chunk, OperatorSourceInput& input) const override;
+    bool IsSource() const override { return true; }
+
+    unique_ptr<GlobalSinkState> GetGlobalSinkState(ClientContext& context) const override;
+    SinkResultType Sink(ExecutionContext& context, DataChunk& chunk, OperatorSinkInput& input) const override;
+    bool IsSink() const override { return true; }
+    bool ParallelSink() const override { return false; }
+
+    string GetName() const override { return "RUCKSDB_DELETE"; }
+};
+
+// UPDATE sink: rewrites the updated columns of each row in place
+class RucksDBUpdate : public PhysicalOperator {
+public:
+    RucksDBUpdate(LogicalOperator& op, TableCatalogEntry& table, vector<column_t> column_ids,
+                  vector<unique_ptr<Expression>> expressions);
+
+    TableCatalogEntry& table;
+    vector<column_t> column_ids;
+    vector<unique_ptr<Expression>> expressions;
+
+public:
+    SourceResultType GetData(ExecutionContext& context, DataChunk& chunk, OperatorSourceInput& input) const override;
+    bool IsSource() const override { return true; }
+
+    unique_ptr<GlobalSinkState> GetGlobalSinkState(ClientContext& context) const override;
+    SinkResultType Sink(ExecutionContext& context, DataChunk& chunk, OperatorSinkInput& input) const override;
+    bool IsSink() const override { return true; }
+    bool ParallelSink() const override { return false; }
+
+    string GetName() const override { return "RUCKSDB_UPDATE"; }
+};
+
+} // namespace duckdb
\ No newline at end of file
@@ -0,0 +1,48 @@
+// include/RucksDBZipfian.hpp
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+
+namespace duckdb {
+
+// Zipfian key chooser (Gray et al.), as used by YCSB
+class ZipfianGenerator {
+private:
+    uint64_t items_;
+    double theta_, alpha_, zetan_, eta_;
+    std::mt19937_64 rng_;
+    std::uniform_real_distribution<double> dist_;
+    
+    static double Zeta(uint64_t n, double theta) {
+        double sum = 0;
+        for (uint64_t i = 1; i <= n; i++) {
+            sum += 1.0 / std::pow((double)i, theta);
+        }
+        return sum;
+    }
+    
+public:
+    ZipfianGenerator(uint64_t items, double theta = 0.99, uint64_t seed = 42)
+        : items_(items), theta_(theta), rng_(seed), dist_(0.0, 1.0) {
+        double zeta2 = Zeta(2, theta_);
+        zetan_ = Zeta(items_, theta_);
+        alpha_ = 1.0 / (1.0 - theta_);
+        eta_ = (1.0 - std::pow(2.0 / items_, 1.0 - theta_)) / (1.0 - zeta2 / zetan_);
+    }
+    
+    uint64_t Next() {
+        double u = dist_(rng_);
+        double uz = u * zetan_;
+        if (uz < 1.0) {
+            return 0;
+        }
+        if (uz < 1.0 + std::pow(0.5, theta_)) {
+            return 1;
+        }
+        return (uint64_t)(items_ * std::pow(eta_ * u - eta_ + 1.0, alpha_)) % items_;
+    }
+};
+
+} // namespace duckdb
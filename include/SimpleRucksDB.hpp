@@ -2,6 +2,9 @@
 
 #include "duckdb.hpp"
 #include "../include/RocksDBStorage.hpp"
+#include <future>
+#include <mutex>
+#include <unordered_set>
 
 namespace duckdb {
 
@@ -18,14 +21,23 @@ class SimpleTableRegistry {
 private:
     RocksDBStorage* storage_;
     
+    // In-memory catalog loaded once at construction, so the hot path does no metadata Gets
+    bool cache_catalog_;
+    std::mutex catalog_lock_;
+    std::unordered_set<std::string> tables_;
+    
+    void LoadCatalog();
+    
 public:
-    SimpleTableRegistry(RocksDBStorage* storage) : storage_(storage) {}
+    SimpleTableRegistry(RocksDBStorage* storage, bool cache_catalog = true);
     
     void CreateSimpleTable(const std::string& name);
     void DropSimpleTable(const std::string& name);
     bool TableExists(const std::string& name);
     
     void InsertData(const std::string& table_name, const std::string& key, const std::string& value);
+    // Queued on the global ingest queue; the caller does not wait for RocksDB
+    std::future<bool> InsertDataAsync(const std::string& table_name, const std::string& key, const std::string& value);
     bool ReadData(const std::string& table_name, const std::string& key, std::string& value);
     
     std::vector<std::string> ListTables();
@@ -2,6 +2,8 @@
 
 #include <string>
 #include <functional>
+#include <future>
+#include <cstdint>
 
 // RucksDB public API
 namespace rucksdb {
@@ -17,6 +19,21 @@ bool put(const std::string& key, const std::string& value);
 bool get(const std::string& key, std::string& value);
 bool del(const std::string& key);
 
+// Asynchronous writes, coalesced into WriteBatches by background workers.
+// The future resolves to false if the batch containing the write failed.
+std::future<bool> put_async(const std::string& key, const std::string& value);
+void put_async(const std::string& key, const std::string& value,
+               std::function<void(bool success, const std::string& error)> callback);
+std::future<bool> del_async(const std::string& key);
+// Blocks until all previously issued async writes are committed
+void flush_async();
+
+// Backups. checkpoint() hard-links a consistent snapshot into a new directory;
+// backup() adds an incremental backup to backup_dir, throttled to
+// rate_limit bytes/s (0 = the backup_rate_limit option).
+bool checkpoint(const std::string& checkpoint_dir);
+bool backup(const std::string& backup_dir, uint64_t rate_limit = 0);
+
 // Iteration
 void scan_prefix(const std::string& prefix, 
                 std::function<bool(const std::string& key, const std::string& value)> callback);
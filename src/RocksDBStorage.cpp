@@ -1,18 +1,225 @@
 // src/RocksDBStorage.cpp
 
 #include "../include/RocksDBStorage.hpp"
+#include "../include/RucksDBIngestQueue.hpp"
+#include "../include/RucksDBMemoryBudget.hpp"
+#include "../include/RucksDBMergeOperator.hpp"
+#include "../include/RucksDBTrace.hpp"
+#include "rocksdb/rate_limiter.h"
+#include "rocksdb/table.h"
+#include "rocksdb/utilities/backup_engine.h"
+#include "rocksdb/utilities/checkpoint.h"
+#include <algorithm>
 #include <functional>
+#include <future>
 #include <iostream>
+#include <sstream>
+#include <unistd.h>
 
 namespace duckdb {
 
 // Global storage instance
 std::unique_ptr<RocksDBStorage> g_rocksdb_storage;
 
+// Options parsing
+static size_t ParseSize(const string &value) {
+    size_t pos = 0;
+    size_t number = std::stoull(value, &pos);
+    string suffix = value.substr(pos);
+    if (suffix == "KB" || suffix == "kb") {
+        return number << 10;
+    } else if (suffix == "MB" || suffix == "mb") {
+        return number << 20;
+    } else if (suffix == "GB" || suffix == "gb") {
+        return number << 30;
+    } else if (!suffix.empty() && suffix != "B" && suffix != "b") {
+        throw std::runtime_error("Invalid size '" + value + "'");
+    }
+    return number;
+}
+
+RocksDBStorageOptions RocksDBStorageOptions::Parse(const string &options) {
+    RocksDBStorageOptions result;
+    std::istringstream ss(options);
+    string entry;
+    
+    while (std::getline(ss, entry, ';')) {
+        if (entry.empty()) {
+            continue;
+        }
+        size_t eq_pos = entry.find('=');
+        if (eq_pos == string::npos) {
+            throw std::runtime_error("Invalid RucksDB option '" + entry + "', expected key=value");
+        }
+        string key = entry.substr(0, eq_pos);
+        string value = entry.substr(eq_pos + 1);
+        
+        if (key == "mode") {
+            if (value == "primary") {
+                result.mode = RucksDBOpenMode::PRIMARY;
+            } else if (value == "read_only") {
+                result.mode = RucksDBOpenMode::READ_ONLY;
+            } else if (value == "secondary") {
+                result.mode = RucksDBOpenMode::SECONDARY;
+            } else {
+                throw std::runtime_error("Invalid RucksDB mode '" + value + "'");
+            }
+        } else if (key == "secondary_path") {
+            result.secondary_path = value;
+        } else if (key == "catch_up_interval_ms") {
+            result.catch_up_interval_ms = std::stoull(value);
+        } else if (key == "cache_size") {
+            result.cache_size = ParseSize(value);
+        } else if (key == "cache_shards") {
+            result.cache_shards = std::stoull(value);
+        } else if (key == "ingest_queue_capacity") {
+            result.ingest_queue_capacity = std::stoull(value);
+        } else if (key == "ingest_max_batch_size") {
+            result.ingest_max_batch_size = std::stoull(value);
+        } else if (key == "ingest_max_latency_us") {
+            result.ingest_max_latency_us = std::stoull(value);
+        } else if (key == "ingest_threads") {
+            result.ingest_threads = std::stoull(value);
+        } else if (key == "enable_statistics") {
+            result.enable_statistics = value == "true" || value == "1";
+        } else if (key == "perf_sample_rate") {
+            result.perf_sample_rate = std::stoull(value);
+        } else if (key == "trace") {
+            result.trace = value == "true" || value == "1";
+        } else if (key == "trace_buffer_events") {
+            result.trace_buffer_events = std::stoull(value);
+        } else if (key == "shard_paths") {
+            std::istringstream paths(value);
+            string shard_path;
+            while (std::getline(paths, shard_path, ',')) {
+                if (!shard_path.empty()) {
+                    result.shard_paths.push_back(shard_path);
+                }
+            }
+        } else if (key == "sharding") {
+            if (value == "hash") {
+                result.sharding = RucksDBShardingMode::HASH;
+            } else if (value == "range") {
+                result.sharding = RucksDBShardingMode::RANGE;
+            } else {
+                throw std::runtime_error("Invalid RucksDB sharding '" + value + "'");
+            }
+        } else if (key == "shard_block_rows") {
+            result.shard_block_rows = std::max<size_t>(1, std::stoull(value));
+        } else if (key == "backup_rate_limit") {
+            result.backup_rate_limit = ParseSize(value);
+        } else if (key == "wal_ttl_seconds") {
+            result.wal_ttl_seconds = std::stoull(value);
+        } else if (key == "enable_blob_files") {
+            result.enable_blob_files = value == "true" || value == "1";
+        } else if (key == "min_blob_size") {
+            result.min_blob_size = ParseSize(value);
+        } else if (key == "blob_file_size") {
+            result.blob_file_size = ParseSize(value);
+        } else if (key == "enable_blob_garbage_collection") {
+            result.enable_blob_garbage_collection = value == "true" || value == "1";
+        } else if (key == "blob_garbage_collection_age_cutoff") {
+            result.blob_garbage_collection_age_cutoff = std::stod(value);
+            if (result.blob_garbage_collection_age_cutoff < 0 || result.blob_garbage_collection_age_cutoff > 1) {
+                throw std::runtime_error("blob_garbage_collection_age_cutoff must be between 0 and 1");
+            }
+        } else if (key == "large_value_size") {
+            result.large_value_size = ParseSize(value);
+        } else if (key == "async_io") {
+            result.async_io = value == "true" || value == "1";
+        } else if (key == "use_direct_reads") {
+            result.use_direct_reads = value == "true" || value == "1";
+        } else if (key == "readahead_size") {
+            result.readahead_size = ParseSize(value);
+        } else if (key == "scan_prefetch") {
+            result.scan_prefetch = value == "true" || value == "1";
+        } else if (key == "pipelined_writes") {
+            result.pipelined_writes = value == "true" || value == "1";
+        } else if (key == "file_opening_threads") {
+            result.file_opening_threads = std::max<size_t>(1, std::stoull(value));
+        } else if (key == "skip_stats_update_on_db_open") {
+            result.skip_stats_update_on_db_open = value == "true" || value == "1";
+        } else if (key == "flush_on_recovery") {
+            result.flush_on_recovery = value == "true" || value == "1";
+        } else if (key == "max_total_wal_size") {
+            result.max_total_wal_size = ParseSize(value);
+        } else if (key == "memory_budget") {
+            result.memory_budget = ParseSize(value);
+        } else if (key == "rocksdb_memory_share") {
+            result.rocksdb_memory_share = std::stod(value);
+        } else {
+            throw std::runtime_error("Unknown RucksDB option '" + key + "'");
+        }
+    }
+    return result;
+}
+
+// Invalidates cached entries for every key touched by a write batch
+class CacheInvalidationHandler : public rocksdb::WriteBatch::Handler {
+private:
+    RucksDBCache &cache_;
+    
+public:
+    explicit CacheInvalidationHandler(RucksDBCache &cache) : cache_(cache) {}
+    
+    rocksdb::Status PutCF(uint32_t, const rocksdb::Slice &key, const rocksdb::Slice &) override {
+        cache_.Erase(key.ToString());
+        return rocksdb::Status::OK();
+    }
+    rocksdb::Status DeleteCF(uint32_t, const rocksdb::Slice &key) override {
+        cache_.Erase(key.ToString());
+        return rocksdb::Status::OK();
+    }
+    rocksdb::Status SingleDeleteCF(uint32_t, const rocksdb::Slice &key) override {
+        cache_.Erase(key.ToString());
+        return rocksdb::Status::OK();
+    }
+    rocksdb::Status MergeCF(uint32_t, const rocksdb::Slice &key, const rocksdb::Slice &) override {
+        cache_.Erase(key.ToString());
+        return rocksdb::Status::OK();
+    }
+    rocksdb::Status DeleteRangeCF(uint32_t, const rocksdb::Slice &, const rocksdb::Slice &) override {
+        cache_.Clear();
+        return rocksdb::Status::OK();
+    }
+};
+
+void RucksDBCompactionFilter::SetExpiryCheck(std::shared_ptr<const RucksDBExpiryCheck> check) {
+    std::atomic_store(&check_, std::move(check));
+}
+
+bool RucksDBCompactionFilter::Filter(int, const rocksdb::Slice &key, const rocksdb::Slice &existing_value,
+                                     std::string *, bool *) const {
+    auto check = std::atomic_load(&check_);
+    return check && (*check)(key, existing_value);
+}
+
 // RocksDBStorage implementation
-RocksDBStorage::RocksDBStorage(const string &path) : db_path_(path + "_rocksdb") {}
+RocksDBStorage::RocksDBStorage(const string &path, const RocksDBStorageOptions &options)
+    : db_path_(path + "_rocksdb"), options_(options) {
+    if (options_.cache_size > 0) {
+        cache_ = std::make_unique<RucksDBCache>(options_.cache_size, options_.cache_shards);
+    }
+    if (options_.enable_statistics) {
+        statistics_ = rocksdb::CreateDBStatistics();
+    }
+    metrics_ = std::make_unique<RucksDBMetrics>(options_.perf_sample_rate);
+}
+
+static int64_t NowMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
 
 RocksDBStorage::~RocksDBStorage() {
+    if (catch_up_thread_.joinable()) {
+        {
+            std::lock_guard<std::mutex> guard(catch_up_lock_);
+            stop_catch_up_ = true;
+        }
+        catch_up_cv_.notify_all();
+        catch_up_thread_.join();
+    }
     if (db_) {
         db_->Close();
     }
@@ -22,44 +229,453 @@ void RocksDBStorage::Initialize() {
     rocksdb::Options options;
     options.create_if_missing = true;
     options.error_if_exists = false;
+    options.statistics = statistics_;
+    options.WAL_ttl_seconds = options_.wal_ttl_seconds;
+    // Needed in every open mode: readers resolve pending merge operands too
+    options.merge_operator = std::make_shared<RucksDBAggregateMergeOperator>();
+    // Compactions run concurrently with SetExpiryCheck, which swaps the rule atomically
+    compaction_filter_ = std::make_unique<RucksDBCompactionFilter>();
+    options.compaction_filter = compaction_filter_.get();
+    options.listeners.push_back(std::make_shared<RucksDBTraceListener>());
+    options.enable_blob_files = options_.enable_blob_files;
+    options.min_blob_size = options_.min_blob_size;
+    options.blob_file_size = options_.blob_file_size;
+    options.enable_blob_garbage_collection = options_.enable_blob_garbage_collection;
+    options.blob_garbage_collection_age_cutoff = options_.blob_garbage_collection_age_cutoff;
+    options.use_direct_reads = options_.use_direct_reads;
+    options.allow_concurrent_memtable_write = true;
+    options.enable_pipelined_write = options_.pipelined_writes;
+    options.max_file_opening_threads = (int)options_.file_opening_threads;
+    options.skip_stats_update_on_db_open = options_.skip_stats_update_on_db_open;
+    options.avoid_flush_during_recovery = !options_.flush_on_recovery;
+    options.max_total_wal_size = options_.max_total_wal_size;
+    read_options_.async_io = options_.async_io;
+    read_options_.adaptive_readahead = true;
+    read_options_.readahead_size = options_.readahead_size;
+    // Instances opened without a budget of their own join the one configured through rucksdb_init
+    if (!memory_budget_) {
+        memory_budget_ = options_.memory_budget > 0
+                             ? std::make_shared<RucksDBMemoryBudget>(options_.memory_budget,
+                                                                     options_.rocksdb_memory_share)
+                             : RucksDBMemoryBudget::GetDefault();
+    }
+    if (memory_budget_) {
+        memory_budget_->Configure(options);
+    }
+    if (options_.trace) {
+        RucksDBTracer::Enable(options_.trace_buffer_events);
+    }
     
     rocksdb::DB* db_raw;
-    rocksdb::Status status = rocksdb::DB::Open(options, db_path_, &db_raw);
+    rocksdb::Status status;
+    if (options_.mode == RucksDBOpenMode::READ_ONLY) {
+        status = rocksdb::DB::OpenForReadOnly(options, db_path_, &db_raw);
+    } else if (options_.mode == RucksDBOpenMode::SECONDARY) {
+        // Secondaries must keep every table file open to follow the primary's compactions
+        options.max_open_files = -1;
+        string secondary_path = options_.secondary_path;
+        if (secondary_path.empty()) {
+            secondary_path = db_path_ + "_secondary_" + std::to_string(getpid());
+        }
+        status = rocksdb::DB::OpenAsSecondary(options, db_path_, secondary_path, &db_raw);
+    } else {
+        status = rocksdb::DB::Open(options, db_path_, &db_raw);
+    }
     
     if (!status.ok()) {
         throw std::runtime_error("Failed to open RocksDB: " + status.ToString());
     }
     
     db_.reset(db_raw);
+    synced_at_us_ = NowMicros();
+    
+    for (auto &shard_path : options_.shard_paths) {
+        auto shard_options = options_;
+        shard_options.shard_paths.clear();
+        // Secondary shards catch up together with this instance rather than on their own timers
+        shard_options.catch_up_interval_ms = 0;
+        // Tracing is process-wide and already enabled above
+        shard_options.trace = false;
+        if (!shard_options.secondary_path.empty()) {
+            shard_options.secondary_path += "_shard" + std::to_string(shards_.size() + 1);
+        }
+        auto shard = std::make_unique<RocksDBStorage>(shard_path, shard_options);
+        shard->memory_budget_ = memory_budget_;
+        shards_.push_back(std::move(shard));
+    }
+    // Each shard replays its own WAL, so they recover side by side
+    std::vector<std::future<void>> opening;
+    for (auto &shard : shards_) {
+        auto *shard_ptr = shard.get();
+        opening.push_back(std::async(std::launch::async, [shard_ptr]() { shard_ptr->Initialize(); }));
+    }
+    for (auto &open : opening) {
+        open.get();
+    }
+    
+    if (options_.mode == RucksDBOpenMode::SECONDARY && options_.catch_up_interval_ms > 0) {
+        catch_up_thread_ = std::thread([this]() { CatchUpLoop(); });
+    }
+}
+
+void RocksDBStorage::CatchUpLoop() {
+    auto interval = std::chrono::milliseconds(options_.catch_up_interval_ms);
+    std::unique_lock<std::mutex> lock(catch_up_lock_);
+    while (!catch_up_cv_.wait_for(lock, interval, [this]() { return stop_catch_up_; })) {
+        lock.unlock();
+        TryCatchUp();
+        lock.lock();
+    }
+}
+
+bool RocksDBStorage::TryCatchUp() {
+    if (options_.mode != RucksDBOpenMode::SECONDARY) {
+        return false;
+    }
+    auto status = db_->TryCatchUpWithPrimary();
+    for (auto &shard : shards_) {
+        if (status.ok() && !shard->TryCatchUp()) {
+            status = rocksdb::Status::Incomplete("shard catch-up failed");
+        }
+    }
+    if (!status.ok()) {
+        catch_up_failures_++;
+        return false;
+    }
+    // Values cached before the catch-up may have been overwritten by the primary
+    if (cache_) {
+        cache_->Clear();
+    }
+    catch_ups_++;
+    catch_up_epoch_++;
+    synced_at_us_ = NowMicros();
+    return true;
+}
+
+std::vector<RocksDBStorage*> RocksDBStorage::GetShards() {
+    std::vector<RocksDBStorage*> result;
+    result.push_back(this);
+    for (auto &shard : shards_) {
+        result.push_back(shard.get());
+    }
+    return result;
+}
+
+RucksDBReplicationStatus RocksDBStorage::GetReplicationStatus() {
+    RucksDBReplicationStatus status;
+    status.mode = options_.mode;
+    status.catch_ups = catch_ups_;
+    status.catch_up_failures = catch_up_failures_;
+    if (options_.mode != RucksDBOpenMode::PRIMARY) {
+        status.staleness_ms = (uint64_t)(NowMicros() - synced_at_us_) / 1000;
+    }
+    status.latest_sequence = db_ ? db_->GetLatestSequenceNumber() : 0;
+    return status;
 }
 
 void RocksDBStorage::WriteData(const string &key, const string &value) {
+    RucksDBOperationTimer timer(metrics_.get(), RucksDBOperation::PUT);
+    timer.bytes = key.size() + value.size();
     auto status = db_->Put(rocksdb::WriteOptions(), key, value);
     if (!status.ok()) {
         throw std::runtime_error("RocksDB write failed: " + status.ToString());
     }
+    // Invalidate after the write so a concurrent miss cannot re-insert the old value
+    if (cache_) {
+        cache_->Erase(key);
+    }
+}
+
+void RocksDBStorage::MergeData(const string &key, const string &operand) {
+    RucksDBOperationTimer timer(metrics_.get(), RucksDBOperation::MERGE);
+    timer.bytes = key.size() + operand.size();
+    auto status = db_->Merge(rocksdb::WriteOptions(), key, operand);
+    if (!status.ok()) {
+        throw std::runtime_error("RocksDB merge failed: " + status.ToString());
+    }
+    if (cache_) {
+        cache_->Erase(key);
+    }
 }
 
 bool RocksDBStorage::ReadData(const string &key, string &value) {
-    auto status = db_->Get(rocksdb::ReadOptions(), key, &value);
+    if (!cache_) {
+        return ReadDataUncached(key, value);
+    }
+    
+    auto cached = std::dynamic_pointer_cast<const RucksDBCachedBytes>(cache_->Lookup(key));
+    if (cached) {
+        value = cached->value;
+        return true;
+    }
+    
+    uint64_t version = cache_->GetVersion(key);
+    if (!ReadDataUncached(key, value)) {
+        return false;
+    }
+    cache_->Insert(key, std::make_shared<RucksDBCachedBytes>(value), value.size(), version);
+    return true;
+}
+
+bool RocksDBStorage::ReadDataUncached(const string &key, string &value) {
+    RucksDBOperationTimer timer(metrics_.get(), RucksDBOperation::GET);
+    auto status = db_->Get(read_options_, key, &value);
+    timer.bytes = status.ok() ? value.size() : 0;
     return status.ok();
 }
 
+void RocksDBStorage::MultiReadDataUncached(const std::vector<string> &keys, std::vector<string> &values,
+                                           std::vector<bool> &found, bool sorted) {
+    RucksDBOperationTimer timer(metrics_.get(), RucksDBOperation::GET);
+    timer.rows = keys.size();
+    std::vector<rocksdb::Slice> key_slices(keys.begin(), keys.end());
+    std::vector<rocksdb::PinnableSlice> pinned(keys.size());
+    std::vector<rocksdb::Status> statuses(keys.size());
+    db_->MultiGet(read_options_, db_->DefaultColumnFamily(), keys.size(), key_slices.data(),
+                  pinned.data(), statuses.data(), sorted);
+    
+    values.resize(keys.size());
+    found.assign(keys.size(), false);
+    for (size_t i = 0; i < keys.size(); i++) {
+        if (statuses[i].ok()) {
+            values[i].assign(pinned[i].data(), pinned[i].size());
+            found[i] = true;
+            timer.bytes += pinned[i].size();
+        } else if (!statuses[i].IsNotFound()) {
+            throw std::runtime_error("RocksDB MultiGet failed: " + statuses[i].ToString());
+        }
+    }
+}
+
 void RocksDBStorage::DeleteData(const string &key) {
+    RucksDBOperationTimer timer(metrics_.get(), RucksDBOperation::DELETE);
     db_->Delete(rocksdb::WriteOptions(), key);
+    if (cache_) {
+        cache_->Erase(key);
+    }
+}
+
+void RocksDBStorage::ApplyBatch(rocksdb::WriteBatch &batch) {
+    RucksDBOperationTimer timer(metrics_.get(), RucksDBOperation::BATCH);
+    timer.rows = batch.Count();
+    timer.bytes = batch.GetDataSize();
+    auto status = db_->Write(rocksdb::WriteOptions(), &batch);
+    if (!status.ok()) {
+        throw std::runtime_error("RocksDB batch write failed: " + status.ToString());
+    }
+    if (cache_) {
+        CacheInvalidationHandler handler(*cache_);
+        batch.Iterate(&handler);
+    }
+}
+
+RucksDBCacheStatistics RocksDBStorage::GetCacheStatistics() {
+    return cache_ ? cache_->GetStatistics() : RucksDBCacheStatistics();
+}
+
+bool RocksDBStorage::GetProperty(const string &property, string &value) {
+    return db_->GetProperty(property, &value);
+}
+
+void RocksDBStorage::SetExpiryCheck(RucksDBExpiryCheck check) {
+    std::shared_ptr<const RucksDBExpiryCheck> shared;
+    if (check) {
+        shared = std::make_shared<const RucksDBExpiryCheck>(std::move(check));
+    }
+    compaction_filter_->SetExpiryCheck(shared);
+    for (auto &shard : shards_) {
+        shard->compaction_filter_->SetExpiryCheck(shared);
+    }
+}
+
+void RocksDBStorage::CompactPrefix(const string &prefix) {
+    if (IsReadOnly()) {
+        return;
+    }
+    // Every key under prefix sorts before prefix + 0xFF
+    string end = prefix + "\xff";
+    rocksdb::Slice begin_slice(prefix), end_slice(end);
+    auto status = db_->CompactRange(rocksdb::CompactRangeOptions(), &begin_slice, &end_slice);
+    if (!status.ok()) {
+        throw std::runtime_error("RocksDB compaction failed: " + status.ToString());
+    }
+    for (auto &shard : shards_) {
+        shard->CompactPrefix(prefix);
+    }
+}
+
+uint64_t RocksDBStorage::GetLatestSequence() {
+    return db_->GetLatestSequenceNumber();
+}
+
+std::unique_ptr<rocksdb::TransactionLogIterator> RocksDBStorage::GetUpdatesSince(uint64_t sequence) {
+    std::unique_ptr<rocksdb::TransactionLogIterator> iterator;
+    auto status = db_->GetUpdatesSince(sequence, &iterator);
+    if (!status.ok()) {
+        throw std::runtime_error("RocksDB GetUpdatesSince(" + std::to_string(sequence) + ") failed: " +
+                                 status.ToString());
+    }
+    return iterator;
+}
+
+void RocksDBStorage::CreateCheckpoint(const string &checkpoint_dir) {
+    rocksdb::Checkpoint* checkpoint_raw;
+    auto status = rocksdb::Checkpoint::Create(db_.get(), &checkpoint_raw);
+    if (!status.ok()) {
+        throw std::runtime_error("RocksDB checkpoint failed: " + status.ToString());
+    }
+    std::unique_ptr<rocksdb::Checkpoint> checkpoint(checkpoint_raw);
+    
+    status = checkpoint->CreateCheckpoint(checkpoint_dir);
+    if (!status.ok()) {
+        throw std::runtime_error("RocksDB checkpoint failed: " + status.ToString());
+    }
+}
+
+static std::unique_ptr<rocksdb::BackupEngine> OpenBackupEngine(const string &backup_dir, uint64_t rate_limit) {
+    rocksdb::BackupEngineOptions options(backup_dir);
+    // Table files are shared between backups, which makes every backup after the first incremental
+    options.share_table_files = true;
+    if (rate_limit > 0) {
+        options.backup_rate_limiter.reset(rocksdb::NewGenericRateLimiter((int64_t)rate_limit));
+    }
+    
+    rocksdb::BackupEngine* engine_raw;
+    auto status = rocksdb::BackupEngine::Open(options, rocksdb::Env::Default(), &engine_raw);
+    if (!status.ok()) {
+        throw std::runtime_error("Failed to open backup directory: " + status.ToString());
+    }
+    return std::unique_ptr<rocksdb::BackupEngine>(engine_raw);
+}
+
+static RucksDBBackupInfo ToBackupInfo(const rocksdb::BackupInfo &info) {
+    RucksDBBackupInfo result;
+    result.backup_id = info.backup_id;
+    result.timestamp = info.timestamp;
+    result.size = info.size;
+    result.file_count = info.number_files;
+    return result;
+}
+
+RucksDBBackupInfo RocksDBStorage::CreateBackup(const string &backup_dir, uint64_t rate_limit, uint32_t keep_backups) {
+    auto engine = OpenBackupEngine(backup_dir, rate_limit > 0 ? rate_limit : options_.backup_rate_limit);
+    
+    uint32_t backup_id;
+    rocksdb::CreateBackupOptions create_options;
+    create_options.flush_before_backup = true;
+    auto status = engine->CreateNewBackup(create_options, db_.get(), &backup_id);
+    if (!status.ok()) {
+        throw std::runtime_error("RocksDB backup failed: " + status.ToString());
+    }
+    if (keep_backups > 0) {
+        engine->PurgeOldBackups(keep_backups);
+    }
+    
+    rocksdb::BackupInfo info;
+    status = engine->GetBackupInfo(backup_id, &info);
+    if (!status.ok()) {
+        throw std::runtime_error("RocksDB backup failed: " + status.ToString());
+    }
+    return ToBackupInfo(info);
+}
+
+std::vector<RucksDBBackupInfo> RocksDBStorage::ListBackups(const string &backup_dir) {
+    auto engine = OpenBackupEngine(backup_dir, 0);
+    std::vector<rocksdb::BackupInfo> backups;
+    engine->GetBackupInfo(&backups);
+    
+    std::vector<RucksDBBackupInfo> result;
+    for (auto &backup : backups) {
+        result.push_back(ToBackupInfo(backup));
+    }
+    return result;
+}
+
+void RocksDBStorage::RestoreBackup(const string &backup_dir, const string &path, uint32_t backup_id) {
+    auto engine = OpenBackupEngine(backup_dir, 0);
+    string db_dir = path + "_rocksdb";
+    
+    rocksdb::IOStatus status;
+    if (backup_id == 0) {
+        status = engine->RestoreDBFromLatestBackup(db_dir, db_dir);
+    } else {
+        status = engine->RestoreDBFromBackup(backup_id, db_dir, db_dir);
+    }
+    if (!status.ok()) {
+        throw std::runtime_error("RocksDB restore failed: " + status.ToString());
+    }
+}
+
+void RocksDBStorage::Flush() {
+    // Read-only and secondary instances have nothing of their own to flush
+    if (IsReadOnly()) {
+        return;
+    }
+    auto status = db_->Flush(rocksdb::FlushOptions());
+    if (!status.ok()) {
+        throw std::runtime_error("RocksDB flush failed: " + status.ToString());
+    }
+}
+
+void RocksDBStorage::DropBlockCache() {
+    auto table_options = db_->GetOptions().table_factory->GetOptions<rocksdb::BlockBasedTableOptions>();
+    if (table_options && table_options->block_cache) {
+        table_options->block_cache->EraseUnRefEntries();
+    }
+    for (auto &shard : shards_) {
+        shard->DropBlockCache();
+    }
 }
 
 void RocksDBStorage::IteratePrefix(const string &prefix, 
                                  std::function<bool(const string&, const string&)> callback) {
-    auto it = db_->NewIterator(rocksdb::ReadOptions());
+    RucksDBOperationTimer timer(metrics_.get(), RucksDBOperation::SCAN);
+    timer.rows = 0;
+    std::unique_ptr<rocksdb::Iterator> it(db_->NewIterator(read_options_));
     for (it->Seek(prefix); it->Valid() && it->key().starts_with(prefix); it->Next()) {
         string key = it->key().ToString();
         string value = it->value().ToString();
+        timer.rows++;
+        timer.bytes += key.size() + value.size();
+        if (!callback(key, value)) {
+            return;
+        }
+    }
+    if (!it->status().ok()) {
+        throw std::runtime_error("RocksDB iteration failed: " + it->status().ToString());
+    }
+}
+
+void RocksDBStorage::IterateRange(const string &start, const string &end,
+                                  std::function<bool(const string&, const string&)> callback,
+                                  const rocksdb::Snapshot *snapshot) {
+    RucksDBOperationTimer timer(metrics_.get(), RucksDBOperation::SCAN);
+    timer.rows = 0;
+    rocksdb::Slice upper_bound(end);
+    auto read_options = read_options_;
+    read_options.iterate_upper_bound = &upper_bound;
+    read_options.snapshot = snapshot;
+    std::unique_ptr<rocksdb::Iterator> it(db_->NewIterator(read_options));
+    for (it->Seek(start); it->Valid(); it->Next()) {
+        string key = it->key().ToString();
+        string value = it->value().ToString();
+        timer.rows++;
+        timer.bytes += key.size() + value.size();
         if (!callback(key, value)) {
-            break;
+            return;
         }
     }
-    delete it;
+    if (!it->status().ok()) {
+        throw std::runtime_error("RocksDB iteration failed: " + it->status().ToString());
+    }
+}
+
+std::shared_ptr<const rocksdb::Snapshot> RocksDBStorage::GetSnapshot() {
+    auto* db = db_.get();
+    return std::shared_ptr<const rocksdb::Snapshot>(db->GetSnapshot(),
+                                                    [db](const rocksdb::Snapshot *snapshot) {
+        db->ReleaseSnapshot(snapshot);
+    });
 }
 
 void RocksDBStorage::CreateTable(const string &table_name) {
@@ -89,11 +705,24 @@ void RocksDBStorage::SetTableRowCount(const string &table_name, size_t count) {
 // C interface for extension
 extern "C" {
 void rucksdb_init(const char* db_path) {
-    duckdb::g_rocksdb_storage = std::make_unique<duckdb::RocksDBStorage>(db_path ? db_path : "./rucksdb_data");
+    rucksdb_init_with_options(db_path, nullptr);
+}
+
+void rucksdb_init_with_options(const char* db_path, const char* options) {
+    duckdb::g_ingest_queue.reset();
+    auto storage_options = duckdb::RocksDBStorageOptions::Parse(options ? options : "");
+    duckdb::RucksDBMemoryBudget::SetDefault(nullptr);
+    duckdb::g_rocksdb_storage = std::make_unique<duckdb::RocksDBStorage>(db_path ? db_path : "./rucksdb_data",
+                                                                         storage_options);
     duckdb::g_rocksdb_storage->Initialize();
+    // memory_budget here becomes the process-wide budget, shared with later ATTACHed instances
+    duckdb::RucksDBMemoryBudget::SetDefault(duckdb::g_rocksdb_storage->GetSharedMemoryBudget());
 }
 
 void rucksdb_shutdown() {
+    // Drain pending async writes while the storage is still open
+    duckdb::g_ingest_queue.reset();
     duckdb::g_rocksdb_storage.reset();
+    duckdb::RucksDBMemoryBudget::SetDefault(nullptr);
 }
 }
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include "../include/RucksDBBackupFunctions.hpp"
+#include "../include/RucksDBStatsFunctions.hpp"
+#include "../include/RocksDBStorage.hpp"
+#include "../include/RucksDBInstance.hpp"
+#include "duckdb/main/extension_util.hpp"
+
+namespace duckdb {
+
+struct RucksDBBackupBindData : public TableFunctionData {
+    string directory;
+    uint64_t rate_limit = 0;
+    RocksDBStorage* storage = nullptr;
+};
+
+static void SetBackupColumns(vector<LogicalType>& return_types, vector<string>& names) {
+    names = {"backup_id", "timestamp", "size", "files"};
+    return_types = {LogicalType::UINTEGER, LogicalType::TIMESTAMP, LogicalType::UBIGINT, LogicalType::UINTEGER};
+}
+
+static vector<Value> BackupRow(const RucksDBBackupInfo& info) {
+    return {Value::UINTEGER(info.backup_id), Value::TIMESTAMP(Timestamp::FromEpochSeconds(info.timestamp)),
+            Value::UBIGINT(info.size), Value::UINTEGER(info.file_count)};
+}
+
+// rucksdb_checkpoint('dir')
+static unique_ptr<FunctionData> CheckpointBind(ClientContext& context, TableFunctionBindInput& input,
+                                               vector<LogicalType>& return_types, vector<string>& names) {
+    names = {"path"};
+    return_types = {LogicalType::VARCHAR};
+
+    auto bind_data = make_unique<RucksDBBackupBindData>();
+    bind_data->directory = input.inputs[0].GetValue<string>();
+    bind_data->storage = RucksDBInstanceRegistry::Get(input).storage;
+    return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> CheckpointInit(ClientContext& context, TableFunctionInitInput& input) {
+    auto& bind_data = (RucksDBBackupBindData&)*input.bind_data;
+    bind_data.storage->CreateCheckpoint(bind_data.directory);
+
+    auto state = make_unique<RucksDBStatsState>();
+    state->rows.push_back({Value(bind_data.directory)});
+    return std::move(state);
+}
+
+// rucksdb_backup('dir' [, rate_limit])
+static unique_ptr<FunctionData> BackupBind(ClientContext& context, TableFunctionBindInput& input,
+                                           vector<LogicalType>& return_types, vector<string>& names) {
+    SetBackupColumns(return_types, names);
+
+    auto bind_data = make_unique<RucksDBBackupBindData>();
+    bind_data->directory = input.inputs[0].GetValue<string>();
+    bind_data->storage = RucksDBInstanceRegistry::Get(input).storage;
+    if (input.inputs.size() > 1) {
+        auto rate_limit = input.inputs[1].GetValue<int64_t>();
+        if (rate_limit < 0) {
+            throw std::runtime_error("Backup rate limit must not be negative");
+        }
+        bind_data->rate_limit = (uint64_t)rate_limit;
+    }
+    return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> BackupInit(ClientContext& context, TableFunctionInitInput& input) {
+    auto& bind_data = (RucksDBBackupBindData&)*input.bind_data;
+    auto info = bind_data.storage->CreateBackup(bind_data.directory, bind_data.rate_limit);
+
+    auto state = make_unique<RucksDBStatsState>();
+    state->rows.push_back(BackupRow(info));
+    return std::move(state);
+}
+
+// rucksdb_backups('dir')
+static unique_ptr<FunctionData> ListBackupsBind(ClientContext& context, TableFunctionBindInput& input,
+                                                vector<LogicalType>& return_types, vector<string>& names) {
+    SetBackupColumns(return_types, names);
+
+    auto bind_data = make_unique<RucksDBBackupBindData>();
+    bind_data->directory = input.inputs[0].GetValue<string>();
+    return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> ListBackupsInit(ClientContext& context, TableFunctionInitInput& input) {
+    auto& bind_data = (RucksDBBackupBindData&)*input.bind_data;
+
+    auto state = make_unique<RucksDBStatsState>();
+    for (auto& info : RocksDBStorage::ListBackups(bind_data.directory)) {
+        state->rows.push_back(BackupRow(info));
+    }
+    return std::move(state);
+}
+
+TableFunction RucksDBBackupFunctions::GetCheckpointFunction() {
+    TableFunction function("rucksdb_checkpoint", {LogicalType::VARCHAR}, RucksDBStatsFunctions::ExecuteRows,
+                           CheckpointBind, CheckpointInit);
+    function.named_parameters["database"] = LogicalType::VARCHAR;
+    return function;
+}
+
+TableFunctionSet RucksDBBackupFunctions::GetBackupFunction() {
+    TableFunctionSet set("rucksdb_backup");
+    TableFunction backup({LogicalType::VARCHAR}, RucksDBStatsFunctions::ExecuteRows, BackupBind, BackupInit);
+    backup.named_parameters["database"] = LogicalType::VARCHAR;
+    set.AddFunction(backup);
+    backup.arguments.push_back(LogicalType::BIGINT);
+    set.AddFunction(backup);
+    return set;
+}
+
+TableFunction RucksDBBackupFunctions::GetListBackupsFunction() {
+    return TableFunction("rucksdb_backups", {LogicalType::VARCHAR}, RucksDBStatsFunctions::ExecuteRows,
+                         ListBackupsBind, ListBackupsInit);
+}
+
+void RucksDBBackupFunctions::RegisterFunctions(DatabaseInstance& db) {
+    ExtensionUtil::RegisterFunction(db, GetCheckpointFunction());
+    ExtensionUtil::RegisterFunction(db, GetBackupFunction());
+    ExtensionUtil::RegisterFunction(db, GetListBackupsFunction());
+}
+
+} // namespace duckdb
\ No newline at end of file
@@ -0,0 +1,154 @@
+// src/RucksDBCache.cpp
+
+#include "../include/RucksDBCache.hpp"
+#include <functional>
+
+namespace duckdb {
+
+RucksDBCache::RucksDBCache(size_t capacity, size_t shard_count) {
+    if (shard_count == 0) {
+        shard_count = 1;
+    }
+    shard_capacity_ = capacity / shard_count;
+    for (size_t i = 0; i < shard_count; i++) {
+        shards_.push_back(std::make_unique<Shard>());
+    }
+}
+
+RucksDBCache::Shard& RucksDBCache::GetShard(const string& key) {
+    return *shards_[std::hash<string>()(key) % shards_.size()];
+}
+
+RucksDBCache::Handle RucksDBCache::Lookup(const string& key) {
+    auto& shard = GetShard(key);
+    std::lock_guard<std::mutex> guard(shard.lock);
+
+    auto it = shard.index.find(key);
+    if (it == shard.index.end()) {
+        misses_++;
+        return nullptr;
+    }
+
+    auto& slot = shard.slots[it->second];
+    slot.referenced = true;
+    hits_++;
+    return slot.value;
+}
+
+uint64_t RucksDBCache::GetVersion(const string& key) {
+    auto& shard = GetShard(key);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    return shard.version;
+}
+
+void RucksDBCache::EvictSlot(Shard& shard, size_t slot_idx) {
+    auto& slot = shard.slots[slot_idx];
+    shard.index.erase(slot.key);
+    shard.usage -= slot.charge;
+    slot = Slot();
+    shard.free_slots.push_back(slot_idx);
+}
+
+bool RucksDBCache::MakeRoom(Shard& shard, size_t charge) {
+    if (charge > shard_capacity_) {
+        return false;
+    }
+
+    // CLOCK: referenced entries get a second chance, unreferenced ones are evicted
+    while (shard.usage + charge > shard_capacity_) {
+        auto& slot = shard.slots[shard.clock_hand];
+        if (slot.occupied) {
+            if (slot.referenced) {
+                slot.referenced = false;
+            } else {
+                EvictSlot(shard, shard.clock_hand);
+                evictions_++;
+            }
+        }
+        shard.clock_hand = (shard.clock_hand + 1) % shard.slots.size();
+    }
+    return true;
+}
+
+bool RucksDBCache::Insert(const string& key, Handle value, size_t charge, uint64_t version) {
+    charge += key.size() + sizeof(Slot);
+
+    auto& shard = GetShard(key);
+    std::lock_guard<std::mutex> guard(shard.lock);
+
+    if (shard.version != version) {
+        return false;
+    }
+
+    auto it = shard.index.find(key);
+    if (it != shard.index.end()) {
+        EvictSlot(shard, it->second);
+    }
+    if (!MakeRoom(shard, charge)) {
+        return false;
+    }
+
+    size_t slot_idx;
+    if (!shard.free_slots.empty()) {
+        slot_idx = shard.free_slots.back();
+        shard.free_slots.pop_back();
+    } else {
+        slot_idx = shard.slots.size();
+        shard.slots.emplace_back();
+    }
+
+    auto& slot = shard.slots[slot_idx];
+    slot.key = key;
+    slot.value = std::move(value);
+    slot.charge = charge;
+    // New entries start unreferenced so one-hit wonders are the first to go
+    slot.referenced = false;
+    slot.occupied = true;
+
+    shard.index[key] = slot_idx;
+    shard.usage += charge;
+    inserts_++;
+    return true;
+}
+
+void RucksDBCache::Erase(const string& key) {
+    auto& shard = GetShard(key);
+    std::lock_guard<std::mutex> guard(shard.lock);
+
+    shard.version++;
+    auto it = shard.index.find(key);
+    if (it != shard.index.end()) {
+        EvictSlot(shard, it->second);
+        invalidations_++;
+    }
+}
+
+void RucksDBCache::Clear() {
+    for (auto& shard_ptr : shards_) {
+        auto& shard = *shard_ptr;
+        std::lock_guard<std::mutex> guard(shard.lock);
+        shard.version++;
+        shard.index.clear();
+        shard.slots.clear();
+        shard.free_slots.clear();
+        shard.clock_hand = 0;
+        shard.usage = 0;
+    }
+}
+
+RucksDBCacheStatistics RucksDBCache::GetStatistics() {
+    RucksDBCacheStatistics stats;
+    stats.hits = hits_;
+    stats.misses = misses_;
+    stats.inserts = inserts_;
+    stats.evictions = evictions_;
+    stats.invalidations = invalidations_;
+    stats.capacity = shard_capacity_ * shards_.size();
+    for (auto& shard_ptr : shards_) {
+        std::lock_guard<std::mutex> guard(shard_ptr->lock);
+        stats.usage += shard_ptr->usage;
+    }
+    return stats;
+}
+
+} // namespace duckdb
\ No newline at end of file
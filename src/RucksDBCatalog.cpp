@@ -0,0 +1,416 @@
+#include "../include/RucksDBCatalog.hpp"
+#include "../include/RucksDBWriteOperators.hpp"
+#include "../include/RucksDBInstance.hpp"
+#include "../include/RucksDBMemoryBudget.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/execution/physical_plan_generator.hpp"
+#include "duckdb/main/attached_database.hpp"
+#include "duckdb/parser/parsed_data/create_schema_info.hpp"
+#include "duckdb/parser/parsed_data/drop_info.hpp"
+#include "duckdb/planner/expression/bound_reference_expression.hpp"
+#include "duckdb/planner/operator/logical_create_table.hpp"
+#include "duckdb/planner/operator/logical_delete.hpp"
+#include "duckdb/planner/operator/logical_insert.hpp"
+#include "duckdb/planner/operator/logical_update.hpp"
+
+namespace duckdb {
+
+// Table entry implementation
+RucksDBTableEntry::RucksDBTableEntry(Catalog& catalog, SchemaCatalogEntry& schema, CreateTableInfo& info,
+                                     RucksDBTableRegistry& registry)
+    : TableCatalogEntry(catalog, schema, info), registry_(registry) {
+}
+
+RucksDBTableStorage& RucksDBTableEntry::GetStorage() {
+    auto* storage = storage_.load();
+    if (!storage) {
+        // The registry hands every caller the same storage, so racing loads agree
+        storage = registry_.GetTable(name);
+        if (!storage) {
+            throw CatalogException("Table with name \"%s\" does not exist", name);
+        }
+        storage_ = storage;
+    }
+    return *storage;
+}
+
+unique_ptr<BaseStatistics> RucksDBTableEntry::GetStatistics(ClientContext& context, column_t column_id) {
+    if (column_id >= columns.LogicalColumnCount()) {
+        return nullptr;
+    }
+    return GetStorage().GetColumnStatistics(column_id, columns.GetColumn(LogicalIndex(column_id)).Type());
+}
+
+TableFunction RucksDBTableEntry::GetScanFunction(ClientContext& context, unique_ptr<FunctionData>& bind_data) {
+    auto result = make_unique<RocksDBBindData>();
+    result->table_name = name;
+    for (auto& col : columns.Logical()) {
+        result->types.push_back(col.Type());
+        result->names.push_back(col.Name());
+    }
+    result->table_storage = &GetStorage();
+    bind_data = std::move(result);
+
+    return RocksDBTableFunction::GetFunction();
+}
+
+TableStorageInfo RucksDBTableEntry::GetStorageInfo(ClientContext& context) {
+    TableStorageInfo result;
+    result.cardinality = GetStorage().GetLiveRowCount();
+    return result;
+}
+
+// Schema entry implementation
+RucksDBSchemaEntry::RucksDBSchemaEntry(Catalog& catalog, CreateSchemaInfo& info, RucksDBTableRegistry& registry)
+    : SchemaCatalogEntry(catalog, info), registry_(registry) {
+}
+
+optional_ptr<CatalogEntry> RucksDBSchemaEntry::LoadTableEntry(const string& name) {
+    auto it = tables_.find(name);
+    if (it != tables_.end()) {
+        return it->second.get();
+    }
+
+    if (!registry_.TableExists(name)) {
+        return nullptr;
+    }
+
+    CreateTableInfo info(*this, name);
+    for (auto& col : registry_.GetTableColumns(name)) {
+        info.columns.AddColumn(std::move(col));
+    }
+
+    auto entry = make_unique<RucksDBTableEntry>(ParentCatalog(), *this, info, registry_);
+    auto* result = entry.get();
+    tables_[name] = std::move(entry);
+    return result;
+}
+
+optional_ptr<CatalogEntry> RucksDBSchemaEntry::CreateTable(CatalogTransaction transaction, BoundCreateTableInfo& info) {
+    auto& base = info.Base();
+    std::lock_guard<std::mutex> guard(entry_lock_);
+
+    if (registry_.TableExists(base.table)) {
+        switch (base.on_conflict) {
+        case OnCreateConflict::IGNORE_ON_CONFLICT:
+            return LoadTableEntry(base.table);
+        case OnCreateConflict::REPLACE_ON_CONFLICT:
+            DropTable(base.table);
+            break;
+        default:
+            throw CatalogException("Table with name \"%s\" already exists", base.table);
+        }
+    }
+
+    vector<ColumnDefinition> columns;
+    for (auto& col : base.columns.Logical()) {
+        columns.push_back(col.Copy());
+    }
+    registry_.CreateTable(base.table, columns);
+
+    return LoadTableEntry(base.table);
+}
+
+optional_ptr<CatalogEntry> RucksDBSchemaEntry::CreateFunction(CatalogTransaction transaction, CreateFunctionInfo& info) {
+    throw BinderException("RucksDB databases do not support creating functions");
+}
+
+optional_ptr<CatalogEntry> RucksDBSchemaEntry::CreateIndex(CatalogTransaction transaction, CreateIndexInfo& info,
+                                                           TableCatalogEntry& table) {
+    throw BinderException("RucksDB databases do not support creating indexes");
+}
+
+optional_ptr<CatalogEntry> RucksDBSchemaEntry::CreateView(CatalogTransaction transaction, CreateViewInfo& info) {
+    throw BinderException("RucksDB databases do not support creating views");
+}
+
+optional_ptr<CatalogEntry> RucksDBSchemaEntry::CreateSequence(CatalogTransaction transaction, CreateSequenceInfo& info) {
+    throw BinderException("RucksDB databases do not support creating sequences");
+}
+
+optional_ptr<CatalogEntry> RucksDBSchemaEntry::CreateTableFunction(CatalogTransaction transaction,
+                                                                   CreateTableFunctionInfo& info) {
+    throw BinderException("RucksDB databases do not support creating table functions");
+}
+
+optional_ptr<CatalogEntry> RucksDBSchemaEntry::CreateCopyFunction(CatalogTransaction transaction,
+                                                                  CreateCopyFunctionInfo& info) {
+    throw BinderException("RucksDB databases do not support creating copy functions");
+}
+
+optional_ptr<CatalogEntry> RucksDBSchemaEntry::CreatePragmaFunction(CatalogTransaction transaction,
+                                                                    CreatePragmaFunctionInfo& info) {
+    throw BinderException("RucksDB databases do not support creating pragma functions");
+}
+
+optional_ptr<CatalogEntry> RucksDBSchemaEntry::CreateCollation(CatalogTransaction transaction,
+                                                               CreateCollationInfo& info) {
+    throw BinderException("RucksDB databases do not support creating collations");
+}
+
+optional_ptr<CatalogEntry> RucksDBSchemaEntry::CreateType(CatalogTransaction transaction, CreateTypeInfo& info) {
+    throw BinderException("RucksDB databases do not support creating types");
+}
+
+void RucksDBSchemaEntry::Alter(CatalogTransaction transaction, AlterInfo& info) {
+    throw NotImplementedException("ALTER is not supported for RucksDB tables");
+}
+
+void RucksDBSchemaEntry::Scan(ClientContext& context, CatalogType type,
+                              const std::function<void(CatalogEntry&)>& callback) {
+    Scan(type, callback);
+}
+
+void RucksDBSchemaEntry::Scan(CatalogType type, const std::function<void(CatalogEntry&)>& callback) {
+    if (type != CatalogType::TABLE_ENTRY) {
+        return;
+    }
+
+    // Collect entries first so the callback can look up other entries without deadlocking
+    vector<optional_ptr<CatalogEntry>> entries;
+    {
+        std::lock_guard<std::mutex> guard(entry_lock_);
+        for (const auto& table_name : registry_.ListTables()) {
+            auto entry = LoadTableEntry(table_name);
+            if (entry) {
+                entries.push_back(entry);
+            }
+        }
+    }
+
+    for (auto& entry : entries) {
+        callback(*entry);
+    }
+}
+
+void RucksDBSchemaEntry::DropEntry(ClientContext& context, DropInfo& info) {
+    if (info.type != CatalogType::TABLE_ENTRY) {
+        throw BinderException("RucksDB databases only support dropping tables");
+    }
+
+    std::lock_guard<std::mutex> guard(entry_lock_);
+    if (!registry_.TableExists(info.name)) {
+        if (info.if_not_found == OnEntryNotFound::RETURN_NULL) {
+            return;
+        }
+        throw CatalogException("Table with name \"%s\" does not exist", info.name);
+    }
+
+    DropTable(info.name);
+}
+
+void RucksDBSchemaEntry::DropTable(const string& name) {
+    auto it = tables_.find(name);
+    if (it != tables_.end()) {
+        // Binds the entry to the storage being dropped, so that plans holding it never reach a
+        // table created later under the same name
+        it->second->GetStorage();
+    }
+    registry_.DropTable(name);
+    if (it != tables_.end()) {
+        dropped_tables_.push_back(std::move(it->second));
+        tables_.erase(it);
+    }
+}
+
+optional_ptr<CatalogEntry> RucksDBSchemaEntry::GetEntry(CatalogTransaction transaction, CatalogType type,
+                                                        const string& name) {
+    if (type != CatalogType::TABLE_ENTRY) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> guard(entry_lock_);
+    return LoadTableEntry(name);
+}
+
+// Catalog implementation
+RucksDBCatalog::RucksDBCatalog(AttachedDatabase& db, const string& path, AccessMode access_mode,
+                               const string& options)
+    : Catalog(db), path_(path), access_mode_(access_mode), storage_(nullptr), registry_(nullptr) {
+    // RocksDB allows one handle per directory, so reuse the instance opened by rucksdb_init
+    if (g_rocksdb_storage && g_rocksdb_storage->GetPath() == path + "_rocksdb") {
+        if (!g_table_registry) {
+            g_table_registry = make_unique<RucksDBTableRegistry>(g_rocksdb_storage.get());
+        }
+        storage_ = g_rocksdb_storage.get();
+        registry_ = g_table_registry.get();
+    } else {
+        auto storage_options = RocksDBStorageOptions::Parse(options);
+        // ATTACH ... (READ_ONLY) opens without taking RocksDB's write lock, so any number of processes can attach
+        if (access_mode == AccessMode::READ_ONLY && storage_options.mode == RucksDBOpenMode::PRIMARY) {
+            storage_options.mode = RucksDBOpenMode::READ_ONLY;
+        }
+        owned_storage_ = make_unique<RocksDBStorage>(path, storage_options);
+        owned_storage_->Initialize();
+        owned_registry_ = make_unique<RucksDBTableRegistry>(owned_storage_.get());
+        storage_ = owned_storage_.get();
+        registry_ = owned_registry_.get();
+    }
+
+    RucksDBInstanceRegistry::Register(db.GetName(), storage_, registry_);
+    // DuckDB gets what the budget leaves after RocksDB's share
+    if (storage_->GetMemoryBudget()) {
+        storage_->GetMemoryBudget()->AttachDuckDB(db.GetDatabase().shared_from_this());
+    }
+}
+
+RucksDBCatalog::~RucksDBCatalog() {
+    RucksDBInstanceRegistry::Unregister(GetAttached().GetName());
+}
+
+void RucksDBCatalog::Initialize(bool load_builtin) {
+    CreateSchemaInfo info;
+    info.schema = DEFAULT_SCHEMA;
+    main_schema_ = make_unique<RucksDBSchemaEntry>(*this, info, *registry_);
+}
+
+optional_ptr<CatalogEntry> RucksDBCatalog::CreateSchema(CatalogTransaction transaction, CreateSchemaInfo& info) {
+    throw BinderException("RucksDB databases only support the \"%s\" schema", DEFAULT_SCHEMA);
+}
+
+void RucksDBCatalog::DropSchema(ClientContext& context, DropInfo& info) {
+    throw BinderException("RucksDB databases only support the \"%s\" schema", DEFAULT_SCHEMA);
+}
+
+void RucksDBCatalog::ScanSchemas(ClientContext& context, std::function<void(SchemaCatalogEntry&)> callback) {
+    callback(*main_schema_);
+}
+
+optional_ptr<SchemaCatalogEntry> RucksDBCatalog::GetSchema(CatalogTransaction transaction, const string& schema_name,
+                                                           OnEntryNotFound if_not_found,
+                                                           QueryErrorContext error_context) {
+    if (schema_name == DEFAULT_SCHEMA || schema_name == INVALID_SCHEMA) {
+        return main_schema_.get();
+    }
+    if (if_not_found == OnEntryNotFound::RETURN_NULL) {
+        return nullptr;
+    }
+    throw BinderException("Schema with name \"%s\" not found", schema_name);
+}
+
+unique_ptr<PhysicalOperator> RucksDBCatalog::PlanCreateTableAs(ClientContext& context, LogicalCreateTable& op,
+                                                               unique_ptr<PhysicalOperator> plan) {
+    auto insert = make_unique<RucksDBInsert>(op, op.schema, std::move(op.info));
+    insert->parallel = !PhysicalPlanGenerator::PreserveInsertionOrder(context, *plan);
+    insert->children.push_back(std::move(plan));
+    return std::move(insert);
+}
+
+unique_ptr<PhysicalOperator> RucksDBCatalog::PlanInsert(ClientContext& context, LogicalInsert& op,
+                                                        unique_ptr<PhysicalOperator> plan) {
+    if (op.return_chunk) {
+        throw BinderException("RETURNING clause not yet supported for insertion into a RucksDB table");
+    }
+    if (op.action_type != OnConflictAction::THROW) {
+        throw BinderException("ON CONFLICT clause not yet supported for insertion into a RucksDB table");
+    }
+
+    auto insert = make_unique<RucksDBInsert>(op, op.table, op.column_index_map, std::move(op.bound_defaults));
+    // Row ids follow append order, so threads may only append side by side when order does not matter.
+    // Vector index inserts put the neighbors they re-link and the entry point into the appender's
+    // batch; batches of several appenders commit in any order, so an older copy could win.
+    auto& storage = ((RucksDBTableEntry&)op.table).GetStorage();
+    insert->parallel = !PhysicalPlanGenerator::PreserveInsertionOrder(context, *plan) && !storage.HasVectorIndexes();
+    insert->children.push_back(std::move(plan));
+    return std::move(insert);
+}
+
+unique_ptr<PhysicalOperator> RucksDBCatalog::PlanDelete(ClientContext& context, LogicalDelete& op,
+                                                        unique_ptr<PhysicalOperator> plan) {
+    if (op.return_chunk) {
+        throw BinderException("RETURNING clause not yet supported for deletion from a RucksDB table");
+    }
+
+    auto& row_id_ref = op.expressions[0]->Cast<BoundReferenceExpression>();
+    auto del = make_unique<RucksDBDelete>(op, op.table, row_id_ref.index);
+    del->children.push_back(std::move(plan));
+    return std::move(del);
+}
+
+unique_ptr<PhysicalOperator> RucksDBCatalog::PlanUpdate(ClientContext& context, LogicalUpdate& op,
+                                                        unique_ptr<PhysicalOperator> plan) {
+    if (op.return_chunk) {
+        throw BinderException("RETURNING clause not yet supported for updates of a RucksDB table");
+    }
+    for (auto& expr : op.expressions) {
+        if (expr->type == ExpressionType::VALUE_DEFAULT) {
+            throw BinderException("SET DEFAULT is not supported for RucksDB tables");
+        }
+    }
+
+    vector<column_t> column_ids;
+    for (auto& col : op.columns) {
+        column_ids.push_back(col.index);
+    }
+
+    auto update = make_unique<RucksDBUpdate>(op, op.table, std::move(column_ids), std::move(op.expressions));
+    update->children.push_back(std::move(plan));
+    return std::move(update);
+}
+
+unique_ptr<LogicalOperator> RucksDBCatalog::BindCreateIndex(Binder& binder, CreateStatement& stmt,
+                                                            TableCatalogEntry& table,
+                                                            unique_ptr<LogicalOperator> plan) {
+    throw BinderException("RucksDB databases do not support creating indexes");
+}
+
+DatabaseSize RucksDBCatalog::GetDatabaseSize(ClientContext& context) {
+    DatabaseSize size;
+    uint64_t sst_size = 0;
+    storage_->GetDB()->GetIntProperty("rocksdb.total-sst-files-size", &sst_size);
+    size.bytes = sst_size;
+    return size;
+}
+
+// Transaction manager implementation
+RucksDBTransactionManager::RucksDBTransactionManager(AttachedDatabase& db, RucksDBCatalog& catalog)
+    : TransactionManager(db), catalog_(catalog) {
+}
+
+Transaction& RucksDBTransactionManager::StartTransaction(ClientContext& context) {
+    auto transaction = make_unique<RucksDBTransaction>(*this, context);
+    auto& result = *transaction;
+
+    std::lock_guard<std::mutex> guard(transaction_lock_);
+    transactions_[result] = std::move(transaction);
+    return result;
+}
+
+ErrorData RucksDBTransactionManager::CommitTransaction(ClientContext& context, Transaction& transaction) {
+    std::lock_guard<std::mutex> guard(transaction_lock_);
+    transactions_.erase(transaction);
+    return ErrorData();
+}
+
+void RucksDBTransactionManager::RollbackTransaction(Transaction& transaction) {
+    std::lock_guard<std::mutex> guard(transaction_lock_);
+    transactions_.erase(transaction);
+}
+
+void RucksDBTransactionManager::Checkpoint(ClientContext& context, bool force) {
+    catalog_.GetStorage().Flush();
+}
+
+// Storage extension implementation
+static unique_ptr<Catalog> RucksDBAttach(StorageExtensionInfo* storage_info, ClientContext& context,
+                                         AttachedDatabase& db, const string& name, AttachInfo& info,
+                                         AccessMode access_mode) {
+    string options;
+    auto entry = info.options.find("options");
+    if (entry != info.options.end()) {
+        options = entry->second.ToString();
+    }
+    return make_unique<RucksDBCatalog>(db, info.path, access_mode, options);
+}
+
+static unique_ptr<TransactionManager> RucksDBCreateTransactionManager(StorageExtensionInfo* storage_info,
+                                                                      AttachedDatabase& db, Catalog& catalog) {
+    return make_unique<RucksDBTransactionManager>(db, (RucksDBCatalog&)catalog);
+}
+
+RucksDBStorageExtension::RucksDBStorageExtension() {
+    attach = RucksDBAttach;
+    create_transaction_manager = RucksDBCreateTransactionManager;
+}
+
+} // namespace duckdb
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include "../include/RucksDBChangeFunctions.hpp"
+#include "../include/RucksDBChangeStream.hpp"
+#include "../include/RucksDBExtension.hpp"
+#include "../include/RucksDBInstance.hpp"
+#include "duckdb/main/extension_util.hpp"
+
+namespace duckdb {
+
+struct RucksDBChangesBindData : public TableFunctionData {
+    string table_name;
+    uint64_t since_sequence = 0;
+    idx_t column_count = 0;
+    RocksDBStorage* storage = nullptr;
+};
+
+struct RucksDBChangesState : public GlobalTableFunctionState {
+    unique_ptr<RucksDBChangeStream> stream;
+    // Changes committed after the scan started are left for the next call
+    uint64_t until_sequence = 0;
+    vector<RucksDBRowChange> changes;
+    idx_t offset = 0;
+};
+
+static unique_ptr<FunctionData> ChangesBind(ClientContext& context, TableFunctionBindInput& input,
+                                            vector<LogicalType>& return_types, vector<string>& names) {
+    auto table_name = input.inputs[0].GetValue<string>();
+    auto since_sequence = input.inputs[1].GetValue<int64_t>();
+    if (since_sequence < 0) {
+        throw std::runtime_error("Change sequence must not be negative");
+    }
+
+    auto instance = RucksDBInstanceRegistry::Get(input);
+    if (!instance.registry->TableExists(table_name)) {
+        throw std::runtime_error("RocksDB table '" + table_name + "' does not exist");
+    }
+
+    names = {"sequence", "change", "row_id"};
+    return_types = {LogicalType::UBIGINT, LogicalType::VARCHAR, LogicalType::BIGINT};
+    auto& columns = instance.registry->GetTable(table_name)->GetColumns();
+    for (const auto& col : columns) {
+        names.push_back(col.Name());
+        return_types.push_back(col.Type());
+    }
+
+    auto bind_data = make_unique<RucksDBChangesBindData>();
+    bind_data->table_name = table_name;
+    bind_data->since_sequence = (uint64_t)since_sequence;
+    bind_data->column_count = columns.size();
+    bind_data->storage = instance.storage;
+    return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> ChangesInit(ClientContext& context, TableFunctionInitInput& input) {
+    auto& bind_data = (RucksDBChangesBindData&)*input.bind_data;
+
+    auto state = make_unique<RucksDBChangesState>();
+    state->until_sequence = bind_data.storage->GetLatestSequence();
+    state->stream = make_unique<RucksDBChangeStream>(bind_data.storage, bind_data.table_name,
+                                                     bind_data.since_sequence);
+    return std::move(state);
+}
+
+static void ChangesExecute(ClientContext& context, TableFunctionInput& data, DataChunk& output) {
+    auto& bind_data = (RucksDBChangesBindData&)*data.bind_data;
+    auto& state = (RucksDBChangesState&)*data.global_state;
+
+    idx_t count = 0;
+    while (count < STANDARD_VECTOR_SIZE) {
+        if (state.offset == state.changes.size()) {
+            state.changes.clear();
+            state.offset = 0;
+            if (state.stream->Read(state.changes, STANDARD_VECTOR_SIZE, state.until_sequence) == 0) {
+                break;
+            }
+        }
+
+        auto& change = state.changes[state.offset++];
+        output.SetValue(0, count, Value::UBIGINT(change.sequence));
+        output.SetValue(1, count, Value(RucksDBChangeTypeName(change.type)));
+        output.SetValue(2, count, Value::BIGINT((int64_t)change.row_id));
+        for (idx_t col_idx = 0; col_idx < bind_data.column_count; col_idx++) {
+            output.SetValue(3 + col_idx, count,
+                            col_idx < change.values.size() ? change.values[col_idx] : Value());
+        }
+        count++;
+    }
+    output.SetCardinality(count);
+}
+
+TableFunction RucksDBChangeFunctions::GetChangesFunction() {
+    TableFunction function("rucksdb_changes", {LogicalType::VARCHAR, LogicalType::BIGINT}, ChangesExecute,
+                           ChangesBind, ChangesInit);
+    function.named_parameters["database"] = LogicalType::VARCHAR;
+    return function;
+}
+
+void RucksDBChangeFunctions::RegisterFunctions(DatabaseInstance& db) {
+    ExtensionUtil::RegisterFunction(db, GetChangesFunction());
+}
+
+} // namespace duckdb
@@ -0,0 +1,221 @@
+#include "../include/RucksDBChangeStream.hpp"
+#include "../include/RucksDBExtension.hpp"
+#include "../include/RucksDBTrace.hpp"
+#include <map>
+
+namespace duckdb {
+
+const char* RucksDBChangeTypeName(RucksDBChangeType type) {
+    return type == RucksDBChangeType::UPSERT ? "upsert" : "delete";
+}
+
+// Turns the records of one WAL batch into row changes of a single table. Every record
+// consumes one sequence number, whether or not it belongs to the table.
+class RucksDBChangeDecoder : public rocksdb::WriteBatch::Handler {
+private:
+    const string& table_name_;
+    uint64_t sequence_;
+    uint64_t since_sequence_;
+    uint64_t until_sequence_;
+    vector<RucksDBRowChange>& changes_;
+    // Out-of-line values seen in this batch, which always precede their row
+    std::map<std::pair<idx_t, idx_t>, string> large_values_;
+
+    void AddChange(const rocksdb::Slice& key, RucksDBChangeType type, const rocksdb::Slice* value) {
+        uint64_t sequence = sequence_++;
+        idx_t row_id, col_idx;
+        string row_key = key.ToString();
+        if (!RucksDBColumnarStorage::ParseRowKey(table_name_, row_key, row_id)) {
+            if (value && RucksDBColumnarStorage::ParseColumnKey(table_name_, row_key, row_id, col_idx)) {
+                large_values_[{row_id, col_idx}] = RucksDBColumnarStorage::DecodeLargeValue(value->ToString());
+            }
+            return;
+        }
+        if (sequence < since_sequence_ || sequence > until_sequence_) {
+            return;
+        }
+
+        RucksDBRowChange change;
+        change.sequence = sequence;
+        change.type = type;
+        change.row_id = row_id;
+        if (value) {
+            vector<idx_t> large_columns;
+            RucksDBColumnarStorage::DecodeRow(value->ToString(), change.values, &large_columns);
+            for (auto column : large_columns) {
+                auto it = large_values_.find({row_id, column});
+                if (it != large_values_.end()) {
+                    change.values[column] = Value(it->second);
+                }
+            }
+        }
+        changes_.push_back(std::move(change));
+        added++;
+    }
+
+public:
+    idx_t added = 0;
+
+    RucksDBChangeDecoder(const string& table_name, uint64_t batch_sequence, uint64_t since_sequence,
+                         uint64_t until_sequence, vector<RucksDBRowChange>& changes)
+        : table_name_(table_name), sequence_(batch_sequence), since_sequence_(since_sequence),
+          until_sequence_(until_sequence), changes_(changes) {
+    }
+
+    rocksdb::Status PutCF(uint32_t, const rocksdb::Slice& key, const rocksdb::Slice& value) override {
+        AddChange(key, RucksDBChangeType::UPSERT, &value);
+        return rocksdb::Status::OK();
+    }
+    rocksdb::Status DeleteCF(uint32_t, const rocksdb::Slice& key) override {
+        AddChange(key, RucksDBChangeType::DELETE, nullptr);
+        return rocksdb::Status::OK();
+    }
+    rocksdb::Status SingleDeleteCF(uint32_t, const rocksdb::Slice& key) override {
+        AddChange(key, RucksDBChangeType::DELETE, nullptr);
+        return rocksdb::Status::OK();
+    }
+    // Row data is never written with these, but they still consume sequence numbers
+    rocksdb::Status DeleteRangeCF(uint32_t, const rocksdb::Slice&, const rocksdb::Slice&) override {
+        sequence_++;
+        return rocksdb::Status::OK();
+    }
+    rocksdb::Status MergeCF(uint32_t, const rocksdb::Slice&, const rocksdb::Slice&) override {
+        sequence_++;
+        return rocksdb::Status::OK();
+    }
+};
+
+RucksDBChangeStream::RucksDBChangeStream(RocksDBStorage* storage, const string& table_name, uint64_t since_sequence)
+    : storage_(storage), table_name_(table_name), next_sequence_(since_sequence) {
+    // Each shard has its own sequence numbers, so one resume point cannot describe them all
+    if (storage_->GetShards().size() > 1) {
+        throw std::runtime_error("Change capture is not supported on sharded RucksDB instances");
+    }
+}
+
+idx_t RucksDBChangeStream::Read(vector<RucksDBRowChange>& changes, idx_t max_changes, uint64_t until_sequence) {
+    RucksDBTraceScope trace("ReadChanges", "cdc");
+    idx_t added = 0;
+
+    while (added < max_changes && next_sequence_ <= until_sequence) {
+        if (!iterator_ || !iterator_->Valid()) {
+            // A drained iterator does not see later writes, so reopen from the resume point
+            if (next_sequence_ > storage_->GetLatestSequence()) {
+                iterator_.reset();
+                break;
+            }
+            iterator_ = storage_->GetUpdatesSince(next_sequence_);
+            if (!iterator_->Valid()) {
+                iterator_.reset();
+                break;
+            }
+        }
+
+        auto batch = iterator_->GetBatch();
+        if (batch.sequence > std::max<uint64_t>(next_sequence_, 1)) {
+            throw std::runtime_error("WAL no longer contains sequence " + std::to_string(next_sequence_) +
+                                     " (oldest is " + std::to_string(batch.sequence) +
+                                     "); rescan the table or raise wal_ttl_seconds");
+        }
+        if (batch.sequence > until_sequence) {
+            break;
+        }
+
+        RucksDBChangeDecoder decoder(table_name_, batch.sequence, next_sequence_, until_sequence, changes);
+        auto status = batch.writeBatchPtr->Iterate(&decoder);
+        if (!status.ok()) {
+            throw std::runtime_error("Failed to decode WAL batch: " + status.ToString());
+        }
+        added += decoder.added;
+
+        uint64_t batch_end = batch.sequence + batch.writeBatchPtr->Count();
+        if (batch_end > until_sequence + 1) {
+            // Rest of this batch is past the bound; the next Read picks it up from here
+            next_sequence_ = until_sequence + 1;
+            break;
+        }
+        next_sequence_ = std::max(next_sequence_, batch_end);
+        iterator_->Next();
+    }
+
+    trace.arg = added;
+    return added;
+}
+
+RucksDBChangeSubscription::RucksDBChangeSubscription(RocksDBStorage* storage, const string& table_name,
+                                                     uint64_t since_sequence, Callback callback,
+                                                     size_t poll_interval_ms)
+    : storage_(storage), table_name_(table_name), stream_(storage, table_name, since_sequence),
+      callback_(std::move(callback)), poll_interval_ms_(poll_interval_ms), next_sequence_(since_sequence) {
+}
+
+RucksDBChangeSubscription::~RucksDBChangeSubscription() {
+    Stop();
+}
+
+idx_t RucksDBChangeSubscription::Poll() {
+    std::lock_guard<std::mutex> guard(poll_lock_);
+    vector<RucksDBRowChange> changes;
+    idx_t delivered = 0;
+
+    while (stream_.Read(changes, STANDARD_VECTOR_SIZE) > 0) {
+        try {
+            callback_(changes);
+        } catch (...) {
+            // Rewind so the same changes are delivered again
+            stream_ = RucksDBChangeStream(storage_, table_name_, next_sequence_.load());
+            throw;
+        }
+        delivered += changes.size();
+        changes.clear();
+        next_sequence_ = stream_.GetNextSequence();
+    }
+    // Batches without changes to this table still move the resume point
+    next_sequence_ = stream_.GetNextSequence();
+    return delivered;
+}
+
+void RucksDBChangeSubscription::Start() {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (thread_.joinable()) {
+        return;
+    }
+    stop_ = false;
+    thread_ = std::thread([this]() { PollLoop(); });
+}
+
+void RucksDBChangeSubscription::Stop() {
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+string RucksDBChangeSubscription::GetLastError() {
+    std::lock_guard<std::mutex> guard(lock_);
+    return last_error_;
+}
+
+void RucksDBChangeSubscription::PollLoop() {
+    auto interval = std::chrono::milliseconds(poll_interval_ms_);
+    std::unique_lock<std::mutex> lock(lock_);
+    while (!stop_) {
+        lock.unlock();
+        try {
+            Poll();
+        } catch (std::exception& e) {
+            failures_++;
+            lock.lock();
+            last_error_ = e.what();
+            lock.unlock();
+        }
+        lock.lock();
+        cv_.wait_for(lock, interval, [this]() { return stop_; });
+    }
+}
+
+} // namespace duckdb
@@ -0,0 +1,235 @@
+#include "../include/RucksDBCluster.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/date.hpp"
+#include "duckdb/common/types/timestamp.hpp"
+#include <cstring>
+
+namespace duckdb {
+
+static constexpr char CLUSTER_ENTRY_PREFIX[] = "cluster_";
+static constexpr uint64_t SIGN_BIT = 1ULL << 63;
+
+// FLOAT is left out: rows written by the old codec store it rounded to six decimals, so a key
+// re-encoded from such a row would not find the entry written for the inserted value
+static bool IsClusterKeyType(const LogicalType& type) {
+    switch (type.id()) {
+    case LogicalTypeId::BOOLEAN:
+    case LogicalTypeId::TINYINT:
+    case LogicalTypeId::SMALLINT:
+    case LogicalTypeId::INTEGER:
+    case LogicalTypeId::BIGINT:
+    case LogicalTypeId::UTINYINT:
+    case LogicalTypeId::USMALLINT:
+    case LogicalTypeId::UINTEGER:
+    case LogicalTypeId::UBIGINT:
+    case LogicalTypeId::DOUBLE:
+    case LogicalTypeId::DATE:
+    case LogicalTypeId::TIMESTAMP:
+    case LogicalTypeId::VARCHAR:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static void AppendBigEndian(string& out, uint64_t value) {
+    for (int shift = 56; shift >= 0; shift -= 8) {
+        out += (char)((value >> shift) & 0xFF);
+    }
+}
+
+void RucksDBClusterBounds::AddEqual(idx_t key, const string& encoded) {
+    if (equal[key].empty()) {
+        equal[key] = encoded;
+    }
+}
+
+void RucksDBClusterBounds::AddLower(idx_t key, const string& encoded) {
+    if (lower[key].empty() || encoded > lower[key]) {
+        lower[key] = encoded;
+    }
+}
+
+void RucksDBClusterBounds::AddUpper(idx_t key, const string& encoded) {
+    if (upper[key].empty() || encoded < upper[key]) {
+        upper[key] = encoded;
+    }
+}
+
+void RucksDBClusterDefinition::Bind(const vector<ColumnDefinition>& columns) {
+    if (key_columns.empty()) {
+        throw std::runtime_error("Clustering key must name at least one column");
+    }
+    key_indexes.clear();
+    key_types.clear();
+    for (auto& key_column : key_columns) {
+        idx_t i = 0;
+        while (i < columns.size() && !StringUtil::CIEquals(columns[i].Name(), key_column)) {
+            i++;
+        }
+        if (i == columns.size()) {
+            throw std::runtime_error("Column '" + key_column + "' does not exist");
+        }
+        if (!IsClusterKeyType(columns[i].Type())) {
+            throw std::runtime_error("Column '" + key_column + "' of type " + columns[i].Type().ToString() +
+                                     " cannot be part of a clustering key");
+        }
+        key_indexes.push_back(i);
+        key_types.push_back(columns[i].Type());
+    }
+}
+
+string RucksDBClusterDefinition::Serialize() const {
+    return StringUtil::Join(key_columns, ",");
+}
+
+RucksDBClusterDefinition RucksDBClusterDefinition::Deserialize(const string& data) {
+    RucksDBClusterDefinition cluster;
+    for (auto& column : StringUtil::Split(data, ',')) {
+        StringUtil::Trim(column);
+        if (!column.empty()) {
+            cluster.key_columns.push_back(column);
+        }
+    }
+    return cluster;
+}
+
+string RucksDBClusterDefinition::EncodeKey(const vector<Value>& row) const {
+    string key;
+    for (idx_t k = 0; k < key_indexes.size(); k++) {
+        EncodeValue(key_indexes[k] < row.size() ? row[key_indexes[k]] : Value(), key_types[k], key);
+    }
+    return key;
+}
+
+string RucksDBClusterDefinition::EncodeKey(DataChunk& chunk, idx_t row) const {
+    string key;
+    for (idx_t k = 0; k < key_indexes.size(); k++) {
+        EncodeValue(chunk.GetValue(key_indexes[k], row), key_types[k], key);
+    }
+    return key;
+}
+
+void RucksDBClusterDefinition::EncodeValue(const Value& value, const LogicalType& type, string& out) {
+    if (value.IsNull()) {
+        out += '\x00';
+        return;
+    }
+    out += '\x01';
+    // Stored rows decode most types as VARCHAR, which casts back to the key type losslessly
+    Value typed = value.type() == type ? value : value.DefaultCastAs(type);
+    switch (type.id()) {
+    case LogicalTypeId::BOOLEAN:
+        out += typed.GetValue<bool>() ? '\x01' : '\x00';
+        break;
+    case LogicalTypeId::TINYINT:
+    case LogicalTypeId::SMALLINT:
+    case LogicalTypeId::INTEGER:
+    case LogicalTypeId::BIGINT:
+        AppendBigEndian(out, (uint64_t)typed.GetValue<int64_t>() ^ SIGN_BIT);
+        break;
+    case LogicalTypeId::UTINYINT:
+    case LogicalTypeId::USMALLINT:
+    case LogicalTypeId::UINTEGER:
+    case LogicalTypeId::UBIGINT:
+        AppendBigEndian(out, typed.GetValue<uint64_t>());
+        break;
+    case LogicalTypeId::DATE:
+        AppendBigEndian(out, (uint64_t)(int64_t)typed.GetValue<date_t>().days ^ SIGN_BIT);
+        break;
+    case LogicalTypeId::TIMESTAMP:
+        AppendBigEndian(out, (uint64_t)typed.GetValue<timestamp_t>().value ^ SIGN_BIT);
+        break;
+    case LogicalTypeId::DOUBLE: {
+        double number = typed.GetValue<double>();
+        if (number == 0) {
+            // -0.0 equals 0.0
+            number = 0;
+        }
+        uint64_t bits;
+        memcpy(&bits, &number, sizeof(bits));
+        AppendBigEndian(out, (bits & SIGN_BIT) ? ~bits : bits ^ SIGN_BIT);
+        break;
+    }
+    case LogicalTypeId::VARCHAR: {
+        auto text = typed.GetValue<string>();
+        for (char c : text) {
+            out += c;
+            if (c == '\x00') {
+                out += '\xff';
+            }
+        }
+        out += '\x00';
+        out += '\x01';
+        break;
+    }
+    default:
+        throw std::runtime_error("Type " + type.ToString() + " cannot be part of a clustering key");
+    }
+}
+
+string RucksDBClusterDefinition::GetPrefix(const string& table_name) {
+    // The name is encoded like a VARCHAR key, terminated, so no table's prefix starts another's
+    // (with a plain separator, table "a" would cover the entries of table "a:b")
+    string prefix = CLUSTER_ENTRY_PREFIX;
+    EncodeValue(Value(table_name), LogicalType::VARCHAR, prefix);
+    return prefix;
+}
+
+string RucksDBClusterDefinition::GetEntryKey(const string& table_name, const string& key, idx_t row_id) {
+    // The row id makes rows with equal keys distinct and keeps them in insertion order
+    string entry_key = GetPrefix(table_name) + key;
+    AppendBigEndian(entry_key, row_id);
+    return entry_key;
+}
+
+idx_t RucksDBClusterDefinition::ParseRowId(const string& entry_key) {
+    if (entry_key.size() < sizeof(uint64_t)) {
+        throw std::runtime_error("Corrupt RucksDB cluster entry");
+    }
+    uint64_t row_id = 0;
+    for (idx_t i = entry_key.size() - sizeof(uint64_t); i < entry_key.size(); i++) {
+        row_id = (row_id << 8) | (uint8_t)entry_key[i];
+    }
+    return row_id;
+}
+
+// Smallest string greater than every string starting with prefix
+static string PrefixSuccessor(string prefix) {
+    while (!prefix.empty() && (uint8_t)prefix.back() == 0xFF) {
+        prefix.pop_back();
+    }
+    if (!prefix.empty()) {
+        prefix.back() = (char)((uint8_t)prefix.back() + 1);
+    }
+    return prefix;
+}
+
+bool RucksDBClusterDefinition::GetRange(const string& table_name, const RucksDBClusterBounds& bounds,
+                                        RucksDBClusterRange& range) const {
+    // Equalities on leading key columns fix a key prefix; the column after them may add a range
+    string prefix = GetPrefix(table_name);
+    idx_t k = 0;
+    while (k < key_indexes.size() && !bounds.equal[k].empty()) {
+        prefix += bounds.equal[k];
+        k++;
+    }
+    bool has_range = k < key_indexes.size() && (!bounds.lower[k].empty() || !bounds.upper[k].empty());
+    if (k == 0 && !has_range) {
+        return false;
+    }
+
+    range.key_columns = Serialize();
+    range.lower = prefix;
+    range.upper = PrefixSuccessor(prefix);
+    if (has_range) {
+        // A comparison never matches NULL, which encodes as 0x00
+        range.lower = prefix + (bounds.lower[k].empty() ? string(1, '\x01') : bounds.lower[k]);
+        if (!bounds.upper[k].empty()) {
+            range.upper = PrefixSuccessor(prefix + bounds.upper[k]);
+        }
+    }
+    return true;
+}
+
+} // namespace duckdb
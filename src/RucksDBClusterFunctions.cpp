@@ -0,0 +1,86 @@
+#include "../include/RucksDBClusterFunctions.hpp"
+#include "../include/RucksDBStatsFunctions.hpp"
+#include "../include/RucksDBExtension.hpp"
+#include "../include/RucksDBInstance.hpp"
+#include "duckdb/main/extension_util.hpp"
+
+namespace duckdb {
+
+struct RucksDBClusterBindData : public TableFunctionData {
+    string table_name;
+    RucksDBClusterDefinition cluster;
+    RucksDBInstance instance;
+};
+
+// rucksdb_set_clustering('table', 'key_column, ...')
+static unique_ptr<FunctionData> SetClusteringBind(ClientContext& context, TableFunctionBindInput& input,
+                                                  vector<LogicalType>& return_types, vector<string>& names) {
+    names = {"table", "rows"};
+    return_types = {LogicalType::VARCHAR, LogicalType::UBIGINT};
+
+    auto bind_data = make_unique<RucksDBClusterBindData>();
+    bind_data->table_name = input.inputs[0].GetValue<string>();
+    bind_data->cluster = RucksDBClusterDefinition::Deserialize(input.inputs[1].GetValue<string>());
+    bind_data->instance = RucksDBInstanceRegistry::Get(input);
+    return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> SetClusteringInit(ClientContext& context, TableFunctionInitInput& input) {
+    auto& bind_data = (RucksDBClusterBindData&)*input.bind_data;
+    auto& registry = *bind_data.instance.registry;
+
+    // Rows copied in key order; none when clearing
+    idx_t rows = 0;
+    if (bind_data.cluster.key_columns.empty()) {
+        registry.ClearTableClustering(bind_data.table_name);
+    } else {
+        rows = registry.SetTableClustering(bind_data.table_name, bind_data.cluster);
+    }
+
+    auto state = make_unique<RucksDBStatsState>();
+    state->rows.push_back({Value(bind_data.table_name), Value::UBIGINT(rows)});
+    return std::move(state);
+}
+
+// rucksdb_recluster('table')
+static unique_ptr<FunctionData> ReclusterBind(ClientContext& context, TableFunctionBindInput& input,
+                                              vector<LogicalType>& return_types, vector<string>& names) {
+    names = {"table", "rows"};
+    return_types = {LogicalType::VARCHAR, LogicalType::UBIGINT};
+
+    auto bind_data = make_unique<RucksDBClusterBindData>();
+    bind_data->table_name = input.inputs[0].GetValue<string>();
+    bind_data->instance = RucksDBInstanceRegistry::Get(input);
+    return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> ReclusterInit(ClientContext& context, TableFunctionInitInput& input) {
+    auto& bind_data = (RucksDBClusterBindData&)*input.bind_data;
+
+    idx_t rows = bind_data.instance.registry->ReclusterTable(bind_data.table_name);
+
+    auto state = make_unique<RucksDBStatsState>();
+    state->rows.push_back({Value(bind_data.table_name), Value::UBIGINT(rows)});
+    return std::move(state);
+}
+
+TableFunction RucksDBClusterFunctions::GetSetClusteringFunction() {
+    TableFunction function("rucksdb_set_clustering", {LogicalType::VARCHAR, LogicalType::VARCHAR},
+                           RucksDBStatsFunctions::ExecuteRows, SetClusteringBind, SetClusteringInit);
+    function.named_parameters["database"] = LogicalType::VARCHAR;
+    return function;
+}
+
+TableFunction RucksDBClusterFunctions::GetReclusterFunction() {
+    TableFunction function("rucksdb_recluster", {LogicalType::VARCHAR}, RucksDBStatsFunctions::ExecuteRows,
+                           ReclusterBind, ReclusterInit);
+    function.named_parameters["database"] = LogicalType::VARCHAR;
+    return function;
+}
+
+void RucksDBClusterFunctions::RegisterFunctions(DatabaseInstance& db) {
+    ExtensionUtil::RegisterFunction(db, GetSetClusteringFunction());
+    ExtensionUtil::RegisterFunction(db, GetReclusterFunction());
+}
+
+} // namespace duckdb
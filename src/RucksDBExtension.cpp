@@ -1,16 +1,153 @@
 #include "../include/RucksDBExtension.hpp"
+#include "../include/RucksDBOptimizer.hpp"
+#include "../include/RucksDBCatalog.hpp"
+#include "../include/RucksDBStatsFunctions.hpp"
+#include "../include/RucksDBBackupFunctions.hpp"
+#include "../include/RucksDBChangeFunctions.hpp"
+#include "../include/RucksDBRollupFunctions.hpp"
+#include "../include/RucksDBTTLFunctions.hpp"
+#include "../include/RucksDBLookupFunctions.hpp"
+#include "../include/RucksDBTextFunctions.hpp"
+#include "../include/RucksDBTieredFunctions.hpp"
+#include "../include/RucksDBClusterFunctions.hpp"
+#include "../include/RucksDBVectorFunctions.hpp"
+#include "../include/RucksDBInstance.hpp"
+#include "../include/RucksDBTrace.hpp"
+#include "../include/RucksDBMemoryBudget.hpp"
+#include "../include/RucksDBMergeOperator.hpp"
 #include "duckdb/parser/parsed_data/create_table_function_info.hpp"
 #include "duckdb/function/scalar_function.hpp"
 #include "duckdb/main/extension_util.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/parser/parser.hpp"
 #include "duckdb/common/exception.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/serializer/binary_deserializer.hpp"
+#include "duckdb/common/serializer/binary_serializer.hpp"
+#include "duckdb/common/serializer/memory_stream.hpp"
+#include <algorithm>
 #include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <future>
+#include <numeric>
+#include <set>
 #include <sstream>
+#include <unordered_set>
 
 namespace duckdb {
 
 // Global registry instance
 unique_ptr<RucksDBTableRegistry> g_table_registry;
 
+// Encoded rows an appending thread collects before committing them
+static constexpr idx_t APPEND_COMMIT_BYTES = 16ULL << 20;
+
+// How often the mover looks for hot tiers with a full row group
+static constexpr uint64_t TIER_MOVE_INTERVAL_MS = 100;
+
+idx_t RucksDBTableRegistry::SetTableTTL(const string& table_name, RucksDBTableTTL ttl) {
+    auto* table = GetTable(table_name);
+    if (!table) {
+        throw std::runtime_error("RocksDB table '" + table_name + "' does not exist");
+    }
+    
+    if (table->GetCluster()) {
+        throw std::runtime_error("RocksDB table '" + table_name + "' is clustered; clustered tables have no TTL");
+    }
+    
+    idx_t partitions;
+    {
+        std::lock_guard<std::mutex> guard(tables_lock_);
+        ttl.Bind(table->GetColumns());
+        // Partitions of an earlier TTL may have a different width
+        schema_->DropTableTTL(table_name);
+        schema_->StoreTableTTL(table_name, ttl);
+        partitions = table->SetTTL(ttl);
+    }
+    InstallExpiryCheck();
+    return partitions;
+}
+
+void RucksDBTableRegistry::ClearTableTTL(const string& table_name) {
+    auto* table = GetTable(table_name);
+    if (!table) {
+        throw std::runtime_error("RocksDB table '" + table_name + "' does not exist");
+    }
+    
+    {
+        std::lock_guard<std::mutex> guard(tables_lock_);
+        schema_->DropTableTTL(table_name);
+        table->ClearTTL();
+    }
+    InstallExpiryCheck();
+}
+
+idx_t RucksDBTableRegistry::ExpireTable(const string& table_name, idx_t& partitions) {
+    auto* table = GetTable(table_name);
+    if (!table) {
+        throw std::runtime_error("RocksDB table '" + table_name + "' does not exist");
+    }
+    if (!table->GetTTL()) {
+        throw std::runtime_error("RocksDB table '" + table_name + "' has no TTL");
+    }
+    
+    idx_t rows = table->DropExpiredPartitions(partitions);
+    // Row keys are not ordered by row id, so expired rows are dropped by the compaction filter
+    // rather than by a range delete
+    if (partitions > 0) {
+        storage_->CompactTableData(table_name);
+    }
+    return rows;
+}
+
+void RucksDBTableRegistry::InstallExpiryCheck() {
+    auto ttls = std::make_shared<std::unordered_map<string, RucksDBTableTTL>>(schema_->LoadTableTTLs());
+    for (auto it = ttls->begin(); it != ttls->end();) {
+        if (!schema_->TableExists(it->first)) {
+            it = ttls->erase(it);
+            continue;
+        }
+        it->second.Bind(schema_->GetTableSchema(it->first));
+        it++;
+    }
+    if (ttls->empty()) {
+        rocksdb_->SetExpiryCheck(nullptr);
+        return;
+    }
+    
+    rocksdb_->SetExpiryCheck([ttls](const rocksdb::Slice& key, const rocksdb::Slice& value) {
+        static const string DATA_PREFIX = "data_";
+        if (!key.starts_with(DATA_PREFIX)) {
+            return false;
+        }
+        string row_key = key.ToString();
+        auto row_pos = row_key.rfind("_row_");
+        if (row_pos == string::npos || row_pos < DATA_PREFIX.size()) {
+            return false;
+        }
+        auto it = ttls->find(row_key.substr(DATA_PREFIX.size(), row_pos - DATA_PREFIX.size()));
+        if (it == ttls->end()) {
+            return false;
+        }
+        // Compactions run on background threads, so a row that fails to decode is kept
+        try {
+            idx_t row_id, col_idx;
+            if (RucksDBColumnarStorage::ParseColumnKey(it->first, row_key, row_id, col_idx)) {
+                // Out-of-line values carry their row's partition; ones written before the TTL do not
+                int64_t partition;
+                return RucksDBColumnarStorage::GetLargeValuePartition(value, partition) &&
+                       it->second.IsExpired(partition, RucksDBTableTTL::Now());
+            }
+            vector<Value> values;
+            RucksDBColumnarStorage::DecodeRow(value.ToString(), values);
+            return it->second.IsExpiredRow(values, RucksDBTableTTL::Now());
+        } catch (std::exception&) {
+            return false;
+        }
+    });
+}
+
 // Helper functions for SQL interface
 static void CreateRocksDBTableFunction(DataChunk& args, ExpressionState& state, Vector& result);
 static void DropRocksDBTableFunction(DataChunk& args, ExpressionState& state, Vector& result);
@@ -21,9 +158,23 @@ void RucksDBExtension::Load(DuckDB &db) {
     if (!g_table_registry && g_rocksdb_storage) {
         g_table_registry = make_unique<RucksDBTableRegistry>(g_rocksdb_storage.get());
     }
+    // A memory_budget given to rucksdb_init is shared with this database
+    if (g_rocksdb_storage && g_rocksdb_storage->GetMemoryBudget()) {
+        g_rocksdb_storage->GetMemoryBudget()->AttachDuckDB(db.instance);
+    }
     
     // Register table functions
     RocksDBTableFunction::RegisterFunction(*db.instance);
+    RucksDBStatsFunctions::RegisterFunctions(*db.instance);
+    RucksDBBackupFunctions::RegisterFunctions(*db.instance);
+    RucksDBChangeFunctions::RegisterFunctions(*db.instance);
+    RucksDBRollupFunctions::RegisterFunctions(*db.instance);
+    RucksDBTTLFunctions::RegisterFunctions(*db.instance);
+    RucksDBVectorFunctions::RegisterFunctions(*db.instance);
+    RucksDBTextFunctions::RegisterFunctions(*db.instance);
+    RucksDBLookupFunctions::RegisterFunctions(*db.instance);
+    RucksDBTieredFunctions::RegisterFunctions(*db.instance);
+    RucksDBClusterFunctions::RegisterFunctions(*db.instance);
     
     // Register custom scalar functions
     ScalarFunction create_rocksdb_table("create_rocksdb_table", 
@@ -37,50 +188,207 @@ void RucksDBExtension::Load(DuckDB &db) {
                                      LogicalType::BOOLEAN,
                                      DropRocksDBTableFunction);
     ExtensionUtil::RegisterFunction(*db.instance, drop_rocksdb_table);
+    
+    // Answer COUNT/MIN/MAX from metadata where possible
+    auto& config = DBConfig::GetConfig(*db.instance);
+    config.optimizer_extensions.push_back(RucksDBAggregatePushdown());
+    // Read only the key range that filters on a clustered table's key allow
+    config.optimizer_extensions.push_back(RucksDBClusterPushdown());
+    
+    // ATTACH 'path' AS name (TYPE rucksdb)
+    config.storage_extensions["rucksdb"] = make_unique<RucksDBStorageExtension>();
 }
 
 // Schema implementation
-void RucksDBSchema::CreateTable(const string& table_name, const vector<ColumnDefinition>& columns) {
-    // Simple serialization without DuckDB's serializer classes
-    string schema_data = std::to_string(columns.size()) + "|";
-    
+static vector<ColumnDefinition> CopyColumns(const vector<ColumnDefinition>& columns) {
+    vector<ColumnDefinition> result;
+    result.reserve(columns.size());
     for (const auto& col : columns) {
-        schema_data += col.Name() + ":" + col.Type().ToString() + "|";
+        result.push_back(col.Copy());
+    }
+    return result;
+}
+
+RucksDBSchema::RucksDBSchema(RocksDBStorage* storage) : storage_(storage) {
+    LoadSchemas();
+}
+
+void RucksDBSchema::LoadSchemas() {
+    RucksDBTraceScope trace("LoadCatalog", "catalog");
+    std::lock_guard<std::mutex> guard(schema_lock_);
+    
+    // Keys in ascending order, so MultiGet does not sort them
+    vector<string> keys = {CATALOG_SNAPSHOT_KEY, CATALOG_VERSION_KEY};
+    vector<string> values;
+    vector<bool> found;
+    storage_->MultiReadDataUncached(keys, values, found, true);
+    catalog_version_ = found[1] ? DecodeCounter(values[1]) : 0;
+    if (found[0] && LoadSnapshot(values[0])) {
+        trace.arg = schemas_.size();
+        return;
+    }
+    
+    string prefix = SCHEMA_PREFIX;
+    schemas_.clear();
+    storage_->IteratePrefix(prefix, [this, &prefix](const string& key, const string& value) {
+        schemas_[key.substr(prefix.length())].data = value;
+        return true;
+    });
+    snapshot_version_ = -1;
+    if (!storage_->IsReadOnly()) {
+        SaveSnapshotLocked();
+    }
+    trace.arg = schemas_.size();
+}
+
+bool RucksDBSchema::LoadSnapshot(const string& snapshot) {
+    MemoryStream stream((data_ptr_t)snapshot.data(), snapshot.size());
+    BinaryDeserializer deserializer(stream);
+    deserializer.Begin();
+    auto version = deserializer.ReadProperty<int64_t>(100, "version");
+    if (version != catalog_version_) {
+        return false;
+    }
+    auto names = deserializer.ReadProperty<vector<string>>(101, "names");
+    auto records = deserializer.ReadProperty<vector<string>>(102, "schemas");
+    deserializer.End();
+    if (names.size() != records.size()) {
+        return false;
+    }
+    
+    schemas_.clear();
+    schemas_.reserve(names.size());
+    for (idx_t i = 0; i < names.size(); i++) {
+        schemas_[names[i]].data = std::move(records[i]);
+    }
+    snapshot_version_ = version;
+    return true;
+}
+
+void RucksDBSchema::SaveSnapshot() {
+    std::lock_guard<std::mutex> guard(schema_lock_);
+    if (snapshot_version_ != catalog_version_) {
+        SaveSnapshotLocked();
+    }
+}
+
+void RucksDBSchema::SaveSnapshotLocked() {
+    vector<string> names;
+    vector<string> records;
+    names.reserve(schemas_.size());
+    records.reserve(schemas_.size());
+    for (auto& entry : schemas_) {
+        names.push_back(entry.first);
+        records.push_back(entry.second.data);
     }
     
-    string key = string(SCHEMA_PREFIX) + table_name;
-    storage_->WriteData(key, schema_data);
+    MemoryStream stream;
+    BinarySerializer serializer(stream);
+    serializer.Begin();
+    serializer.WriteProperty(100, "version", catalog_version_);
+    serializer.WriteProperty(101, "names", names);
+    serializer.WriteProperty(102, "schemas", records);
+    serializer.End();
+    storage_->WriteData(CATALOG_SNAPSHOT_KEY, string((const char*)stream.GetData(), stream.GetPosition()));
+    snapshot_version_ = catalog_version_;
+}
+
+void RucksDBSchema::CreateTable(const string& table_name, const vector<ColumnDefinition>& columns) {
+    string schema_data = SerializeSchema(columns);
+    
+    // Schema, row count and the catalog version land together, so a snapshot is never taken
+    // for current when it lacks the table
+    rocksdb::WriteBatch batch;
+    batch.Put(string(SCHEMA_PREFIX) + table_name, schema_data);
+    batch.Put(string(TABLE_META_PREFIX) + table_name, EncodeCounter(0));
+    batch.Put(string(TABLE_NEXT_ROW_PREFIX) + table_name, EncodeCounter(0, RucksDBAggregateKind::MAX));
+    batch.Merge(CATALOG_VERSION_KEY, EncodeCounter(1));
+    storage_->ApplyBatch(batch);
     
-    // Initialize table metadata
-    StoreTableMetadata(table_name, 0);
+    std::lock_guard<std::mutex> guard(schema_lock_);
+    auto& schema = schemas_[table_name];
+    schema.data = std::move(schema_data);
+    schema.columns = CopyColumns(columns);
+    schema.parsed = true;
+    catalog_version_++;
 }
 
 void RucksDBSchema::DropTable(const string& table_name) {
-    string schema_key = string(SCHEMA_PREFIX) + table_name;
-    storage_->DeleteData(schema_key);
+    {
+        std::lock_guard<std::mutex> guard(schema_lock_);
+        schemas_.erase(table_name);
+        catalog_version_++;
+    }
     
-    string meta_key = string(TABLE_META_PREFIX) + table_name;
-    storage_->DeleteData(meta_key);
+    rocksdb::WriteBatch batch;
+    batch.Delete(string(SCHEMA_PREFIX) + table_name);
+    batch.Delete(string(TABLE_META_PREFIX) + table_name);
+    batch.Delete(string(TABLE_NEXT_ROW_PREFIX) + table_name);
+    batch.Delete(string(TABLE_STATS_PREFIX) + table_name);
+    batch.Merge(CATALOG_VERSION_KEY, EncodeCounter(1));
+    storage_->ApplyBatch(batch);
     
-    // Delete all table data
-    string table_prefix = "data_" + table_name + "_";
-    storage_->IteratePrefix(table_prefix, [this](const string& key, const string& value) {
-        storage_->DeleteData(key);
-        return true;
-    });
+    for (auto& rollup : LoadRollups()) {
+        if (rollup.table_name == table_name) {
+            DropRollup(rollup.name);
+        }
+    }
+    DropTableTTL(table_name);
+    for (auto& index : LoadVectorIndexes()) {
+        if (index.table_name == table_name) {
+            DropVectorIndex(index.name);
+        }
+    }
+    for (auto& index : LoadTextIndexes()) {
+        if (index.table_name == table_name) {
+            DropTextIndex(index.name);
+        }
+    }
+    DropTableTier(table_name);
+    DropTableCluster(table_name);
+    
+    // Row data may be sharded, so RucksDBColumnarStorage::DropTableData removes it
 }
 
 vector<ColumnDefinition> RucksDBSchema::GetTableSchema(const string& table_name) {
-    string key = string(SCHEMA_PREFIX) + table_name;
-    string value;
-    
-    if (!storage_->ReadData(key, value)) {
+    std::lock_guard<std::mutex> guard(schema_lock_);
+    auto it = schemas_.find(table_name);
+    if (it == schemas_.end()) {
         throw std::runtime_error("Table '" + table_name + "' does not exist");
     }
+    auto& schema = it->second;
+    if (!schema.parsed) {
+        schema.columns = ParseSchema(schema.data);
+        schema.parsed = true;
+    }
+    return CopyColumns(schema.columns);
+}
+
+// First byte of schema records in DuckDB's binary format; text records start with a digit
+static constexpr char SCHEMA_BINARY_MAGIC = 0x01;
+
+string RucksDBSchema::SerializeSchema(const vector<ColumnDefinition>& columns) {
+    MemoryStream stream;
+    BinarySerializer serializer(stream);
+    serializer.Begin();
+    serializer.WriteProperty(100, "columns", columns);
+    serializer.End();
+    return string(1, SCHEMA_BINARY_MAGIC) + string((const char*)stream.GetData(), stream.GetPosition());
+}
+
+vector<ColumnDefinition> RucksDBSchema::ParseSchema(const string& schema_data) {
+    if (!schema_data.empty() && schema_data[0] == SCHEMA_BINARY_MAGIC) {
+        MemoryStream stream((data_ptr_t)schema_data.data() + 1, schema_data.size() - 1);
+        BinaryDeserializer deserializer(stream);
+        deserializer.Begin();
+        auto columns = deserializer.ReadProperty<vector<ColumnDefinition>>(100, "columns");
+        deserializer.End();
+        return columns;
+    }
     
-    // Simple deserialization
+    // "count|name:type|..." records written before the binary format
     vector<ColumnDefinition> columns;
-    std::istringstream ss(value);
+    std::istringstream ss(schema_data);
     string token;
     
     // Get column count
@@ -97,19 +405,7 @@ vector<ColumnDefinition> RucksDBSchema::GetTableSchema(const string& table_name)
             string name = token.substr(0, colon_pos);
             string type_str = token.substr(colon_pos + 1);
             
-            // Basic type mapping
-            LogicalType type;
-            if (type_str == "INTEGER") {
-                type = LogicalType::INTEGER;
-            } else if (type_str == "VARCHAR") {
-                type = LogicalType::VARCHAR;
-            } else if (type_str == "FLOAT") {
-                type = LogicalType::FLOAT;
-            } else {
-                type = LogicalType::VARCHAR; // Default fallback
-            }
-            
-            columns.emplace_back(name, type);
+            columns.emplace_back(name, TransformStringToLogicalType(type_str));
         }
     }
     
@@ -117,199 +413,1884 @@ vector<ColumnDefinition> RucksDBSchema::GetTableSchema(const string& table_name)
 }
 
 bool RucksDBSchema::TableExists(const string& table_name) {
-    string key = string(SCHEMA_PREFIX) + table_name;
-    string value;
-    return storage_->ReadData(key, value);
+    std::lock_guard<std::mutex> guard(schema_lock_);
+    return schemas_.find(table_name) != schemas_.end();
 }
 
-void RucksDBSchema::StoreTableMetadata(const string& table_name, idx_t row_count) {
-    string key = string(TABLE_META_PREFIX) + table_name;
-    string value = to_string(row_count);
-    storage_->WriteData(key, value);
+vector<string> RucksDBSchema::ListTables() {
+    std::lock_guard<std::mutex> guard(schema_lock_);
+    vector<string> tables;
+    for (const auto& entry : schemas_) {
+        tables.push_back(entry.first);
+    }
+    return tables;
+}
+
+void RucksDBSchema::StoreTableMetadata(const string& table_name, idx_t next_row, idx_t row_count) {
+    rocksdb::WriteBatch batch;
+    batch.Put(string(TABLE_META_PREFIX) + table_name, EncodeCounter((int64_t)row_count));
+    batch.Put(string(TABLE_NEXT_ROW_PREFIX) + table_name, EncodeCounter((int64_t)next_row, RucksDBAggregateKind::MAX));
+    storage_->ApplyBatch(batch);
 }
 
 idx_t RucksDBSchema::LoadTableRowCount(const string& table_name) {
     string key = string(TABLE_META_PREFIX) + table_name;
     string value;
     if (storage_->ReadData(key, value)) {
-        return std::stoull(value);
+        // Also reads the plain decimal counts written before merges were used
+        return (idx_t)DecodeCounter(value);
     }
     return 0;
 }
 
+bool RucksDBSchema::LoadTableNextRow(const string& table_name, idx_t& next_row) {
+    string key = string(TABLE_NEXT_ROW_PREFIX) + table_name;
+    string value;
+    if (!storage_->ReadData(key, value)) {
+        return false;
+    }
+    next_row = (idx_t)DecodeCounter(value);
+    return true;
+}
+
+void RucksDBSchema::MergeTableRowCount(rocksdb::WriteBatch& batch, const string& table_name, int64_t delta) {
+    string key = string(TABLE_META_PREFIX) + table_name;
+    batch.Merge(key, EncodeCounter(delta));
+}
+
+void RucksDBSchema::MergeTableNextRow(rocksdb::WriteBatch& batch, const string& table_name, idx_t next_row) {
+    string key = string(TABLE_NEXT_ROW_PREFIX) + table_name;
+    batch.Merge(key, EncodeCounter((int64_t)next_row, RucksDBAggregateKind::MAX));
+}
+
+void RucksDBSchema::StoreTableStatistics(const string& table_name, const RucksDBTableStatistics& stats) {
+    string key = string(TABLE_STATS_PREFIX) + table_name;
+    storage_->WriteData(key, stats.Serialize());
+}
+
+bool RucksDBSchema::LoadTableStatistics(const string& table_name, const vector<LogicalType>& types,
+                                        RucksDBTableStatistics& stats) {
+    string key = string(TABLE_STATS_PREFIX) + table_name;
+    string value;
+    if (!storage_->ReadData(key, value)) {
+        return false;
+    }
+    return stats.Deserialize(value, types);
+}
+
+void RucksDBSchema::StoreRollup(const RucksDBRollupDefinition& rollup) {
+    string key = string(ROLLUP_PREFIX) + rollup.name;
+    storage_->WriteData(key, rollup.Serialize());
+}
+
+void RucksDBSchema::DropRollup(const string& rollup_name) {
+    string key = string(ROLLUP_PREFIX) + rollup_name;
+    storage_->DeleteData(key);
+    
+    rocksdb::WriteBatch batch;
+    storage_->IteratePrefix(RucksDBRollupDefinition::GetDataPrefix(rollup_name),
+                            [&batch](const string& group_key, const string& value) {
+        batch.Delete(group_key);
+        return true;
+    });
+    storage_->ApplyBatch(batch);
+}
+
+vector<RucksDBRollupDefinition> RucksDBSchema::LoadRollups() {
+    vector<RucksDBRollupDefinition> rollups;
+    storage_->IteratePrefix(ROLLUP_PREFIX, [&rollups](const string& key, const string& value) {
+        rollups.push_back(RucksDBRollupDefinition::Deserialize(value));
+        return true;
+    });
+    return rollups;
+}
+
+void RucksDBSchema::StoreTableTTL(const string& table_name, const RucksDBTableTTL& ttl) {
+    string key = string(TTL_PREFIX) + table_name;
+    storage_->WriteData(key, ttl.Serialize());
+}
+
+void RucksDBSchema::DropTableTTL(const string& table_name) {
+    string key = string(TTL_PREFIX) + table_name;
+    storage_->DeleteData(key);
+    
+    rocksdb::WriteBatch batch;
+    storage_->IteratePrefix(RucksDBPartitionIndex::GetPrefix(table_name),
+                            [&batch](const string& partition_key, const string& value) {
+        batch.Delete(partition_key);
+        return true;
+    });
+    storage_->ApplyBatch(batch);
+}
+
+bool RucksDBSchema::LoadTableTTL(const string& table_name, RucksDBTableTTL& ttl) {
+    string key = string(TTL_PREFIX) + table_name;
+    string value;
+    if (!storage_->ReadData(key, value)) {
+        return false;
+    }
+    ttl = RucksDBTableTTL::Deserialize(value);
+    return true;
+}
+
+std::unordered_map<string, RucksDBTableTTL> RucksDBSchema::LoadTableTTLs() {
+    string prefix = TTL_PREFIX;
+    std::unordered_map<string, RucksDBTableTTL> ttls;
+    storage_->IteratePrefix(prefix, [&ttls, &prefix](const string& key, const string& value) {
+        ttls[key.substr(prefix.length())] = RucksDBTableTTL::Deserialize(value);
+        return true;
+    });
+    return ttls;
+}
+
+void RucksDBSchema::StoreVectorIndex(const RucksDBVectorIndexDefinition& index) {
+    string key = string(VECTOR_INDEX_PREFIX) + index.name;
+    storage_->WriteData(key, index.Serialize());
+}
+
+void RucksDBSchema::DropVectorIndex(const string& index_name) {
+    rocksdb::WriteBatch batch;
+    batch.Delete(string(VECTOR_INDEX_PREFIX) + index_name);
+    batch.Delete(RucksDBVectorIndex::GetMetaKey(index_name));
+    storage_->IteratePrefix(RucksDBVectorIndex::GetNodePrefix(index_name),
+                            [&batch](const string& key, const string& value) {
+        batch.Delete(key);
+        return true;
+    });
+    storage_->ApplyBatch(batch);
+}
+
+vector<RucksDBVectorIndexDefinition> RucksDBSchema::LoadVectorIndexes() {
+    vector<RucksDBVectorIndexDefinition> indexes;
+    storage_->IteratePrefix(VECTOR_INDEX_PREFIX, [&indexes](const string& key, const string& value) {
+        indexes.push_back(RucksDBVectorIndexDefinition::Deserialize(value));
+        return true;
+    });
+    return indexes;
+}
+
+void RucksDBSchema::StoreTextIndex(const RucksDBTextIndexDefinition& index) {
+    string key = string(TEXT_INDEX_PREFIX) + index.name;
+    storage_->WriteData(key, index.Serialize());
+}
+
+void RucksDBSchema::DropTextIndex(const string& index_name) {
+    rocksdb::WriteBatch batch;
+    batch.Delete(string(TEXT_INDEX_PREFIX) + index_name);
+    storage_->IteratePrefix(RucksDBTextIndexDefinition::GetTermPrefix(index_name),
+                            [&batch](const string& key, const string& value) {
+        batch.Delete(key);
+        return true;
+    });
+    storage_->ApplyBatch(batch);
+}
+
+vector<RucksDBTextIndexDefinition> RucksDBSchema::LoadTextIndexes() {
+    vector<RucksDBTextIndexDefinition> indexes;
+    storage_->IteratePrefix(TEXT_INDEX_PREFIX, [&indexes](const string& key, const string& value) {
+        indexes.push_back(RucksDBTextIndexDefinition::Deserialize(value));
+        return true;
+    });
+    return indexes;
+}
+
+void RucksDBSchema::StoreTableTier(const string& table_name, const RucksDBTierDefinition& tier) {
+    string key = string(TIER_PREFIX) + table_name;
+    storage_->WriteData(key, tier.Serialize());
+}
+
+void RucksDBSchema::DropTableTier(const string& table_name) {
+    rocksdb::WriteBatch batch;
+    batch.Delete(string(TIER_PREFIX) + table_name);
+    for (auto& prefix : {RucksDBHotTier::GetLogPrefix(table_name), RucksDBHotTier::GetKeyPrefix(table_name)}) {
+        storage_->IteratePrefix(prefix, [&batch](const string& key, const string& value) {
+            batch.Delete(key);
+            return true;
+        });
+    }
+    storage_->ApplyBatch(batch);
+}
+
+bool RucksDBSchema::LoadTableTier(const string& table_name, RucksDBTierDefinition& tier) {
+    string key = string(TIER_PREFIX) + table_name;
+    string value;
+    if (!storage_->ReadData(key, value)) {
+        return false;
+    }
+    tier = RucksDBTierDefinition::Deserialize(value);
+    return true;
+}
+
+void RucksDBSchema::StoreTableCluster(const string& table_name, const RucksDBClusterDefinition& cluster) {
+    string key = string(CLUSTER_PREFIX) + table_name;
+    storage_->WriteData(key, cluster.Serialize());
+}
+
+void RucksDBSchema::DropTableCluster(const string& table_name) {
+    rocksdb::WriteBatch batch;
+    batch.Delete(string(CLUSTER_PREFIX) + table_name);
+    storage_->IteratePrefix(RucksDBClusterDefinition::GetPrefix(table_name),
+                            [&batch](const string& key, const string& value) {
+        batch.Delete(key);
+        return true;
+    });
+    storage_->ApplyBatch(batch);
+}
+
+bool RucksDBSchema::LoadTableCluster(const string& table_name, RucksDBClusterDefinition& cluster) {
+    string key = string(CLUSTER_PREFIX) + table_name;
+    string value;
+    if (!storage_->ReadData(key, value)) {
+        return false;
+    }
+    cluster = RucksDBClusterDefinition::Deserialize(value);
+    return true;
+}
+
 // Columnar storage implementation
+RucksDBColumnarStorage::RucksDBColumnarStorage(RocksDBStorage* storage)
+    : storage_(storage), shards_(storage->GetShards()), sharding_(storage->GetOptions().sharding),
+      shard_block_rows_(storage->GetOptions().shard_block_rows),
+      large_value_size_(storage->GetOptions().large_value_size),
+      scan_prefetch_(storage->GetOptions().scan_prefetch) {
+}
+
+idx_t RucksDBColumnarStorage::ShardIndex(idx_t row_id) {
+    if (shards_.size() == 1) {
+        return 0;
+    }
+    if (sharding_ == RucksDBShardingMode::RANGE) {
+        return (row_id / shard_block_rows_) % shards_.size();
+    }
+    // Fibonacci hashing spreads consecutive row ids evenly
+    return ((row_id * 0x9E3779B97F4A7C15ULL) >> 32) % shards_.size();
+}
+
+RocksDBStorage* RucksDBColumnarStorage::GetShard(idx_t row_id) {
+    return shards_[ShardIndex(row_id)];
+}
+
+idx_t RucksDBColumnarStorage::GetMorselSize() const {
+    idx_t morsel = 8 * STANDARD_VECTOR_SIZE;
+    if (shards_.size() > 1 && sharding_ == RucksDBShardingMode::RANGE && shard_block_rows_ % morsel != 0) {
+        return shard_block_rows_;
+    }
+    return morsel;
+}
+
+void RucksDBColumnarStorage::ApplyShardBatches(vector<rocksdb::WriteBatch>& batches) {
+    vector<std::future<void>> pending;
+    rocksdb::WriteBatch* local = nullptr;
+    for (idx_t i = 0; i < batches.size(); i++) {
+        if (batches[i].Count() == 0) {
+            continue;
+        }
+        if (!local) {
+            // The calling thread writes one shard itself
+            local = &batches[i];
+            continue;
+        }
+        auto* shard = shards_[i];
+        auto* batch = &batches[i];
+        pending.push_back(std::async(std::launch::async, [shard, batch]() { shard->ApplyBatch(*batch); }));
+    }
+    if (local) {
+        shards_[local - batches.data()]->ApplyBatch(*local);
+    }
+    for (auto& write : pending) {
+        write.get();
+    }
+}
+
 string RucksDBColumnarStorage::GetRowKey(const string& table_name, idx_t row_id) {
     return "data_" + table_name + "_row_" + to_string(row_id);
 }
 
-void RucksDBColumnarStorage::WriteRow(const string& table_name, idx_t row_id, 
-                                    const DataChunk& chunk, idx_t chunk_row) {
-    // Simple serialization without DuckDB serializers
-    string row_data = std::to_string(chunk.ColumnCount()) + "|";
+bool RucksDBColumnarStorage::ParseRowKey(const string& table_name, const string& key, idx_t& row_id) {
+    string prefix = "data_" + table_name + "_row_";
+    if (key.size() <= prefix.size() || key.compare(0, prefix.size(), prefix) != 0) {
+        return false;
+    }
+    // Requiring only digits after the prefix keeps table "t" from matching rows of "t_row_x"
+    row_id = 0;
+    for (idx_t i = prefix.size(); i < key.size(); i++) {
+        if (key[i] < '0' || key[i] > '9') {
+            return false;
+        }
+        row_id = row_id * 10 + (idx_t)(key[i] - '0');
+    }
+    return true;
+}
+
+string RucksDBColumnarStorage::GetColumnKey(const string& table_name, idx_t col_idx, idx_t row_id) {
+    return GetRowKey(table_name, row_id) + "_c" + to_string(col_idx);
+}
+
+bool RucksDBColumnarStorage::ParseColumnKey(const string& table_name, const string& key, idx_t& row_id,
+                                            idx_t& col_idx) {
+    auto column_pos = key.rfind("_c");
+    if (column_pos == string::npos || column_pos + 2 >= key.size() ||
+        !ParseRowKey(table_name, key.substr(0, column_pos), row_id)) {
+        return false;
+    }
+    col_idx = 0;
+    for (idx_t i = column_pos + 2; i < key.size(); i++) {
+        if (key[i] < '0' || key[i] > '9') {
+            return false;
+        }
+        col_idx = col_idx * 10 + (idx_t)(key[i] - '0');
+    }
+    return true;
+}
+
+string RucksDBColumnarStorage::DecodeLargeValue(const string& data) {
+    auto separator = data.find('|');
+    return separator == string::npos ? data : data.substr(separator + 1);
+}
+
+bool RucksDBColumnarStorage::GetLargeValuePartition(const rocksdb::Slice& data, int64_t& partition) {
+    // Only the header is looked at, the value itself may be megabytes
+    auto* separator = (const char*)memchr(data.data(), '|', data.size());
+    if (!separator || separator == data.data()) {
+        return false;
+    }
+    partition = std::stoll(string(data.data(), separator - data.data()));
+    return true;
+}
+
+// Rows written since values became length-prefixed start with this; older rows start with the
+// column count
+static constexpr char ROW_FORMAT_MARKER = '#';
+
+string RucksDBColumnarStorage::EncodeRow(const string& table_name, idx_t row_id, const vector<Value>& values,
+                                         rocksdb::WriteBatch& batch, const RucksDBTableTTL* ttl) {
+    // Simple serialization without DuckDB serializers. Text carries its length, so it may hold the
+    // separator.
+    string row_data = string(1, ROW_FORMAT_MARKER) + std::to_string(values.size()) + "|";
     
-    for (idx_t col_idx = 0; col_idx < chunk.ColumnCount(); col_idx++) {
-        auto value = chunk.data[col_idx].GetValue(chunk_row);
-        
+    for (idx_t col_idx = 0; col_idx < values.size(); col_idx++) {
+        auto& value = values[col_idx];
         // Simple value serialization
         if (value.IsNull()) {
             row_data += "NULL|";
-        } else {
-            switch (value.type().id()) {
-                case LogicalTypeId::INTEGER:
-                    row_data += "INT:" + std::to_string(value.GetValue<int32_t>()) + "|";
-                    break;
-                case LogicalTypeId::FLOAT:
-                    row_data += "FLOAT:" + std::to_string(value.GetValue<float>()) + "|";
-                    break;
-                case LogicalTypeId::VARCHAR:
-                    row_data += "VARCHAR:" + value.GetValue<string>() + "|";
-                    break;
-                default:
-                    row_data += "VARCHAR:" + value.ToString() + "|";
-                    break;
+            continue;
+        }
+        string text;
+        switch (value.type().id()) {
+            case LogicalTypeId::INTEGER:
+                row_data += "INT:" + std::to_string(value.GetValue<int32_t>()) + "|";
+                continue;
+            case LogicalTypeId::FLOAT: {
+                // Nine significant digits read back as the same float
+                char buffer[32];
+                snprintf(buffer, sizeof(buffer), "%.9g", value.GetValue<float>());
+                row_data += string("FLOAT:") + buffer + "|";
+                continue;
             }
+            case LogicalTypeId::VARCHAR:
+                text = value.GetValue<string>();
+                break;
+            default:
+                text = value.ToString();
+                break;
+        }
+        if (large_value_size_ == 0 || text.size() < large_value_size_) {
+            row_data += "VARCHAR:" + std::to_string(text.size()) + ":" + text + "|";
+            continue;
         }
+        // The partition lets the compaction filter expire the value without reading its row
+        string header = ttl && ttl->column_index < values.size()
+                            ? std::to_string(ttl->PartitionOf(values[ttl->column_index])) : string();
+        batch.Put(GetColumnKey(table_name, col_idx, row_id), header + "|" + text);
+        row_data += "LARGE:" + std::to_string(text.size()) + "|";
     }
     
-    string key = GetRowKey(table_name, row_id);
-    storage_->WriteData(key, row_data);
+    return row_data;
 }
 
-bool RucksDBColumnarStorage::ReadRow(const string& table_name, idx_t row_id, 
-                                   DataChunk& result, idx_t result_row,
-                                   const vector<column_t>& column_ids) {
-    string key = GetRowKey(table_name, row_id);
-    string value;
-    
-    if (!storage_->ReadData(key, value)) {
-        return false;
+string RucksDBColumnarStorage::PutRow(const string& table_name, idx_t row_id, const vector<Value>& values,
+                                      rocksdb::WriteBatch& batch, const RucksDBTableTTL* ttl) {
+    // Out-of-line values go first, so change capture has them when it reaches the row
+    string row_data = EncodeRow(table_name, row_id, values, batch, ttl);
+    batch.Put(GetRowKey(table_name, row_id), row_data);
+    return row_data;
+}
+
+static Value DecodeToken(const string& type_str, const string& value_str, idx_t column,
+                         vector<idx_t>* large_columns) {
+    if (type_str == "INT") {
+        return Value::INTEGER(std::stoi(value_str));
+    } else if (type_str == "FLOAT") {
+        return Value::FLOAT(std::stof(value_str));
+    } else if (type_str == "LARGE") {
+        if (large_columns) {
+            large_columns->push_back(column);
+        }
+        return Value();
     }
-    
-    // Simple deserialization
-    std::istringstream ss(value);
+    return Value(value_str);
+}
+
+// Rows written before values were length-prefixed; text holding '|' was split there and cannot
+// be recovered
+static void DecodeLegacyRow(const string& data, vector<Value>& values, vector<idx_t>* large_columns) {
+    std::istringstream ss(data);
     string token;
     
     // Get column count
     std::getline(ss, token, '|');
     size_t column_count = std::stoull(token);
     
-    // Parse values
-    vector<Value> values;
-    for (size_t i = 0; i < column_count; i++) {
-        std::getline(ss, token, '|');
-        if (token.empty()) break;
-        
-        if (token == "NULL") {
-            values.push_back(Value());
-        } else {
-            size_t colon_pos = token.find(':');
-            if (colon_pos != string::npos) {
-                string type_str = token.substr(0, colon_pos);
-                string value_str = token.substr(colon_pos + 1);
-                
-                if (type_str == "INT") {
-                    values.push_back(Value::INTEGER(std::stoi(value_str)));
-                } else if (type_str == "FLOAT") {
-                    values.push_back(Value::FLOAT(std::stof(value_str)));
-                } else if (type_str == "VARCHAR") {
-                    values.push_back(Value(value_str));
-                } else {
-                    values.push_back(Value(value_str));
-                }
+    for (size_t i = 0; i < column_count; i++) {
+        std::getline(ss, token, '|');
+        if (token.empty()) break;
+        
+        if (token == "NULL") {
+            values.push_back(Value());
+        } else {
+            size_t colon_pos = token.find(':');
+            if (colon_pos != string::npos) {
+                values.push_back(DecodeToken(token.substr(0, colon_pos), token.substr(colon_pos + 1), values.size(),
+                                             large_columns));
+            }
+        }
+    }
+}
+
+void RucksDBColumnarStorage::DecodeRow(const string& data, vector<Value>& values, vector<idx_t>* large_columns) {
+    values.clear();
+    if (large_columns) {
+        large_columns->clear();
+    }
+    if (data.empty() || data[0] != ROW_FORMAT_MARKER) {
+        DecodeLegacyRow(data, values, large_columns);
+        return;
+    }
+    
+    auto corrupt = []() { return std::runtime_error("Corrupt RucksDB row"); };
+    idx_t pos = 1;
+    auto separator = data.find('|', pos);
+    if (separator == string::npos) {
+        throw corrupt();
+    }
+    size_t column_count = std::stoull(data.substr(pos, separator - pos));
+    pos = separator + 1;
+    
+    values.reserve(column_count);
+    for (size_t i = 0; i < column_count; i++) {
+        auto colon = data.find_first_of(":|", pos);
+        if (colon == string::npos) {
+            throw corrupt();
+        }
+        if (data[colon] == '|') {
+            // NULL
+            values.push_back(Value());
+            pos = colon + 1;
+            continue;
+        }
+        string type_str = data.substr(pos, colon - pos);
+        pos = colon + 1;
+        if (type_str == "VARCHAR") {
+            auto length_end = data.find(':', pos);
+            if (length_end == string::npos) {
+                throw corrupt();
+            }
+            idx_t length = std::stoull(data.substr(pos, length_end - pos));
+            pos = length_end + 1;
+            if (pos + length >= data.size() || data[pos + length] != '|') {
+                throw corrupt();
+            }
+            values.push_back(Value(data.substr(pos, length)));
+            pos += length + 1;
+            continue;
+        }
+        auto value_end = data.find('|', pos);
+        if (value_end == string::npos) {
+            throw corrupt();
+        }
+        values.push_back(DecodeToken(type_str, data.substr(pos, value_end - pos), values.size(), large_columns));
+        pos = value_end + 1;
+    }
+}
+
+void RucksDBColumnarStorage::WriteRow(const string& table_name, idx_t row_id, 
+                                    const DataChunk& chunk, idx_t chunk_row,
+                                    const RucksDBTableTTL* ttl) {
+    vector<Value> values;
+    values.reserve(chunk.ColumnCount());
+    for (idx_t col_idx = 0; col_idx < chunk.ColumnCount(); col_idx++) {
+        values.push_back(chunk.data[col_idx].GetValue(chunk_row));
+    }
+    WriteRowValues(table_name, row_id, values, ttl);
+}
+
+bool RucksDBColumnarStorage::ReadRow(const string& table_name, idx_t row_id, 
+                                   DataChunk& result, idx_t result_row,
+                                   const vector<column_t>& column_ids,
+                                   const RucksDBTableTTL* ttl, int64_t now) {
+    RucksDBTraceScope trace("ReadRow", "scan");
+    vector<Value> values;
+    vector<idx_t> large_columns;
+    if (!ReadStoredRow(table_name, row_id, values, large_columns)) {
+        return false;
+    }
+    // Expired rows stay readable until a compaction drops them
+    if (ttl && ttl->IsExpiredRow(values, now)) {
+        return false;
+    }
+    
+    // Out-of-line values are only fetched when projected
+    if (!large_columns.empty()) {
+        vector<std::pair<string, Value*>> targets;
+        for (auto col_idx : large_columns) {
+            if (std::find(column_ids.begin(), column_ids.end(), col_idx) != column_ids.end()) {
+                targets.emplace_back(GetColumnKey(table_name, col_idx, row_id), &values[col_idx]);
+            }
+        }
+        ReadLargeValues(GetShard(row_id), targets);
+    }
+    
+    // Set values for requested columns
+    for (idx_t i = 0; i < column_ids.size(); i++) {
+        column_t col_id = column_ids[i];
+        if (col_id == COLUMN_IDENTIFIER_ROW_ID) {
+            result.data[i].SetValue(result_row, Value::BIGINT((int64_t)row_id));
+        } else if (col_id < values.size()) {
+            result.data[i].SetValue(result_row, values[col_id]);
+        }
+    }
+    
+    return true;
+}
+
+bool RucksDBColumnarStorage::ReadStoredRow(const string& table_name, idx_t row_id, vector<Value>& values,
+                                           vector<idx_t>& large_columns) {
+    string key = GetRowKey(table_name, row_id);
+    string data;
+    
+    auto* shard = GetShard(row_id);
+    auto cache = shard->GetCache();
+    if (!cache) {
+        {
+            RucksDBTraceScope trace("RocksDB.Get", "io");
+            if (!shard->ReadData(key, data)) {
+                return false;
+            }
+        }
+        RucksDBTraceScope trace("DecodeRow", "codec");
+        DecodeRow(data, values, &large_columns);
+        return true;
+    }
+    
+    // Hot rows are cached already decoded, skipping both the RocksDB read path and the codec
+    auto cached = std::dynamic_pointer_cast<const RucksDBCachedRow>(cache->Lookup(key));
+    if (cached) {
+        values = cached->values;
+        large_columns = cached->large_columns;
+        return true;
+    }
+    
+    uint64_t version = cache->GetVersion(key);
+    {
+        RucksDBTraceScope trace("RocksDB.Get", "io");
+        if (!shard->ReadDataUncached(key, data)) {
+            return false;
+        }
+    }
+    {
+        RucksDBTraceScope trace("DecodeRow", "codec");
+        DecodeRow(data, values, &large_columns);
+    }
+    
+    auto row = std::make_shared<RucksDBCachedRow>();
+    row->values = values;
+    row->large_columns = large_columns;
+    cache->Insert(key, std::move(row), data.size() + values.size() * sizeof(Value), version);
+    return true;
+}
+
+void RucksDBColumnarStorage::ReadLargeValues(RocksDBStorage* shard, vector<std::pair<string, Value*>>& targets) {
+    if (targets.empty()) {
+        return;
+    }
+    RucksDBTraceScope trace("ReadLargeValues", "io");
+    trace.arg = targets.size();
+    std::sort(targets.begin(), targets.end(),
+              [](const std::pair<string, Value*>& a, const std::pair<string, Value*>& b) { return a.first < b.first; });
+    vector<string> keys;
+    keys.reserve(targets.size());
+    for (auto& target : targets) {
+        keys.push_back(target.first);
+    }
+    // Large values would crowd rows out of the value cache, so they are always read uncached
+    vector<string> values;
+    vector<bool> hits;
+    shard->MultiReadDataUncached(keys, values, hits, true);
+    for (idx_t i = 0; i < targets.size(); i++) {
+        if (hits[i]) {
+            *targets[i].second = Value(DecodeLargeValue(values[i]));
+        }
+    }
+}
+
+bool RucksDBColumnarStorage::ReadRowValues(const string& table_name, idx_t row_id, vector<Value>& values) {
+    vector<idx_t> large_columns;
+    if (!ReadStoredRow(table_name, row_id, values, large_columns)) {
+        return false;
+    }
+    if (!large_columns.empty()) {
+        vector<std::pair<string, Value*>> targets;
+        for (auto col_idx : large_columns) {
+            targets.emplace_back(GetColumnKey(table_name, col_idx, row_id), &values[col_idx]);
+        }
+        ReadLargeValues(GetShard(row_id), targets);
+    }
+    return true;
+}
+
+void RucksDBColumnarStorage::ReadRowsValues(const string& table_name, const vector<idx_t>& row_ids,
+                                            vector<vector<Value>>& rows, vector<bool>& found,
+                                            const vector<column_t>* column_ids) {
+    rows.assign(row_ids.size(), vector<Value>());
+    found.assign(row_ids.size(), false);
+    
+    // Out-of-line values of every row found, per shard, read once all rows are decoded
+    vector<vector<std::pair<string, Value*>>> large_values(shards_.size());
+    auto add_large_values = [&](idx_t position, const vector<idx_t>& large_columns) {
+        auto row_id = row_ids[position];
+        for (auto col_idx : large_columns) {
+            if (column_ids && std::find(column_ids->begin(), column_ids->end(), col_idx) == column_ids->end()) {
+                continue;
+            }
+            large_values[ShardIndex(row_id)].emplace_back(GetColumnKey(table_name, col_idx, row_id),
+                                                          &rows[position][col_idx]);
+        }
+    };
+    
+    // Cached rows are served directly, the rest are grouped per shard for one MultiGet each
+    vector<vector<idx_t>> misses(shards_.size());
+    for (idx_t i = 0; i < row_ids.size(); i++) {
+        auto* cache = GetShard(row_ids[i])->GetCache();
+        if (cache) {
+            auto cached = std::dynamic_pointer_cast<const RucksDBCachedRow>(
+                cache->Lookup(GetRowKey(table_name, row_ids[i])));
+            if (cached) {
+                rows[i] = cached->values;
+                found[i] = true;
+                add_large_values(i, cached->large_columns);
+                continue;
+            }
+        }
+        misses[ShardIndex(row_ids[i])].push_back(i);
+    }
+    
+    vector<string> keys;
+    vector<string> values;
+    vector<bool> hits;
+    vector<uint64_t> versions;
+    vector<idx_t> large_columns;
+    for (idx_t shard_idx = 0; shard_idx < misses.size(); shard_idx++) {
+        auto& positions = misses[shard_idx];
+        if (positions.empty()) {
+            continue;
+        }
+        auto* shard = shards_[shard_idx];
+        auto* cache = shard->GetCache();
+        
+        // Decimal row ids do not sort like their keys, so order by key for a sorted MultiGet
+        keys.clear();
+        for (auto position : positions) {
+            keys.push_back(GetRowKey(table_name, row_ids[position]));
+        }
+        vector<idx_t> order(positions.size());
+        for (idx_t i = 0; i < order.size(); i++) {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), [&keys](idx_t a, idx_t b) { return keys[a] < keys[b]; });
+        vector<string> sorted_keys;
+        sorted_keys.reserve(keys.size());
+        versions.clear();
+        for (auto i : order) {
+            sorted_keys.push_back(keys[i]);
+            versions.push_back(cache ? cache->GetVersion(keys[i]) : 0);
+        }
+        
+        {
+            RucksDBTraceScope trace("RocksDB.MultiGet", "io");
+            shard->MultiReadDataUncached(sorted_keys, values, hits, true);
+        }
+        RucksDBTraceScope trace("DecodeRow", "codec");
+        for (idx_t i = 0; i < order.size(); i++) {
+            if (!hits[i]) {
+                continue;
+            }
+            auto position = positions[order[i]];
+            DecodeRow(values[i], rows[position], &large_columns);
+            found[position] = true;
+            if (cache) {
+                auto row = std::make_shared<RucksDBCachedRow>();
+                row->values = rows[position];
+                row->large_columns = large_columns;
+                cache->Insert(sorted_keys[i], std::move(row),
+                              values[i].size() + rows[position].size() * sizeof(Value), versions[i]);
+            }
+            add_large_values(position, large_columns);
+        }
+    }
+    
+    for (idx_t shard_idx = 0; shard_idx < large_values.size(); shard_idx++) {
+        ReadLargeValues(shards_[shard_idx], large_values[shard_idx]);
+    }
+}
+
+void RucksDBColumnarStorage::WriteRowValues(const string& table_name, idx_t row_id, 
+                                          const vector<Value>& values, const RucksDBTableTTL* ttl,
+                                          string* encoded) {
+    rocksdb::WriteBatch batch;
+    // Out-of-line values the row no longer has are dropped; ones it still has are overwritten
+    vector<Value> old_values;
+    vector<idx_t> large_columns;
+    if (ReadStoredRow(table_name, row_id, old_values, large_columns)) {
+        for (auto col_idx : large_columns) {
+            batch.Delete(GetColumnKey(table_name, col_idx, row_id));
+        }
+    }
+    string row_data = PutRow(table_name, row_id, values, batch, ttl);
+    GetShard(row_id)->ApplyBatch(batch);
+    if (encoded) {
+        *encoded = std::move(row_data);
+    }
+}
+
+bool RucksDBColumnarStorage::ReadRowData(const string& table_name, idx_t row_id, string& data) {
+    // The cache holds rows decoded, not as stored
+    return GetShard(row_id)->ReadDataUncached(GetRowKey(table_name, row_id), data);
+}
+
+void RucksDBColumnarStorage::DeleteRow(const string& table_name, idx_t row_id) {
+    DeleteRows(table_name, {row_id});
+}
+
+void RucksDBColumnarStorage::WriteChunk(const string& table_name, idx_t start_row, 
+                                      const DataChunk& chunk, const RucksDBTableTTL* ttl) {
+    RucksDBTraceScope trace("WriteChunk", "ingest");
+    trace.arg = chunk.size();
+    
+    // One WriteBatch per chunk and shard instead of one Put per row
+    vector<rocksdb::WriteBatch> batches(shards_.size());
+    EncodeChunk(table_name, start_row, chunk, batches, ttl);
+    RucksDBTraceScope write_trace("RocksDB.Write", "io");
+    ApplyShardBatches(batches);
+}
+
+void RucksDBColumnarStorage::EncodeChunk(const string& table_name, idx_t start_row, const DataChunk& chunk,
+                                         vector<rocksdb::WriteBatch>& batches, const RucksDBTableTTL* ttl,
+                                         vector<string>* encoded_rows) {
+    RucksDBTraceScope encode_trace("EncodeRows", "codec");
+    encode_trace.arg = chunk.size();
+    vector<Value> values(chunk.ColumnCount());
+    if (encoded_rows) {
+        encoded_rows->clear();
+        encoded_rows->reserve(chunk.size());
+    }
+    for (idx_t i = 0; i < chunk.size(); i++) {
+        idx_t row_id = start_row + i;
+        for (idx_t col_idx = 0; col_idx < chunk.ColumnCount(); col_idx++) {
+            values[col_idx] = chunk.data[col_idx].GetValue(i);
+        }
+        auto row_data = PutRow(table_name, row_id, values, batches[ShardIndex(row_id)], ttl);
+        if (encoded_rows) {
+            encoded_rows->push_back(std::move(row_data));
+        }
+    }
+}
+
+void RucksDBColumnarStorage::DeleteRows(const string& table_name, const vector<idx_t>& row_ids) {
+    vector<rocksdb::WriteBatch> batches(shards_.size());
+    // Rows are usually cached by the read that found them, so finding their out-of-line values is cheap
+    vector<Value> values;
+    vector<idx_t> large_columns;
+    for (auto row_id : row_ids) {
+        auto& batch = batches[ShardIndex(row_id)];
+        if (ReadStoredRow(table_name, row_id, values, large_columns)) {
+            for (auto col_idx : large_columns) {
+                batch.Delete(GetColumnKey(table_name, col_idx, row_id));
+            }
+        }
+        batch.Delete(GetRowKey(table_name, row_id));
+    }
+    ApplyShardBatches(batches);
+}
+
+idx_t RucksDBColumnarStorage::ScanRows(const string& table_name, idx_t& next_row, idx_t end_row,
+                                     DataChunk& result, const vector<column_t>& column_ids,
+                                     const RucksDBTableTTL* ttl, int64_t now, const RucksDBHotSnapshot* hot) {
+    RucksDBTraceScope trace("ScanRows", "scan");
+    idx_t rows_read = 0;
+    result.Reset();
+    
+    // Batches shrink to the space left, so gaps from deleted rows never overflow the vector
+    RucksDBRowBatch batch;
+    while (next_row < end_row && rows_read < STANDARD_VECTOR_SIZE) {
+        idx_t count = std::min<idx_t>(STANDARD_VECTOR_SIZE - rows_read, end_row - next_row);
+        ReadRowBatch(table_name, next_row, count, column_ids, batch);
+        rows_read += EmitRows(batch, result, rows_read, column_ids, ttl, now, hot);
+        next_row += count;
+    }
+    
+    result.SetCardinality(rows_read);
+    trace.arg = rows_read;
+    return rows_read;
+}
+
+void RucksDBColumnarStorage::ReadRowBatch(const string& table_name, idx_t start_row, idx_t count,
+                                          const vector<column_t>& column_ids, RucksDBRowBatch& batch) {
+    RucksDBTraceScope trace("ReadRowBatch", "scan");
+    trace.arg = count;
+    batch.start_row = start_row;
+    batch.count = count;
+    // One MultiGet per shard for the whole batch lets RocksDB coalesce and overlap block reads
+    vector<idx_t> row_ids(count);
+    for (idx_t i = 0; i < count; i++) {
+        row_ids[i] = start_row + i;
+    }
+    ReadRowsValues(table_name, row_ids, batch.rows, batch.found, &column_ids);
+}
+
+idx_t RucksDBColumnarStorage::EmitRows(const RucksDBRowBatch& batch, DataChunk& result, idx_t result_row,
+                                       const vector<column_t>& column_ids, const RucksDBTableTTL* ttl,
+                                       int64_t now, const RucksDBHotSnapshot* hot) {
+    idx_t emitted = 0;
+    for (idx_t i = 0; i < batch.count; i++) {
+        auto& values = batch.rows[i];
+        // Expired rows stay readable until a compaction drops them
+        if (!batch.found[i] || (ttl && ttl->IsExpiredRow(values, now)) || (hot && hot->Shadows(values))) {
+            continue;
+        }
+        for (idx_t col = 0; col < column_ids.size(); col++) {
+            column_t col_id = column_ids[col];
+            if (col_id == COLUMN_IDENTIFIER_ROW_ID) {
+                result.data[col].SetValue(result_row + emitted, Value::BIGINT((int64_t)(batch.start_row + i)));
+            } else if (col_id < values.size()) {
+                result.data[col].SetValue(result_row + emitted, values[col_id]);
+            }
+        }
+        emitted++;
+    }
+    return emitted;
+}
+
+idx_t RucksDBColumnarStorage::ScanClusterRange(const string& table_name, string& next_key, const string& end_key,
+                                              const rocksdb::Snapshot* snapshot,
+                                              DataChunk& result, const vector<column_t>& column_ids) {
+    RucksDBTraceScope trace("ScanClusterRange", "scan");
+    idx_t rows_read = 0;
+    result.Reset();
+    
+    // Out-of-line values stay under their row key; they are read per shard once the vector is full
+    struct LargeRead {
+        idx_t row;
+        idx_t col;
+        string key;
+    };
+    vector<vector<LargeRead>> large_reads(shards_.size());
+    vector<Value> values;
+    vector<idx_t> large_columns;
+    string last_key;
+    storage_->IterateRange(next_key, end_key, [&](const string& key, const string& value) {
+        idx_t row_id = RucksDBClusterDefinition::ParseRowId(key);
+        DecodeRow(value, values, &large_columns);
+        for (idx_t col = 0; col < column_ids.size(); col++) {
+            column_t col_id = column_ids[col];
+            if (col_id == COLUMN_IDENTIFIER_ROW_ID) {
+                result.data[col].SetValue(rows_read, Value::BIGINT((int64_t)row_id));
+            } else if (col_id < values.size()) {
+                result.data[col].SetValue(rows_read, values[col_id]);
+                if (std::find(large_columns.begin(), large_columns.end(), col_id) != large_columns.end()) {
+                    large_reads[ShardIndex(row_id)].push_back({rows_read, col, GetColumnKey(table_name, col_id, row_id)});
+                }
+            }
+        }
+        last_key = key;
+        rows_read++;
+        return rows_read < STANDARD_VECTOR_SIZE;
+    }, snapshot);
+    
+    for (idx_t shard_idx = 0; shard_idx < large_reads.size(); shard_idx++) {
+        auto& reads = large_reads[shard_idx];
+        if (reads.empty()) {
+            continue;
+        }
+        vector<Value> large_values(reads.size());
+        vector<std::pair<string, Value*>> targets;
+        for (idx_t i = 0; i < reads.size(); i++) {
+            targets.emplace_back(reads[i].key, &large_values[i]);
+        }
+        ReadLargeValues(shards_[shard_idx], targets);
+        for (idx_t i = 0; i < reads.size(); i++) {
+            result.data[reads[i].col].SetValue(reads[i].row, large_values[i]);
+        }
+    }
+    
+    // A full vector may have stopped short of the range's end; the next read starts right after it
+    if (rows_read == STANDARD_VECTOR_SIZE) {
+        next_key = last_key + string(1, '\0');
+    } else {
+        next_key.clear();
+    }
+    result.SetCardinality(rows_read);
+    trace.arg = rows_read;
+    return rows_read;
+}
+
+void RucksDBColumnarStorage::DropTableData(const string& table_name) {
+    string table_prefix = "data_" + table_name + "_row_";
+    for (auto* shard : shards_) {
+        rocksdb::WriteBatch batch;
+        // The prefix also covers the rows of a table named "<table>_row_x", which stay
+        shard->IteratePrefix(table_prefix, [&](const string& key, const string& value) {
+            idx_t row_id, col_idx;
+            if (ParseRowKey(table_name, key, row_id) || ParseColumnKey(table_name, key, row_id, col_idx)) {
+                batch.Delete(key);
+            }
+            return true;
+        });
+        shard->ApplyBatch(batch);
+    }
+}
+
+void RucksDBColumnarStorage::CompactTableData(const string& table_name) {
+    storage_->CompactPrefix("data_" + table_name + "_row_");
+}
+
+// Table storage implementation
+RucksDBTableStorage::RucksDBTableStorage(const string& table_name, RucksDBSchema* schema, 
+                                       RucksDBColumnarStorage* storage)
+    : table_name_(table_name), schema_(schema), storage_(storage), row_count_(0),
+      metrics_(&storage->GetTableMetrics(table_name)), metadata_(std::make_shared<const RucksDBTableMetadata>()) {
+}
+
+void RucksDBTableStorage::Initialize(const vector<ColumnDefinition>& columns) {
+    columns_ = CopyColumns(columns);
+    Reload();
+}
+
+void RucksDBTableStorage::Reload() {
+    vector<LogicalType> types;
+    for (const auto& col : columns_) {
+        types.push_back(col.Type());
+    }
+    RucksDBTableStatistics stats;
+    if (!schema_->LoadTableStatistics(table_name_, types, stats)) {
+        // Tables written before statistics existed start from empty sketches, which the row count
+        // check below marks stale unless the table is empty
+        stats.Initialize(columns_.size());
+    }
+    
+    idx_t live_rows = schema_->LoadTableRowCount(table_name_);
+    idx_t next_row;
+    if (!schema_->LoadTableNextRow(table_name_, next_row)) {
+        // Tables written before the high-water mark counted appended rows, deleted ones included
+        next_row = live_rows;
+        live_rows -= std::min(stats.GetDeletedCount(), live_rows);
+        if (!schema_->GetStorage()->IsReadOnly()) {
+            schema_->StoreTableMetadata(table_name_, next_row, live_rows);
+        }
+    }
+    row_count_ = next_row;
+    if (stats.GetRowCount() != live_rows) {
+        // Written before a crash caught up with the committed rows, or before the count was kept
+        stats.MarkStale(live_rows);
+    }
+    {
+        std::lock_guard<std::mutex> guard(stats_lock_);
+        stats_ = std::move(stats);
+    }
+    
+    // Built aside and published at once, so queries and writes that hold the old set keep it
+    auto metadata = std::make_shared<RucksDBTableMetadata>();
+    for (auto& rollup : schema_->LoadRollups()) {
+        if (rollup.table_name == table_name_) {
+            rollup.Bind(columns_);
+            metadata->rollups.push_back(std::move(rollup));
+        }
+    }
+    
+    RucksDBTableTTL ttl;
+    if (schema_->LoadTableTTL(table_name_, ttl)) {
+        ttl.Bind(columns_);
+        std::atomic_store(&ttl_, std::make_shared<const RucksDBTableTTL>(ttl));
+        partitions_.Load(schema_->GetStorage(), table_name_);
+    } else {
+        std::atomic_store(&ttl_, std::shared_ptr<const RucksDBTableTTL>());
+        partitions_.Clear();
+    }
+    
+    // Graphs are not read here; each index loads its nodes on first use
+    for (auto& index : schema_->LoadVectorIndexes()) {
+        if (index.table_name == table_name_) {
+            index.Bind(columns_);
+            metadata->vector_indexes.push_back(std::make_shared<RucksDBVectorIndex>(schema_->GetStorage(), index));
+        }
+    }
+    
+    for (auto& index : schema_->LoadTextIndexes()) {
+        if (index.table_name == table_name_) {
+            index.Bind(columns_);
+            metadata->text_indexes.push_back(std::move(index));
+        }
+    }
+    std::atomic_store(&metadata_, std::shared_ptr<const RucksDBTableMetadata>(std::move(metadata)));
+    
+    RucksDBTierDefinition tier;
+    if (schema_->LoadTableTier(table_name_, tier)) {
+        tier.Bind(columns_);
+        auto hot = std::make_shared<RucksDBHotTier>(schema_->GetStorage(), table_name_, tier);
+        hot->Load();
+        std::atomic_store(&hot_, hot);
+    } else {
+        std::atomic_store(&hot_, std::shared_ptr<RucksDBHotTier>());
+    }
+    
+    RucksDBClusterDefinition cluster;
+    if (schema_->LoadTableCluster(table_name_, cluster)) {
+        cluster.Bind(columns_);
+        std::atomic_store(&cluster_, std::make_shared<const RucksDBClusterDefinition>(cluster));
+    } else {
+        std::atomic_store(&cluster_, std::shared_ptr<const RucksDBClusterDefinition>());
+    }
+}
+
+void RucksDBTableStorage::MarkDropped() {
+    std::unique_lock<std::shared_mutex> guard(write_lock_);
+    dropped_ = true;
+}
+
+void RucksDBTableStorage::CheckNotDropped() const {
+    if (dropped_) {
+        throw std::runtime_error("RocksDB table '" + table_name_ + "' was dropped");
+    }
+}
+
+idx_t RucksDBTableStorage::AddTextIndex(const RucksDBTextIndexDefinition& index) {
+    // Backfill in bounded batches, one merge per term and batch
+    vector<idx_t> row_ids;
+    vector<string> texts;
+    vector<Value> values;
+    idx_t rows = 0;
+    auto flush = [&]() {
+        rocksdb::WriteBatch batch;
+        index.IndexRows(row_ids, texts, batch);
+        schema_->ApplyBatch(batch);
+        row_ids.clear();
+        texts.clear();
+    };
+    for (idx_t row_id = 0; row_id < row_count_; row_id++) {
+        if (!storage_->ReadRowValues(table_name_, row_id, values) || index.column_index >= values.size() ||
+            values[index.column_index].IsNull()) {
+            continue;
+        }
+        row_ids.push_back(row_id);
+        texts.push_back(values[index.column_index].ToString());
+        rows++;
+        if (row_ids.size() >= 65536) {
+            flush();
+        }
+    }
+    flush();
+    
+    UpdateMetadata([&](RucksDBTableMetadata& metadata) { metadata.text_indexes.push_back(index); });
+    return rows;
+}
+
+void RucksDBTableStorage::RemoveTextIndex(const string& index_name) {
+    UpdateMetadata([&](RucksDBTableMetadata& metadata) {
+        auto& indexes = metadata.text_indexes;
+        indexes.erase(std::remove_if(indexes.begin(), indexes.end(),
+                                     [&](const RucksDBTextIndexDefinition& index) { return index.name == index_name; }),
+                      indexes.end());
+    });
+}
+
+bool RucksDBTableStorage::GetTextIndex(const string& column, RucksDBTextIndexDefinition& index) {
+    auto metadata = GetMetadata();
+    for (auto& text_index : metadata->text_indexes) {
+        if (StringUtil::CIEquals(text_index.column, column)) {
+            index = text_index;
+            return true;
+        }
+    }
+    return false;
+}
+
+idx_t RucksDBTableStorage::AddVectorIndex(std::shared_ptr<RucksDBVectorIndex> index) {
+    auto column_index = index->GetDefinition().column_index;
+    rocksdb::WriteBatch batch;
+    vector<Value> values;
+    vector<float> vector_values;
+    idx_t rows = 0;
+    for (idx_t row_id = 0; row_id < row_count_; row_id++) {
+        if (!storage_->ReadRowValues(table_name_, row_id, values) || column_index >= values.size() ||
+            !RucksDBVectorIndexDefinition::ExtractVector(values[column_index], vector_values)) {
+            continue;
+        }
+        index->Insert(row_id, vector_values, batch);
+        rows++;
+        // Nodes stay cached, so flushing mid-build never loses links
+        if (batch.Count() >= 4096) {
+            schema_->ApplyBatch(batch);
+            batch.Clear();
+        }
+    }
+    schema_->ApplyBatch(batch);
+    
+    UpdateMetadata([&](RucksDBTableMetadata& metadata) { metadata.vector_indexes.push_back(index); });
+    return rows;
+}
+
+void RucksDBTableStorage::RemoveVectorIndex(const string& index_name) {
+    UpdateMetadata([&](RucksDBTableMetadata& metadata) {
+        auto& indexes = metadata.vector_indexes;
+        indexes.erase(std::remove_if(indexes.begin(), indexes.end(),
+                                     [&](const std::shared_ptr<RucksDBVectorIndex>& index) {
+                                         return index->GetDefinition().name == index_name;
+                                     }),
+                      indexes.end());
+    });
+}
+
+std::shared_ptr<RucksDBVectorIndex> RucksDBTableStorage::GetVectorIndex(const string& column) {
+    auto metadata = GetMetadata();
+    for (auto& index : metadata->vector_indexes) {
+        if (StringUtil::CIEquals(index->GetDefinition().column, column)) {
+            return index;
+        }
+    }
+    return nullptr;
+}
+
+void RucksDBTableStorage::IndexChunk(const RucksDBTableMetadata& metadata, const DataChunk& chunk, idx_t start_row,
+                                     rocksdb::WriteBatch& batch) {
+    vector<float> vector_values;
+    for (auto& index : metadata.vector_indexes) {
+        auto column_index = index->GetDefinition().column_index;
+        for (idx_t i = 0; i < chunk.size(); i++) {
+            if (RucksDBVectorIndexDefinition::ExtractVector(chunk.GetValue(column_index, i), vector_values)) {
+                index->Insert(start_row + i, vector_values, batch);
+            }
+        }
+    }
+}
+
+idx_t RucksDBTableStorage::SetTTL(const RucksDBTableTTL& ttl) {
+    // Rows reserved by appends still open are committed before the rows are indexed
+    std::unique_lock<std::shared_mutex> guard(write_lock_);
+    // Index the existing rows, so scans can skip them once their partitions expire
+    partitions_.Clear();
+    rocksdb::WriteBatch batch;
+    vector<Value> values;
+    std::set<int64_t> partitions;
+    for (idx_t row_id = 0; row_id < row_count_; row_id++) {
+        if (!storage_->ReadRowValues(table_name_, row_id, values) || ttl.column_index >= values.size()) {
+            continue;
+        }
+        auto partition = ttl.PartitionOf(values[ttl.column_index]);
+        partitions_.Add(table_name_, partition, RucksDBPartition {row_id, row_id + 1, 1}, batch);
+        partitions.insert(partition);
+        if (batch.Count() >= 4096) {
+            schema_->ApplyBatch(batch);
+            batch.Clear();
+        }
+    }
+    schema_->ApplyBatch(batch);
+    
+    std::atomic_store(&ttl_, std::make_shared<const RucksDBTableTTL>(ttl));
+    return partitions.size();
+}
+
+void RucksDBTableStorage::ClearTTL() {
+    std::unique_lock<std::shared_mutex> guard(write_lock_);
+    std::atomic_store(&ttl_, std::shared_ptr<const RucksDBTableTTL>());
+    partitions_.Clear();
+}
+
+idx_t RucksDBTableStorage::DropExpiredPartitions(idx_t& partitions) {
+    partitions = 0;
+    auto ttl = GetTTL();
+    if (!ttl) {
+        return 0;
+    }
+    rocksdb::WriteBatch batch;
+    idx_t rows = partitions_.DropExpired(table_name_, *ttl, RucksDBTableTTL::Now(), partitions, batch);
+    schema_->ApplyBatch(batch);
+    return rows;
+}
+
+idx_t RucksDBTableStorage::GetFirstLiveRow() {
+    auto ttl = GetTTL();
+    if (!ttl) {
+        return 0;
+    }
+    return partitions_.FirstLiveRow(*ttl, RucksDBTableTTL::Now(), row_count_);
+}
+
+void RucksDBTableStorage::UpdateMetadata(const std::function<void(RucksDBTableMetadata&)>& change) {
+    auto metadata = std::make_shared<RucksDBTableMetadata>(*GetMetadata());
+    change(*metadata);
+    std::atomic_store(&metadata_, std::shared_ptr<const RucksDBTableMetadata>(std::move(metadata)));
+}
+
+void RucksDBTableStorage::AddRollup(RucksDBRollupDefinition rollup) {
+    UpdateMetadata([&](RucksDBTableMetadata& metadata) { metadata.rollups.push_back(std::move(rollup)); });
+}
+
+void RucksDBTableStorage::RemoveRollup(const string& rollup_name) {
+    UpdateMetadata([&](RucksDBTableMetadata& metadata) {
+        auto& rollups = metadata.rollups;
+        rollups.erase(std::remove_if(rollups.begin(), rollups.end(),
+                                     [&](const RucksDBRollupDefinition& rollup) { return rollup.name == rollup_name; }),
+                      rollups.end());
+    });
+}
+
+vector<RucksDBRollupAccumulator> RucksDBTableStorage::StartRollupDeltas(const RucksDBTableMetadata& metadata) {
+    vector<RucksDBRollupAccumulator> accumulators;
+    accumulators.reserve(metadata.rollups.size());
+    for (auto& rollup : metadata.rollups) {
+        accumulators.emplace_back(rollup);
+    }
+    return accumulators;
+}
+
+void RucksDBTableStorage::ApplyDeltas(rocksdb::WriteBatch& deltas, int64_t added_rows,
+                                      vector<RucksDBRollupAccumulator>& accumulators) {
+    // Row count, rollups and partitions take deltas through the merge operator, so nothing is read back
+    if (added_rows != 0) {
+        schema_->MergeTableRowCount(deltas, table_name_, added_rows);
+    }
+    for (auto& accumulator : accumulators) {
+        accumulator.Write(deltas);
+    }
+    if (deltas.Count() > 0) {
+        schema_->ApplyBatch(deltas);
+    }
+}
+
+void RucksDBTableStorage::Append(DataChunk& chunk) {
+    RucksDBAppendState state;
+    InitializeAppend(state);
+    Append(chunk, state);
+    FinalizeAppend(state);
+}
+
+void RucksDBTableStorage::InitializeAppend(RucksDBAppendState& state) {
+    state.batches.clear();
+    state.batches.resize(storage_->ShardCount());
+    state.deltas.Clear();
+    state.metadata = GetMetadata();
+    state.rollups = StartRollupDeltas(*state.metadata);
+    state.stats.Initialize(columns_.size());
+    state.rows = 0;
+    state.next_row = 0;
+}
+
+void RucksDBTableStorage::Append(DataChunk& chunk, RucksDBAppendState& state) {
+    RucksDBOperationTimer timer(metrics_, RucksDBOperation::APPEND);
+    timer.rows = chunk.size();
+    if (auto hot = GetHotTier()) {
+        CheckNotDropped();
+        // Rows appended before the table was tiered are committed first, so that this thread
+        // holds no write lock while it seals
+        if (state.writing) {
+            CommitAppend(state);
+        }
+        hot->Append(chunk);
+        // The mover seals in the background; an appender that outruns it seals inline
+        if (hot->GetRowCount() >= 4 * hot->GetDefinition().row_group_size) {
+            SealHotRows(false);
+        }
+        return;
+    }
+    AppendRows(chunk, state);
+}
+
+idx_t RucksDBTableStorage::AppendRows(DataChunk& chunk, RucksDBAppendState& state) {
+    // Commit before adding rather than after, so whatever the caller adds to state.deltas for
+    // these rows is committed together with them
+    idx_t pending_bytes = state.deltas.GetDataSize();
+    for (auto& batch : state.batches) {
+        pending_bytes += batch.GetDataSize();
+    }
+    if (pending_bytes >= APPEND_COMMIT_BYTES) {
+        CommitAppend(state);
+    }
+    if (!state.writing) {
+        state.writing = std::shared_lock<std::shared_mutex>(write_lock_);
+    }
+    CheckNotDropped();
+    
+    // A clustered table takes the chunk in key order, so row ids follow the key within a batch too
+    DataChunk sorted;
+    vector<string> keys;
+    auto cluster = GetCluster();
+    auto ttl = GetTTL();
+    if (cluster) {
+        vector<string> chunk_keys;
+        chunk_keys.reserve(chunk.size());
+        for (idx_t i = 0; i < chunk.size(); i++) {
+            chunk_keys.push_back(cluster->EncodeKey(chunk, i));
+        }
+        vector<idx_t> order(chunk.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](idx_t a, idx_t b) { return chunk_keys[a] < chunk_keys[b]; });
+        SelectionVector sel(std::max<idx_t>(chunk.size(), 1));
+        keys.reserve(chunk.size());
+        for (idx_t i = 0; i < chunk.size(); i++) {
+            sel.set_index(i, order[i]);
+            keys.push_back(std::move(chunk_keys[order[i]]));
+        }
+        sorted.Initialize(Allocator::DefaultAllocator(), chunk.GetTypes(), std::max<idx_t>(chunk.size(), 1));
+        chunk.Copy(sorted, sel, chunk.size());
+    }
+    auto& rows = cluster ? sorted : chunk;
+    
+    // Rows are readable as gaps until committed, like deleted ones
+    idx_t start_row = row_count_.fetch_add(rows.size());
+    vector<string> encoded_rows;
+    storage_->EncodeChunk(table_name_, start_row, rows, state.batches, ttl.get(), cluster ? &encoded_rows : nullptr);
+    if (cluster) {
+        for (idx_t i = 0; i < rows.size(); i++) {
+            state.deltas.Put(RucksDBClusterDefinition::GetEntryKey(table_name_, keys[i], start_row + i),
+                             encoded_rows[i]);
+        }
+    }
+    if (ttl) {
+        partitions_.Add(table_name_, *ttl, rows, start_row, state.deltas);
+    }
+    IndexChunk(*state.metadata, rows, start_row, state.deltas);
+    for (auto& index : state.metadata->text_indexes) {
+        index.IndexChunk(rows, start_row, state.deltas);
+    }
+    for (auto& accumulator : state.rollups) {
+        accumulator.Add(rows, 1);
+    }
+    state.stats.Update(rows);
+    state.rows += rows.size();
+    state.next_row = std::max(state.next_row, start_row + rows.size());
+    return start_row;
+}
+
+void RucksDBTableStorage::FinalizeAppend(RucksDBAppendState& state) {
+    if (state.rows > 0 || state.deltas.Count() > 0) {
+        CommitAppend(state);
+    }
+    if (state.writing) {
+        state.writing.unlock();
+    }
+}
+
+void RucksDBTableStorage::CommitAppend(RucksDBAppendState& state) {
+    RucksDBTraceScope trace("CommitAppend", "ingest");
+    trace.arg = state.rows;
+    {
+        RucksDBTraceScope write_trace("RocksDB.Write", "io");
+        storage_->ApplyShardBatches(state.batches);
+    }
+    // Rows first, then the row count and high-water mark that make them visible after a restart.
+    // Ids reserved by an append that failed stay below the mark, as gaps.
+    if (state.next_row > 0) {
+        schema_->MergeTableNextRow(state.deltas, table_name_, state.next_row);
+    }
+    ApplyDeltas(state.deltas, (int64_t)state.rows, state.rollups);
+    for (auto& batch : state.batches) {
+        batch.Clear();
+    }
+    state.deltas.Clear();
+    
+    {
+        std::lock_guard<std::mutex> guard(stats_lock_);
+        stats_.Merge(state.stats);
+        schema_->StoreTableStatistics(table_name_, stats_);
+    }
+    state.stats.Initialize(columns_.size());
+    state.rows = 0;
+    state.next_row = 0;
+    if (state.writing) {
+        state.writing.unlock();
+    }
+}
+
+idx_t RucksDBTableStorage::SetCluster(const RucksDBClusterDefinition& cluster) {
+    // Rows reserved by appends still open are committed before the copy starts, and writes wait
+    // until the definition is published
+    std::unique_lock<std::shared_mutex> guard(write_lock_);
+    // Copy the existing rows as stored, out-of-line placeholders included
+    rocksdb::WriteBatch batch;
+    string row_data;
+    vector<Value> values;
+    vector<idx_t> large_columns;
+    idx_t copied = 0;
+    for (idx_t row_id = 0; row_id < row_count_; row_id++) {
+        if (!storage_->ReadRowData(table_name_, row_id, row_data)) {
+            continue;
+        }
+        RucksDBColumnarStorage::DecodeRow(row_data, values, &large_columns);
+        if (!large_columns.empty() && !storage_->ReadRowValues(table_name_, row_id, values)) {
+            continue;
+        }
+        batch.Put(RucksDBClusterDefinition::GetEntryKey(table_name_, cluster.EncodeKey(values), row_id), row_data);
+        copied++;
+        if (batch.Count() >= 4096) {
+            schema_->ApplyBatch(batch);
+            batch.Clear();
+        }
+    }
+    schema_->ApplyBatch(batch);
+    
+    std::atomic_store(&cluster_, std::make_shared<const RucksDBClusterDefinition>(cluster));
+    return copied;
+}
+
+void RucksDBTableStorage::ClearCluster() {
+    // Waits for writes that loaded the definition, so the copies they commit are dropped too
+    std::unique_lock<std::shared_mutex> guard(write_lock_);
+    std::atomic_store(&cluster_, std::shared_ptr<const RucksDBClusterDefinition>());
+}
+
+idx_t RucksDBTableStorage::SetTier(const RucksDBTierDefinition& tier) {
+    // Key the existing rows, so a hot row sealed later replaces the sealed row of its key
+    rocksdb::WriteBatch batch;
+    vector<Value> values;
+    idx_t indexed = 0;
+    for (idx_t row_id = 0; row_id < row_count_; row_id++) {
+        if (!storage_->ReadRowValues(table_name_, row_id, values) || tier.key_index >= values.size() ||
+            values[tier.key_index].IsNull()) {
+            continue;
+        }
+        auto key = RucksDBTierDefinition::KeyOf(values[tier.key_index]);
+        batch.Put(RucksDBHotTier::GetKeyIndexKey(table_name_, key), std::to_string(row_id));
+        indexed++;
+        if (batch.Count() >= 4096) {
+            schema_->ApplyBatch(batch);
+            batch.Clear();
+        }
+    }
+    schema_->ApplyBatch(batch);
+    
+    std::atomic_store(&hot_, std::make_shared<RucksDBHotTier>(schema_->GetStorage(), table_name_, tier));
+    return indexed;
+}
+
+idx_t RucksDBTableStorage::ClearTier() {
+    idx_t sealed = SealHotRows(true);
+    // Threads still holding the hot tier keep it alive until they are done with it
+    std::atomic_store(&hot_, std::shared_ptr<RucksDBHotTier>());
+    return sealed;
+}
+
+idx_t RucksDBTableStorage::SealHotRows(bool force) {
+    std::lock_guard<std::mutex> guard(seal_lock_);
+    auto hot = GetHotTier();
+    if (!hot) {
+        return 0;
+    }
+    idx_t sealed = 0;
+    vector<std::shared_ptr<const DataChunk>> chunks;
+    vector<string> log_keys;
+    while (hot->PeekRowGroup(force, chunks, log_keys)) {
+        sealed += SealChunks(hot->GetDefinition(), chunks, log_keys);
+        // Scans that start from here on read these rows from RocksDB. Ones that started earlier
+        // still hold the chunks, which shadow the new rows' keys.
+        hot->PopChunks(chunks.size());
+        if (force) {
+            break;
+        }
+    }
+    return sealed;
+}
+
+idx_t RucksDBTableStorage::SealChunks(const RucksDBTierDefinition& tier,
+                                      const vector<std::shared_ptr<const DataChunk>>& chunks,
+                                      const vector<string>& log_keys) {
+    RucksDBTraceScope trace("SealRowGroup", "tier");
+    
+    // Only the newest row of each key is sealed; walk newest first, then restore insertion order
+    vector<std::pair<idx_t, idx_t>> rows;
+    vector<string> index_keys;
+    std::unordered_set<string> seen;
+    for (idx_t c = chunks.size(); c-- > 0;) {
+        for (idx_t row = chunks[c]->size(); row-- > 0;) {
+            auto key = RucksDBTierDefinition::KeyOf(chunks[c]->GetValue(tier.key_index, row));
+            if (seen.insert(key).second) {
+                rows.emplace_back(c, row);
+                index_keys.push_back(RucksDBHotTier::GetKeyIndexKey(table_name_, key));
             }
         }
     }
+    std::reverse(rows.begin(), rows.end());
+    std::reverse(index_keys.begin(), index_keys.end());
     
-    // Set values for requested columns
-    for (idx_t i = 0; i < column_ids.size(); i++) {
-        column_t col_id = column_ids[i];
-        if (col_id < values.size()) {
-            result.data[i].SetValue(result_row, values[col_id]);
+    // Sealed rows of the same keys are older versions
+    vector<string> index_values;
+    vector<bool> found;
+    schema_->GetStorage()->MultiReadDataUncached(index_keys, index_values, found);
+    vector<idx_t> replaced;
+    for (idx_t i = 0; i < index_keys.size(); i++) {
+        if (found[i]) {
+            replaced.push_back(std::stoull(index_values[i]));
         }
     }
+    DeleteRowIds(replaced);
     
-    return true;
+    // Key index entries and the removal of the sealed log records land with the row count, so a
+    // crash before it leaves the rows invisible and the hot tier replayed in full
+    vector<LogicalType> types;
+    for (auto& column : columns_) {
+        types.push_back(column.Type());
+    }
+    DataChunk chunk;
+    chunk.Initialize(Allocator::DefaultAllocator(), types);
+    RucksDBAppendState state;
+    InitializeAppend(state);
+    for (idx_t i = 0; i < rows.size(); i++) {
+        auto& source = *chunks[rows[i].first];
+        idx_t out = chunk.size();
+        for (idx_t col = 0; col < types.size(); col++) {
+            chunk.SetValue(col, out, source.GetValue(col, rows[i].second));
+        }
+        chunk.SetCardinality(out + 1);
+        if (chunk.size() < STANDARD_VECTOR_SIZE && i + 1 < rows.size()) {
+            continue;
+        }
+        idx_t start_row = AppendRows(chunk, state);
+        idx_t first = i + 1 - chunk.size();
+        for (idx_t j = 0; j < chunk.size(); j++) {
+            state.deltas.Put(index_keys[first + j], std::to_string(start_row + j));
+        }
+        chunk.Reset();
+    }
+    for (auto& log_key : log_keys) {
+        state.deltas.Delete(log_key);
+    }
+    FinalizeAppend(state);
+    trace.arg = rows.size();
+    return rows.size();
 }
 
-void RucksDBColumnarStorage::DeleteRow(const string& table_name, idx_t row_id) {
-    string key = GetRowKey(table_name, row_id);
-    storage_->DeleteData(key);
+void RucksDBTableStorage::Delete(const Vector& row_ids, idx_t count) {
+    RucksDBOperationTimer timer(metrics_, RucksDBOperation::DELETE);
+    timer.rows = 0;
+    if (GetHotTier()) {
+        // Hot rows have no row ids to delete by
+        throw std::runtime_error("DELETE is not supported on tiered table '" + table_name_ + "'");
+    }
+    vector<idx_t> candidates;
+    for (idx_t i = 0; i < count; i++) {
+        auto row_id_value = row_ids.GetValue(i);
+        if (!row_id_value.IsNull()) {
+            candidates.push_back((idx_t)row_id_value.GetValue<int64_t>());
+        }
+    }
+    timer.rows = DeleteRowIds(candidates);
 }
 
-void RucksDBColumnarStorage::WriteChunk(const string& table_name, idx_t start_row, 
-                                      const DataChunk& chunk) {
-    for (idx_t i = 0; i < chunk.size(); i++) {
-        WriteRow(table_name, start_row + i, chunk, i);
+idx_t RucksDBTableStorage::DeleteRowIds(const vector<idx_t>& row_ids) {
+    std::shared_lock<std::shared_mutex> writing(write_lock_);
+    CheckNotDropped();
+    auto cluster = GetCluster();
+    auto metadata = GetMetadata();
+    // Only count rows that still exist so the live row count stays exact
+    vector<idx_t> deleted;
+    auto rollup_deltas = StartRollupDeltas(*metadata);
+    rocksdb::WriteBatch deltas;
+    for (auto row_id : row_ids) {
+        if (row_id < row_count_ && storage_->ReadRowValues(table_name_, row_id, values_buffer_)) {
+            deleted.push_back(row_id);
+            for (auto& accumulator : rollup_deltas) {
+                accumulator.Add(values_buffer_, -1);
+            }
+            if (cluster) {
+                deltas.Delete(RucksDBClusterDefinition::GetEntryKey(table_name_, cluster->EncodeKey(values_buffer_),
+                                                                    row_id));
+            }
+        }
+    }
+    
+    if (deleted.empty()) {
+        return 0;
+    }
+    storage_->DeleteRows(table_name_, deleted);
+    ApplyDeltas(deltas, -(int64_t)deleted.size(), rollup_deltas);
+    {
+        std::lock_guard<std::mutex> guard(stats_lock_);
+        stats_.RecordDelete(deleted.size());
+        schema_->StoreTableStatistics(table_name_, stats_);
     }
+    return deleted.size();
 }
 
-idx_t RucksDBColumnarStorage::ScanRows(const string& table_name, idx_t start_row, idx_t max_count,
-                                     DataChunk& result, const vector<column_t>& column_ids) {
-    idx_t rows_read = 0;
-    result.Reset();
-    
-    for (idx_t row_id = start_row; row_id < start_row + max_count && rows_read < STANDARD_VECTOR_SIZE; row_id++) {
-        if (ReadRow(table_name, row_id, result, rows_read, column_ids)) {
-            rows_read++;
+void RucksDBTableStorage::Update(const Vector& row_ids, const vector<column_t>& column_ids, DataChunk& data) {
+    if (GetHotTier()) {
+        throw std::runtime_error("UPDATE is not supported on tiered table '" + table_name_ +
+                                 "'; insert the new row under the same key instead");
+    }
+    RucksDBOperationTimer timer(metrics_, RucksDBOperation::PUT);
+    timer.rows = data.size();
+    std::shared_lock<std::shared_mutex> writing(write_lock_);
+    CheckNotDropped();
+    auto cluster = GetCluster();
+    auto ttl = GetTTL();
+    auto metadata = GetMetadata();
+    auto rollup_deltas = StartRollupDeltas(*metadata);
+    rocksdb::WriteBatch deltas;
+    vector<float> vector_values;
+    for (idx_t i = 0; i < data.size(); i++) {
+        auto row_id = (idx_t)row_ids.GetValue(i).GetValue<int64_t>();
+        if (!storage_->ReadRowValues(table_name_, row_id, values_buffer_)) {
+            continue;
+        }
+        values_buffer_.resize(columns_.size());
+        // An update moves the row out of its old group and into the new one
+        for (auto& accumulator : rollup_deltas) {
+            accumulator.Add(values_buffer_, -1);
+        }
+        string old_key = cluster ? cluster->EncodeKey(values_buffer_) : string();
+        for (idx_t col_idx = 0; col_idx < column_ids.size(); col_idx++) {
+            values_buffer_[column_ids[col_idx]] = data.data[col_idx].GetValue(i);
+        }
+        for (auto& accumulator : rollup_deltas) {
+            accumulator.Add(values_buffer_, 1);
+        }
+        string row_data;
+        storage_->WriteRowValues(table_name_, row_id, values_buffer_, ttl.get(), &row_data);
+        // The clustered copy moves with its key and always takes the new values
+        if (cluster) {
+            string new_key = cluster->EncodeKey(values_buffer_);
+            if (new_key != old_key) {
+                deltas.Delete(RucksDBClusterDefinition::GetEntryKey(table_name_, old_key, row_id));
+            }
+            deltas.Put(RucksDBClusterDefinition::GetEntryKey(table_name_, new_key, row_id), row_data);
+        }
+        // A changed vector is re-linked at its new position; older links to the row stay valid
+        for (auto& index : metadata->vector_indexes) {
+            auto column_index = index->GetDefinition().column_index;
+            if (std::find(column_ids.begin(), column_ids.end(), column_index) != column_ids.end() &&
+                RucksDBVectorIndexDefinition::ExtractVector(values_buffer_[column_index], vector_values)) {
+                index->Insert(row_id, vector_values, deltas);
+            }
+        }
+        // New terms are merged in; postings of the old text stay and are filtered by the query
+        for (auto& index : metadata->text_indexes) {
+            if (std::find(column_ids.begin(), column_ids.end(), index.column_index) != column_ids.end() &&
+                !values_buffer_[index.column_index].IsNull()) {
+                index.IndexRows({row_id}, {values_buffer_[index.column_index].ToString()}, deltas);
+            }
         }
     }
+    ApplyDeltas(deltas, 0, rollup_deltas);
     
-    result.SetCardinality(rows_read);
-    return rows_read;
+    std::lock_guard<std::mutex> guard(stats_lock_);
+    stats_.RecordUpdate(column_ids, data);
+    schema_->StoreTableStatistics(table_name_, stats_);
 }
 
-// Table storage implementation
-RucksDBTableStorage::RucksDBTableStorage(const string& table_name, RucksDBSchema* schema, 
-                                       RucksDBColumnarStorage* storage)
-    : table_name_(table_name), schema_(schema), storage_(storage), row_count_(0) {
+unique_ptr<BaseStatistics> RucksDBTableStorage::GetColumnStatistics(column_t column_id, const LogicalType& type) const {
+    // Hot rows reach the statistics only once sealed, so the newest rows would fall outside the bounds
+    if (GetHotTier()) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> guard(stats_lock_);
+    // Stale statistics, e.g. of a table without a statistics record, may exclude committed rows
+    if (stats_.IsStale() || column_id >= stats_.ColumnCount()) {
+        return nullptr;
+    }
+    return stats_.GetColumn(column_id).ToBaseStatistics(type);
 }
 
-void RucksDBTableStorage::Initialize(const vector<ColumnDefinition>& columns) {
-    columns_ = columns;
-    row_count_ = schema_->LoadTableRowCount(table_name_);
+bool RucksDBTableStorage::FetchRow(idx_t row_id, vector<Value>& values) {
+    if (row_id >= row_count_ || !storage_->ReadRowValues(table_name_, row_id, values)) {
+        return false;
+    }
+    auto ttl = GetTTL();
+    if (ttl && ttl->IsExpiredRow(values, RucksDBTableTTL::Now())) {
+        return false;
+    }
+    auto hot = GetHotTier();
+    return !hot || !hot->Snapshot()->Shadows(values);
 }
 
-void RucksDBTableStorage::Append(DataChunk& chunk) {
-    storage_->WriteChunk(table_name_, row_count_, chunk);
-    row_count_ += chunk.size();
-    schema_->StoreTableMetadata(table_name_, row_count_);
+void RucksDBTableStorage::FetchRows(const vector<idx_t>& row_ids, vector<vector<Value>>& rows,
+                                    vector<bool>& found) {
+    storage_->ReadRowsValues(table_name_, row_ids, rows, found);
+    auto ttl = GetTTL();
+    int64_t now = ttl ? RucksDBTableTTL::Now() : 0;
+    // A sealed row whose key has a newer row in the hot tier is a superseded version
+    std::shared_ptr<const RucksDBHotSnapshot> hot;
+    if (auto hot_tier = GetHotTier()) {
+        hot = hot_tier->Snapshot();
+    }
+    for (idx_t i = 0; i < row_ids.size(); i++) {
+        if (found[i] && (row_ids[i] >= row_count_ || (ttl && ttl->IsExpiredRow(rows[i], now)) ||
+                         (hot && hot->Shadows(rows[i])))) {
+            found[i] = false;
+        }
+    }
 }
 
-void RucksDBTableStorage::InitializeScan(TableScanState& state, const vector<column_t>& column_ids) {
-    auto& scan_state = (RucksDBScanState&)state;
-    scan_state.current_row = 0;
-    scan_state.total_rows = row_count_;
+void RucksDBTableStorage::InitializeScan(RucksDBScanState& scan_state, const vector<column_t>& column_ids,
+                                         idx_t start_row, idx_t end_row) {
+    scan_state.current_row = start_row;
+    scan_state.total_rows = std::min<idx_t>(end_row, row_count_);
     scan_state.table_name = table_name_;
     scan_state.column_ids = column_ids;
-    scan_state.finished = false;
+    scan_state.finished = scan_state.current_row >= scan_state.total_rows;
+    scan_state.prefetch = storage_->PrefetchScans();
 }
 
-void RucksDBTableStorage::Scan(DataChunk& result, TableScanState& state, 
+void RucksDBTableStorage::Scan(DataChunk& result, RucksDBScanState& scan_state, 
                              const vector<column_t>& column_ids) {
-    auto& scan_state = (RucksDBScanState&)state;
-    
     if (scan_state.finished || scan_state.current_row >= scan_state.total_rows) {
+        scan_state.finished = true;
         return;
     }
     
-    idx_t rows_to_read = std::min((idx_t)STANDARD_VECTOR_SIZE, 
-                                 scan_state.total_rows - scan_state.current_row);
-    
-    idx_t rows_read = storage_->ScanRows(table_name_, scan_state.current_row, rows_to_read,
-                                       result, column_ids);
-    
-    scan_state.current_row += rows_read;
+    RucksDBOperationTimer timer(metrics_, RucksDBOperation::SCAN);
+    auto ttl = GetTTL();
+    int64_t now = ttl ? RucksDBTableTTL::Now() : 0;
+    if (!scan_state.prefetch) {
+        // Stops after a full vector or at the end of the range, skipping deleted row ids
+        timer.rows = storage_->ScanRows(table_name_, scan_state.current_row, scan_state.total_rows,
+                                        result, column_ids, ttl.get(), now, scan_state.hot);
+    } else {
+        // Deleted rows may leave this vector short; the next call continues after it
+        idx_t count = std::min<idx_t>(STANDARD_VECTOR_SIZE, scan_state.total_rows - scan_state.current_row);
+        RucksDBRowBatch batch;
+        if (scan_state.pending.Pending()) {
+            RucksDBTraceScope wait_trace("WaitPrefetch", "scan");
+            scan_state.pending.Wait(batch);
+        }
+        if (batch.start_row != scan_state.current_row || batch.count != count) {
+            storage_->ReadRowBatch(table_name_, scan_state.current_row, count, column_ids, batch);
+        }
+        
+        // Start reading the next vector, or the first of the queued morsel, before returning this one
+        idx_t next_start = scan_state.current_row + count;
+        idx_t next_end = scan_state.total_rows;
+        if (next_start >= next_end && scan_state.queued) {
+            next_start = scan_state.queued_start;
+            next_end = scan_state.queued_end;
+        }
+        if (next_start < next_end) {
+            idx_t next_count = std::min<idx_t>(STANDARD_VECTOR_SIZE, next_end - next_start);
+            scan_state.pending.Start(storage_, table_name_, next_start, next_count, column_ids);
+        }
+        
+        result.Reset();
+        timer.rows = storage_->EmitRows(batch, result, 0, column_ids, ttl.get(), now, scan_state.hot);
+        result.SetCardinality(timer.rows);
+        scan_state.current_row += count;
+    }
     
-    if (scan_state.current_row >= scan_state.total_rows || rows_read == 0) {
+    if (scan_state.current_row >= scan_state.total_rows) {
         scan_state.finished = true;
     }
 }
 
+void RucksDBTableStorage::ScanCluster(DataChunk& result, string& next_key, const string& end_key,
+                                      const rocksdb::Snapshot* snapshot, const vector<column_t>& column_ids) {
+    RucksDBOperationTimer timer(metrics_, RucksDBOperation::SCAN);
+    timer.rows = storage_->ScanClusterRange(table_name_, next_key, end_key, snapshot, result, column_ids);
+}
+
+RucksDBScanPrefetcher::~RucksDBScanPrefetcher() {
+    if (worker_.joinable()) {
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        worker_.join();
+    }
+}
+
+void RucksDBScanPrefetcher::Start(RucksDBColumnarStorage* storage, const string& table_name, idx_t start_row,
+                                  idx_t count, const vector<column_t>& column_ids) {
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        storage_ = storage;
+        table_name_ = table_name;
+        start_row_ = start_row;
+        count_ = count;
+        column_ids_ = column_ids;
+        requested_ = true;
+        done_ = false;
+        error_ = nullptr;
+    }
+    if (!worker_.joinable()) {
+        worker_ = std::thread([this]() { Run(); });
+    }
+    cv_.notify_all();
+}
+
+bool RucksDBScanPrefetcher::Pending() {
+    std::lock_guard<std::mutex> guard(lock_);
+    return requested_;
+}
+
+void RucksDBScanPrefetcher::Wait(RucksDBRowBatch& batch) {
+    std::unique_lock<std::mutex> lock(lock_);
+    cv_.wait(lock, [this]() { return done_; });
+    requested_ = false;
+    done_ = false;
+    if (error_) {
+        auto error = error_;
+        error_ = nullptr;
+        std::rethrow_exception(error);
+    }
+    batch = std::move(batch_);
+}
+
+void RucksDBScanPrefetcher::Run() {
+    std::unique_lock<std::mutex> lock(lock_);
+    while (true) {
+        cv_.wait(lock, [this]() { return stop_ || (requested_ && !done_); });
+        if (stop_) {
+            return;
+        }
+        // The request stays untouched until Wait takes the result, so it is read without the lock
+        lock.unlock();
+        RucksDBRowBatch batch;
+        std::exception_ptr error;
+        try {
+            storage_->ReadRowBatch(table_name_, start_row_, count_, column_ids_, batch);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        lock.lock();
+        batch_ = std::move(batch);
+        error_ = error;
+        done_ = true;
+        cv_.notify_all();
+    }
+}
+
 // Table function implementation
 void RocksDBTableFunction::RegisterFunction(DatabaseInstance& db) {
+    ExtensionUtil::RegisterFunction(db, GetFunction());
+}
+
+TableFunction RocksDBTableFunction::GetFunction() {
     TableFunction rocksdb_scan("rocksdb_scan", {LogicalType::VARCHAR}, Bind, InitGlobal, InitLocal);
     rocksdb_scan.function = Execute;
-    ExtensionUtil::RegisterFunction(db, rocksdb_scan);
+    rocksdb_scan.cardinality = Cardinality;
+    rocksdb_scan.statistics = Statistics;
+    // Only the projected columns (and the row id, for DELETE/UPDATE) are materialized
+    rocksdb_scan.projection_pushdown = true;
+    // rocksdb_scan('t', database := 'name') reads from an attached or opened instance
+    rocksdb_scan.named_parameters["database"] = LogicalType::VARCHAR;
+    // prefetch := false reads each vector only when asked for, e.g. to compare against prefetching
+    rocksdb_scan.named_parameters["prefetch"] = LogicalType::BOOLEAN;
+    return rocksdb_scan;
 }
 
 unique_ptr<FunctionData> RocksDBTableFunction::Bind(ClientContext& context, 
@@ -317,13 +2298,14 @@ unique_ptr<FunctionData> RocksDBTableFunction::Bind(ClientContext& context,
                                                    vector<LogicalType>& return_types, 
                                                    vector<string>& names) {
     auto table_name = input.inputs[0].GetValue<string>();
+    auto instance = RucksDBInstanceRegistry::Get(input);
     
-    if (!g_table_registry || !g_table_registry->TableExists(table_name)) {
+    if (!instance.registry->TableExists(table_name)) {
         throw std::runtime_error("RocksDB table '" + table_name + "' does not exist");
     }
     
-    auto table_storage = g_table_registry->GetTable(table_name);
-    auto columns = table_storage->GetColumns();
+    auto table_storage = instance.registry->GetTable(table_name);
+    auto& columns = table_storage->GetColumns();
     
     for (const auto& col : columns) {
         return_types.push_back(col.Type());
@@ -335,6 +2317,10 @@ unique_ptr<FunctionData> RocksDBTableFunction::Bind(ClientContext& context,
     bind_data->types = return_types;
     bind_data->names = names;
     bind_data->table_storage = table_storage;
+    auto prefetch = input.named_parameters.find("prefetch");
+    if (prefetch != input.named_parameters.end()) {
+        bind_data->prefetch = prefetch->second;
+    }
     
     return std::move(bind_data);
 }
@@ -345,7 +2331,24 @@ unique_ptr<GlobalTableFunctionState> RocksDBTableFunction::InitGlobal(ClientCont
     
     auto global_state = make_unique<RocksDBGlobalState>();
     global_state->table_name = bind_data.table_name;
+    // Snapshot the hot tier before reading the row count: rows sealed in between are then in both
+    // views, and the hot copy shadows the sealed one
+    if (auto hot = bind_data.table_storage->GetHotTier()) {
+        global_state->hot = hot->Snapshot();
+    }
     global_state->total_rows = bind_data.table_storage->GetRowCount();
+    global_state->morsel_size = bind_data.table_storage->GetMorselSize();
+    // Rows below the oldest live partition have expired
+    global_state->next_row = bind_data.table_storage->GetFirstLiveRow();
+    
+    // A key range pushed down at planning applies only while the table keeps the same clustering key
+    auto cluster = bind_data.table_storage->GetCluster();
+    if (bind_data.cluster_range && cluster && cluster->Serialize() == bind_data.cluster_range->key_columns) {
+        global_state->clustered = true;
+        global_state->cluster_next_key = bind_data.cluster_range->lower;
+        global_state->cluster_end_key = bind_data.cluster_range->upper;
+        global_state->cluster_snapshot = bind_data.table_storage->GetClusterSnapshot();
+    }
     
     return std::move(global_state);
 }
@@ -353,33 +2356,265 @@ unique_ptr<GlobalTableFunctionState> RocksDBTableFunction::InitGlobal(ClientCont
 unique_ptr<LocalTableFunctionState> RocksDBTableFunction::InitLocal(ExecutionContext& context,
                                                                    TableFunctionInitInput& input,
                                                                    GlobalTableFunctionState* global_state) {
-    return make_unique<RucksDBScanState>();
+    auto& bind_data = (RocksDBBindData&)*input.bind_data;
+    
+    // Starts with an empty range; Execute claims row ranges from the global state
+    auto local_state = make_unique<RucksDBScanState>();
+    bind_data.table_storage->InitializeScan(*local_state, input.column_ids, 0, 0);
+    if (!bind_data.prefetch.IsNull()) {
+        local_state->prefetch = BooleanValue::Get(bind_data.prefetch);
+    }
+    local_state->hot = ((RocksDBGlobalState*)global_state)->hot.get();
+    return std::move(local_state);
 }
 
 void RocksDBTableFunction::Execute(ClientContext& context, TableFunctionInput& data, 
                                  DataChunk& output) {
     auto& bind_data = (RocksDBBindData&)*data.bind_data;
+    auto& global_state = (RocksDBGlobalState&)*data.global_state;
     auto& local_state = (RucksDBScanState&)*data.local_state;
     
-    // Initialize column ids for all columns
-    if (local_state.column_ids.empty()) {
-        for (idx_t i = 0; i < bind_data.types.size(); i++) {
-            local_state.column_ids.push_back(i);
+    RucksDBTraceScope trace("rocksdb_scan", "duckdb");
+    if (global_state.clustered) {
+        // Single-threaded (see MaxThreads), so the cursor needs no lock
+        if (!global_state.cluster_next_key.empty()) {
+            bind_data.table_storage->ScanCluster(output, global_state.cluster_next_key, global_state.cluster_end_key,
+                                                 global_state.cluster_snapshot.get(), local_state.column_ids);
+        }
+        trace.arg = output.size();
+        return;
+    }
+    // Threads claim morsels of consecutive row ids, so scans run in parallel and, with range
+    // sharding, each morsel reads from a single shard
+    while (output.size() == 0) {
+        if (local_state.finished) {
+            if (local_state.queued) {
+                local_state.current_row = local_state.queued_start;
+                local_state.total_rows = local_state.queued_end;
+                local_state.queued = false;
+            } else {
+                idx_t start_row = global_state.next_row.fetch_add(global_state.morsel_size);
+                if (start_row >= global_state.total_rows) {
+                    // Sealed rows are all claimed; tiered tables go on with their hot chunks
+                    if (!global_state.hot) {
+                        break;
+                    }
+                    idx_t chunk_idx = global_state.next_hot_chunk++;
+                    if (chunk_idx >= global_state.hot->chunks.size()) {
+                        break;
+                    }
+                    global_state.hot->Emit(chunk_idx, output, local_state.column_ids);
+                    continue;
+                }
+                local_state.current_row = start_row;
+                local_state.total_rows = std::min(start_row + global_state.morsel_size, global_state.total_rows);
+            }
+            local_state.finished = false;
+        }
+        // A prefetching scan claims its next morsel when reading the last vector of this one
+        if (local_state.prefetch && !local_state.queued &&
+            local_state.current_row + STANDARD_VECTOR_SIZE >= local_state.total_rows) {
+            idx_t start_row = global_state.next_row.fetch_add(global_state.morsel_size);
+            if (start_row < global_state.total_rows) {
+                local_state.queued = true;
+                local_state.queued_start = start_row;
+                local_state.queued_end = std::min(start_row + global_state.morsel_size, global_state.total_rows);
+            }
         }
-        bind_data.table_storage->InitializeScan(local_state, local_state.column_ids);
+        bind_data.table_storage->Scan(output, local_state, local_state.column_ids);
     }
+    trace.arg = output.size();
+}
+
+unique_ptr<NodeStatistics> RocksDBTableFunction::Cardinality(ClientContext& context,
+                                                             const FunctionData* bind_data_p) {
+    auto& bind_data = (const RocksDBBindData&)*bind_data_p;
     
-    bind_data.table_storage->Scan(output, local_state, local_state.column_ids);
+    // Row count is kept in sync with LoadTableRowCount by Append and Delete, so the estimate is exact
+    idx_t row_count = bind_data.table_storage->GetLiveRowCount();
+    return make_unique<NodeStatistics>(row_count, row_count);
+}
+
+unique_ptr<BaseStatistics> RocksDBTableFunction::Statistics(ClientContext& context, 
+                                                            const FunctionData* bind_data_p,
+                                                            column_t column_index) {
+    auto& bind_data = (const RocksDBBindData&)*bind_data_p;
+    if (column_index >= bind_data.types.size()) {
+        return nullptr;
+    }
+    return bind_data.table_storage->GetColumnStatistics(column_index, bind_data.types[column_index]);
 }
 
 // Table registry implementation
-RucksDBTableRegistry::RucksDBTableRegistry(RocksDBStorage* storage) {
+RucksDBTableRegistry::RucksDBTableRegistry(RocksDBStorage* storage)
+    : rocksdb_(storage), catch_up_epoch_(storage->GetCatchUpEpoch()) {
     schema_ = make_unique<RucksDBSchema>(storage);
     storage_ = make_unique<RucksDBColumnarStorage>(storage);
+    if (!storage->IsReadOnly()) {
+        InstallExpiryCheck();
+    }
+}
+
+RucksDBTableRegistry::~RucksDBTableRegistry() {
+    if (mover_.joinable()) {
+        {
+            std::lock_guard<std::mutex> guard(mover_lock_);
+            mover_stop_ = true;
+        }
+        mover_cv_.notify_all();
+        mover_.join();
+    }
+    // The next open then reads the catalog in one go; failing here only costs it a schema scan
+    if (!rocksdb_->IsReadOnly()) {
+        try {
+            schema_->SaveSnapshot();
+        } catch (std::exception&) {
+        }
+    }
+}
+
+void RucksDBTableRegistry::StartMover() {
+    // Secondaries replay the primary's hot tiers but never seal them
+    if (rocksdb_->IsReadOnly()) {
+        return;
+    }
+    std::call_once(mover_started_, [this]() { mover_ = std::thread([this]() { MoverLoop(); }); });
+}
+
+void RucksDBTableRegistry::MoverLoop() {
+    auto interval = std::chrono::milliseconds(TIER_MOVE_INTERVAL_MS);
+    std::unique_lock<std::mutex> lock(mover_lock_);
+    while (!mover_cv_.wait_for(lock, interval, [this]() { return mover_stop_; })) {
+        vector<RucksDBTableStorage*> tiered;
+        {
+            std::lock_guard<std::mutex> guard(tables_lock_);
+            for (auto& entry : tables_) {
+                if (entry.second->GetHotTier()) {
+                    tiered.push_back(entry.second.get());
+                }
+            }
+        }
+        for (auto* table : tiered) {
+            try {
+                table->SealHotRows(false);
+            } catch (std::exception&) {
+                // The rows stay hot and logged; the next pass tries again
+            }
+        }
+    }
+}
+
+idx_t RucksDBTableRegistry::SetTableTier(const string& table_name, RucksDBTierDefinition tier) {
+    auto* table = GetTable(table_name);
+    if (!table) {
+        throw std::runtime_error("RocksDB table '" + table_name + "' does not exist");
+    }
+    if (table->GetCluster()) {
+        throw std::runtime_error("RocksDB table '" + table_name + "' is clustered; clustered tables cannot be tiered");
+    }
+    tier.Bind(table->GetColumns());
+    
+    idx_t indexed;
+    {
+        std::lock_guard<std::mutex> guard(mover_lock_);
+        // A new key needs a new key index, so an earlier tiering is sealed and dropped first
+        if (table->GetHotTier()) {
+            table->ClearTier();
+        }
+        schema_->DropTableTier(table_name);
+        schema_->StoreTableTier(table_name, tier);
+        indexed = table->SetTier(tier);
+    }
+    StartMover();
+    return indexed;
+}
+
+idx_t RucksDBTableRegistry::ClearTableTier(const string& table_name) {
+    auto* table = GetTable(table_name);
+    if (!table) {
+        throw std::runtime_error("RocksDB table '" + table_name + "' does not exist");
+    }
+    std::lock_guard<std::mutex> guard(mover_lock_);
+    idx_t sealed = table->ClearTier();
+    schema_->DropTableTier(table_name);
+    return sealed;
+}
+
+idx_t RucksDBTableRegistry::SealTable(const string& table_name) {
+    auto* table = GetTable(table_name);
+    if (!table) {
+        throw std::runtime_error("RocksDB table '" + table_name + "' does not exist");
+    }
+    if (!table->GetHotTier()) {
+        throw std::runtime_error("RocksDB table '" + table_name + "' is not tiered");
+    }
+    std::lock_guard<std::mutex> guard(mover_lock_);
+    return table->SealHotRows(true);
+}
+
+idx_t RucksDBTableRegistry::SetTableClustering(const string& table_name, RucksDBClusterDefinition cluster) {
+    auto* table = GetTable(table_name);
+    if (!table) {
+        throw std::runtime_error("RocksDB table '" + table_name + "' does not exist");
+    }
+    // Hot rows have no row ids to key a copy by, and expired rows would linger in the copies
+    if (table->GetHotTier() || table->GetTTL()) {
+        throw std::runtime_error("RocksDB table '" + table_name + "' has tiering or a TTL and cannot be clustered");
+    }
+    cluster.Bind(table->GetColumns());
+    
+    std::lock_guard<std::mutex> guard(tables_lock_);
+    // Copies under an earlier key are dropped before the rows are copied under the new one
+    table->ClearCluster();
+    schema_->DropTableCluster(table_name);
+    schema_->StoreTableCluster(table_name, cluster);
+    return table->SetCluster(cluster);
+}
+
+void RucksDBTableRegistry::ClearTableClustering(const string& table_name) {
+    auto* table = GetTable(table_name);
+    if (!table) {
+        throw std::runtime_error("RocksDB table '" + table_name + "' does not exist");
+    }
+    std::lock_guard<std::mutex> guard(tables_lock_);
+    table->ClearCluster();
+    schema_->DropTableCluster(table_name);
+}
+
+idx_t RucksDBTableRegistry::ReclusterTable(const string& table_name) {
+    auto* table = GetTable(table_name);
+    if (!table) {
+        throw std::runtime_error("RocksDB table '" + table_name + "' does not exist");
+    }
+    if (!table->GetCluster()) {
+        throw std::runtime_error("RocksDB table '" + table_name + "' is not clustered");
+    }
+    // Each append leaves its copies as a sorted run; compaction merges the runs in the background,
+    // and this merges them now
+    rocksdb_->CompactPrefix(RucksDBClusterDefinition::GetPrefix(table_name));
+    return table->GetLiveRowCount();
+}
+
+void RucksDBTableRegistry::RefreshIfStale() {
+    uint64_t epoch = rocksdb_->GetCatchUpEpoch();
+    if (epoch == catch_up_epoch_) {
+        return;
+    }
+    catch_up_epoch_ = epoch;
+    
+    schema_->LoadSchemas();
+    // Entries of tables dropped by the primary stay allocated, since catalog entries may reference them.
+    // Reload publishes what it re-reads atomically, so queries running on a table are not disturbed.
+    for (auto& entry : tables_) {
+        if (schema_->TableExists(entry.first)) {
+            entry.second->Reload();
+        }
+    }
 }
 
 void RucksDBTableRegistry::CreateTable(const string& name, const vector<ColumnDefinition>& columns) {
-    if (TableExists(name)) {
+    std::lock_guard<std::mutex> guard(tables_lock_);
+    if (schema_->TableExists(name)) {
         throw std::runtime_error("Table '" + name + "' already exists");
     }
     
@@ -392,28 +2627,47 @@ void RucksDBTableRegistry::CreateTable(const string& name, const vector<ColumnDe
 }
 
 void RucksDBTableRegistry::DropTable(const string& name) {
-    if (!TableExists(name)) {
+    std::lock_guard<std::mutex> mover_guard(mover_lock_);
+    std::lock_guard<std::mutex> guard(tables_lock_);
+    if (!schema_->TableExists(name)) {
         throw std::runtime_error("Table '" + name + "' does not exist");
     }
     
+    auto it = tables_.find(name);
+    bool had_ttl = it != tables_.end() && it->second->GetTTL();
+    if (it != tables_.end()) {
+        it->second->MarkDropped();
+    }
     schema_->DropTable(name);
-    tables_.erase(name);
+    storage_->DropTableData(name);
+    if (it != tables_.end()) {
+        dropped_tables_.push_back(std::move(it->second));
+        tables_.erase(it);
+    }
+    if (had_ttl) {
+        InstallExpiryCheck();
+    }
 }
 
 RucksDBTableStorage* RucksDBTableRegistry::GetTable(const string& name) {
+    std::lock_guard<std::mutex> guard(tables_lock_);
+    RefreshIfStale();
     auto it = tables_.find(name);
-    if (it != tables_.end()) {
+    if (it != tables_.end() && schema_->TableExists(name)) {
         return it->second.get();
     }
     
     // Try to load from storage
-    if (schema_->TableExists(name)) {
+    if (it == tables_.end() && schema_->TableExists(name)) {
         auto columns = schema_->GetTableSchema(name);
         auto table_storage = make_unique<RucksDBTableStorage>(name, schema_.get(), storage_.get());
         table_storage->Initialize(columns);
         
         auto* ptr = table_storage.get();
         tables_[name] = std::move(table_storage);
+        if (ptr->GetHotTier()) {
+            StartMover();
+        }
         return ptr;
     }
     
@@ -421,15 +2675,195 @@ RucksDBTableStorage* RucksDBTableRegistry::GetTable(const string& name) {
 }
 
 bool RucksDBTableRegistry::TableExists(const string& name) {
-    return tables_.find(name) != tables_.end() || schema_->TableExists(name);
+    {
+        std::lock_guard<std::mutex> guard(tables_lock_);
+        RefreshIfStale();
+    }
+    // Served from the schema cache, which covers every persisted table
+    return schema_->TableExists(name);
+}
+
+vector<ColumnDefinition> RucksDBTableRegistry::GetTableColumns(const string& name) {
+    {
+        std::lock_guard<std::mutex> guard(tables_lock_);
+        RefreshIfStale();
+    }
+    return schema_->GetTableSchema(name);
 }
 
 vector<string> RucksDBTableRegistry::ListTables() {
-    vector<string> table_names;
-    for (const auto& pair : tables_) {
-        table_names.push_back(pair.first);
+    {
+        std::lock_guard<std::mutex> guard(tables_lock_);
+        RefreshIfStale();
+    }
+    // Persisted schemas cover tables created by earlier processes as well
+    return schema_->ListTables();
+}
+
+idx_t RucksDBTableRegistry::CreateRollup(RucksDBRollupDefinition rollup) {
+    if (rollup.name.empty()) {
+        throw std::runtime_error("Rollup name must not be empty");
+    }
+    for (char c : rollup.name) {
+        if (!isalnum((unsigned char)c) && c != '_') {
+            throw std::runtime_error("Rollup name '" + rollup.name + "' may only contain letters, digits and _");
+        }
+    }
+    auto* table = GetTable(rollup.table_name);
+    if (!table) {
+        throw std::runtime_error("RocksDB table '" + rollup.table_name + "' does not exist");
+    }
+    
+    std::lock_guard<std::mutex> guard(tables_lock_);
+    for (auto& existing : schema_->LoadRollups()) {
+        if (existing.name == rollup.name) {
+            throw std::runtime_error("Rollup '" + rollup.name + "' already exists");
+        }
+    }
+    rollup.Bind(table->GetColumns());
+    // Clears groups a crashed earlier attempt may have left behind
+    schema_->DropRollup(rollup.name);
+    schema_->StoreRollup(rollup);
+    
+    // Backfill from the existing rows, flushing the groups in bounded batches
+    RucksDBRollupAccumulator accumulator(rollup);
+    vector<Value> values;
+    idx_t rows = 0;
+    for (idx_t row_id = 0; row_id < table->GetRowCount(); row_id++) {
+        if (!storage_->ReadRowValues(rollup.table_name, row_id, values)) {
+            continue;
+        }
+        accumulator.Add(values, 1);
+        rows++;
+        if (accumulator.GroupCount() >= 65536) {
+            rocksdb::WriteBatch batch;
+            accumulator.Write(batch);
+            schema_->ApplyBatch(batch);
+        }
+    }
+    rocksdb::WriteBatch batch;
+    accumulator.Write(batch);
+    schema_->ApplyBatch(batch);
+    
+    table->AddRollup(std::move(rollup));
+    return rows;
+}
+
+idx_t RucksDBTableRegistry::CreateVectorIndex(RucksDBVectorIndexDefinition index) {
+    if (index.name.empty()) {
+        throw std::runtime_error("Vector index name must not be empty");
+    }
+    for (char c : index.name) {
+        if (!isalnum((unsigned char)c) && c != '_') {
+            throw std::runtime_error("Vector index name '" + index.name + "' may only contain letters, digits and _");
+        }
+    }
+    auto* table = GetTable(index.table_name);
+    if (!table) {
+        throw std::runtime_error("RocksDB table '" + index.table_name + "' does not exist");
+    }
+    
+    std::lock_guard<std::mutex> guard(tables_lock_);
+    for (auto& existing : schema_->LoadVectorIndexes()) {
+        if (existing.name == index.name) {
+            throw std::runtime_error("Vector index '" + index.name + "' already exists");
+        }
+    }
+    index.Bind(table->GetColumns());
+    if (table->GetVectorIndex(index.column)) {
+        throw std::runtime_error("Column '" + index.column + "' already has a vector index");
+    }
+    // Clears nodes a crashed earlier build may have left behind
+    schema_->DropVectorIndex(index.name);
+    schema_->StoreVectorIndex(index);
+    
+    return table->AddVectorIndex(std::make_shared<RucksDBVectorIndex>(rocksdb_, index));
+}
+
+idx_t RucksDBTableRegistry::CreateTextIndex(RucksDBTextIndexDefinition index) {
+    if (index.name.empty()) {
+        throw std::runtime_error("Text index name must not be empty");
+    }
+    for (char c : index.name) {
+        if (!isalnum((unsigned char)c) && c != '_') {
+            throw std::runtime_error("Text index name '" + index.name + "' may only contain letters, digits and _");
+        }
+    }
+    auto* table = GetTable(index.table_name);
+    if (!table) {
+        throw std::runtime_error("RocksDB table '" + index.table_name + "' does not exist");
+    }
+    
+    std::lock_guard<std::mutex> guard(tables_lock_);
+    for (auto& existing : schema_->LoadTextIndexes()) {
+        if (existing.name == index.name) {
+            throw std::runtime_error("Text index '" + index.name + "' already exists");
+        }
+    }
+    index.Bind(table->GetColumns());
+    RucksDBTextIndexDefinition existing;
+    if (table->GetTextIndex(index.column, existing)) {
+        throw std::runtime_error("Column '" + index.column + "' already has a text index");
+    }
+    // Clears postings a crashed earlier build may have left behind
+    schema_->DropTextIndex(index.name);
+    schema_->StoreTextIndex(index);
+    
+    return table->AddTextIndex(index);
+}
+
+void RucksDBTableRegistry::DropTextIndex(const string& name) {
+    std::lock_guard<std::mutex> guard(tables_lock_);
+    for (auto& index : schema_->LoadTextIndexes()) {
+        if (index.name != name) {
+            continue;
+        }
+        schema_->DropTextIndex(name);
+        auto it = tables_.find(index.table_name);
+        if (it != tables_.end()) {
+            it->second->RemoveTextIndex(name);
+        }
+        return;
+    }
+    throw std::runtime_error("Text index '" + name + "' does not exist");
+}
+
+void RucksDBTableRegistry::DropVectorIndex(const string& name) {
+    std::lock_guard<std::mutex> guard(tables_lock_);
+    for (auto& index : schema_->LoadVectorIndexes()) {
+        if (index.name != name) {
+            continue;
+        }
+        schema_->DropVectorIndex(name);
+        auto it = tables_.find(index.table_name);
+        if (it != tables_.end()) {
+            it->second->RemoveVectorIndex(name);
+        }
+        return;
+    }
+    throw std::runtime_error("Vector index '" + name + "' does not exist");
+}
+
+void RucksDBTableRegistry::DropRollup(const string& name) {
+    auto rollup = GetRollup(name);
+    std::lock_guard<std::mutex> guard(tables_lock_);
+    schema_->DropRollup(name);
+    auto it = tables_.find(rollup.table_name);
+    if (it != tables_.end()) {
+        it->second->RemoveRollup(name);
     }
-    return table_names;
+}
+
+RucksDBRollupDefinition RucksDBTableRegistry::GetRollup(const string& name) {
+    std::lock_guard<std::mutex> guard(tables_lock_);
+    RefreshIfStale();
+    for (auto& rollup : schema_->LoadRollups()) {
+        if (rollup.name == name) {
+            rollup.Bind(schema_->GetTableSchema(rollup.table_name));
+            return rollup;
+        }
+    }
+    throw std::runtime_error("Rollup '" + name + "' does not exist");
 }
 
 // Helper functions for SQL interface
@@ -437,14 +2871,16 @@ static void CreateRocksDBTableFunction(DataChunk& args, ExpressionState& state,
     auto table_name = args.data[0].GetValue(0).GetValue<string>();
     auto schema_sql = args.data[1].GetValue(0).GetValue<string>();
     
-    // Parse simple schema: "col1 TYPE, col2 TYPE, ..."
-    vector<ColumnDefinition> columns;
-    // TODO: Implement proper SQL parsing
-    // For now, assume simple format
-    
     bool success = false;
     if (g_table_registry) {
         try {
+            // Parse schema: "col1 TYPE, col2 TYPE, ..."
+            vector<ColumnDefinition> columns;
+            auto column_list = Parser::ParseColumnList(schema_sql);
+            for (auto& col : column_list.Logical()) {
+                columns.push_back(col.Copy());
+            }
+            
             g_table_registry->CreateTable(table_name, columns);
             success = true;
         } catch (...) {
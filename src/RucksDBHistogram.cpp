@@ -0,0 +1,79 @@
+// src/RucksDBHistogram.cpp
+
+#include "../include/RucksDBHistogram.hpp"
+
+namespace duckdb {
+
+RucksDBHistogram::RucksDBHistogram() {
+    Reset();
+}
+
+size_t RucksDBHistogram::BucketIndex(uint64_t value) {
+    if (value < SUB_BUCKETS) {
+        return value;
+    }
+    size_t msb = 63;
+    while ((value & (uint64_t(1) << msb)) == 0) {
+        msb--;
+    }
+    size_t shift = msb - SUB_BUCKET_BITS;
+    size_t sub_bucket = (value >> shift) & (SUB_BUCKETS - 1);
+    return (shift + 1) * SUB_BUCKETS + sub_bucket;
+}
+
+uint64_t RucksDBHistogram::BucketUpperBound(size_t index) {
+    if (index < SUB_BUCKETS) {
+        return index;
+    }
+    size_t shift = index / SUB_BUCKETS - 1;
+    size_t sub_bucket = index % SUB_BUCKETS;
+    return ((uint64_t(SUB_BUCKETS + sub_bucket) + 1) << shift) - 1;
+}
+
+void RucksDBHistogram::Record(uint64_t value) {
+    counts_[BucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t current_max = max_.load(std::memory_order_relaxed);
+    while (value > current_max && !max_.compare_exchange_weak(current_max, value, std::memory_order_relaxed)) {
+    }
+}
+
+void RucksDBHistogram::Reset() {
+    for (auto& bucket : counts_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+double RucksDBHistogram::Mean() const {
+    uint64_t count = Count();
+    return count == 0 ? 0.0 : double(Sum()) / double(count);
+}
+
+uint64_t RucksDBHistogram::Percentile(double percentile) const {
+    uint64_t count = Count();
+    if (count == 0) {
+        return 0;
+    }
+
+    uint64_t target = uint64_t(double(count) * percentile / 100.0);
+    if (target == 0) {
+        target = 1;
+    }
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        seen += counts_[i].load(std::memory_order_relaxed);
+        if (seen >= target) {
+            auto bound = BucketUpperBound(i);
+            return bound < Max() ? bound : Max();
+        }
+    }
+    return Max();
+}
+
+} // namespace duckdb
\ No newline at end of file
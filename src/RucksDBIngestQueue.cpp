@@ -0,0 +1,237 @@
+// src/RucksDBIngestQueue.cpp
+
+#include "../include/RucksDBIngestQueue.hpp"
+#include "../include/RucksDBTrace.hpp"
+#include <stdexcept>
+
+namespace duckdb {
+
+// Global ingest queue
+std::unique_ptr<RucksDBIngestQueue> g_ingest_queue;
+static std::mutex g_ingest_queue_lock;
+
+RucksDBIngestQueue &GetGlobalIngestQueue() {
+    std::lock_guard<std::mutex> guard(g_ingest_queue_lock);
+    if (!g_ingest_queue) {
+        if (!g_rocksdb_storage) {
+            throw std::runtime_error("RucksDB is not initialized");
+        }
+        auto &storage_options = g_rocksdb_storage->GetOptions();
+        RucksDBIngestOptions options;
+        options.queue_capacity = storage_options.ingest_queue_capacity;
+        options.max_batch_size = storage_options.ingest_max_batch_size;
+        options.max_latency = std::chrono::microseconds(storage_options.ingest_max_latency_us);
+        options.worker_threads = storage_options.ingest_threads;
+        g_ingest_queue = std::make_unique<RucksDBIngestQueue>(g_rocksdb_storage.get(), options);
+    }
+    return *g_ingest_queue;
+}
+
+RucksDBIngestQueue::RucksDBIngestQueue(RocksDBStorage *storage, const RucksDBIngestOptions &options)
+    : storage_(storage), options_(options), start_time_(std::chrono::steady_clock::now()) {
+    if (options_.worker_threads == 0) {
+        options_.worker_threads = 1;
+    }
+    if (options_.max_batch_size == 0) {
+        options_.max_batch_size = 1;
+    }
+    if (options_.queue_capacity < options_.max_batch_size) {
+        options_.queue_capacity = options_.max_batch_size;
+    }
+
+    for (size_t i = 0; i < options_.worker_threads; i++) {
+        partitions_.push_back(std::make_unique<Partition>());
+    }
+    for (auto &partition : partitions_) {
+        auto *partition_ptr = partition.get();
+        partition->worker = std::thread([this, partition_ptr]() { WorkerLoop(*partition_ptr); });
+    }
+}
+
+RucksDBIngestQueue::~RucksDBIngestQueue() {
+    Shutdown();
+}
+
+void RucksDBIngestQueue::Shutdown() {
+    if (stop_.exchange(true)) {
+        return;
+    }
+    for (auto &partition : partitions_) {
+        {
+            std::lock_guard<std::mutex> guard(partition->lock);
+        }
+        partition->not_empty.notify_all();
+        partition->not_full.notify_all();
+    }
+    for (auto &partition : partitions_) {
+        if (partition->worker.joinable()) {
+            partition->worker.join();
+        }
+    }
+}
+
+RucksDBIngestQueue::Partition &RucksDBIngestQueue::GetPartition(const string &key) {
+    return *partitions_[std::hash<string>()(key) % partitions_.size()];
+}
+
+void RucksDBIngestQueue::Enqueue(Item item) {
+    auto start = std::chrono::steady_clock::now();
+    auto &partition = GetPartition(item.key);
+
+    std::unique_lock<std::mutex> lock(partition.lock);
+    // Backpressure: block the producer while this partition is full
+    partition.not_full.wait(lock, [&]() { return stop_ || partition.items.size() < options_.queue_capacity; });
+    if (stop_) {
+        throw std::runtime_error("RucksDB ingest queue is shut down");
+    }
+
+    item.enqueue_time = std::chrono::steady_clock::now();
+    partition.items.push_back(std::move(item));
+    size_t queued = partition.items.size();
+    lock.unlock();
+
+    // Wake the worker to start its latency timer, or because a batch is full
+    if (queued == 1 || queued >= options_.max_batch_size) {
+        partition.not_empty.notify_one();
+    }
+
+    enqueued_++;
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    enqueue_latency_.Record(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
+
+void RucksDBIngestQueue::WorkerLoop(Partition &partition) {
+    std::vector<Item> batch;
+    batch.reserve(options_.max_batch_size);
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(partition.lock);
+            partition.not_empty.wait(lock, [&]() { return stop_ || !partition.items.empty(); });
+            if (partition.items.empty()) {
+                // Only reachable when stopping with nothing left to drain
+                return;
+            }
+
+            // Give the batch until the oldest write's deadline to fill up
+            auto deadline = partition.items.front().enqueue_time + options_.max_latency;
+            partition.not_empty.wait_until(lock, deadline, [&]() {
+                return stop_ || flush_waiters_ > 0 || partition.items.size() >= options_.max_batch_size;
+            });
+
+            size_t take = std::min(partition.items.size(), options_.max_batch_size);
+            for (size_t i = 0; i < take; i++) {
+                batch.push_back(std::move(partition.items.front()));
+                partition.items.pop_front();
+            }
+            partition.in_flight += take;
+        }
+        partition.not_full.notify_all();
+
+        RucksDBTraceScope trace("IngestBatch", "ingest");
+        trace.arg = batch.size();
+        rocksdb::WriteBatch write_batch;
+        for (auto &item : batch) {
+            if (item.is_delete) {
+                write_batch.Delete(item.key);
+            } else {
+                write_batch.Put(item.key, item.value);
+            }
+        }
+
+        bool success = true;
+        string error;
+        auto commit_start = std::chrono::steady_clock::now();
+        try {
+            storage_->ApplyBatch(write_batch);
+        } catch (const std::exception &e) {
+            success = false;
+            error = e.what();
+        }
+        auto commit_elapsed = std::chrono::steady_clock::now() - commit_start;
+        commit_latency_.Record(std::chrono::duration_cast<std::chrono::nanoseconds>(commit_elapsed).count());
+
+        for (auto &item : batch) {
+            if (item.has_promise) {
+                item.promise.set_value(success);
+            }
+            if (item.callback) {
+                item.callback(success, error);
+            }
+        }
+
+        batches_++;
+        (success ? completed_ : failed_) += batch.size();
+
+        {
+            std::lock_guard<std::mutex> guard(partition.lock);
+            partition.in_flight -= batch.size();
+        }
+        partition.drained.notify_all();
+        batch.clear();
+    }
+}
+
+std::future<bool> RucksDBIngestQueue::PutAsync(const string &key, const string &value) {
+    Item item;
+    item.key = key;
+    item.value = value;
+    item.has_promise = true;
+    auto future = item.promise.get_future();
+    Enqueue(std::move(item));
+    return future;
+}
+
+void RucksDBIngestQueue::PutAsync(const string &key, const string &value, Callback callback) {
+    Item item;
+    item.key = key;
+    item.value = value;
+    item.callback = std::move(callback);
+    Enqueue(std::move(item));
+}
+
+std::future<bool> RucksDBIngestQueue::DeleteAsync(const string &key) {
+    Item item;
+    item.key = key;
+    item.is_delete = true;
+    item.has_promise = true;
+    auto future = item.promise.get_future();
+    Enqueue(std::move(item));
+    return future;
+}
+
+void RucksDBIngestQueue::DeleteAsync(const string &key, Callback callback) {
+    Item item;
+    item.key = key;
+    item.is_delete = true;
+    item.callback = std::move(callback);
+    Enqueue(std::move(item));
+}
+
+void RucksDBIngestQueue::Flush() {
+    flush_waiters_++;
+    for (auto &partition : partitions_) {
+        std::unique_lock<std::mutex> lock(partition->lock);
+        partition->not_empty.notify_one();
+        partition->drained.wait(lock, [&]() { return partition->items.empty() && partition->in_flight == 0; });
+    }
+    flush_waiters_--;
+}
+
+RucksDBIngestStatistics RucksDBIngestQueue::GetStatistics() {
+    RucksDBIngestStatistics stats;
+    stats.enqueued = enqueued_;
+    stats.completed = completed_;
+    stats.failed = failed_;
+    stats.batches = batches_;
+    stats.enqueue_p50_ns = enqueue_latency_.Percentile(50);
+    stats.enqueue_p99_ns = enqueue_latency_.Percentile(99);
+    stats.commit_p50_ns = commit_latency_.Percentile(50);
+    stats.commit_p99_ns = commit_latency_.Percentile(99);
+
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time_).count();
+    stats.throughput = elapsed > 0 ? double(stats.completed) / elapsed : 0;
+    return stats;
+}
+
+} // namespace duckdb
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include "../include/RucksDBInstance.hpp"
+#include "../include/RucksDBExtension.hpp"
+
+namespace duckdb {
+
+struct RucksDBInstanceEntry {
+    RucksDBInstance instance;
+    // Set only for instances opened through RucksDBInstanceRegistry::Open
+    unique_ptr<RocksDBStorage> owned_storage;
+    unique_ptr<RucksDBTableRegistry> owned_registry;
+};
+
+static std::mutex g_instances_lock;
+static std::unordered_map<string, unique_ptr<RucksDBInstanceEntry>> g_instances;
+
+void RucksDBInstanceRegistry::Register(const string& name, RocksDBStorage* storage, RucksDBTableRegistry* registry) {
+    auto entry = make_unique<RucksDBInstanceEntry>();
+    entry->instance.storage = storage;
+    entry->instance.registry = registry;
+
+    std::lock_guard<std::mutex> guard(g_instances_lock);
+    g_instances[name] = std::move(entry);
+}
+
+void RucksDBInstanceRegistry::Unregister(const string& name) {
+    unique_ptr<RucksDBInstanceEntry> entry;
+    {
+        std::lock_guard<std::mutex> guard(g_instances_lock);
+        auto it = g_instances.find(name);
+        if (it == g_instances.end()) {
+            return;
+        }
+        entry = std::move(it->second);
+        g_instances.erase(it);
+    }
+    // Owned instances close here, outside the lock
+}
+
+RucksDBInstance RucksDBInstanceRegistry::Open(const string& name, const string& path,
+                                              const RocksDBStorageOptions& options) {
+    if (name.empty()) {
+        throw std::runtime_error("RucksDB instance name must not be empty");
+    }
+    auto entry = make_unique<RucksDBInstanceEntry>();
+    entry->owned_storage = make_unique<RocksDBStorage>(path, options);
+    entry->owned_storage->Initialize();
+    entry->owned_registry = make_unique<RucksDBTableRegistry>(entry->owned_storage.get());
+    entry->instance.storage = entry->owned_storage.get();
+    entry->instance.registry = entry->owned_registry.get();
+    auto instance = entry->instance;
+
+    std::lock_guard<std::mutex> guard(g_instances_lock);
+    if (g_instances.find(name) != g_instances.end()) {
+        throw std::runtime_error("RucksDB instance '" + name + "' is already open");
+    }
+    g_instances[name] = std::move(entry);
+    return instance;
+}
+
+void RucksDBInstanceRegistry::Close(const string& name) {
+    Unregister(name);
+}
+
+RucksDBInstance RucksDBInstanceRegistry::Get(const string& name) {
+    if (name.empty()) {
+        if (!g_rocksdb_storage) {
+            throw std::runtime_error("RucksDB is not initialized");
+        }
+        if (!g_table_registry) {
+            g_table_registry = make_unique<RucksDBTableRegistry>(g_rocksdb_storage.get());
+        }
+        RucksDBInstance instance;
+        instance.storage = g_rocksdb_storage.get();
+        instance.registry = g_table_registry.get();
+        return instance;
+    }
+
+    std::lock_guard<std::mutex> guard(g_instances_lock);
+    auto it = g_instances.find(name);
+    if (it == g_instances.end()) {
+        throw std::runtime_error("Unknown RucksDB database '" + name + "'");
+    }
+    return it->second->instance;
+}
+
+RucksDBInstance RucksDBInstanceRegistry::Get(TableFunctionBindInput& input) {
+    auto it = input.named_parameters.find("database");
+    if (it == input.named_parameters.end() || it->second.IsNull()) {
+        return Get(string());
+    }
+    return Get(it->second.GetValue<string>());
+}
+
+vector<string> RucksDBInstanceRegistry::List() {
+    std::lock_guard<std::mutex> guard(g_instances_lock);
+    vector<string> names;
+    for (auto& entry : g_instances) {
+        names.push_back(entry.first);
+    }
+    return names;
+}
+
+} // namespace duckdb
\ No newline at end of file
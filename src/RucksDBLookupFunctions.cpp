@@ -0,0 +1,131 @@
+#include "../include/RucksDBLookupFunctions.hpp"
+#include "../include/RucksDBExtension.hpp"
+#include "../include/RucksDBInstance.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/main/extension_util.hpp"
+#include <algorithm>
+#include <unordered_set>
+
+namespace duckdb {
+
+struct RucksDBLookupBindData : public TableFunctionData {
+    RucksDBTableStorage* table_storage;
+    idx_t input_columns;
+};
+
+struct RucksDBLookupGlobalState : public GlobalTableFunctionState {
+    // Probes are independent, so every pipeline thread can resolve its own vectors
+    idx_t MaxThreads() const override { return GlobalTableFunctionState::MAX_THREADS; }
+};
+
+struct RucksDBLookupLocalState : public LocalTableFunctionState {
+    vector<std::pair<idx_t, idx_t>> probes;
+    vector<idx_t> row_ids;
+    vector<vector<Value>> rows;
+    vector<bool> found;
+};
+
+// rocksdb_lookup((SELECT ...), 'table')
+static unique_ptr<FunctionData> LookupBind(ClientContext& context, TableFunctionBindInput& input,
+                                           vector<LogicalType>& return_types, vector<string>& names) {
+    if (input.input_table_types.empty()) {
+        throw std::runtime_error("rocksdb_lookup needs a subquery whose first column holds the row ids");
+    }
+    auto key_type = input.input_table_types[0];
+    if (!key_type.IsIntegral()) {
+        throw std::runtime_error("rocksdb_lookup probe keys must be integer row ids, got " + key_type.ToString());
+    }
+    auto table_name = input.inputs[1].GetValue<string>();
+    auto instance = RucksDBInstanceRegistry::Get(input);
+    auto* table_storage = instance.registry->GetTable(table_name);
+    if (!table_storage) {
+        throw std::runtime_error("RocksDB table '" + table_name + "' does not exist");
+    }
+
+    auto bind_data = make_unique<RucksDBLookupBindData>();
+    bind_data->table_storage = table_storage;
+    bind_data->input_columns = input.input_table_types.size();
+
+    // Probe columns first; table columns that clash with them get a suffix
+    std::unordered_set<string> taken;
+    for (idx_t i = 0; i < input.input_table_types.size(); i++) {
+        names.push_back(input.input_table_names[i]);
+        return_types.push_back(input.input_table_types[i]);
+        taken.insert(StringUtil::Lower(input.input_table_names[i]));
+    }
+    for (auto& column : table_storage->GetColumns()) {
+        auto name = column.Name();
+        while (taken.count(StringUtil::Lower(name))) {
+            name += "_1";
+        }
+        taken.insert(StringUtil::Lower(name));
+        names.push_back(name);
+        return_types.push_back(column.Type());
+    }
+    return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> LookupInitGlobal(ClientContext& context, TableFunctionInitInput& input) {
+    return make_unique<RucksDBLookupGlobalState>();
+}
+
+static unique_ptr<LocalTableFunctionState> LookupInitLocal(ExecutionContext& context, TableFunctionInitInput& input,
+                                                           GlobalTableFunctionState* global_state) {
+    return make_unique<RucksDBLookupLocalState>();
+}
+
+static OperatorResultType LookupExecute(ExecutionContext& context, TableFunctionInput& data, DataChunk& input,
+                                        DataChunk& output) {
+    auto& bind_data = (RucksDBLookupBindData&)*data.bind_data;
+    auto& state = (RucksDBLookupLocalState&)*data.local_state;
+
+    // (row id, input row), sorted so the reads walk the key space once
+    state.probes.clear();
+    for (idx_t i = 0; i < input.size(); i++) {
+        auto key = input.data[0].GetValue(i);
+        if (!key.IsNull() && key.GetValue<int64_t>() >= 0) {
+            state.probes.emplace_back((idx_t)key.GetValue<int64_t>(), i);
+        }
+    }
+    std::sort(state.probes.begin(), state.probes.end());
+
+    state.row_ids.clear();
+    for (auto& probe : state.probes) {
+        state.row_ids.push_back(probe.first);
+    }
+    bind_data.table_storage->FetchRows(state.row_ids, state.rows, state.found);
+
+    // Every probe matches at most one row, so an input vector always fits one output vector
+    idx_t count = 0;
+    for (idx_t i = 0; i < state.probes.size(); i++) {
+        if (!state.found[i]) {
+            continue;
+        }
+        idx_t input_row = state.probes[i].second;
+        for (idx_t col_idx = 0; col_idx < bind_data.input_columns; col_idx++) {
+            output.SetValue(col_idx, count, input.GetValue(col_idx, input_row));
+        }
+        auto& row = state.rows[i];
+        for (idx_t col_idx = 0; col_idx < row.size() && bind_data.input_columns + col_idx < output.ColumnCount();
+             col_idx++) {
+            output.SetValue(bind_data.input_columns + col_idx, count, row[col_idx]);
+        }
+        count++;
+    }
+    output.SetCardinality(count);
+    return OperatorResultType::NEED_MORE_INPUT;
+}
+
+TableFunction RucksDBLookupFunctions::GetLookupFunction() {
+    TableFunction function("rocksdb_lookup", {LogicalType::TABLE, LogicalType::VARCHAR}, nullptr, LookupBind,
+                           LookupInitGlobal, LookupInitLocal);
+    function.in_out_function = LookupExecute;
+    function.named_parameters["database"] = LogicalType::VARCHAR;
+    return function;
+}
+
+void RucksDBLookupFunctions::RegisterFunctions(DatabaseInstance& db) {
+    ExtensionUtil::RegisterFunction(db, GetLookupFunction());
+}
+
+} // namespace duckdb
@@ -0,0 +1,154 @@
+// src/RucksDBMemoryBudget.cpp
+
+#include "../include/RucksDBMemoryBudget.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+#include "rocksdb/table.h"
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+namespace duckdb {
+
+static constexpr uint64_t REBALANCE_INTERVAL_MS = 100;
+
+static std::mutex default_budget_lock;
+static std::shared_ptr<RucksDBMemoryBudget> default_budget;
+
+RucksDBMemoryBudget::RucksDBMemoryBudget(uint64_t budget, double rocksdb_share) : budget_(budget) {
+    if (rocksdb_share <= 0 || rocksdb_share >= 1) {
+        throw std::runtime_error("rocksdb_memory_share must be between 0 and 1");
+    }
+    rocksdb_target_ = (uint64_t)(budget * rocksdb_share);
+    memtable_limit_ = rocksdb_target_ / 4;
+    rocksdb_floor_ = memtable_limit_ + rocksdb_target_ / 8;
+    step_ = std::max<uint64_t>(budget / 16, 1);
+
+    cache_ = rocksdb::NewLRUCache(rocksdb_target_);
+    // Stalling writers once memtables reach their share beats growing past the budget
+    write_buffer_manager_ = std::make_shared<rocksdb::WriteBufferManager>(memtable_limit_, cache_, true);
+}
+
+RucksDBMemoryBudget::~RucksDBMemoryBudget() {
+    if (rebalance_thread_.joinable()) {
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            stop_ = true;
+        }
+        rebalance_cv_.notify_all();
+        rebalance_thread_.join();
+    }
+}
+
+void RucksDBMemoryBudget::Configure(rocksdb::Options &options) {
+    rocksdb::BlockBasedTableOptions table_options;
+    table_options.block_cache = cache_;
+    // Index and filter blocks count against the budget too; L0's stay pinned as they are read most
+    table_options.cache_index_and_filter_blocks = true;
+    table_options.pin_l0_filter_and_index_blocks_in_cache = true;
+    options.table_factory.reset(rocksdb::NewBlockBasedTableFactory(table_options));
+    options.write_buffer_manager = write_buffer_manager_;
+    // A single memtable may not take the whole memtable share
+    options.write_buffer_size = std::min<size_t>(options.write_buffer_size, std::max<uint64_t>(memtable_limit_ / 2, 1));
+}
+
+void RucksDBMemoryBudget::AttachDuckDB(std::shared_ptr<DatabaseInstance> db) {
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        duckdb_ = db;
+    }
+    try {
+        BufferManager::GetBufferManager(*db).SetMemoryLimit(budget_ - cache_->GetCapacity());
+    } catch (std::exception &) {
+        // DuckDB already holds more than its share; Rebalance shrinks the cache to make room
+    }
+    if (!rebalance_thread_.joinable()) {
+        rebalance_thread_ = std::thread([this]() { RebalanceLoop(); });
+    }
+}
+
+void RucksDBMemoryBudget::RebalanceLoop() {
+    auto interval = std::chrono::milliseconds(REBALANCE_INTERVAL_MS);
+    std::unique_lock<std::mutex> lock(lock_);
+    while (!rebalance_cv_.wait_for(lock, interval, [this]() { return stop_; })) {
+        lock.unlock();
+        Rebalance();
+        lock.lock();
+    }
+}
+
+void RucksDBMemoryBudget::Rebalance() {
+    std::shared_ptr<DatabaseInstance> db;
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        db = duckdb_.lock();
+    }
+    if (!db) {
+        return;
+    }
+    auto &buffer_manager = BufferManager::GetBufferManager(*db);
+    uint64_t used = buffer_manager.GetUsedMemory();
+    uint64_t limit = buffer_manager.GetMaxMemory();
+    uint64_t capacity = cache_->GetCapacity();
+
+    if (used >= limit / 10 * 9 && capacity > rocksdb_floor_) {
+        // DuckDB is about to spill or fail: hand it a step of the cache, evicting unpinned blocks
+        uint64_t new_capacity = std::max(rocksdb_floor_, capacity > step_ ? capacity - step_ : 0);
+        cache_->SetCapacity(new_capacity);
+        try {
+            buffer_manager.SetMemoryLimit(budget_ - new_capacity);
+            shrinks_++;
+        } catch (std::exception &) {
+            cache_->SetCapacity(capacity);
+        }
+    } else if (capacity < rocksdb_target_ && used < limit / 2) {
+        // Take memory back only while DuckDB would keep plenty of headroom under its lower limit
+        uint64_t new_capacity = std::min(rocksdb_target_, capacity + step_);
+        uint64_t new_limit = budget_ - new_capacity;
+        if (used >= new_limit / 4 * 3) {
+            return;
+        }
+        try {
+            // Lower DuckDB first, so the two never add up to more than the budget
+            buffer_manager.SetMemoryLimit(new_limit);
+        } catch (std::exception &) {
+            return;
+        }
+        cache_->SetCapacity(new_capacity);
+        grows_++;
+    }
+}
+
+RucksDBMemoryStatistics RucksDBMemoryBudget::GetStatistics() {
+    RucksDBMemoryStatistics stats;
+    stats.budget = budget_;
+    stats.rocksdb_capacity = cache_->GetCapacity();
+    stats.rocksdb_usage = cache_->GetUsage();
+    stats.memtable_usage = write_buffer_manager_->memory_usage();
+    stats.shrinks = shrinks_;
+    stats.grows = grows_;
+
+    std::shared_ptr<DatabaseInstance> db;
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        db = duckdb_.lock();
+    }
+    if (db) {
+        auto &buffer_manager = BufferManager::GetBufferManager(*db);
+        stats.duckdb_limit = buffer_manager.GetMaxMemory();
+        stats.duckdb_used = buffer_manager.GetUsedMemory();
+    }
+    return stats;
+}
+
+std::shared_ptr<RucksDBMemoryBudget> RucksDBMemoryBudget::GetDefault() {
+    std::lock_guard<std::mutex> guard(default_budget_lock);
+    return default_budget;
+}
+
+void RucksDBMemoryBudget::SetDefault(std::shared_ptr<RucksDBMemoryBudget> budget) {
+    std::lock_guard<std::mutex> guard(default_budget_lock);
+    default_budget = std::move(budget);
+}
+
+} // namespace duckdb
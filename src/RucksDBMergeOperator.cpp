@@ -0,0 +1,286 @@
+// src/RucksDBMergeOperator.cpp
+
+#include "../include/RucksDBMergeOperator.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+namespace duckdb {
+
+static constexpr char AGGREGATE_MAGIC = 'A';
+static constexpr char POSTINGS_MAGIC = 'P';
+
+void RucksDBAggregateValue::Merge(const RucksDBAggregateValue &other) {
+    switch (kind) {
+    case RucksDBAggregateKind::SUM:
+        if (is_double) {
+            double_value += other.is_double ? other.double_value : (double)other.int_value;
+        } else {
+            int_value += other.is_double ? (int64_t)other.double_value : other.int_value;
+        }
+        empty = empty && other.empty;
+        break;
+    case RucksDBAggregateKind::MIN:
+    case RucksDBAggregateKind::MAX: {
+        if (other.empty) {
+            break;
+        }
+        bool take = empty;
+        if (!take) {
+            bool less = is_double ? other.double_value < double_value : other.int_value < int_value;
+            bool greater = is_double ? other.double_value > double_value : other.int_value > int_value;
+            take = kind == RucksDBAggregateKind::MIN ? less : greater;
+        }
+        if (take) {
+            int_value = other.int_value;
+            double_value = other.double_value;
+            empty = false;
+        }
+        break;
+    }
+    case RucksDBAggregateKind::HLL:
+        if (registers.size() < other.registers.size()) {
+            registers.resize(other.registers.size(), 0);
+        }
+        for (size_t i = 0; i < other.registers.size(); i++) {
+            registers[i] = std::max<unsigned char>(registers[i], other.registers[i]);
+        }
+        empty = empty && other.empty;
+        break;
+    }
+}
+
+template <class T>
+static void AppendRaw(string &out, T value) {
+    out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <class T>
+static bool ReadRaw(const char *&pos, const char *end, T &value) {
+    if (end - pos < (ptrdiff_t)sizeof(T)) {
+        return false;
+    }
+    std::memcpy(&value, pos, sizeof(T));
+    pos += sizeof(T);
+    return true;
+}
+
+string EncodeAggregates(const std::vector<RucksDBAggregateValue> &values) {
+    string out;
+    out += AGGREGATE_MAGIC;
+    AppendRaw<uint32_t>(out, (uint32_t)values.size());
+    for (auto &value : values) {
+        AppendRaw<uint8_t>(out, (uint8_t)value.kind);
+        AppendRaw<uint8_t>(out, (uint8_t)((value.is_double ? 1 : 0) | (value.empty ? 2 : 0)));
+        if (value.kind == RucksDBAggregateKind::HLL) {
+            AppendRaw<uint32_t>(out, (uint32_t)value.registers.size());
+            out += value.registers;
+        } else if (value.is_double) {
+            AppendRaw<double>(out, value.double_value);
+        } else {
+            AppendRaw<int64_t>(out, value.int_value);
+        }
+    }
+    return out;
+}
+
+bool DecodeAggregates(const rocksdb::Slice &data, std::vector<RucksDBAggregateValue> &values) {
+    values.clear();
+    if (data.empty()) {
+        return false;
+    }
+    if (data[0] != AGGREGATE_MAGIC) {
+        // Legacy decimal counter
+        try {
+            RucksDBAggregateValue value;
+            value.int_value = std::stoll(data.ToString());
+            value.empty = false;
+            values.push_back(value);
+            return true;
+        } catch (std::exception &) {
+            return false;
+        }
+    }
+
+    const char *pos = data.data() + 1;
+    const char *end = data.data() + data.size();
+    uint32_t count;
+    if (!ReadRaw(pos, end, count)) {
+        return false;
+    }
+    values.resize(count);
+    for (auto &value : values) {
+        uint8_t kind, flags;
+        if (!ReadRaw(pos, end, kind) || !ReadRaw(pos, end, flags) || kind > (uint8_t)RucksDBAggregateKind::HLL) {
+            return false;
+        }
+        value.kind = (RucksDBAggregateKind)kind;
+        value.is_double = flags & 1;
+        value.empty = flags & 2;
+        if (value.kind == RucksDBAggregateKind::HLL) {
+            uint32_t size;
+            if (!ReadRaw(pos, end, size) || end - pos < (ptrdiff_t)size) {
+                return false;
+            }
+            value.registers.assign(pos, size);
+            pos += size;
+        } else if (value.is_double) {
+            if (!ReadRaw(pos, end, value.double_value)) {
+                return false;
+            }
+        } else if (!ReadRaw(pos, end, value.int_value)) {
+            return false;
+        }
+    }
+    return pos == end;
+}
+
+string EncodeCounter(int64_t delta, RucksDBAggregateKind kind) {
+    RucksDBAggregateValue value;
+    value.kind = kind;
+    value.int_value = delta;
+    value.empty = false;
+    return EncodeAggregates({value});
+}
+
+int64_t DecodeCounter(const string &data) {
+    std::vector<RucksDBAggregateValue> values;
+    if (!DecodeAggregates(data, values) || values.size() != 1 || values[0].kind == RucksDBAggregateKind::HLL) {
+        throw std::runtime_error("Invalid RucksDB counter value");
+    }
+    return values[0].is_double ? (int64_t)values[0].double_value : values[0].int_value;
+}
+
+static void AppendVarint(string &out, uint64_t value) {
+    while (value >= 0x80) {
+        out += (char)((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    out += (char)value;
+}
+
+static bool ReadVarint(const char *&pos, const char *end, uint64_t &value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && pos < end; shift += 7) {
+        uint8_t byte = (uint8_t)*pos++;
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+string EncodePostings(const std::vector<uint64_t> &row_ids) {
+    string out;
+    out += POSTINGS_MAGIC;
+    AppendVarint(out, row_ids.size());
+    AppendVarint(out, row_ids.empty() ? 0 : row_ids.back());
+    uint64_t previous = 0;
+    for (auto row_id : row_ids) {
+        AppendVarint(out, row_id - previous);
+        previous = row_id;
+    }
+    return out;
+}
+
+// Reads the header, leaving pos at the first delta
+static bool ReadPostingsHeader(const rocksdb::Slice &data, const char *&pos, uint64_t &count, uint64_t &last) {
+    if (data.empty() || data[0] != POSTINGS_MAGIC) {
+        return false;
+    }
+    pos = data.data() + 1;
+    const char *end = data.data() + data.size();
+    return ReadVarint(pos, end, count) && ReadVarint(pos, end, last);
+}
+
+bool DecodePostings(const rocksdb::Slice &data, std::vector<uint64_t> &row_ids) {
+    row_ids.clear();
+    const char *pos;
+    uint64_t count, last;
+    if (!ReadPostingsHeader(data, pos, count, last)) {
+        return false;
+    }
+    const char *end = data.data() + data.size();
+    row_ids.reserve(count);
+    uint64_t row_id = 0;
+    for (uint64_t i = 0; i < count; i++) {
+        uint64_t delta;
+        if (!ReadVarint(pos, end, delta)) {
+            return false;
+        }
+        row_id += delta;
+        row_ids.push_back(row_id);
+    }
+    return pos == end;
+}
+
+bool MergePostings(const rocksdb::Slice &existing, const rocksdb::Slice &operand, string &merged) {
+    const char *existing_pos, *operand_pos;
+    uint64_t existing_count, existing_last, operand_count, operand_last;
+    if (!ReadPostingsHeader(existing, existing_pos, existing_count, existing_last) ||
+        !ReadPostingsHeader(operand, operand_pos, operand_count, operand_last)) {
+        return false;
+    }
+    if (existing_count == 0 || operand_count == 0) {
+        merged = existing_count == 0 ? operand.ToString() : existing.ToString();
+        return true;
+    }
+
+    const char *operand_end = operand.data() + operand.size();
+    const char *operand_rest = operand_pos;
+    uint64_t operand_first;
+    if (!ReadVarint(operand_rest, operand_end, operand_first)) {
+        return false;
+    }
+    if (operand_first > existing_last) {
+        // Appends arrive in row id order: splice, re-basing only the operand's first delta
+        merged.clear();
+        merged += POSTINGS_MAGIC;
+        AppendVarint(merged, existing_count + operand_count);
+        AppendVarint(merged, operand_last);
+        merged.append(existing_pos, existing.data() + existing.size() - existing_pos);
+        AppendVarint(merged, operand_first - existing_last);
+        merged.append(operand_rest, operand_end - operand_rest);
+        return true;
+    }
+
+    std::vector<uint64_t> left, right, result;
+    if (!DecodePostings(existing, left) || !DecodePostings(operand, right)) {
+        return false;
+    }
+    result.reserve(left.size() + right.size());
+    std::set_union(left.begin(), left.end(), right.begin(), right.end(), std::back_inserter(result));
+    merged = EncodePostings(result);
+    return true;
+}
+
+bool RucksDBAggregateMergeOperator::Merge(const rocksdb::Slice &key, const rocksdb::Slice *existing_value,
+                                          const rocksdb::Slice &value, std::string *new_value,
+                                          rocksdb::Logger *logger) const {
+    if (!existing_value) {
+        new_value->assign(value.data(), value.size());
+        return true;
+    }
+    if (!value.empty() && value[0] == POSTINGS_MAGIC) {
+        return MergePostings(*existing_value, value, *new_value);
+    }
+
+    std::vector<RucksDBAggregateValue> existing, operand;
+    if (!DecodeAggregates(*existing_value, existing) || !DecodeAggregates(value, operand) ||
+        existing.size() != operand.size()) {
+        // Fails the read/compaction with a corruption status rather than guessing
+        return false;
+    }
+    for (size_t i = 0; i < existing.size(); i++) {
+        if (existing[i].kind != operand[i].kind) {
+            return false;
+        }
+        existing[i].Merge(operand[i]);
+    }
+    *new_value = EncodeAggregates(existing);
+    return true;
+}
+
+} // namespace duckdb
@@ -0,0 +1,162 @@
+// src/RucksDBMetrics.cpp
+
+#include "../include/RucksDBMetrics.hpp"
+#include "rocksdb/iostats_context.h"
+#include "rocksdb/perf_context.h"
+#include "rocksdb/perf_level.h"
+
+namespace duckdb {
+
+const char *RucksDBOperationName(RucksDBOperation op) {
+    switch (op) {
+    case RucksDBOperation::PUT:
+        return "put";
+    case RucksDBOperation::GET:
+        return "get";
+    case RucksDBOperation::DELETE:
+        return "delete";
+    case RucksDBOperation::SCAN:
+        return "scan";
+    case RucksDBOperation::APPEND:
+        return "append";
+    case RucksDBOperation::BATCH:
+        return "batch";
+    case RucksDBOperation::MERGE:
+        return "merge";
+    }
+    return "unknown";
+}
+
+static void RecordInto(RucksDBOperationSet &set, RucksDBOperation op, uint64_t nanos, uint64_t rows,
+                       uint64_t bytes) {
+    auto &metrics = set.Get(op);
+    metrics.latency_ns.Record(nanos);
+    metrics.rows.fetch_add(rows, std::memory_order_relaxed);
+    metrics.bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void RucksDBMetrics::Record(RucksDBOperation op, uint64_t nanos, uint64_t rows, uint64_t bytes) {
+    RecordInto(storage_ops_, op, nanos, rows, bytes);
+}
+
+void RucksDBMetrics::RecordTable(const string &table_name, RucksDBOperation op, uint64_t nanos, uint64_t rows,
+                                 uint64_t bytes) {
+    RecordInto(GetTableOperations(table_name), op, nanos, rows, bytes);
+}
+
+RucksDBOperationSet &RucksDBMetrics::GetTableOperations(const string &table_name) {
+    std::lock_guard<std::mutex> guard(tables_lock_);
+    auto &entry = tables_[table_name];
+    if (!entry) {
+        entry = std::make_unique<RucksDBOperationSet>();
+    }
+    return *entry;
+}
+
+std::vector<string> RucksDBMetrics::ListTables() {
+    std::lock_guard<std::mutex> guard(tables_lock_);
+    std::vector<string> result;
+    for (auto &entry : tables_) {
+        result.push_back(entry.first);
+    }
+    return result;
+}
+
+bool RucksDBMetrics::StartSample() {
+    if (perf_sample_rate_ == 0) {
+        return false;
+    }
+    // Per-thread countdown, so sampling needs no shared state on the hot path
+    static thread_local size_t countdown = 0;
+    if (countdown > 0) {
+        countdown--;
+        return false;
+    }
+    countdown = perf_sample_rate_ - 1;
+
+    rocksdb::SetPerfLevel(rocksdb::PerfLevel::kEnableTimeExceptForMutex);
+    rocksdb::get_perf_context()->Reset();
+    rocksdb::get_iostats_context()->Reset();
+    return true;
+}
+
+void RucksDBMetrics::EndSample() {
+    auto *perf = rocksdb::get_perf_context();
+    auto *iostats = rocksdb::get_iostats_context();
+    rocksdb::SetPerfLevel(rocksdb::PerfLevel::kDisable);
+
+    auto relaxed = std::memory_order_relaxed;
+    perf_.samples.fetch_add(1, relaxed);
+    perf_.block_cache_hit_count.fetch_add(perf->block_cache_hit_count, relaxed);
+    perf_.block_read_count.fetch_add(perf->block_read_count, relaxed);
+    perf_.block_read_byte.fetch_add(perf->block_read_byte, relaxed);
+    perf_.block_read_time_ns.fetch_add(perf->block_read_time, relaxed);
+    perf_.get_from_memtable_count.fetch_add(perf->get_from_memtable_count, relaxed);
+    perf_.internal_key_skipped_count.fetch_add(perf->internal_key_skipped_count, relaxed);
+    perf_.internal_delete_skipped_count.fetch_add(perf->internal_delete_skipped_count, relaxed);
+    perf_.write_wal_time_ns.fetch_add(perf->write_wal_time, relaxed);
+    perf_.write_memtable_time_ns.fetch_add(perf->write_memtable_time, relaxed);
+    perf_.io_bytes_read.fetch_add(iostats->bytes_read, relaxed);
+    perf_.io_bytes_written.fetch_add(iostats->bytes_written, relaxed);
+}
+
+static void ResetSet(RucksDBOperationSet &set) {
+    for (auto &metrics : set.ops) {
+        metrics.latency_ns.Reset();
+        metrics.rows = 0;
+        metrics.bytes = 0;
+    }
+}
+
+void RucksDBMetrics::Reset() {
+    ResetSet(storage_ops_);
+    {
+        std::lock_guard<std::mutex> guard(tables_lock_);
+        for (auto &entry : tables_) {
+            ResetSet(*entry.second);
+        }
+    }
+    perf_.samples = 0;
+    perf_.block_cache_hit_count = 0;
+    perf_.block_read_count = 0;
+    perf_.block_read_byte = 0;
+    perf_.block_read_time_ns = 0;
+    perf_.get_from_memtable_count = 0;
+    perf_.internal_key_skipped_count = 0;
+    perf_.internal_delete_skipped_count = 0;
+    perf_.write_wal_time_ns = 0;
+    perf_.write_memtable_time_ns = 0;
+    perf_.io_bytes_read = 0;
+    perf_.io_bytes_written = 0;
+}
+
+RucksDBOperationTimer::RucksDBOperationTimer(RucksDBMetrics *metrics, RucksDBOperation op)
+    : metrics_(metrics), set_(nullptr), op_(op), sampled_(false) {
+    if (!metrics_) {
+        return;
+    }
+    set_ = &metrics_->GetStorageOperations();
+    sampled_ = metrics_->StartSample();
+    start_ = std::chrono::steady_clock::now();
+}
+
+RucksDBOperationTimer::RucksDBOperationTimer(RucksDBOperationSet *set, RucksDBOperation op)
+    : metrics_(nullptr), set_(set), op_(op), sampled_(false) {
+    if (set_) {
+        start_ = std::chrono::steady_clock::now();
+    }
+}
+
+RucksDBOperationTimer::~RucksDBOperationTimer() {
+    if (!set_) {
+        return;
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start_;
+    auto nanos = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    if (sampled_) {
+        metrics_->EndSample();
+    }
+    RecordInto(*set_, op_, nanos, rows, bytes);
+}
+
+} // namespace duckdb
@@ -0,0 +1,243 @@
+#include "../include/RucksDBOptimizer.hpp"
+#include "../include/RucksDBExtension.hpp"
+#include "duckdb/optimizer/optimizer.hpp"
+#include "duckdb/planner/binder.hpp"
+#include "duckdb/planner/expression/bound_between_expression.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/expression/bound_comparison_expression.hpp"
+#include "duckdb/planner/expression/bound_constant_expression.hpp"
+#include "duckdb/planner/operator/logical_dummy_scan.hpp"
+#include "duckdb/planner/operator/logical_projection.hpp"
+
+namespace duckdb {
+
+void RucksDBAggregatePushdown::Optimize(OptimizerExtensionInput& input, unique_ptr<LogicalOperator>& plan) {
+    if (TryRewriteAggregate(input, plan)) {
+        return;
+    }
+    for (auto& child : plan->children) {
+        Optimize(input, child);
+    }
+}
+
+bool RucksDBAggregatePushdown::TryRewriteAggregate(OptimizerExtensionInput& input,
+                                                   unique_ptr<LogicalOperator>& op) {
+    if (op->type != LogicalOperatorType::LOGICAL_AGGREGATE_AND_GROUP_BY) {
+        return false;
+    }
+
+    // Only ungrouped aggregates directly on top of an unfiltered rocksdb_scan qualify
+    auto& aggr = op->Cast<LogicalAggregate>();
+    if (!aggr.groups.empty() || aggr.grouping_sets.size() > 1 || !aggr.grouping_functions.empty()) {
+        return false;
+    }
+    if (aggr.children.size() != 1 || aggr.children[0]->type != LogicalOperatorType::LOGICAL_GET) {
+        return false;
+    }
+
+    auto& get = aggr.children[0]->Cast<LogicalGet>();
+    if (get.function.name != "rocksdb_scan" || !get.bind_data || !get.table_filters.filters.empty()) {
+        return false;
+    }
+    auto& bind_data = (const RocksDBBindData&)*get.bind_data;
+    // Table statistics still count rows whose TTL has run out, and know nothing of hot rows
+    if (bind_data.table_storage->GetTTL() || bind_data.table_storage->GetHotTier()) {
+        return false;
+    }
+
+    vector<unique_ptr<Expression>> constants;
+    for (auto& expr : aggr.expressions) {
+        if (expr->GetExpressionClass() != ExpressionClass::BOUND_AGGREGATE) {
+            return false;
+        }
+        auto& aggr_expr = expr->Cast<BoundAggregateExpression>();
+        if (aggr_expr.IsDistinct() || aggr_expr.filter || aggr_expr.order_bys) {
+            return false;
+        }
+
+        Value result;
+        if (!ComputeAggregate(aggr_expr, get, bind_data, result)) {
+            return false;
+        }
+        constants.push_back(make_unique<BoundConstantExpression>(std::move(result)));
+    }
+
+    // Replace the aggregate with a single-row projection that keeps the aggregate bindings
+    auto projection = make_unique<LogicalProjection>(aggr.aggregate_index, std::move(constants));
+    projection->children.push_back(make_unique<LogicalDummyScan>(input.optimizer.binder.GenerateTableIndex()));
+    op = std::move(projection);
+    return true;
+}
+
+bool RucksDBAggregatePushdown::ComputeAggregate(const BoundAggregateExpression& aggr, const LogicalGet& get,
+                                                const RocksDBBindData& bind_data, Value& result) {
+    auto& table_storage = *bind_data.table_storage;
+    auto& name = aggr.function.name;
+
+    if (name == "count_star") {
+        result = Value::BIGINT((int64_t)table_storage.GetLiveRowCount());
+        return true;
+    }
+
+    if (aggr.children.size() != 1 || aggr.children[0]->GetExpressionClass() != ExpressionClass::BOUND_COLUMN_REF) {
+        return false;
+    }
+    auto& colref = aggr.children[0]->Cast<BoundColumnRefExpression>();
+    if (colref.binding.table_index != get.table_index) {
+        return false;
+    }
+
+    auto& column_ids = get.GetColumnIds();
+    if (colref.binding.column_index >= column_ids.size()) {
+        return false;
+    }
+    column_t column_id = column_ids[colref.binding.column_index];
+
+    // Deletes and updates leave min/max as loose bounds, which cannot answer the aggregate
+    auto stats = table_storage.GetStatistics();
+    if (!stats.IsExact() || column_id >= stats.ColumnCount()) {
+        return false;
+    }
+    auto& column_stats = stats.GetColumn(column_id);
+
+    if (name == "count") {
+        result = Value::BIGINT((int64_t)column_stats.valid_count);
+        return true;
+    }
+    if (name == "min" || name == "max") {
+        // Statistics hold the inserted floats, while rows written by the old codec read back rounded
+        // to six decimals, so a scan may not find the value the statistics would return
+        if (column_id < bind_data.types.size() && bind_data.types[column_id].id() == LogicalTypeId::FLOAT) {
+            return false;
+        }
+        if (column_stats.valid_count == 0) {
+            result = Value(aggr.return_type);
+            return true;
+        }
+        auto& bound = name == "min" ? column_stats.min : column_stats.max;
+        result = bound.DefaultCastAs(aggr.return_type);
+        return true;
+    }
+    return false;
+}
+
+void RucksDBClusterPushdown::Optimize(OptimizerExtensionInput& input, unique_ptr<LogicalOperator>& plan) {
+    if (plan->type == LogicalOperatorType::LOGICAL_FILTER && plan->children.size() == 1 &&
+        plan->children[0]->type == LogicalOperatorType::LOGICAL_GET) {
+        PushRange(plan->Cast<LogicalFilter>(), plan->children[0]->Cast<LogicalGet>());
+    }
+    for (auto& child : plan->children) {
+        Optimize(input, child);
+    }
+}
+
+void RucksDBClusterPushdown::PushRange(LogicalFilter& filter, LogicalGet& get) {
+    if (get.function.name != "rocksdb_scan" || !get.bind_data) {
+        return;
+    }
+    auto& bind_data = (RocksDBBindData&)*get.bind_data;
+    auto cluster = bind_data.table_storage->GetCluster();
+    if (!cluster) {
+        return;
+    }
+
+    // The filter's expressions are conjuncts, so every one of them narrows the range
+    RucksDBClusterBounds bounds(cluster->key_indexes.size());
+    for (auto& expr : filter.expressions) {
+        AddBounds(*expr, get, *cluster, bounds);
+    }
+    RucksDBClusterRange range;
+    if (cluster->GetRange(bind_data.table_name, bounds, range)) {
+        bind_data.cluster_range = std::make_shared<RucksDBClusterRange>(std::move(range));
+    }
+}
+
+// Key column a column reference of the scan reads, if it has the key column's type
+static bool MatchKeyColumn(const Expression& expr, const LogicalGet& get, const RucksDBClusterDefinition& cluster,
+                           idx_t& key) {
+    if (expr.GetExpressionClass() != ExpressionClass::BOUND_COLUMN_REF) {
+        return false;
+    }
+    auto& colref = expr.Cast<BoundColumnRefExpression>();
+    auto& column_ids = get.GetColumnIds();
+    if (colref.binding.table_index != get.table_index || colref.binding.column_index >= column_ids.size()) {
+        return false;
+    }
+    column_t column_id = column_ids[colref.binding.column_index];
+    for (key = 0; key < cluster.key_indexes.size(); key++) {
+        if (cluster.key_indexes[key] == column_id) {
+            return colref.return_type == cluster.key_types[key];
+        }
+    }
+    return false;
+}
+
+// Encoded constant compared against a key column; a constant of another type would compare
+// differently from its cast, so only exact types are used
+static bool EncodeConstant(const Expression& expr, const LogicalType& type, string& encoded) {
+    if (expr.GetExpressionClass() != ExpressionClass::BOUND_CONSTANT) {
+        return false;
+    }
+    auto& value = expr.Cast<BoundConstantExpression>().value;
+    if (value.IsNull() || value.type() != type) {
+        return false;
+    }
+    encoded.clear();
+    RucksDBClusterDefinition::EncodeValue(value, type, encoded);
+    return true;
+}
+
+void RucksDBClusterPushdown::AddBounds(const Expression& expr, const LogicalGet& get,
+                                       const RucksDBClusterDefinition& cluster, RucksDBClusterBounds& bounds) {
+    idx_t key;
+    string encoded;
+    if (expr.GetExpressionClass() == ExpressionClass::BOUND_BETWEEN) {
+        auto& between = expr.Cast<BoundBetweenExpression>();
+        if (!MatchKeyColumn(*between.input, get, cluster, key)) {
+            return;
+        }
+        if (EncodeConstant(*between.lower, cluster.key_types[key], encoded)) {
+            bounds.AddLower(key, encoded);
+        }
+        if (EncodeConstant(*between.upper, cluster.key_types[key], encoded)) {
+            bounds.AddUpper(key, encoded);
+        }
+        return;
+    }
+    if (expr.GetExpressionClass() != ExpressionClass::BOUND_COMPARISON) {
+        return;
+    }
+
+    auto& comparison = expr.Cast<BoundComparisonExpression>();
+    auto type = comparison.type;
+    const Expression* constant = comparison.right.get();
+    if (!MatchKeyColumn(*comparison.left, get, cluster, key)) {
+        // constant <op> column reads as column <flipped op> constant
+        if (!MatchKeyColumn(*comparison.right, get, cluster, key)) {
+            return;
+        }
+        constant = comparison.left.get();
+        type = FlipComparisonExpression(type);
+    }
+    if (!EncodeConstant(*constant, cluster.key_types[key], encoded)) {
+        return;
+    }
+    switch (type) {
+    case ExpressionType::COMPARE_EQUAL:
+        bounds.AddEqual(key, encoded);
+        break;
+    // Strict bounds are kept inclusive; the filter drops the rows equal to them
+    case ExpressionType::COMPARE_GREATERTHAN:
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+        bounds.AddLower(key, encoded);
+        break;
+    case ExpressionType::COMPARE_LESSTHAN:
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+        bounds.AddUpper(key, encoded);
+        break;
+    default:
+        break;
+    }
+}
+
+} // namespace duckdb
\ No newline at end of file
@@ -0,0 +1,393 @@
+#include "../include/RucksDBRollup.hpp"
+#include "duckdb/common/string_util.hpp"
+
+namespace duckdb {
+
+static constexpr char ROLLUP_DATA_PREFIX[] = "rollup_data_";
+
+// Length-prefixed field helpers for the rollup definition and group keys
+static void AppendField(string& out, const string& field) {
+    out += std::to_string(field.size()) + ":" + field;
+}
+
+static bool ReadField(const string& in, idx_t& pos, string& field) {
+    auto colon_pos = in.find(':', pos);
+    if (colon_pos == string::npos) {
+        return false;
+    }
+    idx_t length = std::stoull(in.substr(pos, colon_pos - pos));
+    if (colon_pos + 1 + length > in.size()) {
+        return false;
+    }
+    field = in.substr(colon_pos + 1, length);
+    pos = colon_pos + 1 + length;
+    return true;
+}
+
+static string ReadRequiredField(const string& in, idx_t& pos) {
+    string field;
+    if (!ReadField(in, pos, field)) {
+        throw std::runtime_error("Corrupt RucksDB rollup definition");
+    }
+    return field;
+}
+
+static string SerializeValue(const Value& value) {
+    return value.IsNull() ? "N" : "V" + value.ToString();
+}
+
+static Value DeserializeValue(const string& data, const LogicalType& type) {
+    if (data.empty() || data[0] == 'N') {
+        return Value(type);
+    }
+    return Value(data.substr(1)).DefaultCastAs(type);
+}
+
+// Row values decoded from storage are not always of the column type
+static Value CastTo(const Value& value, const LogicalType& type) {
+    if (value.IsNull() || value.type() == type) {
+        return value;
+    }
+    return value.DefaultCastAs(type);
+}
+
+static bool IsIntegerType(const LogicalType& type) {
+    switch (type.id()) {
+    case LogicalTypeId::TINYINT:
+    case LogicalTypeId::SMALLINT:
+    case LogicalTypeId::INTEGER:
+    case LogicalTypeId::BIGINT:
+    case LogicalTypeId::UTINYINT:
+    case LogicalTypeId::USMALLINT:
+    case LogicalTypeId::UINTEGER:
+    case LogicalTypeId::UBIGINT:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static const char* AggregateKindName(RucksDBAggregateKind kind) {
+    switch (kind) {
+    case RucksDBAggregateKind::SUM:
+        return "sum";
+    case RucksDBAggregateKind::MIN:
+        return "min";
+    case RucksDBAggregateKind::MAX:
+        return "max";
+    case RucksDBAggregateKind::HLL:
+        return "hll";
+    }
+    return "unknown";
+}
+
+bool RucksDBRollupAggregate::IsDouble() const {
+    return !is_count && kind != RucksDBAggregateKind::HLL && !IsIntegerType(type);
+}
+
+string RucksDBRollupAggregate::OutputName() const {
+    if (is_count) {
+        return "count";
+    }
+    if (kind == RucksDBAggregateKind::HLL) {
+        return "distinct_" + column;
+    }
+    return string(AggregateKindName(kind)) + "_" + column;
+}
+
+LogicalType RucksDBRollupAggregate::OutputType() const {
+    if (is_count || kind == RucksDBAggregateKind::HLL) {
+        return LogicalType::BIGINT;
+    }
+    if (kind == RucksDBAggregateKind::SUM) {
+        return IsDouble() ? LogicalType::DOUBLE : LogicalType::BIGINT;
+    }
+    return type;
+}
+
+vector<string> RucksDBRollupDefinition::ParseColumnList(const string& list) {
+    vector<string> columns;
+    for (auto& column : StringUtil::Split(list, ',')) {
+        StringUtil::Trim(column);
+        if (!column.empty()) {
+            columns.push_back(column);
+        }
+    }
+    return columns;
+}
+
+vector<RucksDBRollupAggregate> RucksDBRollupDefinition::ParseAggregates(const string& spec) {
+    vector<RucksDBRollupAggregate> aggregates;
+    for (auto& item : ParseColumnList(spec)) {
+        RucksDBRollupAggregate aggregate;
+        auto open = item.find('(');
+        string function = StringUtil::Lower(item.substr(0, open));
+        StringUtil::Trim(function);
+        if (open != string::npos) {
+            auto close = item.rfind(')');
+            if (close == string::npos || close < open) {
+                throw std::runtime_error("Invalid rollup aggregate '" + item + "'");
+            }
+            aggregate.column = item.substr(open + 1, close - open - 1);
+            StringUtil::Trim(aggregate.column);
+        }
+
+        if (function == "count") {
+            if (!aggregate.column.empty() && aggregate.column != "*") {
+                throw std::runtime_error("Rollups only support count(*), not '" + item + "'");
+            }
+            aggregate.is_count = true;
+            aggregate.column.clear();
+        } else {
+            if (function == "sum") {
+                aggregate.kind = RucksDBAggregateKind::SUM;
+            } else if (function == "min") {
+                aggregate.kind = RucksDBAggregateKind::MIN;
+            } else if (function == "max") {
+                aggregate.kind = RucksDBAggregateKind::MAX;
+            } else if (function == "hll" || function == "approx_count_distinct") {
+                aggregate.kind = RucksDBAggregateKind::HLL;
+            } else {
+                throw std::runtime_error("Unsupported rollup aggregate '" + item +
+                                         "', expected count, sum, min, max or hll");
+            }
+            if (aggregate.column.empty()) {
+                throw std::runtime_error("Rollup aggregate '" + item + "' needs a column");
+            }
+        }
+        aggregates.push_back(std::move(aggregate));
+    }
+    if (aggregates.empty()) {
+        throw std::runtime_error("A rollup needs at least one aggregate");
+    }
+    return aggregates;
+}
+
+static idx_t FindColumn(const vector<ColumnDefinition>& columns, const string& name) {
+    for (idx_t i = 0; i < columns.size(); i++) {
+        if (StringUtil::CIEquals(columns[i].Name(), name)) {
+            return i;
+        }
+    }
+    throw std::runtime_error("Column '" + name + "' does not exist");
+}
+
+void RucksDBRollupDefinition::Bind(const vector<ColumnDefinition>& columns) {
+    key_indexes.clear();
+    key_types.clear();
+    key_names.clear();
+
+    if (!time_column.empty()) {
+        idx_t index = FindColumn(columns, time_column);
+        auto& type = columns[index].Type();
+        if (type.id() != LogicalTypeId::TIMESTAMP && !IsIntegerType(type)) {
+            throw std::runtime_error("Rollup time column '" + time_column + "' must be a TIMESTAMP or integer");
+        }
+        if (bucket_seconds <= 0) {
+            throw std::runtime_error("Rollup time column '" + time_column + "' needs a positive bucket width");
+        }
+        key_indexes.push_back(index);
+        key_types.push_back(type);
+        key_names.push_back(columns[index].Name());
+    }
+    for (auto& name : group_by) {
+        idx_t index = FindColumn(columns, name);
+        key_indexes.push_back(index);
+        key_types.push_back(columns[index].Type());
+        key_names.push_back(columns[index].Name());
+    }
+
+    for (auto& aggregate : aggregates) {
+        if (aggregate.is_count) {
+            continue;
+        }
+        aggregate.column_index = FindColumn(columns, aggregate.column);
+        aggregate.type = columns[aggregate.column_index].Type();
+        if (aggregate.kind != RucksDBAggregateKind::HLL && !aggregate.type.IsNumeric()) {
+            throw std::runtime_error("Rollup aggregate on '" + aggregate.column + "' needs a numeric column");
+        }
+    }
+}
+
+string RucksDBRollupDefinition::Serialize() const {
+    string data;
+    AppendField(data, name);
+    AppendField(data, table_name);
+    AppendField(data, time_column);
+    AppendField(data, std::to_string(bucket_seconds));
+    AppendField(data, std::to_string(group_by.size()));
+    for (auto& column : group_by) {
+        AppendField(data, column);
+    }
+    AppendField(data, std::to_string(aggregates.size()));
+    for (auto& aggregate : aggregates) {
+        AppendField(data, aggregate.is_count ? "count" : AggregateKindName(aggregate.kind));
+        AppendField(data, aggregate.column);
+    }
+    return data;
+}
+
+RucksDBRollupDefinition RucksDBRollupDefinition::Deserialize(const string& data) {
+    RucksDBRollupDefinition rollup;
+    idx_t pos = 0;
+    rollup.name = ReadRequiredField(data, pos);
+    rollup.table_name = ReadRequiredField(data, pos);
+    rollup.time_column = ReadRequiredField(data, pos);
+    rollup.bucket_seconds = std::stoll(ReadRequiredField(data, pos));
+
+    idx_t group_count = std::stoull(ReadRequiredField(data, pos));
+    for (idx_t i = 0; i < group_count; i++) {
+        rollup.group_by.push_back(ReadRequiredField(data, pos));
+    }
+
+    idx_t aggregate_count = std::stoull(ReadRequiredField(data, pos));
+    for (idx_t i = 0; i < aggregate_count; i++) {
+        auto function = ReadRequiredField(data, pos);
+        auto column = ReadRequiredField(data, pos);
+        auto parsed = ParseAggregates(column.empty() ? function : function + "(" + column + ")");
+        rollup.aggregates.push_back(std::move(parsed[0]));
+    }
+    return rollup;
+}
+
+string RucksDBRollupDefinition::GetDataPrefix(const string& rollup_name) {
+    // The separator keeps rollup "a" from matching the groups of rollup "a_b"
+    return string(ROLLUP_DATA_PREFIX) + rollup_name + ":";
+}
+
+string RucksDBRollupDefinition::GetDataPrefix() const {
+    return GetDataPrefix(name);
+}
+
+vector<Value> RucksDBRollupDefinition::DecodeGroupKey(const string& key) const {
+    vector<Value> values;
+    idx_t pos = GetDataPrefix().size();
+    string field;
+    for (idx_t i = 0; i < key_types.size(); i++) {
+        if (!ReadField(key, pos, field)) {
+            throw std::runtime_error("Corrupt RucksDB rollup key in '" + name + "'");
+        }
+        values.push_back(DeserializeValue(field, key_types[i]));
+    }
+    return values;
+}
+
+// Rounds down to the start of the bucket, also for times before the epoch
+static int64_t BucketStart(int64_t value, int64_t width) {
+    return value - ((value % width) + width) % width;
+}
+
+void RucksDBRollupAccumulator::Add(const vector<Value>& row, int64_t sign) {
+    key_buffer_ = rollup_.GetDataPrefix();
+    for (idx_t i = 0; i < rollup_.key_indexes.size(); i++) {
+        auto& type = rollup_.key_types[i];
+        auto index = rollup_.key_indexes[i];
+        auto value = index < row.size() ? CastTo(row[index], type) : Value(type);
+        if (i == 0 && !rollup_.time_column.empty() && !value.IsNull()) {
+            if (type.id() == LogicalTypeId::TIMESTAMP) {
+                auto micros = value.GetValue<timestamp_t>().value;
+                value = Value::TIMESTAMP(timestamp_t(BucketStart(micros, rollup_.bucket_seconds * 1000000)));
+            } else {
+                value = Value::BIGINT(BucketStart(value.GetValue<int64_t>(), rollup_.bucket_seconds))
+                            .DefaultCastAs(type);
+            }
+        }
+        AppendField(key_buffer_, SerializeValue(value));
+    }
+
+    auto& group = groups_[key_buffer_];
+    if (group.values.empty()) {
+        group.values.resize(rollup_.aggregates.size());
+        group.sketches.resize(rollup_.aggregates.size());
+        for (idx_t i = 0; i < rollup_.aggregates.size(); i++) {
+            auto& aggregate = rollup_.aggregates[i];
+            group.values[i].kind = aggregate.kind;
+            group.values[i].is_double = aggregate.IsDouble();
+            if (aggregate.kind == RucksDBAggregateKind::HLL) {
+                group.sketches[i] = make_unique<RucksDBHyperLogLog>();
+            }
+        }
+    }
+
+    for (idx_t i = 0; i < rollup_.aggregates.size(); i++) {
+        auto& aggregate = rollup_.aggregates[i];
+        auto& state = group.values[i];
+        if (aggregate.is_count) {
+            state.int_value += sign;
+            state.empty = false;
+            continue;
+        }
+        if (aggregate.column_index >= row.size() || row[aggregate.column_index].IsNull()) {
+            continue;
+        }
+        auto value = CastTo(row[aggregate.column_index], aggregate.type);
+
+        RucksDBAggregateValue delta;
+        delta.kind = aggregate.kind;
+        delta.is_double = state.is_double;
+        delta.empty = false;
+        switch (aggregate.kind) {
+        case RucksDBAggregateKind::SUM:
+            if (state.is_double) {
+                delta.double_value = value.GetValue<double>() * (double)sign;
+            } else {
+                delta.int_value = value.GetValue<int64_t>() * sign;
+            }
+            state.Merge(delta);
+            break;
+        case RucksDBAggregateKind::MIN:
+        case RucksDBAggregateKind::MAX:
+            // Extremes cannot be retracted without the remaining rows
+            if (sign > 0) {
+                if (state.is_double) {
+                    delta.double_value = value.GetValue<double>();
+                } else {
+                    delta.int_value = value.GetValue<int64_t>();
+                }
+                state.Merge(delta);
+            }
+            break;
+        case RucksDBAggregateKind::HLL:
+            if (sign > 0) {
+                group.sketches[i]->Add(value.Hash());
+                state.empty = false;
+            }
+            break;
+        }
+    }
+}
+
+void RucksDBRollupAccumulator::Add(const DataChunk& chunk, int64_t sign) {
+    // Only the referenced columns are materialized
+    vector<idx_t> used = rollup_.key_indexes;
+    for (auto& aggregate : rollup_.aggregates) {
+        if (!aggregate.is_count) {
+            used.push_back(aggregate.column_index);
+        }
+    }
+
+    vector<Value> row(chunk.ColumnCount());
+    for (idx_t row_idx = 0; row_idx < chunk.size(); row_idx++) {
+        for (auto index : used) {
+            if (index < chunk.ColumnCount()) {
+                row[index] = chunk.GetValue(index, row_idx);
+            }
+        }
+        Add(row, sign);
+    }
+}
+
+void RucksDBRollupAccumulator::Write(rocksdb::WriteBatch& batch) {
+    for (auto& entry : groups_) {
+        auto& group = entry.second;
+        for (idx_t i = 0; i < group.values.size(); i++) {
+            if (group.sketches[i]) {
+                group.values[i].registers = group.sketches[i]->Serialize();
+            }
+        }
+        batch.Merge(entry.first, EncodeAggregates(group.values));
+    }
+    groups_.clear();
+}
+
+} // namespace duckdb
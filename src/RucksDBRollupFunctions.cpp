@@ -0,0 +1,188 @@
+#include "../include/RucksDBRollupFunctions.hpp"
+#include "../include/RucksDBStatsFunctions.hpp"
+#include "../include/RucksDBExtension.hpp"
+#include "../include/RucksDBInstance.hpp"
+#include "duckdb/main/extension_util.hpp"
+
+namespace duckdb {
+
+struct RucksDBRollupBindData : public TableFunctionData {
+    RucksDBRollupDefinition rollup;
+    RucksDBInstance instance;
+};
+
+struct RucksDBRollupScanState : public GlobalTableFunctionState {
+    // Group keys and aggregate values, decoded lazily a vector at a time
+    vector<std::pair<string, string>> groups;
+    idx_t offset = 0;
+};
+
+static string GetNamedString(TableFunctionBindInput& input, const string& name) {
+    auto it = input.named_parameters.find(name);
+    if (it == input.named_parameters.end() || it->second.IsNull()) {
+        return string();
+    }
+    return it->second.GetValue<string>();
+}
+
+// rucksdb_create_rollup('name', 'table', 'aggregates')
+static unique_ptr<FunctionData> CreateRollupBind(ClientContext& context, TableFunctionBindInput& input,
+                                                 vector<LogicalType>& return_types, vector<string>& names) {
+    names = {"rollup", "rows"};
+    return_types = {LogicalType::VARCHAR, LogicalType::UBIGINT};
+
+    auto bind_data = make_unique<RucksDBRollupBindData>();
+    auto& rollup = bind_data->rollup;
+    rollup.name = input.inputs[0].GetValue<string>();
+    rollup.table_name = input.inputs[1].GetValue<string>();
+    rollup.aggregates = RucksDBRollupDefinition::ParseAggregates(input.inputs[2].GetValue<string>());
+    rollup.group_by = RucksDBRollupDefinition::ParseColumnList(GetNamedString(input, "group_by"));
+    rollup.time_column = GetNamedString(input, "time_column");
+    auto bucket = input.named_parameters.find("bucket_seconds");
+    if (bucket != input.named_parameters.end() && !bucket->second.IsNull()) {
+        rollup.bucket_seconds = bucket->second.GetValue<int64_t>();
+    }
+    bind_data->instance = RucksDBInstanceRegistry::Get(input);
+    return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> CreateRollupInit(ClientContext& context, TableFunctionInitInput& input) {
+    auto& bind_data = (RucksDBRollupBindData&)*input.bind_data;
+    idx_t rows = bind_data.instance.registry->CreateRollup(bind_data.rollup);
+
+    auto state = make_unique<RucksDBStatsState>();
+    state->rows.push_back({Value(bind_data.rollup.name), Value::UBIGINT(rows)});
+    return std::move(state);
+}
+
+// rucksdb_drop_rollup('name')
+static unique_ptr<FunctionData> DropRollupBind(ClientContext& context, TableFunctionBindInput& input,
+                                               vector<LogicalType>& return_types, vector<string>& names) {
+    names = {"rollup"};
+    return_types = {LogicalType::VARCHAR};
+
+    auto bind_data = make_unique<RucksDBRollupBindData>();
+    bind_data->rollup.name = input.inputs[0].GetValue<string>();
+    bind_data->instance = RucksDBInstanceRegistry::Get(input);
+    return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> DropRollupInit(ClientContext& context, TableFunctionInitInput& input) {
+    auto& bind_data = (RucksDBRollupBindData&)*input.bind_data;
+    bind_data.instance.registry->DropRollup(bind_data.rollup.name);
+
+    auto state = make_unique<RucksDBStatsState>();
+    state->rows.push_back({Value(bind_data.rollup.name)});
+    return std::move(state);
+}
+
+// rucksdb_rollup('name')
+static unique_ptr<FunctionData> RollupBind(ClientContext& context, TableFunctionBindInput& input,
+                                           vector<LogicalType>& return_types, vector<string>& names) {
+    auto bind_data = make_unique<RucksDBRollupBindData>();
+    bind_data->instance = RucksDBInstanceRegistry::Get(input);
+    bind_data->rollup = bind_data->instance.registry->GetRollup(input.inputs[0].GetValue<string>());
+
+    auto& rollup = bind_data->rollup;
+    names = rollup.key_names;
+    return_types = rollup.key_types;
+    for (auto& aggregate : rollup.aggregates) {
+        names.push_back(aggregate.OutputName());
+        return_types.push_back(aggregate.OutputType());
+    }
+    return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> RollupInit(ClientContext& context, TableFunctionInitInput& input) {
+    auto& bind_data = (RucksDBRollupBindData&)*input.bind_data;
+
+    auto state = make_unique<RucksDBRollupScanState>();
+    bind_data.instance.storage->IteratePrefix(bind_data.rollup.GetDataPrefix(),
+                                              [&state](const string& key, const string& value) {
+        state->groups.emplace_back(key, value);
+        return true;
+    });
+    return std::move(state);
+}
+
+static Value AggregateToValue(const RucksDBRollupAggregate& aggregate, const RucksDBAggregateValue& value) {
+    if (aggregate.kind == RucksDBAggregateKind::HLL) {
+        RucksDBHyperLogLog sketch;
+        if (value.empty || !sketch.Deserialize(value.registers)) {
+            return Value::BIGINT(0);
+        }
+        return Value::BIGINT((int64_t)sketch.Count());
+    }
+    if (value.empty) {
+        return Value(aggregate.OutputType());
+    }
+    auto result = value.is_double ? Value::DOUBLE(value.double_value) : Value::BIGINT(value.int_value);
+    return result.DefaultCastAs(aggregate.OutputType());
+}
+
+static void RollupExecute(ClientContext& context, TableFunctionInput& data, DataChunk& output) {
+    auto& bind_data = (RucksDBRollupBindData&)*data.bind_data;
+    auto& state = (RucksDBRollupScanState&)*data.global_state;
+    auto& rollup = bind_data.rollup;
+
+    idx_t count = 0;
+    vector<RucksDBAggregateValue> values;
+    while (state.offset < state.groups.size() && count < STANDARD_VECTOR_SIZE) {
+        auto& group = state.groups[state.offset++];
+        if (!DecodeAggregates(group.second, values) || values.size() != rollup.aggregates.size()) {
+            throw std::runtime_error("Corrupt aggregate in rollup '" + rollup.name + "'");
+        }
+        // Groups whose rows were all deleted keep a zero count
+        bool removed = false;
+        for (idx_t i = 0; i < values.size(); i++) {
+            if (rollup.aggregates[i].is_count && values[i].int_value == 0) {
+                removed = true;
+            }
+        }
+        if (removed) {
+            continue;
+        }
+
+        auto keys = rollup.DecodeGroupKey(group.first);
+        idx_t col_idx = 0;
+        for (auto& key : keys) {
+            output.SetValue(col_idx++, count, key);
+        }
+        for (idx_t i = 0; i < values.size(); i++) {
+            output.SetValue(col_idx++, count, AggregateToValue(rollup.aggregates[i], values[i]));
+        }
+        count++;
+    }
+    output.SetCardinality(count);
+}
+
+TableFunction RucksDBRollupFunctions::GetCreateRollupFunction() {
+    TableFunction function("rucksdb_create_rollup", {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR},
+                           RucksDBStatsFunctions::ExecuteRows, CreateRollupBind, CreateRollupInit);
+    function.named_parameters["group_by"] = LogicalType::VARCHAR;
+    function.named_parameters["time_column"] = LogicalType::VARCHAR;
+    function.named_parameters["bucket_seconds"] = LogicalType::BIGINT;
+    function.named_parameters["database"] = LogicalType::VARCHAR;
+    return function;
+}
+
+TableFunction RucksDBRollupFunctions::GetDropRollupFunction() {
+    TableFunction function("rucksdb_drop_rollup", {LogicalType::VARCHAR}, RucksDBStatsFunctions::ExecuteRows,
+                           DropRollupBind, DropRollupInit);
+    function.named_parameters["database"] = LogicalType::VARCHAR;
+    return function;
+}
+
+TableFunction RucksDBRollupFunctions::GetRollupFunction() {
+    TableFunction function("rucksdb_rollup", {LogicalType::VARCHAR}, RollupExecute, RollupBind, RollupInit);
+    function.named_parameters["database"] = LogicalType::VARCHAR;
+    return function;
+}
+
+void RucksDBRollupFunctions::RegisterFunctions(DatabaseInstance& db) {
+    ExtensionUtil::RegisterFunction(db, GetCreateRollupFunction());
+    ExtensionUtil::RegisterFunction(db, GetDropRollupFunction());
+    ExtensionUtil::RegisterFunction(db, GetRollupFunction());
+}
+
+} // namespace duckdb
@@ -0,0 +1,270 @@
+#include "../include/RucksDBStatistics.hpp"
+#include "duckdb/storage/statistics/numeric_stats.hpp"
+#include <cmath>
+
+namespace duckdb {
+
+// Length-prefixed field helpers for the statistics record
+static void AppendField(string& out, const string& field) {
+    out += std::to_string(field.size()) + ":" + field;
+}
+
+static bool ReadField(const string& in, idx_t& pos, string& field) {
+    auto colon_pos = in.find(':', pos);
+    if (colon_pos == string::npos) {
+        return false;
+    }
+    idx_t length = std::stoull(in.substr(pos, colon_pos - pos));
+    if (colon_pos + 1 + length > in.size()) {
+        return false;
+    }
+    field = in.substr(colon_pos + 1, length);
+    pos = colon_pos + 1 + length;
+    return true;
+}
+
+static bool ReadNumber(const string& in, idx_t& pos, idx_t& number) {
+    auto bar_pos = in.find('|', pos);
+    if (bar_pos == string::npos) {
+        return false;
+    }
+    number = std::stoull(in.substr(pos, bar_pos - pos));
+    pos = bar_pos + 1;
+    return true;
+}
+
+static string SerializeValue(const Value& value) {
+    return value.IsNull() ? "N" : "V" + value.ToString();
+}
+
+static Value DeserializeValue(const string& data, const LogicalType& type) {
+    if (data.empty() || data[0] == 'N') {
+        return Value(type);
+    }
+    return Value(data.substr(1)).DefaultCastAs(type);
+}
+
+// HyperLogLog implementation
+void RucksDBHyperLogLog::Add(hash_t hash) {
+    idx_t index = hash >> (64 - PRECISION);
+    uint64_t remaining = hash << PRECISION;
+
+    uint8_t rank = 1;
+    while (rank <= 64 - PRECISION && (remaining & (uint64_t(1) << 63)) == 0) {
+        remaining <<= 1;
+        rank++;
+    }
+
+    if (rank > registers_[index]) {
+        registers_[index] = rank;
+    }
+}
+
+void RucksDBHyperLogLog::Merge(const RucksDBHyperLogLog& other) {
+    for (idx_t i = 0; i < REGISTER_COUNT; i++) {
+        registers_[i] = std::max(registers_[i], other.registers_[i]);
+    }
+}
+
+idx_t RucksDBHyperLogLog::Count() const {
+    const double m = double(REGISTER_COUNT);
+    const double alpha = 0.7213 / (1.0 + 1.079 / m);
+
+    double sum = 0;
+    idx_t zeros = 0;
+    for (auto reg : registers_) {
+        sum += std::ldexp(1.0, -int(reg));
+        if (reg == 0) {
+            zeros++;
+        }
+    }
+
+    double estimate = alpha * m * m / sum;
+    // Small-range correction (linear counting)
+    if (estimate <= 2.5 * m && zeros > 0) {
+        estimate = m * std::log(m / double(zeros));
+    }
+    return idx_t(estimate + 0.5);
+}
+
+string RucksDBHyperLogLog::Serialize() const {
+    return string(reinterpret_cast<const char*>(registers_.data()), registers_.size());
+}
+
+bool RucksDBHyperLogLog::Deserialize(const string& data) {
+    if (data.size() != REGISTER_COUNT) {
+        return false;
+    }
+    std::copy(data.begin(), data.end(), reinterpret_cast<char*>(registers_.data()));
+    return true;
+}
+
+// Column statistics implementation
+void RucksDBColumnStatistics::Update(const Value& value) {
+    if (value.IsNull()) {
+        null_count++;
+        return;
+    }
+
+    valid_count++;
+    distinct.Add(value.Hash());
+
+    if (min.IsNull() || value < min) {
+        min = value;
+    }
+    if (max.IsNull() || value > max) {
+        max = value;
+    }
+}
+
+unique_ptr<BaseStatistics> RucksDBColumnStatistics::ToBaseStatistics(const LogicalType& type) const {
+    // Starts from unknown and narrows only by what was counted: DuckDB folds filters away on
+    // these, so a flag or bound that is not known must stay unset. Only numeric stats carry min/max.
+    auto result = BaseStatistics::CreateUnknown(type);
+    if (valid_count > 0 && BaseStatistics::GetStatsType(type) == StatisticsType::NUMERIC_STATS) {
+        NumericStats::SetMin(result, min.DefaultCastAs(type));
+        NumericStats::SetMax(result, max.DefaultCastAs(type));
+    }
+    if (null_count == 0 && valid_count > 0) {
+        result.Set(StatsInfo::CANNOT_HAVE_NULL_VALUES);
+    } else if (valid_count == 0 && null_count > 0) {
+        result.Set(StatsInfo::CANNOT_HAVE_VALID_VALUES);
+    }
+    result.SetDistinctCount(distinct.Count());
+    return result.ToUnique();
+}
+
+// Table statistics implementation
+void RucksDBTableStatistics::Initialize(idx_t column_count) {
+    columns_.clear();
+    columns_.resize(column_count);
+    deleted_count_ = 0;
+    row_count_ = 0;
+    exact_ = true;
+    stale_ = false;
+}
+
+void RucksDBTableStatistics::Update(const DataChunk& chunk) {
+    idx_t column_count = std::min(chunk.ColumnCount(), columns_.size());
+    for (idx_t col_idx = 0; col_idx < column_count; col_idx++) {
+        auto& column = columns_[col_idx];
+        for (idx_t row = 0; row < chunk.size(); row++) {
+            column.Update(chunk.data[col_idx].GetValue(row));
+        }
+    }
+    row_count_ += chunk.size();
+}
+
+void RucksDBTableStatistics::Merge(const RucksDBTableStatistics& other) {
+    idx_t column_count = std::min(other.columns_.size(), columns_.size());
+    for (idx_t col_idx = 0; col_idx < column_count; col_idx++) {
+        auto& column = columns_[col_idx];
+        auto& source = other.columns_[col_idx];
+        column.null_count += source.null_count;
+        column.valid_count += source.valid_count;
+        column.distinct.Merge(source.distinct);
+        if (!source.min.IsNull() && (column.min.IsNull() || source.min < column.min)) {
+            column.min = source.min;
+        }
+        if (!source.max.IsNull() && (column.max.IsNull() || source.max > column.max)) {
+            column.max = source.max;
+        }
+    }
+    deleted_count_ += other.deleted_count_;
+    row_count_ += other.row_count_;
+    exact_ = exact_ && other.exact_;
+    stale_ = stale_ || other.stale_;
+}
+
+void RucksDBTableStatistics::RecordDelete(idx_t count) {
+    if (count == 0) {
+        return;
+    }
+    deleted_count_ += count;
+    row_count_ -= std::min(count, row_count_);
+    exact_ = false;
+}
+
+void RucksDBTableStatistics::MarkStale(idx_t row_count) {
+    row_count_ = row_count;
+    exact_ = false;
+    stale_ = true;
+}
+
+void RucksDBTableStatistics::RecordUpdate(const vector<column_t>& column_ids, const DataChunk& data) {
+    // Widen the bounds with the new values; the overwritten values cannot be removed
+    for (idx_t i = 0; i < column_ids.size() && i < data.ColumnCount(); i++) {
+        if (column_ids[i] >= columns_.size()) {
+            continue;
+        }
+        auto& column = columns_[column_ids[i]];
+        for (idx_t row = 0; row < data.size(); row++) {
+            column.Update(data.data[i].GetValue(row));
+        }
+    }
+    if (data.size() > 0) {
+        exact_ = false;
+    }
+}
+
+string RucksDBTableStatistics::Serialize() const {
+    string result = std::to_string(columns_.size()) + "|";
+    for (const auto& column : columns_) {
+        result += std::to_string(column.null_count) + "|";
+        result += std::to_string(column.valid_count) + "|";
+        AppendField(result, SerializeValue(column.min));
+        AppendField(result, SerializeValue(column.max));
+        AppendField(result, column.distinct.Serialize());
+    }
+    result += std::to_string(deleted_count_) + "|" + (exact_ ? "1" : "0") + "|" + std::to_string(row_count_) + "|";
+    result += string(stale_ ? "1" : "0") + "|";
+    return result;
+}
+
+bool RucksDBTableStatistics::Deserialize(const string& data, const vector<LogicalType>& types) {
+    idx_t pos = 0;
+    idx_t column_count;
+    if (!ReadNumber(data, pos, column_count) || column_count != types.size()) {
+        return false;
+    }
+
+    vector<RucksDBColumnStatistics> columns(column_count);
+    for (idx_t col_idx = 0; col_idx < column_count; col_idx++) {
+        auto& column = columns[col_idx];
+        string min_data, max_data, hll_data;
+        if (!ReadNumber(data, pos, column.null_count) || !ReadNumber(data, pos, column.valid_count) ||
+            !ReadField(data, pos, min_data) || !ReadField(data, pos, max_data) ||
+            !ReadField(data, pos, hll_data) || !column.distinct.Deserialize(hll_data)) {
+            return false;
+        }
+        column.min = DeserializeValue(min_data, types[col_idx]);
+        column.max = DeserializeValue(max_data, types[col_idx]);
+    }
+
+    // Trailer is optional so records written before deletes were tracked still load. Records
+    // without a row count cannot be checked against the table and are taken as inexact.
+    idx_t deleted_count = 0;
+    idx_t exact = 1;
+    idx_t row_count = 0;
+    if (pos < data.size() && (!ReadNumber(data, pos, deleted_count) || !ReadNumber(data, pos, exact))) {
+        return false;
+    }
+    bool has_row_count = pos < data.size();
+    if (has_row_count && !ReadNumber(data, pos, row_count)) {
+        return false;
+    }
+    // Stale statistics keep being written, and their row count then matches the table again
+    idx_t stale = 0;
+    if (pos < data.size() && !ReadNumber(data, pos, stale)) {
+        return false;
+    }
+
+    columns_ = std::move(columns);
+    deleted_count_ = deleted_count;
+    row_count_ = row_count;
+    exact_ = exact != 0 && has_row_count;
+    stale_ = stale != 0;
+    return true;
+}
+
+} // namespace duckdb
\ No newline at end of file
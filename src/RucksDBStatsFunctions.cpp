@@ -0,0 +1,303 @@
+#include "../include/RucksDBStatsFunctions.hpp"
+#include "../include/RucksDBExtension.hpp"
+#include "../include/RucksDBIngestQueue.hpp"
+#include "../include/RucksDBMemoryBudget.hpp"
+#include "../include/RucksDBTrace.hpp"
+#include "duckdb/main/extension_util.hpp"
+
+namespace duckdb {
+
+static void AddRow(RucksDBStatsState& state, const string& category, const string& name, uint64_t value) {
+    state.rows.push_back({Value(category), Value(name), Value::UBIGINT(value)});
+}
+
+static void AddOperationRows(RucksDBStatsState& state, RucksDBOperationSet& ops) {
+    for (idx_t i = 0; i < RUCKSDB_OPERATION_COUNT; i++) {
+        auto op = (RucksDBOperation)i;
+        auto& metrics = ops.Get(op);
+        string name = RucksDBOperationName(op);
+        auto& latency = metrics.latency_ns;
+
+        AddRow(state, "operation", name + ".count", latency.Count());
+        AddRow(state, "operation", name + ".rows", metrics.rows);
+        AddRow(state, "operation", name + ".bytes", metrics.bytes);
+        AddRow(state, "operation", name + ".mean_ns", (uint64_t)latency.Mean());
+        AddRow(state, "operation", name + ".p50_ns", latency.Percentile(50));
+        AddRow(state, "operation", name + ".p99_ns", latency.Percentile(99));
+        AddRow(state, "operation", name + ".p999_ns", latency.Percentile(99.9));
+        AddRow(state, "operation", name + ".max_ns", latency.Max());
+    }
+}
+
+static void AddPerfRows(RucksDBStatsState& state, const RucksDBPerfSample& perf) {
+    AddRow(state, "perf_context", "samples", perf.samples);
+    AddRow(state, "perf_context", "block_cache_hit_count", perf.block_cache_hit_count);
+    AddRow(state, "perf_context", "block_read_count", perf.block_read_count);
+    AddRow(state, "perf_context", "block_read_byte", perf.block_read_byte);
+    AddRow(state, "perf_context", "block_read_time_ns", perf.block_read_time_ns);
+    AddRow(state, "perf_context", "get_from_memtable_count", perf.get_from_memtable_count);
+    AddRow(state, "perf_context", "internal_key_skipped_count", perf.internal_key_skipped_count);
+    AddRow(state, "perf_context", "internal_delete_skipped_count", perf.internal_delete_skipped_count);
+    AddRow(state, "perf_context", "write_wal_time_ns", perf.write_wal_time_ns);
+    AddRow(state, "perf_context", "write_memtable_time_ns", perf.write_memtable_time_ns);
+    AddRow(state, "iostats_context", "bytes_read", perf.io_bytes_read);
+    AddRow(state, "iostats_context", "bytes_written", perf.io_bytes_written);
+}
+
+static void AddRocksDBRows(RucksDBStatsState& state, rocksdb::Statistics& statistics) {
+    for (const auto& ticker : rocksdb::TickersNameMap) {
+        AddRow(state, "rocksdb", ticker.second, statistics.getTickerCount(ticker.first));
+    }
+    // Histograms are reported in RocksDB's own units (mostly micros); skip the ones never hit
+    for (const auto& histogram : rocksdb::HistogramsNameMap) {
+        rocksdb::HistogramData data;
+        statistics.histogramData(histogram.first, &data);
+        if (data.count == 0) {
+            continue;
+        }
+        AddRow(state, "rocksdb", histogram.second + ".count", data.count);
+        AddRow(state, "rocksdb", histogram.second + ".p50", (uint64_t)data.median);
+        AddRow(state, "rocksdb", histogram.second + ".p99", (uint64_t)data.percentile99);
+        AddRow(state, "rocksdb", histogram.second + ".max", (uint64_t)data.max);
+    }
+}
+
+// rucksdb_stats()
+static unique_ptr<FunctionData> StatsBind(ClientContext& context, TableFunctionBindInput& input,
+                                          vector<LogicalType>& return_types, vector<string>& names) {
+    names = {"category", "name", "value"};
+    return_types = {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::UBIGINT};
+
+    auto bind_data = make_unique<RucksDBStatsBindData>();
+    bind_data->instance = RucksDBInstanceRegistry::Get(input);
+    return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> StatsInit(ClientContext& context, TableFunctionInitInput& input) {
+    auto& bind_data = (RucksDBStatsBindData&)*input.bind_data;
+    auto& storage = *bind_data.instance.storage;
+    auto state = make_unique<RucksDBStatsState>();
+
+    AddOperationRows(*state, storage.GetMetrics().GetStorageOperations());
+    AddPerfRows(*state, storage.GetMetrics().GetPerfSample());
+
+    auto cache = storage.GetCacheStatistics();
+    AddRow(*state, "cache", "hits", cache.hits);
+    AddRow(*state, "cache", "misses", cache.misses);
+    AddRow(*state, "cache", "inserts", cache.inserts);
+    AddRow(*state, "cache", "evictions", cache.evictions);
+    AddRow(*state, "cache", "invalidations", cache.invalidations);
+    AddRow(*state, "cache", "usage", cache.usage);
+    AddRow(*state, "cache", "capacity", cache.capacity);
+
+    if (storage.GetMemoryBudget()) {
+        auto memory = storage.GetMemoryBudget()->GetStatistics();
+        AddRow(*state, "memory", "budget", memory.budget);
+        AddRow(*state, "memory", "rocksdb_capacity", memory.rocksdb_capacity);
+        AddRow(*state, "memory", "rocksdb_usage", memory.rocksdb_usage);
+        AddRow(*state, "memory", "memtable_usage", memory.memtable_usage);
+        AddRow(*state, "memory", "duckdb_limit", memory.duckdb_limit);
+        AddRow(*state, "memory", "duckdb_used", memory.duckdb_used);
+        AddRow(*state, "memory", "shrinks", memory.shrinks);
+        AddRow(*state, "memory", "grows", memory.grows);
+    }
+
+    // The ingest queue only ever writes to the default storage
+    if (g_ingest_queue && &storage == g_rocksdb_storage.get()) {
+        auto ingest = g_ingest_queue->GetStatistics();
+        AddRow(*state, "ingest", "enqueued", ingest.enqueued);
+        AddRow(*state, "ingest", "completed", ingest.completed);
+        AddRow(*state, "ingest", "failed", ingest.failed);
+        AddRow(*state, "ingest", "batches", ingest.batches);
+        AddRow(*state, "ingest", "enqueue_p50_ns", ingest.enqueue_p50_ns);
+        AddRow(*state, "ingest", "enqueue_p99_ns", ingest.enqueue_p99_ns);
+        AddRow(*state, "ingest", "commit_p50_ns", ingest.commit_p50_ns);
+        AddRow(*state, "ingest", "commit_p99_ns", ingest.commit_p99_ns);
+    }
+
+    auto replication = storage.GetReplicationStatus();
+    AddRow(*state, "replication", "read_only", storage.IsReadOnly() ? 1 : 0);
+    AddRow(*state, "replication", "secondary", replication.mode == RucksDBOpenMode::SECONDARY ? 1 : 0);
+    AddRow(*state, "replication", "catch_ups", replication.catch_ups);
+    AddRow(*state, "replication", "catch_up_failures", replication.catch_up_failures);
+    AddRow(*state, "replication", "staleness_ms", replication.staleness_ms);
+    AddRow(*state, "replication", "latest_sequence", replication.latest_sequence);
+
+    if (storage.GetStatistics()) {
+        AddRocksDBRows(*state, *storage.GetStatistics());
+    }
+    return std::move(state);
+}
+
+// rucksdb_table_stats('t')
+static unique_ptr<FunctionData> TableStatsBind(ClientContext& context, TableFunctionBindInput& input,
+                                               vector<LogicalType>& return_types, vector<string>& names) {
+    auto table_name = input.inputs[0].GetValue<string>();
+    auto instance = RucksDBInstanceRegistry::Get(input);
+    if (!instance.registry->TableExists(table_name)) {
+        throw std::runtime_error("RocksDB table '" + table_name + "' does not exist");
+    }
+
+    names = {"operation", "count", "rows", "bytes", "mean_ns", "p50_ns", "p99_ns", "p999_ns", "max_ns"};
+    return_types = {LogicalType::VARCHAR, LogicalType::UBIGINT, LogicalType::UBIGINT, LogicalType::UBIGINT,
+                    LogicalType::DOUBLE, LogicalType::UBIGINT, LogicalType::UBIGINT, LogicalType::UBIGINT,
+                    LogicalType::UBIGINT};
+
+    auto bind_data = make_unique<RucksDBStatsBindData>();
+    bind_data->argument = table_name;
+    bind_data->instance = instance;
+    return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> TableStatsInit(ClientContext& context, TableFunctionInitInput& input) {
+    auto& bind_data = (RucksDBStatsBindData&)*input.bind_data;
+    auto& ops = bind_data.instance.storage->GetMetrics().GetTableOperations(bind_data.argument);
+
+    auto state = make_unique<RucksDBStatsState>();
+    for (idx_t i = 0; i < RUCKSDB_OPERATION_COUNT; i++) {
+        auto op = (RucksDBOperation)i;
+        auto& metrics = ops.Get(op);
+        auto& latency = metrics.latency_ns;
+        state->rows.push_back({Value(RucksDBOperationName(op)), Value::UBIGINT(latency.Count()),
+                               Value::UBIGINT(metrics.rows), Value::UBIGINT(metrics.bytes),
+                               Value::DOUBLE(latency.Mean()), Value::UBIGINT(latency.Percentile(50)),
+                               Value::UBIGINT(latency.Percentile(99)), Value::UBIGINT(latency.Percentile(99.9)),
+                               Value::UBIGINT(latency.Max())});
+    }
+    return std::move(state);
+}
+
+// rucksdb_rocksdb_property('rocksdb.stats')
+static unique_ptr<FunctionData> PropertyBind(ClientContext& context, TableFunctionBindInput& input,
+                                             vector<LogicalType>& return_types, vector<string>& names) {
+    names = {"property", "value"};
+    return_types = {LogicalType::VARCHAR, LogicalType::VARCHAR};
+
+    auto bind_data = make_unique<RucksDBStatsBindData>();
+    bind_data->argument = input.inputs[0].GetValue<string>();
+    bind_data->instance = RucksDBInstanceRegistry::Get(input);
+    return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> PropertyInit(ClientContext& context, TableFunctionInitInput& input) {
+    auto& bind_data = (RucksDBStatsBindData&)*input.bind_data;
+
+    string value;
+    if (!bind_data.instance.storage->GetProperty(bind_data.argument, value)) {
+        throw std::runtime_error("Unknown RocksDB property '" + bind_data.argument + "'");
+    }
+
+    auto state = make_unique<RucksDBStatsState>();
+    state->rows.push_back({Value(bind_data.argument), Value(value)});
+    return std::move(state);
+}
+
+// rucksdb_trace_start / rucksdb_trace_stop / rucksdb_trace_dump
+static unique_ptr<FunctionData> TraceBind(ClientContext& context, TableFunctionBindInput& input,
+                                          vector<LogicalType>& return_types, vector<string>& names) {
+    names = {"tracing", "events"};
+    return_types = {LogicalType::BOOLEAN, LogicalType::UBIGINT};
+
+    auto bind_data = make_unique<RucksDBStatsBindData>();
+    if (!input.inputs.empty()) {
+        bind_data->argument = input.inputs[0].ToString();
+    }
+    return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> TraceStartInit(ClientContext& context, TableFunctionInitInput& input) {
+    auto& bind_data = (RucksDBStatsBindData&)*input.bind_data;
+    size_t events_per_thread = bind_data.argument.empty() ? 65536 : std::stoull(bind_data.argument);
+    RucksDBTracer::Enable(events_per_thread);
+
+    auto state = make_unique<RucksDBStatsState>();
+    state->rows.push_back({Value::BOOLEAN(true), Value::UBIGINT(events_per_thread)});
+    return std::move(state);
+}
+
+static unique_ptr<GlobalTableFunctionState> TraceStopInit(ClientContext& context, TableFunctionInitInput& input) {
+    RucksDBTracer::Disable();
+
+    auto state = make_unique<RucksDBStatsState>();
+    state->rows.push_back({Value::BOOLEAN(false), Value::UBIGINT(0)});
+    return std::move(state);
+}
+
+static unique_ptr<FunctionData> TraceDumpBind(ClientContext& context, TableFunctionBindInput& input,
+                                              vector<LogicalType>& return_types, vector<string>& names) {
+    names = {"path", "events"};
+    return_types = {LogicalType::VARCHAR, LogicalType::UBIGINT};
+
+    auto bind_data = make_unique<RucksDBStatsBindData>();
+    bind_data->argument = input.inputs[0].GetValue<string>();
+    return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> TraceDumpInit(ClientContext& context, TableFunctionInitInput& input) {
+    auto& bind_data = (RucksDBStatsBindData&)*input.bind_data;
+    size_t events = RucksDBTracer::DumpChromeTrace(bind_data.argument);
+
+    auto state = make_unique<RucksDBStatsState>();
+    state->rows.push_back({Value(bind_data.argument), Value::UBIGINT(events)});
+    return std::move(state);
+}
+
+void RucksDBStatsFunctions::ExecuteRows(ClientContext& context, TableFunctionInput& data, DataChunk& output) {
+    auto& state = (RucksDBStatsState&)*data.global_state;
+
+    idx_t count = 0;
+    while (state.offset < state.rows.size() && count < STANDARD_VECTOR_SIZE) {
+        auto& row = state.rows[state.offset++];
+        for (idx_t col_idx = 0; col_idx < row.size(); col_idx++) {
+            output.SetValue(col_idx, count, row[col_idx]);
+        }
+        count++;
+    }
+    output.SetCardinality(count);
+}
+
+TableFunction RucksDBStatsFunctions::GetStatsFunction() {
+    TableFunction function("rucksdb_stats", {}, ExecuteRows, StatsBind, StatsInit);
+    function.named_parameters["database"] = LogicalType::VARCHAR;
+    return function;
+}
+
+TableFunction RucksDBStatsFunctions::GetTableStatsFunction() {
+    TableFunction function("rucksdb_table_stats", {LogicalType::VARCHAR}, ExecuteRows, TableStatsBind,
+                           TableStatsInit);
+    function.named_parameters["database"] = LogicalType::VARCHAR;
+    return function;
+}
+
+TableFunction RucksDBStatsFunctions::GetPropertyFunction() {
+    TableFunction function("rucksdb_rocksdb_property", {LogicalType::VARCHAR}, ExecuteRows, PropertyBind,
+                           PropertyInit);
+    function.named_parameters["database"] = LogicalType::VARCHAR;
+    return function;
+}
+
+TableFunctionSet RucksDBStatsFunctions::GetTraceStartFunction() {
+    TableFunctionSet set("rucksdb_trace_start");
+    set.AddFunction(TableFunction({}, ExecuteRows, TraceBind, TraceStartInit));
+    set.AddFunction(TableFunction({LogicalType::BIGINT}, ExecuteRows, TraceBind, TraceStartInit));
+    return set;
+}
+
+TableFunction RucksDBStatsFunctions::GetTraceStopFunction() {
+    return TableFunction("rucksdb_trace_stop", {}, ExecuteRows, TraceBind, TraceStopInit);
+}
+
+TableFunction RucksDBStatsFunctions::GetTraceDumpFunction() {
+    return TableFunction("rucksdb_trace_dump", {LogicalType::VARCHAR}, ExecuteRows, TraceDumpBind, TraceDumpInit);
+}
+
+void RucksDBStatsFunctions::RegisterFunctions(DatabaseInstance& db) {
+    ExtensionUtil::RegisterFunction(db, GetStatsFunction());
+    ExtensionUtil::RegisterFunction(db, GetTableStatsFunction());
+    ExtensionUtil::RegisterFunction(db, GetPropertyFunction());
+    ExtensionUtil::RegisterFunction(db, GetTraceStartFunction());
+    ExtensionUtil::RegisterFunction(db, GetTraceStopFunction());
+    ExtensionUtil::RegisterFunction(db, GetTraceDumpFunction());
+}
+
+} // namespace duckdb
\ No newline at end of file
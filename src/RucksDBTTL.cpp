@@ -0,0 +1,191 @@
+#include "../include/RucksDBTTL.hpp"
+#include "../include/RucksDBMergeOperator.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/timestamp.hpp"
+
+namespace duckdb {
+
+static constexpr char PARTITION_PREFIX[] = "table_part_";
+
+static bool IsTimeColumnType(const LogicalType& type) {
+    switch (type.id()) {
+    case LogicalTypeId::TIMESTAMP:
+    case LogicalTypeId::INTEGER:
+    case LogicalTypeId::BIGINT:
+    case LogicalTypeId::UINTEGER:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void RucksDBTableTTL::Bind(const vector<ColumnDefinition>& columns) {
+    if (ttl_seconds <= 0 || partition_seconds <= 0) {
+        throw std::runtime_error("TTL and partition width must be positive");
+    }
+    for (idx_t i = 0; i < columns.size(); i++) {
+        if (StringUtil::CIEquals(columns[i].Name(), column)) {
+            if (!IsTimeColumnType(columns[i].Type())) {
+                throw std::runtime_error("TTL column '" + column + "' must be a TIMESTAMP or integer epoch seconds");
+            }
+            column_index = i;
+            type = columns[i].Type();
+            return;
+        }
+    }
+    throw std::runtime_error("Column '" + column + "' does not exist");
+}
+
+string RucksDBTableTTL::Serialize() const {
+    // Column last, so it may contain the separator
+    return std::to_string(ttl_seconds) + "|" + std::to_string(partition_seconds) + "|" + column;
+}
+
+RucksDBTableTTL RucksDBTableTTL::Deserialize(const string& data) {
+    auto first = data.find('|');
+    auto second = first == string::npos ? string::npos : data.find('|', first + 1);
+    if (second == string::npos) {
+        throw std::runtime_error("Corrupt RucksDB TTL definition");
+    }
+    RucksDBTableTTL ttl;
+    ttl.ttl_seconds = std::stoll(data.substr(0, first));
+    ttl.partition_seconds = std::stoll(data.substr(first + 1, second - first - 1));
+    ttl.column = data.substr(second + 1);
+    return ttl;
+}
+
+int64_t RucksDBTableTTL::PartitionOf(const Value& value) const {
+    if (value.IsNull()) {
+        return NULL_PARTITION;
+    }
+    // Values decoded from storage are not always of the column type
+    auto time = value.type() == type ? value : value.DefaultCastAs(type);
+    int64_t seconds = type.id() == LogicalTypeId::TIMESTAMP
+                          ? Timestamp::GetEpochSeconds(time.GetValue<timestamp_t>())
+                          : time.GetValue<int64_t>();
+    return seconds - ((seconds % partition_seconds) + partition_seconds) % partition_seconds;
+}
+
+bool RucksDBTableTTL::IsExpiredRow(const vector<Value>& row, int64_t now) const {
+    if (column_index >= row.size()) {
+        return false;
+    }
+    return IsExpired(PartitionOf(row[column_index]), now);
+}
+
+int64_t RucksDBTableTTL::Now() {
+    return Timestamp::GetEpochSeconds(Timestamp::GetCurrentTimestamp());
+}
+
+// Partition index implementation
+string RucksDBPartitionIndex::GetPrefix(const string& table_name) {
+    return string(PARTITION_PREFIX) + table_name + ":";
+}
+
+string RucksDBPartitionIndex::GetKey(const string& table_name, int64_t partition) {
+    return GetPrefix(table_name) + std::to_string(partition);
+}
+
+static string EncodePartition(const RucksDBPartition& partition) {
+    vector<RucksDBAggregateValue> values(3);
+    values[0].kind = RucksDBAggregateKind::MIN;
+    values[0].int_value = (int64_t)partition.first_row;
+    values[1].kind = RucksDBAggregateKind::MAX;
+    values[1].int_value = (int64_t)partition.end_row;
+    values[2].kind = RucksDBAggregateKind::SUM;
+    values[2].int_value = (int64_t)partition.rows;
+    for (auto& value : values) {
+        value.empty = false;
+    }
+    return EncodeAggregates(values);
+}
+
+void RucksDBPartitionIndex::Load(RocksDBStorage* storage, const string& table_name) {
+    std::lock_guard<std::mutex> guard(lock_);
+    partitions_.clear();
+
+    string prefix = GetPrefix(table_name);
+    vector<RucksDBAggregateValue> values;
+    storage->IteratePrefix(prefix, [&](const string& key, const string& value) {
+        if (!DecodeAggregates(value, values) || values.size() != 3) {
+            return true;
+        }
+        auto& partition = partitions_[std::stoll(key.substr(prefix.size()))];
+        partition.first_row = (idx_t)values[0].int_value;
+        partition.end_row = (idx_t)values[1].int_value;
+        partition.rows = (idx_t)values[2].int_value;
+        return true;
+    });
+}
+
+void RucksDBPartitionIndex::Clear() {
+    std::lock_guard<std::mutex> guard(lock_);
+    partitions_.clear();
+}
+
+void RucksDBPartitionIndex::Add(const string& table_name, const RucksDBTableTTL& ttl, const DataChunk& chunk,
+                                idx_t start_row, rocksdb::WriteBatch& batch) {
+    // Appends mostly touch one or two partitions, so collect per chunk before merging
+    std::map<int64_t, RucksDBPartition> deltas;
+    for (idx_t i = 0; i < chunk.size(); i++) {
+        auto partition = ttl.PartitionOf(chunk.GetValue(ttl.column_index, i));
+        idx_t row_id = start_row + i;
+        auto it = deltas.find(partition);
+        if (it == deltas.end()) {
+            deltas[partition] = RucksDBPartition {row_id, row_id + 1, 1};
+        } else {
+            it->second.end_row = row_id + 1;
+            it->second.rows++;
+        }
+    }
+    for (auto& delta : deltas) {
+        Add(table_name, delta.first, delta.second, batch);
+    }
+}
+
+void RucksDBPartitionIndex::Add(const string& table_name, int64_t partition, const RucksDBPartition& delta,
+                                rocksdb::WriteBatch& batch) {
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        auto it = partitions_.find(partition);
+        if (it == partitions_.end()) {
+            partitions_[partition] = delta;
+        } else {
+            it->second.first_row = std::min(it->second.first_row, delta.first_row);
+            it->second.end_row = std::max(it->second.end_row, delta.end_row);
+            it->second.rows += delta.rows;
+        }
+    }
+    batch.Merge(GetKey(table_name, partition), EncodePartition(delta));
+}
+
+idx_t RucksDBPartitionIndex::FirstLiveRow(const RucksDBTableTTL& ttl, int64_t now, idx_t row_count) {
+    std::lock_guard<std::mutex> guard(lock_);
+    idx_t first_live = row_count;
+    for (auto& entry : partitions_) {
+        if (!ttl.IsExpired(entry.first, now)) {
+            first_live = std::min(first_live, entry.second.first_row);
+        }
+    }
+    return first_live;
+}
+
+idx_t RucksDBPartitionIndex::DropExpired(const string& table_name, const RucksDBTableTTL& ttl, int64_t now,
+                                         idx_t& partitions, rocksdb::WriteBatch& batch) {
+    std::lock_guard<std::mutex> guard(lock_);
+    idx_t rows = 0;
+    partitions = 0;
+    for (auto it = partitions_.begin(); it != partitions_.end();) {
+        if (!ttl.IsExpired(it->first, now)) {
+            it++;
+            continue;
+        }
+        rows += it->second.rows;
+        partitions++;
+        batch.Delete(GetKey(table_name, it->first));
+        it = partitions_.erase(it);
+    }
+    return rows;
+}
+
+} // namespace duckdb
@@ -0,0 +1,92 @@
+#include "../include/RucksDBTTLFunctions.hpp"
+#include "../include/RucksDBStatsFunctions.hpp"
+#include "../include/RucksDBExtension.hpp"
+#include "../include/RucksDBInstance.hpp"
+#include "duckdb/main/extension_util.hpp"
+
+namespace duckdb {
+
+struct RucksDBTTLBindData : public TableFunctionData {
+    string table_name;
+    RucksDBTableTTL ttl;
+    RucksDBInstance instance;
+};
+
+// rucksdb_set_ttl('table', 'column', ttl_seconds)
+static unique_ptr<FunctionData> SetTTLBind(ClientContext& context, TableFunctionBindInput& input,
+                                           vector<LogicalType>& return_types, vector<string>& names) {
+    names = {"table", "partitions"};
+    return_types = {LogicalType::VARCHAR, LogicalType::UBIGINT};
+
+    auto bind_data = make_unique<RucksDBTTLBindData>();
+    bind_data->table_name = input.inputs[0].GetValue<string>();
+    bind_data->ttl.column = input.inputs[1].GetValue<string>();
+    bind_data->ttl.ttl_seconds = input.inputs[2].GetValue<int64_t>();
+    auto partition = input.named_parameters.find("partition_seconds");
+    if (partition != input.named_parameters.end() && !partition->second.IsNull()) {
+        bind_data->ttl.partition_seconds = partition->second.GetValue<int64_t>();
+    }
+    bind_data->instance = RucksDBInstanceRegistry::Get(input);
+    return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> SetTTLInit(ClientContext& context, TableFunctionInitInput& input) {
+    auto& bind_data = (RucksDBTTLBindData&)*input.bind_data;
+    auto& registry = *bind_data.instance.registry;
+
+    idx_t partitions = 0;
+    if (bind_data.ttl.ttl_seconds == 0) {
+        registry.ClearTableTTL(bind_data.table_name);
+    } else {
+        partitions = registry.SetTableTTL(bind_data.table_name, bind_data.ttl);
+    }
+
+    auto state = make_unique<RucksDBStatsState>();
+    state->rows.push_back({Value(bind_data.table_name), Value::UBIGINT(partitions)});
+    return std::move(state);
+}
+
+// rucksdb_expire('table')
+static unique_ptr<FunctionData> ExpireBind(ClientContext& context, TableFunctionBindInput& input,
+                                           vector<LogicalType>& return_types, vector<string>& names) {
+    names = {"table", "partitions", "rows"};
+    return_types = {LogicalType::VARCHAR, LogicalType::UBIGINT, LogicalType::UBIGINT};
+
+    auto bind_data = make_unique<RucksDBTTLBindData>();
+    bind_data->table_name = input.inputs[0].GetValue<string>();
+    bind_data->instance = RucksDBInstanceRegistry::Get(input);
+    return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> ExpireInit(ClientContext& context, TableFunctionInitInput& input) {
+    auto& bind_data = (RucksDBTTLBindData&)*input.bind_data;
+
+    idx_t partitions = 0;
+    idx_t rows = bind_data.instance.registry->ExpireTable(bind_data.table_name, partitions);
+
+    auto state = make_unique<RucksDBStatsState>();
+    state->rows.push_back({Value(bind_data.table_name), Value::UBIGINT(partitions), Value::UBIGINT(rows)});
+    return std::move(state);
+}
+
+TableFunction RucksDBTTLFunctions::GetSetTTLFunction() {
+    TableFunction function("rucksdb_set_ttl", {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::BIGINT},
+                           RucksDBStatsFunctions::ExecuteRows, SetTTLBind, SetTTLInit);
+    function.named_parameters["partition_seconds"] = LogicalType::BIGINT;
+    function.named_parameters["database"] = LogicalType::VARCHAR;
+    return function;
+}
+
+TableFunction RucksDBTTLFunctions::GetExpireFunction() {
+    TableFunction function("rucksdb_expire", {LogicalType::VARCHAR}, RucksDBStatsFunctions::ExecuteRows,
+                           ExpireBind, ExpireInit);
+    function.named_parameters["database"] = LogicalType::VARCHAR;
+    return function;
+}
+
+void RucksDBTTLFunctions::RegisterFunctions(DatabaseInstance& db) {
+    ExtensionUtil::RegisterFunction(db, GetSetTTLFunction());
+    ExtensionUtil::RegisterFunction(db, GetExpireFunction());
+}
+
+} // namespace duckdb
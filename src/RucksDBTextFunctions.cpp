@@ -0,0 +1,193 @@
+#include "../include/RucksDBTextFunctions.hpp"
+#include "../include/RucksDBStatsFunctions.hpp"
+#include "../include/RucksDBExtension.hpp"
+#include "../include/RucksDBInstance.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/main/extension_util.hpp"
+
+namespace duckdb {
+
+struct RucksDBTextIndexBindData : public TableFunctionData {
+    RucksDBTextIndexDefinition index;
+    RucksDBInstance instance;
+};
+
+// rucksdb_create_text_index('name', 'table', 'column')
+static unique_ptr<FunctionData> CreateIndexBind(ClientContext& context, TableFunctionBindInput& input,
+                                                vector<LogicalType>& return_types, vector<string>& names) {
+    names = {"index", "rows"};
+    return_types = {LogicalType::VARCHAR, LogicalType::UBIGINT};
+
+    auto bind_data = make_unique<RucksDBTextIndexBindData>();
+    bind_data->index.name = input.inputs[0].GetValue<string>();
+    bind_data->index.table_name = input.inputs[1].GetValue<string>();
+    bind_data->index.column = input.inputs[2].GetValue<string>();
+    bind_data->instance = RucksDBInstanceRegistry::Get(input);
+    return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> CreateIndexInit(ClientContext& context, TableFunctionInitInput& input) {
+    auto& bind_data = (RucksDBTextIndexBindData&)*input.bind_data;
+    idx_t rows = bind_data.instance.registry->CreateTextIndex(bind_data.index);
+
+    auto state = make_unique<RucksDBStatsState>();
+    state->rows.push_back({Value(bind_data.index.name), Value::UBIGINT(rows)});
+    return std::move(state);
+}
+
+// rucksdb_drop_text_index('name')
+static unique_ptr<FunctionData> DropIndexBind(ClientContext& context, TableFunctionBindInput& input,
+                                              vector<LogicalType>& return_types, vector<string>& names) {
+    names = {"index"};
+    return_types = {LogicalType::VARCHAR};
+
+    auto bind_data = make_unique<RucksDBTextIndexBindData>();
+    bind_data->index.name = input.inputs[0].GetValue<string>();
+    bind_data->instance = RucksDBInstanceRegistry::Get(input);
+    return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> DropIndexInit(ClientContext& context, TableFunctionInitInput& input) {
+    auto& bind_data = (RucksDBTextIndexBindData&)*input.bind_data;
+    bind_data.instance.registry->DropTextIndex(bind_data.index.name);
+
+    auto state = make_unique<RucksDBStatsState>();
+    state->rows.push_back({Value(bind_data.index.name)});
+    return std::move(state);
+}
+
+struct RucksDBTextSearchBindData : public TableFunctionData {
+    RucksDBInstance instance;
+    RucksDBTableStorage* table_storage;
+    idx_t column_index;
+    RucksDBTextQuery query;
+    bool indexed = false;
+    RucksDBTextIndexDefinition index;
+};
+
+struct RucksDBTextSearchState : public GlobalTableFunctionState {
+    // Candidates from the posting lists, or every row id when the column has no index
+    vector<idx_t> row_ids;
+    idx_t offset = 0;
+    idx_t end_row = 0;
+    bool indexed = false;
+    vector<vector<Value>> rows;
+    vector<bool> found;
+    vector<idx_t> batch;
+};
+
+// rucksdb_text_search('table', 'column', 'query')
+static unique_ptr<FunctionData> TextSearchBind(ClientContext& context, TableFunctionBindInput& input,
+                                               vector<LogicalType>& return_types, vector<string>& names) {
+    auto table_name = input.inputs[0].GetValue<string>();
+    auto column = input.inputs[1].GetValue<string>();
+    auto bind_data = make_unique<RucksDBTextSearchBindData>();
+    bind_data->instance = RucksDBInstanceRegistry::Get(input);
+    bind_data->table_storage = bind_data->instance.registry->GetTable(table_name);
+    if (!bind_data->table_storage) {
+        throw std::runtime_error("RocksDB table '" + table_name + "' does not exist");
+    }
+
+    auto& columns = bind_data->table_storage->GetColumns();
+    bind_data->column_index = columns.size();
+    for (idx_t i = 0; i < columns.size(); i++) {
+        names.push_back(columns[i].Name());
+        return_types.push_back(columns[i].Type());
+        if (StringUtil::CIEquals(columns[i].Name(), column)) {
+            bind_data->column_index = i;
+        }
+    }
+    if (bind_data->column_index == columns.size()) {
+        throw std::runtime_error("Column '" + column + "' does not exist in RocksDB table '" + table_name + "'");
+    }
+    names.push_back("row_id");
+    return_types.push_back(LogicalType::BIGINT);
+
+    bind_data->query = RucksDBTextQuery::Parse(input.inputs[2].GetValue<string>());
+    bind_data->indexed = bind_data->table_storage->GetTextIndex(column, bind_data->index);
+    return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> TextSearchInit(ClientContext& context, TableFunctionInitInput& input) {
+    auto& bind_data = (RucksDBTextSearchBindData&)*input.bind_data;
+    auto state = make_unique<RucksDBTextSearchState>();
+    state->indexed = bind_data.indexed;
+    if (bind_data.indexed) {
+        state->row_ids = bind_data.query.Evaluate(*bind_data.instance.storage, bind_data.index);
+    } else {
+        state->end_row = bind_data.table_storage->GetRowCount();
+    }
+    return std::move(state);
+}
+
+static void TextSearchExecute(ClientContext& context, TableFunctionInput& data, DataChunk& output) {
+    auto& bind_data = (RucksDBTextSearchBindData&)*data.bind_data;
+    auto& state = (RucksDBTextSearchState&)*data.global_state;
+    idx_t row_id_column = output.ColumnCount() - 1;
+
+    idx_t count = 0;
+    while (count == 0) {
+        // Next vector of candidates; stale or deleted ones drop out below
+        state.batch.clear();
+        if (state.indexed) {
+            while (state.offset < state.row_ids.size() && state.batch.size() < STANDARD_VECTOR_SIZE) {
+                state.batch.push_back(state.row_ids[state.offset++]);
+            }
+        } else {
+            while (state.offset < state.end_row && state.batch.size() < STANDARD_VECTOR_SIZE) {
+                state.batch.push_back(state.offset++);
+            }
+        }
+        if (state.batch.empty()) {
+            break;
+        }
+
+        bind_data.table_storage->FetchRows(state.batch, state.rows, state.found);
+        for (idx_t i = 0; i < state.batch.size(); i++) {
+            if (!state.found[i]) {
+                continue;
+            }
+            auto& row = state.rows[i];
+            if (bind_data.column_index >= row.size() || row[bind_data.column_index].IsNull() ||
+                !bind_data.query.Matches(row[bind_data.column_index].ToString())) {
+                continue;
+            }
+            for (idx_t col_idx = 0; col_idx < row_id_column && col_idx < row.size(); col_idx++) {
+                output.SetValue(col_idx, count, row[col_idx]);
+            }
+            output.SetValue(row_id_column, count, Value::BIGINT((int64_t)state.batch[i]));
+            count++;
+        }
+    }
+    output.SetCardinality(count);
+}
+
+TableFunction RucksDBTextFunctions::GetCreateTextIndexFunction() {
+    TableFunction function("rucksdb_create_text_index",
+                           {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR},
+                           RucksDBStatsFunctions::ExecuteRows, CreateIndexBind, CreateIndexInit);
+    function.named_parameters["database"] = LogicalType::VARCHAR;
+    return function;
+}
+
+TableFunction RucksDBTextFunctions::GetDropTextIndexFunction() {
+    TableFunction function("rucksdb_drop_text_index", {LogicalType::VARCHAR}, RucksDBStatsFunctions::ExecuteRows,
+                           DropIndexBind, DropIndexInit);
+    function.named_parameters["database"] = LogicalType::VARCHAR;
+    return function;
+}
+
+TableFunction RucksDBTextFunctions::GetTextSearchFunction() {
+    TableFunction function("rucksdb_text_search", {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR},
+                           TextSearchExecute, TextSearchBind, TextSearchInit);
+    function.named_parameters["database"] = LogicalType::VARCHAR;
+    return function;
+}
+
+void RucksDBTextFunctions::RegisterFunctions(DatabaseInstance& db) {
+    ExtensionUtil::RegisterFunction(db, GetCreateTextIndexFunction());
+    ExtensionUtil::RegisterFunction(db, GetDropTextIndexFunction());
+    ExtensionUtil::RegisterFunction(db, GetTextSearchFunction());
+}
+
+} // namespace duckdb
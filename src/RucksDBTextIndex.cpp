@@ -0,0 +1,229 @@
+#include "../include/RucksDBTextIndex.hpp"
+#include "../include/RucksDBMergeOperator.hpp"
+#include "duckdb/common/string_util.hpp"
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <unordered_set>
+
+namespace duckdb {
+
+static constexpr char TEXT_TERM_PREFIX[] = "ftidx_term_";
+static constexpr idx_t MAX_TERM_LENGTH = 64;
+
+void RucksDBTextIndexDefinition::Bind(const vector<ColumnDefinition>& columns) {
+    for (idx_t i = 0; i < columns.size(); i++) {
+        if (StringUtil::CIEquals(columns[i].Name(), column)) {
+            if (columns[i].Type().id() != LogicalTypeId::VARCHAR) {
+                throw std::runtime_error("Text index column '" + column + "' must be VARCHAR");
+            }
+            column_index = i;
+            return;
+        }
+    }
+    throw std::runtime_error("Column '" + column + "' does not exist");
+}
+
+string RucksDBTextIndexDefinition::Serialize() const {
+    // Column last, so it may contain the separator
+    return name + "|" + table_name + "|" + column;
+}
+
+RucksDBTextIndexDefinition RucksDBTextIndexDefinition::Deserialize(const string& data) {
+    auto first = data.find('|');
+    auto second = first == string::npos ? string::npos : data.find('|', first + 1);
+    if (second == string::npos) {
+        throw std::runtime_error("Corrupt RucksDB text index definition");
+    }
+    RucksDBTextIndexDefinition index;
+    index.name = data.substr(0, first);
+    index.table_name = data.substr(first + 1, second - first - 1);
+    index.column = data.substr(second + 1);
+    return index;
+}
+
+string RucksDBTextIndexDefinition::GetTermPrefix() const {
+    return GetTermPrefix(name);
+}
+
+string RucksDBTextIndexDefinition::GetTermPrefix(const string& index_name) {
+    return string(TEXT_TERM_PREFIX) + index_name + ":";
+}
+
+string RucksDBTextIndexDefinition::GetTermKey(const string& term) const {
+    return GetTermPrefix() + term;
+}
+
+void RucksDBTextIndexDefinition::Tokenize(const string& text, vector<string>& terms) {
+    terms.clear();
+    string term;
+    for (char c : text) {
+        // Bytes of multi-byte UTF-8 characters are kept, so non-ASCII words stay whole
+        if (isalnum((unsigned char)c) || (unsigned char)c >= 0x80) {
+            if (term.size() < MAX_TERM_LENGTH) {
+                term += (char)tolower((unsigned char)c);
+            }
+        } else if (!term.empty()) {
+            terms.push_back(std::move(term));
+            term.clear();
+        }
+    }
+    if (!term.empty()) {
+        terms.push_back(std::move(term));
+    }
+}
+
+static void WritePostings(const RucksDBTextIndexDefinition& index, std::map<string, vector<uint64_t>>& postings,
+                          rocksdb::WriteBatch& batch) {
+    for (auto& entry : postings) {
+        auto& row_ids = entry.second;
+        std::sort(row_ids.begin(), row_ids.end());
+        row_ids.erase(std::unique(row_ids.begin(), row_ids.end()), row_ids.end());
+        batch.Merge(index.GetTermKey(entry.first), EncodePostings(row_ids));
+    }
+}
+
+void RucksDBTextIndexDefinition::IndexChunk(const DataChunk& chunk, idx_t start_row,
+                                            rocksdb::WriteBatch& batch) const {
+    // One merge operand per term and chunk, rather than one per term occurrence
+    std::map<string, vector<uint64_t>> postings;
+    vector<string> terms;
+    for (idx_t i = 0; i < chunk.size(); i++) {
+        auto value = chunk.GetValue(column_index, i);
+        if (value.IsNull()) {
+            continue;
+        }
+        Tokenize(StringValue::Get(value), terms);
+        for (auto& term : terms) {
+            postings[term].push_back(start_row + i);
+        }
+    }
+    WritePostings(*this, postings, batch);
+}
+
+void RucksDBTextIndexDefinition::IndexRows(const vector<idx_t>& row_ids, const vector<string>& texts,
+                                           rocksdb::WriteBatch& batch) const {
+    std::map<string, vector<uint64_t>> postings;
+    vector<string> terms;
+    for (idx_t i = 0; i < row_ids.size(); i++) {
+        Tokenize(texts[i], terms);
+        for (auto& term : terms) {
+            postings[term].push_back(row_ids[i]);
+        }
+    }
+    WritePostings(*this, postings, batch);
+}
+
+// Query implementation
+RucksDBTextQuery RucksDBTextQuery::Parse(const string& query) {
+    RucksDBTextQuery result;
+    result.clauses.emplace_back();
+    for (auto& word : StringUtil::Split(query, ' ')) {
+        if (word.empty() || word == "AND") {
+            continue;
+        }
+        if (word == "OR") {
+            if (!result.clauses.back().empty()) {
+                result.clauses.emplace_back();
+            }
+            continue;
+        }
+        bool prefix = word.back() == '*';
+        vector<string> parts;
+        RucksDBTextIndexDefinition::Tokenize(prefix ? word.substr(0, word.size() - 1) : word, parts);
+        // "disk-full" is indexed as two terms, so it must match both
+        for (idx_t i = 0; i < parts.size(); i++) {
+            result.clauses.back().push_back(Term {parts[i], prefix && i + 1 == parts.size()});
+        }
+    }
+    if (result.clauses.back().empty()) {
+        result.clauses.pop_back();
+    }
+    if (result.clauses.empty()) {
+        throw std::runtime_error("Text query '" + query + "' has no terms");
+    }
+    return result;
+}
+
+static vector<uint64_t> ReadTermPostings(RocksDBStorage& storage, const RucksDBTextIndexDefinition& index,
+                                         const RucksDBTextQuery::Term& term) {
+    vector<uint64_t> row_ids;
+    if (!term.prefix) {
+        // Posting lists are large and read once per query, so they bypass the value cache
+        string data;
+        if (storage.ReadDataUncached(index.GetTermKey(term.text), data) && !DecodePostings(data, row_ids)) {
+            throw std::runtime_error("Corrupt posting list in text index '" + index.name + "'");
+        }
+        return row_ids;
+    }
+
+    vector<uint64_t> term_ids, merged;
+    storage.IteratePrefix(index.GetTermKey(term.text), [&](const string& key, const string& value) {
+        if (!DecodePostings(value, term_ids)) {
+            throw std::runtime_error("Corrupt posting list in text index '" + index.name + "'");
+        }
+        merged.clear();
+        std::set_union(row_ids.begin(), row_ids.end(), term_ids.begin(), term_ids.end(), std::back_inserter(merged));
+        row_ids.swap(merged);
+        return true;
+    });
+    return row_ids;
+}
+
+vector<idx_t> RucksDBTextQuery::Evaluate(RocksDBStorage& storage, const RucksDBTextIndexDefinition& index) const {
+    vector<uint64_t> result, clause_ids, term_ids, merged;
+    for (auto& clause : clauses) {
+        bool first = true;
+        for (auto& term : clause) {
+            term_ids = ReadTermPostings(storage, index, term);
+            if (first) {
+                clause_ids.swap(term_ids);
+                first = false;
+            } else {
+                merged.clear();
+                std::set_intersection(clause_ids.begin(), clause_ids.end(), term_ids.begin(), term_ids.end(),
+                                      std::back_inserter(merged));
+                clause_ids.swap(merged);
+            }
+            if (clause_ids.empty()) {
+                break;
+            }
+        }
+        merged.clear();
+        std::set_union(result.begin(), result.end(), clause_ids.begin(), clause_ids.end(), std::back_inserter(merged));
+        result.swap(merged);
+    }
+    return vector<idx_t>(result.begin(), result.end());
+}
+
+bool RucksDBTextQuery::Matches(const string& text) const {
+    vector<string> terms;
+    RucksDBTextIndexDefinition::Tokenize(text, terms);
+    std::unordered_set<string> present(terms.begin(), terms.end());
+    for (auto& clause : clauses) {
+        bool all = true;
+        for (auto& term : clause) {
+            bool found = false;
+            if (term.prefix) {
+                for (auto& candidate : terms) {
+                    if (candidate.compare(0, term.text.size(), term.text) == 0) {
+                        found = true;
+                        break;
+                    }
+                }
+            } else {
+                found = present.count(term.text) > 0;
+            }
+            if (!found) {
+                all = false;
+                break;
+            }
+        }
+        if (all) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace duckdb
@@ -0,0 +1,241 @@
+#include "../include/RucksDBTiered.hpp"
+#include "../include/RucksDBTrace.hpp"
+#include "duckdb/common/serializer/binary_deserializer.hpp"
+#include "duckdb/common/serializer/binary_serializer.hpp"
+#include "duckdb/common/serializer/memory_stream.hpp"
+#include "duckdb/common/string_util.hpp"
+#include <algorithm>
+#include <cstdio>
+
+namespace duckdb {
+
+static constexpr char TIER_LOG_PREFIX[] = "tier_hot_";
+static constexpr char TIER_KEY_PREFIX[] = "tier_key_";
+
+// Keys are matched in text form (see KeyOf), so a key type must read back from a sealed row with
+// the text it was inserted with. FLOAT is left out: rows written by the old codec store it rounded
+// to six decimals.
+static bool IsTierKeyType(const LogicalType& type) {
+    switch (type.id()) {
+    case LogicalTypeId::BOOLEAN:
+    case LogicalTypeId::TINYINT:
+    case LogicalTypeId::SMALLINT:
+    case LogicalTypeId::INTEGER:
+    case LogicalTypeId::BIGINT:
+    case LogicalTypeId::UTINYINT:
+    case LogicalTypeId::USMALLINT:
+    case LogicalTypeId::UINTEGER:
+    case LogicalTypeId::UBIGINT:
+    case LogicalTypeId::DOUBLE:
+    case LogicalTypeId::DATE:
+    case LogicalTypeId::TIMESTAMP:
+    case LogicalTypeId::VARCHAR:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void RucksDBTierDefinition::Bind(const vector<ColumnDefinition>& columns) {
+    if (row_group_size == 0) {
+        throw std::runtime_error("Tier row group size must be positive");
+    }
+    for (idx_t i = 0; i < columns.size(); i++) {
+        if (StringUtil::CIEquals(columns[i].Name(), key_column)) {
+            if (!IsTierKeyType(columns[i].Type())) {
+                throw std::runtime_error("Column '" + key_column + "' of type " + columns[i].Type().ToString() +
+                                         " cannot be a tier key");
+            }
+            key_index = i;
+            return;
+        }
+    }
+    throw std::runtime_error("Column '" + key_column + "' does not exist");
+}
+
+string RucksDBTierDefinition::Serialize() const {
+    // Column last, so it may contain the separator
+    return std::to_string(row_group_size) + "|" + key_column;
+}
+
+RucksDBTierDefinition RucksDBTierDefinition::Deserialize(const string& data) {
+    auto separator = data.find('|');
+    if (separator == string::npos) {
+        throw std::runtime_error("Corrupt RucksDB tier definition");
+    }
+    RucksDBTierDefinition tier;
+    tier.row_group_size = std::stoull(data.substr(0, separator));
+    tier.key_column = data.substr(separator + 1);
+    return tier;
+}
+
+string RucksDBTierDefinition::KeyOf(const Value& value) {
+    return value.ToString();
+}
+
+bool RucksDBHotSnapshot::Shadows(const vector<Value>& row) const {
+    if (keys.empty() || key_index >= row.size() || row[key_index].IsNull()) {
+        return false;
+    }
+    return keys.count(RucksDBTierDefinition::KeyOf(row[key_index])) > 0;
+}
+
+idx_t RucksDBHotSnapshot::Emit(idx_t chunk_idx, DataChunk& result, const vector<column_t>& column_ids) const {
+    auto& chunk = *chunks[chunk_idx];
+    auto& chunk_visible = visible[chunk_idx];
+    idx_t emitted = 0;
+    for (idx_t row = 0; row < chunk.size(); row++) {
+        if (!chunk_visible[row]) {
+            continue;
+        }
+        for (idx_t col = 0; col < column_ids.size(); col++) {
+            column_t col_id = column_ids[col];
+            if (col_id == COLUMN_IDENTIFIER_ROW_ID) {
+                result.data[col].SetValue(emitted, Value(LogicalType::BIGINT));
+            } else if (col_id < chunk.ColumnCount()) {
+                result.data[col].SetValue(emitted, chunk.GetValue(col_id, row));
+            }
+        }
+        emitted++;
+    }
+    result.SetCardinality(emitted);
+    return emitted;
+}
+
+RucksDBHotTier::RucksDBHotTier(RocksDBStorage* storage, const string& table_name, RucksDBTierDefinition definition)
+    : storage_(storage), table_name_(table_name), definition_(std::move(definition)) {
+}
+
+string RucksDBHotTier::GetLogPrefix(const string& table_name) {
+    return string(TIER_LOG_PREFIX) + table_name + ":";
+}
+
+string RucksDBHotTier::GetKeyPrefix(const string& table_name) {
+    return string(TIER_KEY_PREFIX) + table_name + ":";
+}
+
+string RucksDBHotTier::GetKeyIndexKey(const string& table_name, const string& key) {
+    return GetKeyPrefix(table_name) + key;
+}
+
+string RucksDBHotTier::GetLogKey(uint64_t sequence) const {
+    // Zero-padded, so the log iterates in append order
+    char buffer[21];
+    snprintf(buffer, sizeof(buffer), "%020llu", (unsigned long long)sequence);
+    return GetLogPrefix(table_name_) + buffer;
+}
+
+void RucksDBHotTier::Load() {
+    RucksDBTraceScope trace("ReplayHotTier", "tier");
+    auto prefix = GetLogPrefix(table_name_);
+    std::lock_guard<std::mutex> guard(lock_);
+    chunks_.clear();
+    rows_ = 0;
+    storage_->IteratePrefix(prefix, [&](const string& key, const string& value) {
+        MemoryStream stream((data_ptr_t)value.data(), value.size());
+        BinaryDeserializer deserializer(stream);
+        auto chunk = std::make_shared<DataChunk>();
+        deserializer.Begin();
+        chunk->Deserialize(deserializer);
+        deserializer.End();
+
+        uint64_t sequence = std::stoull(key.substr(prefix.size()));
+        rows_ += chunk->size();
+        chunks_.push_back(HotChunk {std::move(chunk), sequence});
+        next_sequence_ = sequence + 1;
+        return true;
+    });
+    snapshot_.reset();
+    trace.arg = rows_;
+}
+
+void RucksDBHotTier::Append(DataChunk& chunk) {
+    for (idx_t i = 0; i < chunk.size(); i++) {
+        if (chunk.GetValue(definition_.key_index, i).IsNull()) {
+            throw std::runtime_error("Key column '" + definition_.key_column + "' of tiered table '" +
+                                     table_name_ + "' must not be NULL");
+        }
+    }
+
+    auto copy = std::make_shared<DataChunk>();
+    copy->Initialize(Allocator::DefaultAllocator(), chunk.GetTypes(), std::max<idx_t>(chunk.size(), 1));
+    chunk.Copy(*copy);
+
+    MemoryStream stream;
+    BinarySerializer serializer(stream);
+    serializer.Begin();
+    copy->Serialize(serializer);
+    serializer.End();
+
+    std::lock_guard<std::mutex> guard(lock_);
+    uint64_t sequence = next_sequence_++;
+    // One record per chunk instead of one per row; this is the only write an insert waits for
+    storage_->WriteData(GetLogKey(sequence), string((const char*)stream.GetData(), stream.GetPosition()));
+    rows_ += copy->size();
+    chunks_.push_back(HotChunk {std::move(copy), sequence});
+    snapshot_.reset();
+}
+
+std::shared_ptr<const RucksDBHotSnapshot> RucksDBHotTier::Snapshot() {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (snapshot_) {
+        return snapshot_;
+    }
+
+    // Newest rows first: the first row seen of each key is the one scans return
+    auto snapshot = std::make_shared<RucksDBHotSnapshot>();
+    snapshot->key_index = definition_.key_index;
+    snapshot->chunks.reserve(chunks_.size());
+    snapshot->visible.resize(chunks_.size());
+    for (auto& chunk : chunks_) {
+        snapshot->chunks.push_back(chunk.data);
+    }
+    for (idx_t c = chunks_.size(); c-- > 0;) {
+        auto& chunk = *snapshot->chunks[c];
+        auto& chunk_visible = snapshot->visible[c];
+        chunk_visible.resize(chunk.size());
+        for (idx_t row = chunk.size(); row-- > 0;) {
+            chunk_visible[row] =
+                snapshot->keys.insert(RucksDBTierDefinition::KeyOf(chunk.GetValue(definition_.key_index, row))).second;
+            snapshot->visible_rows += chunk_visible[row];
+        }
+    }
+    snapshot_ = snapshot;
+    return snapshot_;
+}
+
+bool RucksDBHotTier::PeekRowGroup(bool force, vector<std::shared_ptr<const DataChunk>>& chunks,
+                                  vector<string>& log_keys) {
+    chunks.clear();
+    log_keys.clear();
+    std::lock_guard<std::mutex> guard(lock_);
+    if (rows_ == 0 || (!force && rows_ < definition_.row_group_size)) {
+        return false;
+    }
+    idx_t rows = 0;
+    for (auto& chunk : chunks_) {
+        if (!force && rows >= definition_.row_group_size) {
+            break;
+        }
+        chunks.push_back(chunk.data);
+        log_keys.push_back(GetLogKey(chunk.sequence));
+        rows += chunk.data->size();
+    }
+    return true;
+}
+
+void RucksDBHotTier::PopChunks(idx_t count) {
+    std::lock_guard<std::mutex> guard(lock_);
+    for (idx_t i = 0; i < count && !chunks_.empty(); i++) {
+        rows_ -= chunks_.front().data->size();
+        chunks_.pop_front();
+    }
+    snapshot_.reset();
+}
+
+idx_t RucksDBHotTier::GetRowCount() {
+    std::lock_guard<std::mutex> guard(lock_);
+    return rows_;
+}
+
+} // namespace duckdb
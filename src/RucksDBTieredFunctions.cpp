@@ -0,0 +1,91 @@
+#include "../include/RucksDBTieredFunctions.hpp"
+#include "../include/RucksDBStatsFunctions.hpp"
+#include "../include/RucksDBExtension.hpp"
+#include "../include/RucksDBInstance.hpp"
+#include "duckdb/main/extension_util.hpp"
+
+namespace duckdb {
+
+struct RucksDBTierBindData : public TableFunctionData {
+    string table_name;
+    RucksDBTierDefinition tier;
+    RucksDBInstance instance;
+};
+
+// rucksdb_set_tiering('table', 'key_column')
+static unique_ptr<FunctionData> SetTieringBind(ClientContext& context, TableFunctionBindInput& input,
+                                               vector<LogicalType>& return_types, vector<string>& names) {
+    names = {"table", "rows"};
+    return_types = {LogicalType::VARCHAR, LogicalType::UBIGINT};
+
+    auto bind_data = make_unique<RucksDBTierBindData>();
+    bind_data->table_name = input.inputs[0].GetValue<string>();
+    bind_data->tier.key_column = input.inputs[1].GetValue<string>();
+    auto row_group_size = input.named_parameters.find("row_group_size");
+    if (row_group_size != input.named_parameters.end() && !row_group_size->second.IsNull()) {
+        bind_data->tier.row_group_size = row_group_size->second.GetValue<idx_t>();
+    }
+    bind_data->instance = RucksDBInstanceRegistry::Get(input);
+    return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> SetTieringInit(ClientContext& context, TableFunctionInitInput& input) {
+    auto& bind_data = (RucksDBTierBindData&)*input.bind_data;
+    auto& registry = *bind_data.instance.registry;
+
+    // Rows keyed when tiering, rows sealed when clearing it
+    idx_t rows;
+    if (bind_data.tier.key_column.empty()) {
+        rows = registry.ClearTableTier(bind_data.table_name);
+    } else {
+        rows = registry.SetTableTier(bind_data.table_name, bind_data.tier);
+    }
+
+    auto state = make_unique<RucksDBStatsState>();
+    state->rows.push_back({Value(bind_data.table_name), Value::UBIGINT(rows)});
+    return std::move(state);
+}
+
+// rucksdb_seal('table')
+static unique_ptr<FunctionData> SealBind(ClientContext& context, TableFunctionBindInput& input,
+                                         vector<LogicalType>& return_types, vector<string>& names) {
+    names = {"table", "rows"};
+    return_types = {LogicalType::VARCHAR, LogicalType::UBIGINT};
+
+    auto bind_data = make_unique<RucksDBTierBindData>();
+    bind_data->table_name = input.inputs[0].GetValue<string>();
+    bind_data->instance = RucksDBInstanceRegistry::Get(input);
+    return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> SealInit(ClientContext& context, TableFunctionInitInput& input) {
+    auto& bind_data = (RucksDBTierBindData&)*input.bind_data;
+
+    idx_t rows = bind_data.instance.registry->SealTable(bind_data.table_name);
+
+    auto state = make_unique<RucksDBStatsState>();
+    state->rows.push_back({Value(bind_data.table_name), Value::UBIGINT(rows)});
+    return std::move(state);
+}
+
+TableFunction RucksDBTieredFunctions::GetSetTieringFunction() {
+    TableFunction function("rucksdb_set_tiering", {LogicalType::VARCHAR, LogicalType::VARCHAR},
+                           RucksDBStatsFunctions::ExecuteRows, SetTieringBind, SetTieringInit);
+    function.named_parameters["row_group_size"] = LogicalType::UBIGINT;
+    function.named_parameters["database"] = LogicalType::VARCHAR;
+    return function;
+}
+
+TableFunction RucksDBTieredFunctions::GetSealFunction() {
+    TableFunction function("rucksdb_seal", {LogicalType::VARCHAR}, RucksDBStatsFunctions::ExecuteRows,
+                           SealBind, SealInit);
+    function.named_parameters["database"] = LogicalType::VARCHAR;
+    return function;
+}
+
+void RucksDBTieredFunctions::RegisterFunctions(DatabaseInstance& db) {
+    ExtensionUtil::RegisterFunction(db, GetSetTieringFunction());
+    ExtensionUtil::RegisterFunction(db, GetSealFunction());
+}
+
+} // namespace duckdb
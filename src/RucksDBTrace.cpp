@@ -0,0 +1,174 @@
+// src/RucksDBTrace.cpp
+
+#include "../include/RucksDBTrace.hpp"
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace duckdb {
+
+std::atomic<bool> RucksDBTracer::enabled_{false};
+
+struct RucksDBTraceEvent {
+    const char *name;
+    const char *category;
+    std::chrono::steady_clock::time_point start;
+    uint64_t duration_ns;
+    uint64_t arg;
+};
+
+struct RucksDBTraceBuffer {
+    // Only contended while a dump or clear runs
+    std::mutex lock;
+    std::vector<RucksDBTraceEvent> events;
+    size_t next = 0;
+    bool wrapped = false;
+    uint32_t tid = 0;
+};
+
+// Buffers outlive their threads so a dump still shows work done by finished threads
+static std::mutex g_trace_lock;
+static std::vector<std::shared_ptr<RucksDBTraceBuffer>> g_trace_buffers;
+static size_t g_trace_capacity = 65536;
+static const auto g_trace_epoch = std::chrono::steady_clock::now();
+
+static RucksDBTraceBuffer &GetThreadBuffer() {
+    static thread_local std::shared_ptr<RucksDBTraceBuffer> buffer;
+    if (!buffer) {
+        buffer = std::make_shared<RucksDBTraceBuffer>();
+        std::lock_guard<std::mutex> guard(g_trace_lock);
+        buffer->events.resize(g_trace_capacity);
+        buffer->tid = (uint32_t)g_trace_buffers.size() + 1;
+        g_trace_buffers.push_back(buffer);
+    }
+    return *buffer;
+}
+
+void RucksDBTracer::Enable(size_t events_per_thread) {
+    {
+        std::lock_guard<std::mutex> guard(g_trace_lock);
+        g_trace_capacity = events_per_thread == 0 ? 1 : events_per_thread;
+        for (auto &buffer : g_trace_buffers) {
+            std::lock_guard<std::mutex> buffer_guard(buffer->lock);
+            buffer->events.assign(g_trace_capacity, RucksDBTraceEvent());
+            buffer->next = 0;
+            buffer->wrapped = false;
+        }
+    }
+    enabled_.store(true, std::memory_order_relaxed);
+}
+
+void RucksDBTracer::Disable() {
+    enabled_.store(false, std::memory_order_relaxed);
+}
+
+void RucksDBTracer::Clear() {
+    std::lock_guard<std::mutex> guard(g_trace_lock);
+    for (auto &buffer : g_trace_buffers) {
+        std::lock_guard<std::mutex> buffer_guard(buffer->lock);
+        buffer->next = 0;
+        buffer->wrapped = false;
+    }
+}
+
+void RucksDBTracer::Record(const char *name, const char *category, std::chrono::steady_clock::time_point start,
+                           std::chrono::steady_clock::time_point end, uint64_t arg) {
+    auto &buffer = GetThreadBuffer();
+    std::lock_guard<std::mutex> guard(buffer.lock);
+
+    auto &event = buffer.events[buffer.next];
+    event.name = name;
+    event.category = category;
+    event.start = start;
+    event.duration_ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    event.arg = arg;
+
+    if (++buffer.next == buffer.events.size()) {
+        buffer.next = 0;
+        buffer.wrapped = true;
+    }
+}
+
+static void WriteJSONString(std::ofstream &out, const char *value) {
+    out << '"';
+    for (const char *c = value; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            out << '\\';
+        }
+        out << *c;
+    }
+    out << '"';
+}
+
+size_t RucksDBTracer::DumpChromeTrace(const string &path) {
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("Cannot open trace file '" + path + "'");
+    }
+
+    std::vector<std::shared_ptr<RucksDBTraceBuffer>> buffers;
+    {
+        std::lock_guard<std::mutex> guard(g_trace_lock);
+        buffers = g_trace_buffers;
+    }
+
+    size_t written = 0;
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    for (auto &buffer : buffers) {
+        std::lock_guard<std::mutex> guard(buffer->lock);
+        size_t count = buffer->wrapped ? buffer->events.size() : buffer->next;
+        size_t first = buffer->wrapped ? buffer->next : 0;
+
+        for (size_t i = 0; i < count; i++) {
+            auto &event = buffer->events[(first + i) % buffer->events.size()];
+            auto start_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(event.start - g_trace_epoch).count();
+
+            out << (written > 0 ? ",\n" : "\n") << "{\"name\":";
+            WriteJSONString(out, event.name);
+            out << ",\"cat\":";
+            WriteJSONString(out, event.category);
+            // Chrome trace timestamps are in (fractional) microseconds
+            out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->tid << ",\"ts\":" << start_ns / 1000.0
+                << ",\"dur\":" << event.duration_ns / 1000.0 << ",\"args\":{\"arg\":" << event.arg << "}}";
+            written++;
+        }
+    }
+    out << "\n]}" << std::endl;
+    return written;
+}
+
+// Flushes and compactions begin and complete on the same background thread
+static thread_local std::chrono::steady_clock::time_point t_flush_start;
+static thread_local std::chrono::steady_clock::time_point t_compaction_start;
+
+void RucksDBTraceListener::OnFlushBegin(rocksdb::DB *, const rocksdb::FlushJobInfo &) {
+    if (RucksDBTracer::IsEnabled()) {
+        t_flush_start = std::chrono::steady_clock::now();
+    }
+}
+
+void RucksDBTraceListener::OnFlushCompleted(rocksdb::DB *, const rocksdb::FlushJobInfo &info) {
+    if (RucksDBTracer::IsEnabled() && t_flush_start.time_since_epoch().count() != 0) {
+        RucksDBTracer::Record("Flush", "rocksdb", t_flush_start, std::chrono::steady_clock::now(),
+                              info.table_properties.data_size);
+        t_flush_start = std::chrono::steady_clock::time_point();
+    }
+}
+
+void RucksDBTraceListener::OnCompactionBegin(rocksdb::DB *, const rocksdb::CompactionJobInfo &) {
+    if (RucksDBTracer::IsEnabled()) {
+        t_compaction_start = std::chrono::steady_clock::now();
+    }
+}
+
+void RucksDBTraceListener::OnCompactionCompleted(rocksdb::DB *, const rocksdb::CompactionJobInfo &info) {
+    if (RucksDBTracer::IsEnabled() && t_compaction_start.time_since_epoch().count() != 0) {
+        RucksDBTracer::Record("Compaction", "rocksdb", t_compaction_start, std::chrono::steady_clock::now(),
+                              info.stats.total_output_bytes);
+        t_compaction_start = std::chrono::steady_clock::time_point();
+    }
+}
+
+} // namespace duckdb
@@ -0,0 +1,255 @@
+#include "../include/RucksDBVectorFunctions.hpp"
+#include "../include/RucksDBStatsFunctions.hpp"
+#include "../include/RucksDBExtension.hpp"
+#include "../include/RucksDBInstance.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/main/extension_util.hpp"
+#include <queue>
+
+namespace duckdb {
+
+struct RucksDBVectorIndexBindData : public TableFunctionData {
+    RucksDBVectorIndexDefinition index;
+    RucksDBInstance instance;
+};
+
+static int64_t GetNamedInteger(TableFunctionBindInput& input, const string& name, int64_t default_value) {
+    auto it = input.named_parameters.find(name);
+    if (it == input.named_parameters.end() || it->second.IsNull()) {
+        return default_value;
+    }
+    return it->second.GetValue<int64_t>();
+}
+
+static string GetNamedString(TableFunctionBindInput& input, const string& name) {
+    auto it = input.named_parameters.find(name);
+    if (it == input.named_parameters.end() || it->second.IsNull()) {
+        return string();
+    }
+    return it->second.GetValue<string>();
+}
+
+// rucksdb_create_vector_index('name', 'table', 'column')
+static unique_ptr<FunctionData> CreateIndexBind(ClientContext& context, TableFunctionBindInput& input,
+                                                vector<LogicalType>& return_types, vector<string>& names) {
+    names = {"index", "rows"};
+    return_types = {LogicalType::VARCHAR, LogicalType::UBIGINT};
+
+    auto bind_data = make_unique<RucksDBVectorIndexBindData>();
+    auto& index = bind_data->index;
+    index.name = input.inputs[0].GetValue<string>();
+    index.table_name = input.inputs[1].GetValue<string>();
+    index.column = input.inputs[2].GetValue<string>();
+    auto metric = GetNamedString(input, "metric");
+    if (!metric.empty()) {
+        index.metric = RucksDBVectorIndexDefinition::ParseMetric(metric);
+    }
+    index.m = (idx_t)GetNamedInteger(input, "m", (int64_t)index.m);
+    index.ef_construction = (idx_t)GetNamedInteger(input, "ef_construction", (int64_t)index.ef_construction);
+    bind_data->instance = RucksDBInstanceRegistry::Get(input);
+    return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> CreateIndexInit(ClientContext& context, TableFunctionInitInput& input) {
+    auto& bind_data = (RucksDBVectorIndexBindData&)*input.bind_data;
+    idx_t rows = bind_data.instance.registry->CreateVectorIndex(bind_data.index);
+
+    auto state = make_unique<RucksDBStatsState>();
+    state->rows.push_back({Value(bind_data.index.name), Value::UBIGINT(rows)});
+    return std::move(state);
+}
+
+// rucksdb_drop_vector_index('name')
+static unique_ptr<FunctionData> DropIndexBind(ClientContext& context, TableFunctionBindInput& input,
+                                              vector<LogicalType>& return_types, vector<string>& names) {
+    names = {"index"};
+    return_types = {LogicalType::VARCHAR};
+
+    auto bind_data = make_unique<RucksDBVectorIndexBindData>();
+    bind_data->index.name = input.inputs[0].GetValue<string>();
+    bind_data->instance = RucksDBInstanceRegistry::Get(input);
+    return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> DropIndexInit(ClientContext& context, TableFunctionInitInput& input) {
+    auto& bind_data = (RucksDBVectorIndexBindData&)*input.bind_data;
+    bind_data.instance.registry->DropVectorIndex(bind_data.index.name);
+
+    auto state = make_unique<RucksDBStatsState>();
+    state->rows.push_back({Value(bind_data.index.name)});
+    return std::move(state);
+}
+
+struct RucksDBKnnBindData : public TableFunctionData {
+    RucksDBTableStorage* table_storage;
+    idx_t column_index;
+    vector<float> query;
+    idx_t k;
+    idx_t ef;
+    RucksDBVectorMetric metric = RucksDBVectorMetric::L2;
+    // Null when the column has no index and is searched exhaustively
+    std::shared_ptr<RucksDBVectorIndex> index;
+};
+
+struct RucksDBKnnState : public GlobalTableFunctionState {
+    vector<vector<Value>> rows;
+    vector<float> distances;
+    idx_t offset = 0;
+};
+
+// rocksdb_knn('table', 'column', query, k)
+static unique_ptr<FunctionData> KnnBind(ClientContext& context, TableFunctionBindInput& input,
+                                        vector<LogicalType>& return_types, vector<string>& names) {
+    auto table_name = input.inputs[0].GetValue<string>();
+    auto column = input.inputs[1].GetValue<string>();
+    auto instance = RucksDBInstanceRegistry::Get(input);
+    auto* table_storage = instance.registry->GetTable(table_name);
+    if (!table_storage) {
+        throw std::runtime_error("RocksDB table '" + table_name + "' does not exist");
+    }
+
+    auto bind_data = make_unique<RucksDBKnnBindData>();
+    bind_data->table_storage = table_storage;
+    auto& columns = table_storage->GetColumns();
+    bind_data->column_index = columns.size();
+    for (idx_t i = 0; i < columns.size(); i++) {
+        names.push_back(columns[i].Name());
+        return_types.push_back(columns[i].Type());
+        if (StringUtil::CIEquals(columns[i].Name(), column)) {
+            bind_data->column_index = i;
+        }
+    }
+    if (bind_data->column_index == columns.size()) {
+        throw std::runtime_error("Column '" + column + "' does not exist in RocksDB table '" + table_name + "'");
+    }
+    names.push_back("distance");
+    return_types.push_back(LogicalType::FLOAT);
+
+    if (!RucksDBVectorIndexDefinition::ExtractVector(input.inputs[2], bind_data->query)) {
+        throw std::runtime_error("rocksdb_knn query vector must not be NULL");
+    }
+    auto k = input.inputs[3].GetValue<int64_t>();
+    if (k <= 0) {
+        throw std::runtime_error("rocksdb_knn k must be positive");
+    }
+    bind_data->k = (idx_t)k;
+    bind_data->ef = (idx_t)std::max<int64_t>(GetNamedInteger(input, "ef", 64), k);
+    bind_data->index = table_storage->GetVectorIndex(column);
+    if (bind_data->index) {
+        bind_data->metric = bind_data->index->GetDefinition().metric;
+    }
+    auto metric = GetNamedString(input, "metric");
+    if (!metric.empty()) {
+        auto requested = RucksDBVectorIndexDefinition::ParseMetric(metric);
+        if (bind_data->index && requested != bind_data->metric) {
+            throw std::runtime_error("Vector index on '" + column + "' uses metric '" +
+                                  RucksDBVectorIndexDefinition::MetricName(bind_data->metric) + "'");
+        }
+        bind_data->metric = requested;
+    }
+    return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> KnnInit(ClientContext& context, TableFunctionInitInput& input) {
+    auto& bind_data = (RucksDBKnnBindData&)*input.bind_data;
+    auto& table = *bind_data.table_storage;
+
+    auto state = make_unique<RucksDBKnnState>();
+    vector<Value> values;
+    if (bind_data.index) {
+        // Candidates whose rows were deleted or expired are skipped, the ef - k spare ones cover them
+        for (auto& match : bind_data.index->Search(bind_data.query, bind_data.k, bind_data.ef)) {
+            if (state->rows.size() >= bind_data.k) {
+                break;
+            }
+            if (table.FetchRow(match.row_id, values)) {
+                state->rows.push_back(values);
+                state->distances.push_back(match.distance);
+            }
+        }
+        return std::move(state);
+    }
+
+    // Exhaustive search, keeping the k closest rows in a max-heap
+    std::priority_queue<std::pair<float, idx_t>> nearest;
+    vector<float> row_vector;
+    for (idx_t row_id = 0; row_id < table.GetRowCount(); row_id++) {
+        if (!table.FetchRow(row_id, values) || bind_data.column_index >= values.size() ||
+            !RucksDBVectorIndexDefinition::ExtractVector(values[bind_data.column_index], row_vector) ||
+            row_vector.size() != bind_data.query.size()) {
+            continue;
+        }
+        float distance = RucksDBVectorIndex::ComputeDistance(bind_data.metric, bind_data.query, row_vector);
+        if (nearest.size() < bind_data.k) {
+            nearest.emplace(distance, row_id);
+        } else if (distance < nearest.top().first) {
+            nearest.pop();
+            nearest.emplace(distance, row_id);
+        }
+    }
+    vector<std::pair<float, idx_t>> sorted;
+    while (!nearest.empty()) {
+        sorted.push_back(nearest.top());
+        nearest.pop();
+    }
+    for (auto it = sorted.rbegin(); it != sorted.rend(); it++) {
+        if (table.FetchRow(it->second, values)) {
+            state->rows.push_back(values);
+            state->distances.push_back(it->first);
+        }
+    }
+    return std::move(state);
+}
+
+static void KnnExecute(ClientContext& context, TableFunctionInput& data, DataChunk& output) {
+    auto& state = (RucksDBKnnState&)*data.global_state;
+
+    idx_t count = 0;
+    idx_t distance_column = output.ColumnCount() - 1;
+    while (state.offset < state.rows.size() && count < STANDARD_VECTOR_SIZE) {
+        auto& row = state.rows[state.offset];
+        for (idx_t col_idx = 0; col_idx < distance_column && col_idx < row.size(); col_idx++) {
+            output.SetValue(col_idx, count, row[col_idx]);
+        }
+        output.SetValue(distance_column, count, Value::FLOAT(state.distances[state.offset]));
+        state.offset++;
+        count++;
+    }
+    output.SetCardinality(count);
+}
+
+TableFunction RucksDBVectorFunctions::GetCreateVectorIndexFunction() {
+    TableFunction function("rucksdb_create_vector_index",
+                           {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR},
+                           RucksDBStatsFunctions::ExecuteRows, CreateIndexBind, CreateIndexInit);
+    function.named_parameters["metric"] = LogicalType::VARCHAR;
+    function.named_parameters["m"] = LogicalType::BIGINT;
+    function.named_parameters["ef_construction"] = LogicalType::BIGINT;
+    function.named_parameters["database"] = LogicalType::VARCHAR;
+    return function;
+}
+
+TableFunction RucksDBVectorFunctions::GetDropVectorIndexFunction() {
+    TableFunction function("rucksdb_drop_vector_index", {LogicalType::VARCHAR}, RucksDBStatsFunctions::ExecuteRows,
+                           DropIndexBind, DropIndexInit);
+    function.named_parameters["database"] = LogicalType::VARCHAR;
+    return function;
+}
+
+TableFunction RucksDBVectorFunctions::GetKnnFunction() {
+    TableFunction function("rocksdb_knn", {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::ANY,
+                                           LogicalType::BIGINT},
+                           KnnExecute, KnnBind, KnnInit);
+    function.named_parameters["ef"] = LogicalType::BIGINT;
+    function.named_parameters["metric"] = LogicalType::VARCHAR;
+    function.named_parameters["database"] = LogicalType::VARCHAR;
+    return function;
+}
+
+void RucksDBVectorFunctions::RegisterFunctions(DatabaseInstance& db) {
+    ExtensionUtil::RegisterFunction(db, GetCreateVectorIndexFunction());
+    ExtensionUtil::RegisterFunction(db, GetDropVectorIndexFunction());
+    ExtensionUtil::RegisterFunction(db, GetKnnFunction());
+}
+
+} // namespace duckdb
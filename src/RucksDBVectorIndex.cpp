@@ -0,0 +1,694 @@
+#include "../include/RucksDBVectorIndex.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/value.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <queue>
+#include <random>
+#include <unordered_set>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define RUCKSDB_AVX2_DISPATCH 1
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define RUCKSDB_NEON 1
+#endif
+
+namespace duckdb {
+
+static constexpr char VECTOR_META_PREFIX[] = "vindex_meta_";
+static constexpr char VECTOR_NODE_PREFIX[] = "vindex_node_";
+
+// Distance kernels
+static float L2SquaredScalar(const float* a, const float* b, idx_t dims) {
+    // Independent accumulators let the compiler keep several lanes in flight
+    float sum[4] = {0, 0, 0, 0};
+    idx_t i = 0;
+    for (; i + 4 <= dims; i += 4) {
+        for (idx_t j = 0; j < 4; j++) {
+            float d = a[i + j] - b[i + j];
+            sum[j] += d * d;
+        }
+    }
+    float result = sum[0] + sum[1] + sum[2] + sum[3];
+    for (; i < dims; i++) {
+        float d = a[i] - b[i];
+        result += d * d;
+    }
+    return result;
+}
+
+static float DotScalar(const float* a, const float* b, idx_t dims) {
+    float sum[4] = {0, 0, 0, 0};
+    idx_t i = 0;
+    for (; i + 4 <= dims; i += 4) {
+        for (idx_t j = 0; j < 4; j++) {
+            sum[j] += a[i + j] * b[i + j];
+        }
+    }
+    float result = sum[0] + sum[1] + sum[2] + sum[3];
+    for (; i < dims; i++) {
+        result += a[i] * b[i];
+    }
+    return result;
+}
+
+#ifdef RUCKSDB_AVX2_DISPATCH
+__attribute__((target("avx2,fma"))) static float HorizontalSum(__m256 v) {
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+    return _mm_cvtss_f32(sum);
+}
+
+__attribute__((target("avx2,fma"))) static float L2SquaredAVX2(const float* a, const float* b, idx_t dims) {
+    __m256 sum0 = _mm256_setzero_ps();
+    __m256 sum1 = _mm256_setzero_ps();
+    idx_t i = 0;
+    for (; i + 16 <= dims; i += 16) {
+        __m256 d0 = _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+        __m256 d1 = _mm256_sub_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8));
+        sum0 = _mm256_fmadd_ps(d0, d0, sum0);
+        sum1 = _mm256_fmadd_ps(d1, d1, sum1);
+    }
+    for (; i + 8 <= dims; i += 8) {
+        __m256 d = _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+        sum0 = _mm256_fmadd_ps(d, d, sum0);
+    }
+    float result = HorizontalSum(_mm256_add_ps(sum0, sum1));
+    for (; i < dims; i++) {
+        float d = a[i] - b[i];
+        result += d * d;
+    }
+    return result;
+}
+
+__attribute__((target("avx2,fma"))) static float DotAVX2(const float* a, const float* b, idx_t dims) {
+    __m256 sum0 = _mm256_setzero_ps();
+    __m256 sum1 = _mm256_setzero_ps();
+    idx_t i = 0;
+    for (; i + 16 <= dims; i += 16) {
+        sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), sum0);
+        sum1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), sum1);
+    }
+    for (; i + 8 <= dims; i += 8) {
+        sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), sum0);
+    }
+    float result = HorizontalSum(_mm256_add_ps(sum0, sum1));
+    for (; i < dims; i++) {
+        result += a[i] * b[i];
+    }
+    return result;
+}
+
+static bool HasAVX2() {
+    static const bool supported = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    return supported;
+}
+#endif
+
+#ifdef RUCKSDB_NEON
+static float L2SquaredNEON(const float* a, const float* b, idx_t dims) {
+    float32x4_t sum0 = vdupq_n_f32(0);
+    float32x4_t sum1 = vdupq_n_f32(0);
+    idx_t i = 0;
+    for (; i + 8 <= dims; i += 8) {
+        float32x4_t d0 = vsubq_f32(vld1q_f32(a + i), vld1q_f32(b + i));
+        float32x4_t d1 = vsubq_f32(vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+        sum0 = vfmaq_f32(sum0, d0, d0);
+        sum1 = vfmaq_f32(sum1, d1, d1);
+    }
+    float result = vaddvq_f32(vaddq_f32(sum0, sum1));
+    for (; i < dims; i++) {
+        float d = a[i] - b[i];
+        result += d * d;
+    }
+    return result;
+}
+
+static float DotNEON(const float* a, const float* b, idx_t dims) {
+    float32x4_t sum0 = vdupq_n_f32(0);
+    float32x4_t sum1 = vdupq_n_f32(0);
+    idx_t i = 0;
+    for (; i + 8 <= dims; i += 8) {
+        sum0 = vfmaq_f32(sum0, vld1q_f32(a + i), vld1q_f32(b + i));
+        sum1 = vfmaq_f32(sum1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+    }
+    float result = vaddvq_f32(vaddq_f32(sum0, sum1));
+    for (; i < dims; i++) {
+        result += a[i] * b[i];
+    }
+    return result;
+}
+#endif
+
+float RucksDBVectorDistance::L2Squared(const float* a, const float* b, idx_t dims) {
+#if defined(RUCKSDB_AVX2_DISPATCH)
+    if (HasAVX2()) {
+        return L2SquaredAVX2(a, b, dims);
+    }
+#elif defined(RUCKSDB_NEON)
+    return L2SquaredNEON(a, b, dims);
+#endif
+    return L2SquaredScalar(a, b, dims);
+}
+
+float RucksDBVectorDistance::Dot(const float* a, const float* b, idx_t dims) {
+#if defined(RUCKSDB_AVX2_DISPATCH)
+    if (HasAVX2()) {
+        return DotAVX2(a, b, dims);
+    }
+#elif defined(RUCKSDB_NEON)
+    return DotNEON(a, b, dims);
+#endif
+    return DotScalar(a, b, dims);
+}
+
+const char* RucksDBVectorDistance::KernelName() {
+#if defined(RUCKSDB_AVX2_DISPATCH)
+    if (HasAVX2()) {
+        return "avx2";
+    }
+#elif defined(RUCKSDB_NEON)
+    return "neon";
+#endif
+    return "scalar";
+}
+
+// Definition implementation
+RucksDBVectorMetric RucksDBVectorIndexDefinition::ParseMetric(const string& metric) {
+    auto name = StringUtil::Lower(metric);
+    if (name == "l2" || name == "euclidean") {
+        return RucksDBVectorMetric::L2;
+    }
+    if (name == "cosine") {
+        return RucksDBVectorMetric::COSINE;
+    }
+    if (name == "ip" || name == "inner_product") {
+        return RucksDBVectorMetric::INNER_PRODUCT;
+    }
+    throw std::runtime_error("Unknown vector metric '" + metric + "', expected l2, cosine or ip");
+}
+
+string RucksDBVectorIndexDefinition::MetricName(RucksDBVectorMetric metric) {
+    switch (metric) {
+    case RucksDBVectorMetric::COSINE:
+        return "cosine";
+    case RucksDBVectorMetric::INNER_PRODUCT:
+        return "ip";
+    default:
+        return "l2";
+    }
+}
+
+void RucksDBVectorIndexDefinition::Bind(const vector<ColumnDefinition>& columns) {
+    if (m < 2 || ef_construction < m) {
+        throw std::runtime_error("Vector index needs m >= 2 and ef_construction >= m");
+    }
+    for (idx_t i = 0; i < columns.size(); i++) {
+        if (!StringUtil::CIEquals(columns[i].Name(), column)) {
+            continue;
+        }
+        auto& column_type = columns[i].Type();
+        if (column_type.id() == LogicalTypeId::ARRAY) {
+            auto array_dims = ArrayType::GetSize(column_type);
+            if (dims != 0 && dims != array_dims) {
+                throw std::runtime_error("Vector index dimensions do not match column '" + column + "'");
+            }
+            dims = array_dims;
+            if (!ArrayType::GetChildType(column_type).IsNumeric()) {
+                throw std::runtime_error("Vector column '" + column + "' must hold numbers");
+            }
+        } else if (column_type.id() == LogicalTypeId::LIST) {
+            if (!ListType::GetChildType(column_type).IsNumeric()) {
+                throw std::runtime_error("Vector column '" + column + "' must hold numbers");
+            }
+        } else {
+            throw std::runtime_error("Vector column '" + column + "' must be a FLOAT[N] array or list");
+        }
+        column_index = i;
+        type = column_type;
+        return;
+    }
+    throw std::runtime_error("Column '" + column + "' does not exist");
+}
+
+string RucksDBVectorIndexDefinition::Serialize() const {
+    // Column last, so it may contain the separator
+    return name + "|" + table_name + "|" + MetricName(metric) + "|" + std::to_string(m) + "|" +
+           std::to_string(ef_construction) + "|" + std::to_string(dims) + "|" + column;
+}
+
+RucksDBVectorIndexDefinition RucksDBVectorIndexDefinition::Deserialize(const string& data) {
+    vector<string> parts;
+    idx_t start = 0;
+    while (parts.size() < 6) {
+        auto end = data.find('|', start);
+        if (end == string::npos) {
+            throw std::runtime_error("Corrupt RucksDB vector index definition");
+        }
+        parts.push_back(data.substr(start, end - start));
+        start = end + 1;
+    }
+    RucksDBVectorIndexDefinition definition;
+    definition.name = parts[0];
+    definition.table_name = parts[1];
+    definition.metric = ParseMetric(parts[2]);
+    definition.m = std::stoull(parts[3]);
+    definition.ef_construction = std::stoull(parts[4]);
+    definition.dims = std::stoull(parts[5]);
+    definition.column = data.substr(start);
+    return definition;
+}
+
+bool RucksDBVectorIndexDefinition::ExtractVector(const Value& value, vector<float>& result) {
+    result.clear();
+    if (value.IsNull()) {
+        return false;
+    }
+    // Rows decoded from storage hold the vector in its text form
+    auto list = value.type().id() == LogicalTypeId::ARRAY || value.type().id() == LogicalTypeId::LIST
+                    ? value
+                    : value.DefaultCastAs(LogicalType::LIST(LogicalType::FLOAT));
+    auto& children = list.type().id() == LogicalTypeId::ARRAY ? ArrayValue::GetChildren(list)
+                                                              : ListValue::GetChildren(list);
+    result.reserve(children.size());
+    for (auto& child : children) {
+        if (child.IsNull()) {
+            throw std::runtime_error("Vectors must not contain NULL elements");
+        }
+        result.push_back(child.GetValue<float>());
+    }
+    return true;
+}
+
+// Node record: level (u32), dims (u32), floats, then per level a link count (u32) and row ids (u64)
+static string EncodeNode(const RucksDBVectorIndex::Node& node) {
+    string data;
+    auto append = [&data](const void* bytes, idx_t size) { data.append((const char*)bytes, size); };
+    uint32_t level = (uint32_t)node.neighbors.size() - 1;
+    uint32_t dims = (uint32_t)node.values.size();
+    append(&level, sizeof(level));
+    append(&dims, sizeof(dims));
+    append(node.values.data(), dims * sizeof(float));
+    for (auto& links : node.neighbors) {
+        uint32_t count = (uint32_t)links.size();
+        append(&count, sizeof(count));
+        for (auto link : links) {
+            uint64_t id = link;
+            append(&id, sizeof(id));
+        }
+    }
+    return data;
+}
+
+static std::shared_ptr<const RucksDBVectorIndex::Node> DecodeNode(const string& data) {
+    idx_t offset = 0;
+    auto read = [&data, &offset](void* bytes, idx_t size) {
+        if (offset + size > data.size()) {
+            throw std::runtime_error("Corrupt RucksDB vector index node");
+        }
+        memcpy(bytes, data.data() + offset, size);
+        offset += size;
+    };
+    auto node = std::make_shared<RucksDBVectorIndex::Node>();
+    uint32_t level, dims;
+    read(&level, sizeof(level));
+    read(&dims, sizeof(dims));
+    node->values.resize(dims);
+    read(node->values.data(), dims * sizeof(float));
+    node->neighbors.resize(level + 1);
+    for (auto& links : node->neighbors) {
+        uint32_t count;
+        read(&count, sizeof(count));
+        links.resize(count);
+        for (auto& link : links) {
+            uint64_t id;
+            read(&id, sizeof(id));
+            link = id;
+        }
+    }
+    return node;
+}
+
+// HNSW implementation
+RucksDBVectorIndex::RucksDBVectorIndex(RocksDBStorage* storage, RucksDBVectorIndexDefinition definition)
+    : storage_(storage), definition_(std::move(definition)) {
+}
+
+string RucksDBVectorIndex::GetMetaKey(const string& index_name) {
+    return string(VECTOR_META_PREFIX) + index_name;
+}
+
+string RucksDBVectorIndex::GetNodePrefix(const string& index_name) {
+    return string(VECTOR_NODE_PREFIX) + index_name + ":";
+}
+
+string RucksDBVectorIndex::GetNodeKey(const string& index_name, idx_t row_id) {
+    return GetNodePrefix(index_name) + std::to_string(row_id);
+}
+
+void RucksDBVectorIndex::EnsureLoaded() {
+    std::lock_guard<std::mutex> guard(cache_lock_);
+    if (loaded_) {
+        return;
+    }
+    // "entry|max_level|count"; only the entry point is needed to start searching
+    string meta;
+    if (storage_->ReadData(GetMetaKey(definition_.name), meta)) {
+        auto first = meta.find('|');
+        auto second = meta.find('|', first + 1);
+        if (first == string::npos || second == string::npos) {
+            throw std::runtime_error("Corrupt RucksDB vector index '" + definition_.name + "'");
+        }
+        entry_point_ = std::stoull(meta.substr(0, first));
+        max_level_ = std::stoll(meta.substr(first + 1, second - first - 1));
+        count_ = std::stoull(meta.substr(second + 1));
+    }
+    loaded_ = true;
+}
+
+void RucksDBVectorIndex::WriteMeta(rocksdb::WriteBatch& batch) {
+    batch.Put(GetMetaKey(definition_.name),
+              std::to_string(entry_point_) + "|" + std::to_string(max_level_) + "|" + std::to_string(count_));
+}
+
+std::shared_ptr<const RucksDBVectorIndex::Node> RucksDBVectorIndex::GetNode(idx_t row_id) {
+    {
+        std::lock_guard<std::mutex> guard(cache_lock_);
+        auto it = nodes_.find(row_id);
+        if (it != nodes_.end()) {
+            return it->second;
+        }
+    }
+    string data;
+    if (!storage_->ReadData(GetNodeKey(definition_.name, row_id), data)) {
+        return nullptr;
+    }
+    auto node = DecodeNode(data);
+    std::lock_guard<std::mutex> guard(cache_lock_);
+    // An insert may have replaced the node while it was being read
+    return nodes_.emplace(row_id, std::move(node)).first->second;
+}
+
+void RucksDBVectorIndex::PutNode(idx_t row_id, std::shared_ptr<const Node> node, rocksdb::WriteBatch& batch) {
+    batch.Put(GetNodeKey(definition_.name, row_id), EncodeNode(*node));
+    std::lock_guard<std::mutex> guard(cache_lock_);
+    nodes_[row_id] = std::move(node);
+}
+
+idx_t RucksDBVectorIndex::CachedNodes() {
+    std::lock_guard<std::mutex> guard(cache_lock_);
+    return nodes_.size();
+}
+
+float RucksDBVectorIndex::Distance(const float* a, const float* b) const {
+    switch (definition_.metric) {
+    case RucksDBVectorMetric::COSINE:
+        // Vectors are normalized when inserted and queried
+        return 1.0f - RucksDBVectorDistance::Dot(a, b, definition_.dims);
+    case RucksDBVectorMetric::INNER_PRODUCT:
+        return -RucksDBVectorDistance::Dot(a, b, definition_.dims);
+    default:
+        // Ranking by the squared distance saves the square roots
+        return RucksDBVectorDistance::L2Squared(a, b, definition_.dims);
+    }
+}
+
+void RucksDBVectorIndex::Normalize(vector<float>& values) const {
+    if (definition_.metric != RucksDBVectorMetric::COSINE) {
+        return;
+    }
+    float norm = std::sqrt(RucksDBVectorDistance::Dot(values.data(), values.data(), values.size()));
+    if (norm > 0) {
+        for (auto& value : values) {
+            value /= norm;
+        }
+    }
+}
+
+float RucksDBVectorIndex::ComputeDistance(RucksDBVectorMetric metric, const vector<float>& a,
+                                          const vector<float>& b) {
+    idx_t dims = std::min(a.size(), b.size());
+    switch (metric) {
+    case RucksDBVectorMetric::COSINE: {
+        float norms = std::sqrt(RucksDBVectorDistance::Dot(a.data(), a.data(), dims) *
+                                RucksDBVectorDistance::Dot(b.data(), b.data(), dims));
+        return norms > 0 ? 1.0f - RucksDBVectorDistance::Dot(a.data(), b.data(), dims) / norms : 1.0f;
+    }
+    case RucksDBVectorMetric::INNER_PRODUCT:
+        return -RucksDBVectorDistance::Dot(a.data(), b.data(), dims);
+    default:
+        return std::sqrt(RucksDBVectorDistance::L2Squared(a.data(), b.data(), dims));
+    }
+}
+
+idx_t RucksDBVectorIndex::GreedyClosest(const float* query, idx_t entry, int64_t from_level, int64_t to_level) {
+    auto current = GetNode(entry);
+    if (!current) {
+        return entry;
+    }
+    float best = Distance(query, current->values.data());
+    for (int64_t level = from_level; level > to_level; level--) {
+        bool improved = true;
+        while (improved) {
+            improved = false;
+            if ((int64_t)current->neighbors.size() <= level) {
+                break;
+            }
+            for (auto neighbor_id : current->neighbors[level]) {
+                auto neighbor = GetNode(neighbor_id);
+                if (!neighbor) {
+                    continue;
+                }
+                float distance = Distance(query, neighbor->values.data());
+                if (distance < best) {
+                    best = distance;
+                    entry = neighbor_id;
+                    current = neighbor;
+                    improved = true;
+                }
+            }
+        }
+    }
+    return entry;
+}
+
+vector<std::pair<float, idx_t>> RucksDBVectorIndex::SearchLayer(const float* query, idx_t entry, idx_t ef,
+                                                                int64_t level) {
+    using Candidate = std::pair<float, idx_t>;
+    std::priority_queue<Candidate, vector<Candidate>, std::greater<Candidate>> candidates;
+    std::priority_queue<Candidate> results;
+    std::unordered_set<idx_t> visited;
+
+    auto entry_node = GetNode(entry);
+    if (!entry_node) {
+        return {};
+    }
+    float entry_distance = Distance(query, entry_node->values.data());
+    candidates.emplace(entry_distance, entry);
+    results.emplace(entry_distance, entry);
+    visited.insert(entry);
+
+    while (!candidates.empty()) {
+        auto candidate = candidates.top();
+        if (results.size() >= ef && candidate.first > results.top().first) {
+            break;
+        }
+        candidates.pop();
+        auto node = GetNode(candidate.second);
+        if (!node || (int64_t)node->neighbors.size() <= level) {
+            continue;
+        }
+        for (auto neighbor_id : node->neighbors[level]) {
+            if (!visited.insert(neighbor_id).second) {
+                continue;
+            }
+            auto neighbor = GetNode(neighbor_id);
+            if (!neighbor) {
+                continue;
+            }
+            float distance = Distance(query, neighbor->values.data());
+            if (results.size() < ef || distance < results.top().first) {
+                candidates.emplace(distance, neighbor_id);
+                results.emplace(distance, neighbor_id);
+                if (results.size() > ef) {
+                    results.pop();
+                }
+            }
+        }
+    }
+
+    vector<Candidate> sorted(results.size());
+    for (idx_t i = sorted.size(); i > 0; i--) {
+        sorted[i - 1] = results.top();
+        results.pop();
+    }
+    return sorted;
+}
+
+vector<idx_t> RucksDBVectorIndex::SelectNeighbors(const vector<std::pair<float, idx_t>>& candidates, idx_t m,
+                                                  idx_t pending_id, const std::shared_ptr<const Node>& pending) {
+    // Keeps a candidate only if it is closer to the base than to every neighbor kept so far,
+    // which spreads links across directions; pruned candidates fill any remaining slots
+    vector<idx_t> selected;
+    vector<std::shared_ptr<const Node>> selected_nodes;
+    vector<idx_t> pruned;
+    for (auto& candidate : candidates) {
+        if (selected.size() >= m) {
+            break;
+        }
+        auto node = pending && candidate.second == pending_id ? pending : GetNode(candidate.second);
+        if (!node) {
+            continue;
+        }
+        bool diverse = true;
+        for (auto& kept : selected_nodes) {
+            if (Distance(node->values.data(), kept->values.data()) < candidate.first) {
+                diverse = false;
+                break;
+            }
+        }
+        if (diverse) {
+            selected.push_back(candidate.second);
+            selected_nodes.push_back(std::move(node));
+        } else {
+            pruned.push_back(candidate.second);
+        }
+    }
+    for (idx_t i = 0; i < pruned.size() && selected.size() < m; i++) {
+        selected.push_back(pruned[i]);
+    }
+    return selected;
+}
+
+void RucksDBVectorIndex::Insert(idx_t row_id, const vector<float>& values, rocksdb::WriteBatch& batch) {
+    std::lock_guard<std::mutex> guard(write_lock_);
+    EnsureLoaded();
+    if (definition_.dims == 0) {
+        definition_.dims = values.size();
+    }
+    if (values.size() != definition_.dims) {
+        throw std::runtime_error("Vector index '" + definition_.name + "' expects " +
+                                 std::to_string(definition_.dims) + " dimensions, got " +
+                                 std::to_string(values.size()));
+    }
+
+    auto node = std::make_shared<Node>();
+    node->values = values;
+    Normalize(node->values);
+
+    // Levels drawn from a per-row seed, so re-inserting a row keeps its level
+    auto existing = GetNode(row_id);
+    int64_t level;
+    if (existing) {
+        level = (int64_t)existing->neighbors.size() - 1;
+    } else {
+        std::mt19937_64 random(row_id * 0x9E3779B97F4A7C15ULL + 1);
+        std::uniform_real_distribution<double> uniform(std::numeric_limits<double>::min(), 1.0);
+        level = (int64_t)(-std::log(uniform(random)) / std::log((double)definition_.m));
+    }
+    node->neighbors.resize(level + 1);
+
+    if (max_level_ < 0 || (existing && count_ == 1)) {
+        PutNode(row_id, node, batch);
+        entry_point_ = row_id;
+        max_level_ = level;
+        count_ = 1;
+        WriteMeta(batch);
+        return;
+    }
+
+    const float* query = node->values.data();
+    idx_t entry = GreedyClosest(query, entry_point_, max_level_, level);
+    for (int64_t l = std::min(level, max_level_); l >= 0; l--) {
+        auto candidates = SearchLayer(query, entry, definition_.ef_construction, l);
+        for (auto it = candidates.begin(); it != candidates.end(); it++) {
+            if (it->second == row_id) {
+                candidates.erase(it);
+                break;
+            }
+        }
+        if (candidates.empty()) {
+            continue;
+        }
+        entry = candidates[0].second;
+        node->neighbors[l] = SelectNeighbors(candidates, definition_.m);
+
+        // Link back, pruning neighbors that now have too many links
+        idx_t max_links = l == 0 ? 2 * definition_.m : definition_.m;
+        for (auto neighbor_id : node->neighbors[l]) {
+            auto neighbor = GetNode(neighbor_id);
+            if (!neighbor || (int64_t)neighbor->neighbors.size() <= l) {
+                continue;
+            }
+            auto& links = neighbor->neighbors[l];
+            if (std::find(links.begin(), links.end(), row_id) != links.end()) {
+                continue;
+            }
+            auto updated = std::make_shared<Node>(*neighbor);
+            updated->neighbors[l].push_back(row_id);
+            if (updated->neighbors[l].size() > max_links) {
+                vector<std::pair<float, idx_t>> ranked;
+                for (auto link : updated->neighbors[l]) {
+                    auto linked = link == row_id ? node : GetNode(link);
+                    if (linked) {
+                        ranked.emplace_back(Distance(updated->values.data(), linked->values.data()), link);
+                    }
+                }
+                std::sort(ranked.begin(), ranked.end());
+                // The new node is only cached once all its levels are linked
+                updated->neighbors[l] = SelectNeighbors(ranked, max_links, row_id, node);
+            }
+            PutNode(neighbor_id, std::move(updated), batch);
+        }
+    }
+    PutNode(row_id, node, batch);
+
+    if (!existing) {
+        count_++;
+    }
+    if (level > max_level_) {
+        entry_point_ = row_id;
+        max_level_ = level;
+    }
+    WriteMeta(batch);
+}
+
+vector<RucksDBVectorMatch> RucksDBVectorIndex::Search(const vector<float>& query, idx_t k, idx_t ef) {
+    EnsureLoaded();
+    idx_t entry;
+    int64_t max_level;
+    {
+        std::lock_guard<std::mutex> guard(cache_lock_);
+        entry = entry_point_;
+        max_level = max_level_;
+    }
+    vector<RucksDBVectorMatch> matches;
+    if (max_level < 0 || k == 0) {
+        return matches;
+    }
+    if (definition_.dims != 0 && query.size() != definition_.dims) {
+        throw std::runtime_error("Query vector has " + std::to_string(query.size()) + " dimensions, index '" +
+                                 definition_.name + "' has " + std::to_string(definition_.dims));
+    }
+
+    vector<float> normalized = query;
+    Normalize(normalized);
+    entry = GreedyClosest(normalized.data(), entry, max_level, 0);
+    auto candidates = SearchLayer(normalized.data(), entry, std::max(ef, k), 0);
+
+    matches.reserve(candidates.size());
+    for (auto& candidate : candidates) {
+        float distance = candidate.first;
+        if (definition_.metric == RucksDBVectorMetric::L2) {
+            distance = std::sqrt(distance);
+        }
+        matches.push_back(RucksDBVectorMatch {candidate.second, distance});
+    }
+    return matches;
+}
+
+} // namespace duckdb
@@ -0,0 +1,180 @@
+#include "../include/RucksDBWriteOperators.hpp"
+#include "duckdb/execution/expression_executor.hpp"
+#include "duckdb/execution/operator/persistent/physical_insert.hpp"
+#include <atomic>
+
+namespace duckdb {
+
+// Insert implementation
+RucksDBInsert::RucksDBInsert(LogicalOperator& op, TableCatalogEntry& table,
+                             physical_index_vector_t<idx_t> column_index_map,
+                             vector<unique_ptr<Expression>> bound_defaults)
+    : PhysicalOperator(PhysicalOperatorType::EXTENSION, op.types, 1), table(&table), schema(nullptr),
+      column_index_map(std::move(column_index_map)), bound_defaults(std::move(bound_defaults)) {
+}
+
+RucksDBInsert::RucksDBInsert(LogicalOperator& op, SchemaCatalogEntry& schema, unique_ptr<BoundCreateTableInfo> info)
+    : PhysicalOperator(PhysicalOperatorType::EXTENSION, op.types, 1), table(nullptr), schema(&schema),
+      info(std::move(info)) {
+}
+
+class RucksDBInsertGlobalState : public GlobalSinkState {
+public:
+    explicit RucksDBInsertGlobalState(RucksDBTableEntry& table) : table(table), insert_count(0) {
+    }
+
+    RucksDBTableEntry& table;
+    std::atomic<idx_t> insert_count;
+};
+
+class RucksDBInsertLocalState : public LocalSinkState {
+public:
+    RucksDBInsertLocalState(ClientContext& context, RucksDBTableEntry& table,
+                            const vector<unique_ptr<Expression>>& bound_defaults)
+        : default_executor(context, bound_defaults) {
+        insert_chunk.Initialize(Allocator::Get(context), table.GetTypes());
+        table.GetStorage().InitializeAppend(append_state);
+    }
+
+    DataChunk insert_chunk;
+    ExpressionExecutor default_executor;
+    // Rows this thread encoded and has not committed yet
+    RucksDBAppendState append_state;
+};
+
+unique_ptr<GlobalSinkState> RucksDBInsert::GetGlobalSinkState(ClientContext& context) const {
+    optional_ptr<TableCatalogEntry> insert_table = table;
+    if (!insert_table) {
+        // CREATE TABLE AS: create the table before the first chunk arrives
+        auto transaction = schema->ParentCatalog().GetCatalogTransaction(context);
+        insert_table = &schema->CreateTable(transaction, *info)->Cast<TableCatalogEntry>();
+    }
+    return make_unique<RucksDBInsertGlobalState>((RucksDBTableEntry&)*insert_table);
+}
+
+unique_ptr<LocalSinkState> RucksDBInsert::GetLocalSinkState(ExecutionContext& context) const {
+    auto& gstate = (RucksDBInsertGlobalState&)*sink_state;
+    return make_unique<RucksDBInsertLocalState>(context.client, gstate.table, bound_defaults);
+}
+
+SinkResultType RucksDBInsert::Sink(ExecutionContext& context, DataChunk& chunk, OperatorSinkInput& input) const {
+    auto& gstate = (RucksDBInsertGlobalState&)input.global_state;
+    auto& lstate = (RucksDBInsertLocalState&)input.local_state;
+    auto& storage = gstate.table.GetStorage();
+
+    chunk.Flatten();
+    if (column_index_map.empty()) {
+        storage.Append(chunk, lstate.append_state);
+    } else {
+        // Column list given: reorder into table layout and fill in defaults
+        lstate.insert_chunk.Reset();
+        PhysicalInsert::ResolveDefaults(gstate.table, chunk, column_index_map, lstate.default_executor,
+                                        lstate.insert_chunk);
+        storage.Append(lstate.insert_chunk, lstate.append_state);
+    }
+    gstate.insert_count += chunk.size();
+
+    return SinkResultType::NEED_MORE_INPUT;
+}
+
+SinkCombineResultType RucksDBInsert::Combine(ExecutionContext& context, OperatorSinkCombineInput& input) const {
+    auto& gstate = (RucksDBInsertGlobalState&)input.global_state;
+    auto& lstate = (RucksDBInsertLocalState&)input.local_state;
+    gstate.table.GetStorage().FinalizeAppend(lstate.append_state);
+    return SinkCombineResultType::FINISHED;
+}
+
+SourceResultType RucksDBInsert::GetData(ExecutionContext& context, DataChunk& chunk,
+                                        OperatorSourceInput& input) const {
+    auto& gstate = (RucksDBInsertGlobalState&)*sink_state;
+    chunk.SetCardinality(1);
+    chunk.SetValue(0, 0, Value::BIGINT((int64_t)gstate.insert_count.load()));
+    return SourceResultType::FINISHED;
+}
+
+// Delete implementation
+class RucksDBDeleteGlobalState : public GlobalSinkState {
+public:
+    idx_t delete_count = 0;
+};
+
+RucksDBDelete::RucksDBDelete(LogicalOperator& op, TableCatalogEntry& table, idx_t row_id_index)
+    : PhysicalOperator(PhysicalOperatorType::EXTENSION, op.types, 1), table(table), row_id_index(row_id_index) {
+}
+
+unique_ptr<GlobalSinkState> RucksDBDelete::GetGlobalSinkState(ClientContext& context) const {
+    return make_unique<RucksDBDeleteGlobalState>();
+}
+
+SinkResultType RucksDBDelete::Sink(ExecutionContext& context, DataChunk& chunk, OperatorSinkInput& input) const {
+    auto& gstate = (RucksDBDeleteGlobalState&)input.global_state;
+    auto& storage = ((RucksDBTableEntry&)table).GetStorage();
+
+    chunk.Flatten();
+    storage.Delete(chunk.data[row_id_index], chunk.size());
+    gstate.delete_count += chunk.size();
+
+    return SinkResultType::NEED_MORE_INPUT;
+}
+
+SourceResultType RucksDBDelete::GetData(ExecutionContext& context, DataChunk& chunk,
+                                        OperatorSourceInput& input) const {
+    auto& gstate = (RucksDBDeleteGlobalState&)*sink_state;
+    chunk.SetCardinality(1);
+    chunk.SetValue(0, 0, Value::BIGINT((int64_t)gstate.delete_count));
+    return SourceResultType::FINISHED;
+}
+
+// Update implementation
+class RucksDBUpdateGlobalState : public GlobalSinkState {
+public:
+    RucksDBUpdateGlobalState(ClientContext& context, const vector<unique_ptr<Expression>>& expressions)
+        : executor(context, expressions), update_count(0) {
+        vector<LogicalType> types;
+        for (auto& expr : expressions) {
+            types.push_back(expr->return_type);
+        }
+        update_chunk.Initialize(Allocator::Get(context), types);
+    }
+
+    ExpressionExecutor executor;
+    DataChunk update_chunk;
+    idx_t update_count;
+};
+
+RucksDBUpdate::RucksDBUpdate(LogicalOperator& op, TableCatalogEntry& table, vector<column_t> column_ids,
+                             vector<unique_ptr<Expression>> expressions)
+    : PhysicalOperator(PhysicalOperatorType::EXTENSION, op.types, 1), table(table),
+      column_ids(std::move(column_ids)), expressions(std::move(expressions)) {
+}
+
+unique_ptr<GlobalSinkState> RucksDBUpdate::GetGlobalSinkState(ClientContext& context) const {
+    return make_unique<RucksDBUpdateGlobalState>(context, expressions);
+}
+
+SinkResultType RucksDBUpdate::Sink(ExecutionContext& context, DataChunk& chunk, OperatorSinkInput& input) const {
+    auto& gstate = (RucksDBUpdateGlobalState&)input.global_state;
+    auto& storage = ((RucksDBTableEntry&)table).GetStorage();
+
+    chunk.Flatten();
+    gstate.update_chunk.Reset();
+    gstate.executor.Execute(chunk, gstate.update_chunk);
+    gstate.update_chunk.Flatten();
+
+    // The row id is always the last column of the update input
+    auto& row_ids = chunk.data[chunk.ColumnCount() - 1];
+    storage.Update(row_ids, column_ids, gstate.update_chunk);
+    gstate.update_count += chunk.size();
+
+    return SinkResultType::NEED_MORE_INPUT;
+}
+
+SourceResultType RucksDBUpdate::GetData(ExecutionContext& context, DataChunk& chunk,
+                                        OperatorSourceInput& input) const {
+    auto& gstate = (RucksDBUpdateGlobalState&)*sink_state;
+    chunk.SetCardinality(1);
+    chunk.SetValue(0, 0, Value::BIGINT((int64_t)gstate.update_count));
+    return SourceResultType::FINISHED;
+}
+
+} // namespace duckdb
\ No newline at end of file
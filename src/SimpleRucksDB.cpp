@@ -1,4 +1,5 @@
 #include "../include/SimpleRucksDB.hpp"
+#include "../include/RucksDBIngestQueue.hpp"
 #include <iostream>
 
 namespace duckdb {
@@ -18,13 +19,42 @@ void SimpleRucksDBExtension::Load(DuckDB &db) {
 }
 
 // Simple table registry implementation
+SimpleTableRegistry::SimpleTableRegistry(RocksDBStorage* storage, bool cache_catalog)
+    : storage_(storage), cache_catalog_(cache_catalog) {
+    if (cache_catalog_) {
+        LoadCatalog();
+    }
+}
+
+void SimpleTableRegistry::LoadCatalog() {
+    std::string prefix = "table_meta_";
+    std::lock_guard<std::mutex> guard(catalog_lock_);
+    
+    tables_.clear();
+    storage_->IteratePrefix(prefix, [this, &prefix](const std::string& key, const std::string& value) {
+        tables_.insert(key.substr(prefix.length()));
+        return true;
+    });
+}
+
 void SimpleTableRegistry::CreateSimpleTable(const std::string& name) {
     std::string key = "table_meta_" + name;
     std::string value = "created";
     storage_->WriteData(key, value);
+    
+    if (cache_catalog_) {
+        std::lock_guard<std::mutex> guard(catalog_lock_);
+        tables_.insert(name);
+    }
 }
 
 void SimpleTableRegistry::DropSimpleTable(const std::string& name) {
+    // Unpublish first so no new writes start against a table being dropped
+    if (cache_catalog_) {
+        std::lock_guard<std::mutex> guard(catalog_lock_);
+        tables_.erase(name);
+    }
+    
     std::string meta_key = "table_meta_" + name;
     storage_->DeleteData(meta_key);
     
@@ -37,6 +67,11 @@ void SimpleTableRegistry::DropSimpleTable(const std::string& name) {
 }
 
 bool SimpleTableRegistry::TableExists(const std::string& name) {
+    if (cache_catalog_) {
+        std::lock_guard<std::mutex> guard(catalog_lock_);
+        return tables_.count(name) > 0;
+    }
+    
     std::string key = "table_meta_" + name;
     std::string value;
     return storage_->ReadData(key, value);
@@ -51,6 +86,23 @@ void SimpleTableRegistry::InsertData(const std::string& table_name, const std::s
     storage_->WriteData(data_key, value);
 }
 
+std::future<bool> SimpleTableRegistry::InsertDataAsync(const std::string& table_name, const std::string& key,
+                                                       const std::string& value) {
+    if (!TableExists(table_name)) {
+        throw std::runtime_error("Table '" + table_name + "' does not exist");
+    }
+    
+    std::string data_key = "table_data_" + table_name + "_" + key;
+    if (storage_ != g_rocksdb_storage.get()) {
+        // The global queue only writes to g_rocksdb_storage
+        std::promise<bool> done;
+        storage_->WriteData(data_key, value);
+        done.set_value(true);
+        return done.get_future();
+    }
+    return GetGlobalIngestQueue().PutAsync(data_key, value);
+}
+
 bool SimpleTableRegistry::ReadData(const std::string& table_name, const std::string& key, std::string& value) {
     if (!TableExists(table_name)) {
         return false;
@@ -61,6 +113,11 @@ bool SimpleTableRegistry::ReadData(const std::string& table_name, const std::str
 }
 
 std::vector<std::string> SimpleTableRegistry::ListTables() {
+    if (cache_catalog_) {
+        std::lock_guard<std::mutex> guard(catalog_lock_);
+        return std::vector<std::string>(tables_.begin(), tables_.end());
+    }
+    
     std::vector<std::string> tables;
     std::string prefix = "table_meta_";
     
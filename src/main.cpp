@@ -3,14 +3,106 @@
 #include <string>
 #include <stdlib.h>
 #include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
 #include "../include/RocksDBStorage.hpp"
 #include "../include/SimpleRucksDB.hpp"
+#include "../include/RucksDBExtension.hpp"
+#include "../include/RucksDBIngestQueue.hpp"
+#include "../include/RucksDBZipfian.hpp"
 
 extern "C" {
     void rucksdb_init(const char* db_path);
     void rucksdb_shutdown();
 }
 
+// Checks that failed; main reports them and exits with an error
+static int check_failures = 0;
+
+static void Check(bool passed, const std::string& what) {
+    if (!passed) {
+        std::cout << "❌ Check failed: " << what << std::endl;
+        check_failures++;
+    }
+}
+
+// Runs a statement whose result only has to succeed
+static void Exec(duckdb::Connection& con, const std::string& sql) {
+    auto result = con.Query(sql);
+    Check(!result->HasError(), sql + (result->HasError() ? ": " + result->GetError() : ""));
+}
+
+// Checks one value of a query result in text form
+static void CheckValue(duckdb::MaterializedQueryResult& result, duckdb::idx_t col, duckdb::idx_t row,
+                       const std::string& expected, const std::string& what) {
+    if (result.HasError()) {
+        Check(false, what + ": " + result.GetError());
+        return;
+    }
+    if (row >= result.RowCount() || col >= result.ColumnCount()) {
+        Check(false, what + ": no value at row " + std::to_string(row) + ", column " + std::to_string(col));
+        return;
+    }
+    auto actual = result.GetValue(col, row).ToString();
+    Check(actual == expected, what + " is " + actual + ", expected " + expected);
+}
+
+// Runs a query and checks the values of its first row
+static void CheckRow(duckdb::Connection& con, const std::string& sql, const std::vector<std::string>& expected) {
+    auto result = con.Query(sql);
+    for (duckdb::idx_t col = 0; col < expected.size(); col++) {
+        CheckValue(*result, col, 0, expected[col], sql);
+        if (result->HasError()) {
+            return;
+        }
+    }
+}
+
+// YCSB-B style mix (95% reads, 5% updates) over a Zipfian key distribution
+static void RunYCSBB(duckdb::RocksDBStorage& storage, const std::string& label) {
+    const uint64_t record_count = 10000;
+    const uint64_t operation_count = 100000;
+    const std::string payload(100, 'x');
+    
+    for (uint64_t i = 0; i < record_count; i++) {
+        storage.WriteData("user" + std::to_string(i), payload);
+    }
+    
+    duckdb::ZipfianGenerator keys(record_count);
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<int> op_dist(0, 99);
+    std::string value;
+    uint64_t missing = 0;
+    
+    auto start = std::chrono::high_resolution_clock::now();
+    for (uint64_t i = 0; i < operation_count; i++) {
+        std::string key = "user" + std::to_string(keys.Next());
+        if (op_dist(rng) < 95) {
+            if (!storage.ReadData(key, value) || value != payload) {
+                missing++;
+            }
+        } else {
+            storage.WriteData(key, payload);
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    
+    Check(missing == 0, label + ": " + std::to_string(missing) + " reads missed a loaded record");
+    
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    double ops_per_sec = operation_count * 1e6 / std::max<int64_t>(duration.count(), 1);
+    std::cout << "✅ " << label << ": " << (uint64_t)ops_per_sec << " ops/s" << std::endl;
+    
+    auto cache_stats = storage.GetCacheStatistics();
+    if (cache_stats.capacity > 0) {
+        double hit_rate = 100.0 * cache_stats.hits / std::max<uint64_t>(cache_stats.hits + cache_stats.misses, 1);
+        std::cout << "   Cache hits: " << cache_stats.hits << ", misses: " << cache_stats.misses
+                  << " (" << hit_rate << "% hit rate), evictions: " << cache_stats.evictions
+                  << ", invalidations: " << cache_stats.invalidations << std::endl;
+    }
+}
+
 int main() {
     try {
         std::cout << "🚀 Initializing RucksDB (DuckDB + RocksDB Storage Engine)..." << std::endl;
@@ -149,8 +241,406 @@ int main() {
             
             auto bulk_duration = std::chrono::duration_cast<std::chrono::microseconds>(bulk_end - bulk_start);
             std::cout << "✅ RocksDB bulk insert (1k records): " << bulk_duration.count() << " μs" << std::endl;
+            
+            // Same inserts with the catalog cache disabled: every InsertData pays an extra metadata Get
+            duckdb::SimpleTableRegistry uncached_registry(duckdb::g_rocksdb_storage.get(), false);
+            auto uncached_start = std::chrono::high_resolution_clock::now();
+            for (int i = 0; i < 1000; i++) {
+                std::string key = "key" + std::to_string(i);
+                std::string value = "value" + std::to_string(i * 2);
+                uncached_registry.InsertData("perf_test", key, value);
+            }
+            auto uncached_end = std::chrono::high_resolution_clock::now();
+            
+            auto uncached_duration = std::chrono::duration_cast<std::chrono::microseconds>(uncached_end - uncached_start);
+            std::cout << "✅ RocksDB bulk insert without catalog cache (1k records): " 
+                      << uncached_duration.count() << " μs" << std::endl;
+        }
+        
+        // Test 6: SQL-visible RocksDB tables
+        std::cout << "\n=== Test 6: SQL on Attached RocksDB Database ===" << std::endl;
+        
+        auto rucksdb_extension = std::make_unique<duckdb::RucksDBExtension>();
+        rucksdb_extension->Load(db);
+        
+        auto attach_result = con.Query("ATTACH './rucksdb_sql' AS r (TYPE rucksdb)");
+        if (!attach_result->HasError()) {
+            Exec(con, "CREATE OR REPLACE TABLE r.events (id INTEGER, name VARCHAR, score FLOAT)");
+            
+            auto sql_start = std::chrono::high_resolution_clock::now();
+            Exec(con, "INSERT INTO r.events SELECT range, 'event' || range, random() FROM range(10000)");
+            auto sql_end = std::chrono::high_resolution_clock::now();
+            
+            auto sql_duration = std::chrono::duration_cast<std::chrono::microseconds>(sql_end - sql_start);
+            std::cout << "✅ SQL bulk insert into RocksDB (10k rows): " << sql_duration.count() << " μs" << std::endl;
+            
+            CheckRow(con, "SELECT COUNT(*), COUNT(DISTINCT id), MAX(id) FROM r.events", {"10000", "10000", "9999"});
+            
+            Exec(con, "UPDATE r.events SET name = 'updated' WHERE id < 10");
+            Exec(con, "DELETE FROM r.events WHERE id >= 9990");
+            // A scan past deleted rows must neither repeat nor stop early
+            CheckRow(con, "SELECT COUNT(*), COUNT(DISTINCT id), MAX(id) FROM r.events", {"9990", "9990", "9989"});
+            CheckRow(con, "SELECT COUNT(*) FROM r.events WHERE name = 'updated'", {"10"});
+            
+            auto join_result = con.Query("SELECT s.name, e.name AS event FROM standard_table s "
+                                         "JOIN r.events e ON s.id = e.id ORDER BY s.id");
+            if (!join_result->HasError()) {
+                std::cout << "✅ Join between DuckDB and RocksDB tables:" << std::endl;
+                std::cout << join_result->ToString() << std::endl;
+            }
+            CheckValue(*join_result, 0, 2, "Charlie", "Third joined name");
+            CheckValue(*join_result, 1, 2, "updated", "Third joined event");
+            Check(join_result->HasError() || join_result->RowCount() == 3, "Join returns one row per standard_table row");
+            
+            // Rows of a table whose name extends "events" survive dropping events
+            Exec(con, "CREATE OR REPLACE TABLE r.events_row_x (id INTEGER)");
+            Exec(con, "INSERT INTO r.events_row_x SELECT range FROM range(10)");
+            Exec(con, "DROP TABLE r.events");
+            CheckRow(con, "SELECT COUNT(*), SUM(id) FROM r.events_row_x", {"10", "45"});
+            Exec(con, "DROP TABLE r.events_row_x");
+            Exec(con, "DETACH r");
+        } else {
+            Check(false, "ATTACH failed: " + attach_result->GetError());
+        }
+        
+        // Test 7: Hot row cache
+        std::cout << "\n=== Test 7: Row Cache under YCSB-B (95% read / 5% update, Zipfian) ===" << std::endl;
+        {
+            duckdb::RocksDBStorage uncached("./rucksdb_ycsb_nocache");
+            uncached.Initialize();
+            RunYCSBB(uncached, "Without cache");
+            
+            duckdb::RocksDBStorageOptions cache_options;
+            cache_options.cache_size = 1 << 20;
+            duckdb::RocksDBStorage cached("./rucksdb_ycsb_cache", cache_options);
+            cached.Initialize();
+            RunYCSBB(cached, "With 1MB cache");
+        }
+        
+        // Test 8: Asynchronous ingest
+        std::cout << "\n=== Test 8: Async Ingest Queue (4 producers, 100k writes) ===" << std::endl;
+        if (duckdb::g_rocksdb_storage) {
+            const int producers = 4;
+            const int writes_per_producer = 25000;
+            
+            auto sync_start = std::chrono::high_resolution_clock::now();
+            for (int i = 0; i < producers * writes_per_producer; i++) {
+                duckdb::g_rocksdb_storage->WriteData("sync_" + std::to_string(i), "value" + std::to_string(i));
+            }
+            auto sync_end = std::chrono::high_resolution_clock::now();
+            auto sync_duration = std::chrono::duration_cast<std::chrono::microseconds>(sync_end - sync_start);
+            std::cout << "✅ Synchronous puts: "
+                      << (uint64_t)(producers * writes_per_producer * 1e6 / std::max<int64_t>(sync_duration.count(), 1))
+                      << " writes/s" << std::endl;
+            
+            duckdb::RucksDBIngestOptions ingest_options;
+            ingest_options.worker_threads = 2;
+            duckdb::RucksDBIngestQueue queue(duckdb::g_rocksdb_storage.get(), ingest_options);
+            
+            std::vector<std::thread> threads;
+            for (int t = 0; t < producers; t++) {
+                threads.emplace_back([&queue, t, writes_per_producer]() {
+                    for (int i = 0; i < writes_per_producer; i++) {
+                        std::string key = "async_" + std::to_string(t) + "_" + std::to_string(i);
+                        queue.PutAsync(key, "value" + std::to_string(i), [](bool, const std::string&) {});
+                    }
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+            queue.Flush();
+            
+            std::string value;
+            for (int t = 0; t < producers; t++) {
+                auto key = "async_" + std::to_string(t) + "_" + std::to_string(writes_per_producer - 1);
+                Check(duckdb::g_rocksdb_storage->ReadData(key, value) &&
+                          value == "value" + std::to_string(writes_per_producer - 1),
+                      "Flushed async put " + key);
+            }
+            
+            auto ingest_stats = queue.GetStatistics();
+            std::cout << "✅ Async puts: " << (uint64_t)ingest_stats.throughput << " writes/s in "
+                      << ingest_stats.batches << " batches" << std::endl;
+            std::cout << "   Enqueue latency p50: " << ingest_stats.enqueue_p50_ns << " ns, p99: "
+                      << ingest_stats.enqueue_p99_ns << " ns" << std::endl;
+            std::cout << "   Batch commit latency p50: " << ingest_stats.commit_p50_ns << " ns, p99: "
+                      << ingest_stats.commit_p99_ns << " ns" << std::endl;
         }
         
+        // Test 9: Instrumentation through SQL
+        std::cout << "\n=== Test 9: RucksDB Statistics via SQL ===" << std::endl;
+        auto stats_result = con.Query("SELECT name, value FROM rucksdb_stats() "
+                                      "WHERE category = 'operation' AND name LIKE '%.p99_ns' AND value > 0");
+        if (!stats_result->HasError()) {
+            std::cout << "✅ Storage operation p99 latencies:" << std::endl;
+            stats_result->Print();
+        }
+        Check(!stats_result->HasError() && stats_result->RowCount() > 0, "rucksdb_stats reports operation latencies");
+        Exec(con, "CALL rucksdb_trace_start()");
+        Exec(con, "ATTACH './rucksdb_sql' AS r (TYPE rucksdb)");
+        Exec(con, "CREATE OR REPLACE TABLE r.traced AS SELECT range AS id, random() AS score FROM range(10000)");
+        CheckRow(con, "SELECT COUNT(*), SUM(id) FROM r.traced", {"10000", "49995000"});
+        Exec(con, "DROP TABLE r.traced");
+        Exec(con, "DETACH r");
+        Exec(con, "CALL rucksdb_trace_stop()");
+        auto trace_result = con.Query("CALL rucksdb_trace_dump('rucksdb_trace.json')");
+        if (!trace_result->HasError()) {
+            std::cout << "✅ Trace events written to rucksdb_trace.json: "
+                      << trace_result->GetValue(1, 0).ToString() << std::endl;
+        }
+        Check(!trace_result->HasError() && trace_result->GetValue(1, 0).GetValue<int64_t>() > 0,
+              "Tracing recorded events");
+        auto property_result = con.Query("SELECT value FROM rucksdb_rocksdb_property('rocksdb.estimate-num-keys')");
+        if (!property_result->HasError()) {
+            std::cout << "✅ Estimated keys: " << property_result->GetValue(0, 0).ToString() << std::endl;
+        }
+        Check(!property_result->HasError() && property_result->RowCount() == 1, "rocksdb.estimate-num-keys is reported");
+        
+        // Test 10: Online snapshots and backups
+        std::cout << "\n=== Test 10: Checkpoint and Incremental Backup ===" << std::endl;
+        auto checkpoint_dir = "./rucksdb_checkpoint_" + std::to_string(std::chrono::system_clock::now().time_since_epoch().count());
+        auto checkpoint_result = con.Query("CALL rucksdb_checkpoint('" + checkpoint_dir + "')");
+        if (!checkpoint_result->HasError()) {
+            std::cout << "✅ Checkpoint created at " << checkpoint_dir << std::endl;
+        }
+        Check(!checkpoint_result->HasError(), "Checkpoint " + checkpoint_dir);
+        // The second backup only copies files written since the first
+        Exec(con, "CALL rucksdb_backup('./rucksdb_backups', 64 * 1024 * 1024)");
+        duckdb::g_rocksdb_storage->WriteData("backup_marker", "1");
+        Exec(con, "CALL rucksdb_backup('./rucksdb_backups', 64 * 1024 * 1024)");
+        auto backups_result = con.Query("SELECT * FROM rucksdb_backups('./rucksdb_backups') ORDER BY backup_id");
+        if (!backups_result->HasError()) {
+            backups_result->Print();
+        }
+        // Earlier runs may have left backups of their own
+        Check(!backups_result->HasError() && backups_result->RowCount() >= 2, "Both backups are listed");
+
+        // Test 11: A second, range-sharded instance next to the default one
+        std::cout << "\n=== Test 11: Sharded Instance ===" << std::endl;
+        auto sharded = con.Query("ATTACH './rucksdb_sharded' AS sharded (TYPE rucksdb, "
+                                 "OPTIONS 'shard_paths=./rucksdb_shard1,./rucksdb_shard2;sharding=range')");
+        if (!sharded->HasError()) {
+            Exec(con, "CREATE OR REPLACE TABLE sharded.events AS SELECT range AS id, range % 7 AS kind FROM range(100000)");
+            auto count_result = con.Query("SELECT kind, count(*) FROM rocksdb_scan('events', database := 'sharded') "
+                                          "GROUP BY kind ORDER BY kind");
+            if (!count_result->HasError()) {
+                count_result->Print();
+            }
+            Check(count_result->HasError() || count_result->RowCount() == 7, "Sharded scan sees all seven kinds");
+            CheckValue(*count_result, 1, 0, "14286", "Rows of kind 0");
+            CheckValue(*count_result, 1, 6, "14285", "Rows of kind 6");
+            Exec(con, "DETACH sharded");
+        } else {
+            Check(false, "ATTACH sharded failed: " + sharded->GetError());
+        }
+
+        // Test 12: Incremental refresh of a DuckDB copy from the change stream
+        std::cout << "\n=== Test 12: Change Data Capture ===" << std::endl;
+        Exec(con, "ATTACH './rucksdb_cdc' AS cdc (TYPE rucksdb)");
+        Exec(con, "CREATE OR REPLACE TABLE cdc.orders AS SELECT range AS id, range * 10 AS amount FROM range(1000)");
+        Exec(con, "CREATE TABLE orders_copy AS SELECT rowid AS row_id, id, amount FROM cdc.orders");
+        CheckRow(con, "SELECT COUNT(*), SUM(amount) FROM orders_copy", {"1000", "4995000"});
+        auto since = con.Query("SELECT value + 1 FROM rucksdb_stats(database := 'cdc') WHERE name = 'latest_sequence'");
+        Check(!since->HasError() && since->RowCount() == 1, "rucksdb_stats reports latest_sequence");
+        Exec(con, "UPDATE cdc.orders SET amount = 0 WHERE id < 10");
+        Exec(con, "DELETE FROM cdc.orders WHERE id >= 990");
+        if (!since->HasError() && since->RowCount() == 1) {
+            auto changes_sql = "FROM rucksdb_changes('orders', " + since->GetValue(0, 0).ToString() +
+                               ", database := 'cdc')";
+            auto changes = con.Query("SELECT change, count(*) " + changes_sql + " GROUP BY change");
+            if (!changes->HasError()) {
+                changes->Print();
+            }
+            CheckRow(con, "SELECT COUNT(*) FILTER (WHERE change = 'upsert'), COUNT(*) FILTER (WHERE change = 'delete') " +
+                              changes_sql, {"10", "10"});
+        }
+        Exec(con, "DROP TABLE orders_copy");
+
+        // Test 13: Rollup maintained by merge operands on every insert
+        std::cout << "\n=== Test 13: Materialized Rollup ===" << std::endl;
+        Exec(con, "CALL rucksdb_create_rollup('orders_by_bucket', 'orders', 'count, sum(amount), max(amount)', "
+                  "time_column := 'id', bucket_seconds := 100, database := 'cdc')");
+        Exec(con, "INSERT INTO cdc.orders SELECT range AS id, range AS amount FROM range(1000, 1500)");
+        auto rollup = con.Query("SELECT * FROM rucksdb_rollup('orders_by_bucket', database := 'cdc') ORDER BY id");
+        if (!rollup->HasError()) {
+            rollup->Print();
+        }
+        // The 990 rows left by Test 12 are backfilled, the 500 inserted ones merged in
+        CheckRow(con, "SELECT SUM(count), SUM(sum_amount), MAX(max_amount) "
+                      "FROM rucksdb_rollup('orders_by_bucket', database := 'cdc')",
+                 {"1490", "5519850", "9890"});
+        Exec(con, "CALL rucksdb_drop_rollup('orders_by_bucket', database := 'cdc')");
+
+        // Test 14: Time-partitioned TTL; ids are epoch seconds, so every order has long expired
+        std::cout << "\n=== Test 14: Table TTL ===" << std::endl;
+        Exec(con, "CALL rucksdb_set_ttl('orders', 'id', 3600, partition_seconds := 600, database := 'cdc')");
+        auto live = con.Query("SELECT COUNT(*) FROM cdc.orders");
+        if (!live->HasError()) {
+            std::cout << "Live orders: " << live->GetValue(0, 0).ToString() << std::endl;
+        }
+        CheckValue(*live, 0, 0, "0", "Live orders");
+        auto expired = con.Query("CALL rucksdb_expire('orders', database := 'cdc')");
+        if (!expired->HasError()) {
+            expired->Print();
+        }
+        Check(!expired->HasError(), "rucksdb_expire");
+
+        // Test 15: HNSW index over a RocksDB-stored embedding column
+        std::cout << "\n=== Test 15: Vector Index (" << duckdb::RucksDBVectorDistance::KernelName()
+                  << " kernels) ===" << std::endl;
+        Exec(con, "CREATE OR REPLACE TABLE cdc.docs (id INTEGER, embedding FLOAT[3])");
+        Exec(con, "INSERT INTO cdc.docs SELECT range, [range % 10, range % 7, range % 3]::FLOAT[3] FROM range(1000)");
+        Exec(con, "CALL rucksdb_create_vector_index('docs_embedding', 'docs', 'embedding', database := 'cdc')");
+        Exec(con, "INSERT INTO cdc.docs VALUES (1000, [2, 4, 6]::FLOAT[3])");
+        auto knn = con.Query("SELECT id, distance FROM rocksdb_knn('docs', 'embedding', [2, 4, 6]::FLOAT[3], 3, "
+                             "database := 'cdc')");
+        if (!knn->HasError()) {
+            knn->Print();
+        }
+        Check(knn->HasError() || knn->RowCount() == 3, "rocksdb_knn returns k rows");
+        // Row 1000, and rows 102, 312, ... of the first insert, hold the query vector itself
+        CheckValue(*knn, 1, 0, "0.0", "Distance of the nearest neighbor");
+
+        // Test 16: Inverted index over a log message column
+        std::cout << "\n=== Test 16: Text Index ===" << std::endl;
+        Exec(con, "CREATE OR REPLACE TABLE cdc.logs (id INTEGER, message VARCHAR)");
+        Exec(con, "INSERT INTO cdc.logs SELECT range, CASE range % 3 WHEN 0 THEN 'disk full on node ' || range "
+                  "WHEN 1 THEN 'request timeout after retry' ELSE 'healthy' END FROM range(3000)");
+        Exec(con, "CALL rucksdb_create_text_index('logs_message', 'logs', 'message', database := 'cdc')");
+        auto hits = con.Query("SELECT COUNT(*) FROM rucksdb_text_search('logs', 'message', 'disk full OR time*', "
+                              "database := 'cdc')");
+        if (!hits->HasError()) {
+            std::cout << "Matching log lines: " << hits->GetValue(0, 0).ToString() << std::endl;
+        }
+        CheckValue(*hits, 0, 0, "2000", "Matching log lines");
+
+        // Test 17: Lookup join resolving a handful of probes without scanning the table
+        std::cout << "\n=== Test 17: Lookup Join ===" << std::endl;
+        auto lookup = con.Query("SELECT row_id, message FROM rocksdb_lookup((SELECT range AS row_id FROM range(0, 3000, 500)), "
+                                "'logs', database := 'cdc')");
+        if (!lookup->HasError()) {
+            lookup->Print();
+        }
+        // Rows were inserted in order, so row ids equal ids
+        Check(lookup->HasError() || lookup->RowCount() == 6, "rocksdb_lookup finds every probe");
+        CheckValue(*lookup, 1, 0, "disk full on node 0", "Message of row 0");
+        CheckValue(*lookup, 1, 1, "healthy", "Message of row 500");
+        Exec(con, "DETACH cdc");
+
+        // Test 18: Wide documents kept out of line in blob files; the id scan never reads them
+        std::cout << "\n=== Test 18: Large Value Separation ===" << std::endl;
+        auto blobs = con.Query("ATTACH './rucksdb_blobs' AS blobs (TYPE rucksdb, "
+                               "OPTIONS 'enable_blob_files=true;min_blob_size=4KB;large_value_size=4KB')");
+        if (!blobs->HasError()) {
+            Exec(con, "CREATE OR REPLACE TABLE blobs.pages AS SELECT range AS id, repeat('x', 16384) AS body "
+                      "FROM range(2000)");
+            CheckRow(con, "SELECT SUM(id) FROM rocksdb_scan('pages', database := 'blobs')", {"1999000"});
+            auto blob_reads = con.Query("SELECT value FROM rucksdb_stats(database := 'blobs') "
+                                        "WHERE name = 'rocksdb.blobdb.blob.file.bytes.read'");
+            if (!blob_reads->HasError() && blob_reads->RowCount() > 0) {
+                std::cout << "Blob bytes read by the id scan: " << blob_reads->GetValue(0, 0).ToString() << std::endl;
+            }
+            auto lengths = con.Query("SELECT SUM(length(body)) FROM rocksdb_scan('pages', database := 'blobs')");
+            if (!lengths->HasError()) {
+                std::cout << "Body bytes: " << lengths->GetValue(0, 0).ToString() << std::endl;
+            }
+            CheckValue(*lengths, 0, 0, "32768000", "Body bytes");
+            Exec(con, "DETACH blobs");
+        } else {
+            Check(false, "ATTACH blobs failed: " + blobs->GetError());
+        }
+
+        // Test 19: One memory budget split between the block cache and DuckDB's buffer manager
+        std::cout << "\n=== Test 19: Memory Budget ===" << std::endl;
+        auto budgeted = con.Query("ATTACH './rucksdb_budget' AS budget (TYPE rucksdb, "
+                                  "OPTIONS 'memory_budget=512MB;rocksdb_memory_share=0.25')");
+        if (!budgeted->HasError()) {
+            auto memory = con.Query("SELECT name, value FROM rucksdb_stats(database := 'budget') "
+                                    "WHERE category = 'memory'");
+            if (!memory->HasError()) {
+                memory->Print();
+            }
+            Check(!memory->HasError() && memory->RowCount() > 0, "rucksdb_stats reports the memory budget");
+            Exec(con, "DETACH budget");
+        } else {
+            Check(false, "ATTACH budget failed: " + budgeted->GetError());
+        }
+
+        // Test 20: Tiered table; recent rows stay in memory and updates are inserts of the same key
+        std::cout << "\n=== Test 20: Tiered Table ===" << std::endl;
+        auto tiered = con.Query("ATTACH './rucksdb_tiered' AS tiered (TYPE rucksdb)");
+        if (!tiered->HasError()) {
+            Exec(con, "CREATE OR REPLACE TABLE tiered.accounts (id INTEGER, balance BIGINT)");
+            Exec(con, "CALL rucksdb_set_tiering('accounts', 'id', row_group_size := 4096, database := 'tiered')");
+            Exec(con, "INSERT INTO tiered.accounts SELECT range, 100 FROM range(10000)");
+            Exec(con, "CALL rucksdb_seal('accounts', database := 'tiered')");
+            Exec(con, "INSERT INTO tiered.accounts SELECT range, 200 FROM range(0, 10000, 10)");
+            auto balances = con.Query("SELECT COUNT(*), SUM(balance) FROM tiered.accounts");
+            if (!balances->HasError()) {
+                balances->Print();
+            }
+            // Every tenth account was re-inserted with 200, which replaces its sealed row
+            CheckValue(*balances, 0, 0, "10000", "Tiered accounts");
+            CheckValue(*balances, 1, 0, "1100000", "Tiered balance total");
+            Exec(con, "DETACH tiered");
+        } else {
+            Check(false, "ATTACH tiered failed: " + tiered->GetError());
+        }
+
+        // Test 21: Clustered table; a filter on the leading key columns reads one key range
+        std::cout << "\n=== Test 21: Clustered Table ===" << std::endl;
+        auto clustered = con.Query("ATTACH './rucksdb_clustered' AS clustered (TYPE rucksdb)");
+        if (!clustered->HasError()) {
+            // A table whose name extends "events" keeps its copies when events is clustered below
+            Exec(con, "CREATE OR REPLACE TABLE clustered.\"events:eu\" (tenant_id INTEGER, ts TIMESTAMP, payload VARCHAR)");
+            Exec(con, "CALL rucksdb_set_clustering('events:eu', 'tenant_id, ts', database := 'clustered')");
+            Exec(con, "INSERT INTO clustered.\"events:eu\" SELECT 7, TIMESTAMP '2024-01-01 18:00:00', 'eu event ' || range "
+                      "FROM range(10)");
+            Exec(con, "CREATE OR REPLACE TABLE clustered.events (tenant_id INTEGER, ts TIMESTAMP, payload VARCHAR)");
+            Exec(con, "CALL rucksdb_set_clustering('events', 'tenant_id, ts', database := 'clustered')");
+            Exec(con, "INSERT INTO clustered.events SELECT range % 100, TIMESTAMP '2024-01-01' + INTERVAL (range) SECOND, "
+                      "'event ' || range FROM range(100000)");
+            auto window = con.Query("SELECT COUNT(*), MIN(ts), MAX(ts) FROM clustered.events "
+                                    "WHERE tenant_id = 7 AND ts >= TIMESTAMP '2024-01-01 12:00:00'");
+            if (!window->HasError()) {
+                window->Print();
+            }
+            // Tenant 7 holds rows 7, 107, ...; from noon on that is rows 43207 through 99907
+            CheckValue(*window, 0, 0, "568", "Rows in the tenant window");
+            CheckValue(*window, 1, 0, "2024-01-01 12:00:07", "First timestamp in the tenant window");
+            CheckValue(*window, 2, 0, "2024-01-02 03:45:07", "Last timestamp in the tenant window");
+            CheckRow(con, "SELECT COUNT(*), COUNT(DISTINCT payload) FROM clustered.events", {"100000", "100000"});
+            CheckRow(con, "SELECT COUNT(*) FROM clustered.\"events:eu\" WHERE tenant_id = 7", {"10"});
+            Exec(con, "DETACH clustered");
+        } else {
+            Check(false, "ATTACH clustered failed: " + clustered->GetError());
+        }
+
+        // Test 22: A table whose statistics record is missing reports no statistics, so filters
+        // are not folded away on empty sketches
+        std::cout << "\n=== Test 22: Table Without Statistics ===" << std::endl;
+        auto unstated = con.Query("ATTACH './rucksdb_nostats' AS nostats (TYPE rucksdb)");
+        if (!unstated->HasError()) {
+            Exec(con, "CREATE OR REPLACE TABLE nostats.readings (x INTEGER)");
+            Exec(con, "INSERT INTO nostats.readings SELECT range FROM range(100)");
+            Exec(con, "INSERT INTO nostats.readings VALUES (NULL)");
+            Exec(con, "DETACH nostats");
+            {
+                // As left by a version that kept no statistics
+                duckdb::RocksDBStorage raw("./rucksdb_nostats");
+                raw.Initialize();
+                raw.DeleteData("table_stats_readings");
+            }
+            Exec(con, "ATTACH './rucksdb_nostats' AS nostats (TYPE rucksdb)");
+            CheckRow(con, "SELECT COUNT(*) FROM nostats.readings WHERE x > 5", {"94"});
+            CheckRow(con, "SELECT COUNT(*) FROM nostats.readings WHERE x IS NULL", {"1"});
+            CheckRow(con, "SELECT MIN(x), MAX(x) FROM nostats.readings", {"0", "99"});
+            Exec(con, "DETACH nostats");
+        } else {
+            Check(false, "ATTACH nostats failed: " + unstated->GetError());
+        }
+
         // Summary
         std::cout << "\n=== Architecture Summary ===" << std::endl;
         std::cout << "🎯 Hybrid Database Architecture:" << std::endl;
@@ -178,6 +668,10 @@ int main() {
         // Shutdown
         rucksdb_shutdown();
         
+        if (check_failures > 0) {
+            std::cerr << "❌ " << check_failures << " check(s) failed" << std::endl;
+            return 1;
+        }
     } catch (const std::exception &e) {
         std::cerr << "❌ Error: " << e.what() << std::endl;
         rucksdb_shutdown();
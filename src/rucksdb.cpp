@@ -1,6 +1,7 @@
 // src/rucksdb.cpp
 #include "../include/RocksDBStorage.hpp"
 #include "../include/rucksdb.hpp"
+#include "../include/RucksDBIngestQueue.hpp"
 #include <iostream>
 
 // RucksDB API implementation
@@ -42,6 +43,70 @@ bool del(const std::string& key) {
     }
 }
 
+std::future<bool> put_async(const std::string& key, const std::string& value) {
+    if (!duckdb::g_rocksdb_storage) {
+        std::promise<bool> failed;
+        failed.set_value(false);
+        return failed.get_future();
+    }
+    
+    return duckdb::GetGlobalIngestQueue().PutAsync(key, value);
+}
+
+void put_async(const std::string& key, const std::string& value,
+               std::function<void(bool, const std::string&)> callback) {
+    if (!duckdb::g_rocksdb_storage) {
+        callback(false, "RucksDB is not initialized");
+        return;
+    }
+    
+    duckdb::GetGlobalIngestQueue().PutAsync(key, value, std::move(callback));
+}
+
+std::future<bool> del_async(const std::string& key) {
+    if (!duckdb::g_rocksdb_storage) {
+        std::promise<bool> failed;
+        failed.set_value(false);
+        return failed.get_future();
+    }
+    
+    return duckdb::GetGlobalIngestQueue().DeleteAsync(key);
+}
+
+void flush_async() {
+    if (duckdb::g_ingest_queue) {
+        duckdb::g_ingest_queue->Flush();
+    }
+}
+
+bool checkpoint(const std::string& checkpoint_dir) {
+    if (!duckdb::g_rocksdb_storage) {
+        return false;
+    }
+    
+    try {
+        duckdb::g_rocksdb_storage->CreateCheckpoint(checkpoint_dir);
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "RucksDB checkpoint error: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool backup(const std::string& backup_dir, uint64_t rate_limit) {
+    if (!duckdb::g_rocksdb_storage) {
+        return false;
+    }
+    
+    try {
+        duckdb::g_rocksdb_storage->CreateBackup(backup_dir, rate_limit);
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "RucksDB backup error: " << e.what() << std::endl;
+        return false;
+    }
+}
+
 void scan_prefix(const std::string& prefix, 
                 std::function<bool(const std::string&, const std::string&)> callback) {
     if (!duckdb::g_rocksdb_storage) {
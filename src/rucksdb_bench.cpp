@@ -0,0 +1,573 @@
+// src/rucksdb_bench.cpp
+//
+// Reproducible RucksDB benchmarks. Every workload prints one JSON object per
+// line on stdout, and --output=FILE writes the whole run as a single document.
+//
+//   rucksdb_bench [--workload=all|ycsb|ycsb-a..ycsb-f|append|append-parallel|scan|scan-cold|scan-range|mixed|startup]
+//                 [--records=N] [--operations=N] [--value-size=B] [--threads=T] [--tables=N]
+//                 [--scan-iterations=N] [--path=DIR] [--options="cache_size=64MB;..."]
+//                 [--output=FILE]
+//
+// scan-cold empties the caches before every scan and compares prefetching scans with ones
+// reading each vector on demand; run it with --options="use_direct_reads=true" so the page
+// cache does not hide the reads.
+//
+// startup creates --tables tables in DIR_startup and appends --records rows after the last
+// flush, then reopens it --scan-iterations times, timing open plus the first query; compare
+// runs with --options="flush_on_recovery=true" or a smaller max_total_wal_size.
+//
+// append-parallel appends the rows of "append" from --threads threads with one append state
+// each; compare it with "append" for the gain of encoding chunks in parallel.
+//
+// scan-range filters 1% of the ids, first over the plain table and then after clustering it by
+// id, when the filter becomes a bounded key range.
+
+#include <duckdb.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../include/rucksdb.hpp"
+#include "../include/RocksDBStorage.hpp"
+#include "../include/RucksDBExtension.hpp"
+#include "../include/RucksDBHistogram.hpp"
+#include "../include/RucksDBInstance.hpp"
+#include "../include/RucksDBZipfian.hpp"
+
+extern "C" {
+    void rucksdb_init_with_options(const char* db_path, const char* options);
+    void rucksdb_shutdown();
+}
+
+struct BenchConfig {
+    std::string workload = "all";
+    uint64_t records = 100000;
+    uint64_t operations = 100000;
+    size_t value_size = 100;
+    size_t threads = 4;
+    size_t scan_iterations = 5;
+    uint64_t tables = 10000;
+    std::string path = "./rucksdb_bench";
+    std::string options;
+    std::string output;
+};
+
+struct BenchResult {
+    std::string name;
+    uint64_t operations = 0;
+    double seconds = 0;
+    duckdb::RucksDBHistogram latency;
+    uint64_t bytes_written = 0;
+    uint64_t bytes_read = 0;
+    double write_amplification = 0;
+};
+
+// RocksDB tickers sampled around a workload
+struct IOCounters {
+    uint64_t bytes_written = 0;
+    uint64_t bytes_read = 0;
+    uint64_t flush_bytes = 0;
+    uint64_t compaction_bytes = 0;
+
+    static IOCounters Capture() {
+        IOCounters counters;
+        auto statistics = duckdb::g_rocksdb_storage->GetStatistics();
+        if (statistics) {
+            counters.bytes_written = statistics->getTickerCount(rocksdb::BYTES_WRITTEN);
+            counters.bytes_read = statistics->getTickerCount(rocksdb::BYTES_READ) +
+                                  statistics->getTickerCount(rocksdb::ITER_BYTES_READ);
+            counters.flush_bytes = statistics->getTickerCount(rocksdb::FLUSH_WRITE_BYTES);
+            counters.compaction_bytes = statistics->getTickerCount(rocksdb::COMPACT_WRITE_BYTES);
+        }
+        return counters;
+    }
+};
+
+// Times the body of a workload and fills in the I/O counters afterwards
+class Measurement {
+private:
+    BenchResult& result_;
+    IOCounters before_;
+    std::chrono::steady_clock::time_point start_;
+
+public:
+    explicit Measurement(BenchResult& result)
+        : result_(result), before_(IOCounters::Capture()), start_(std::chrono::steady_clock::now()) {}
+
+    void Finish() {
+        result_.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+        // Flushing outside the timed region makes memtable-resident writes count towards write amp
+        duckdb::g_rocksdb_storage->Flush();
+        auto after = IOCounters::Capture();
+        result_.bytes_written = after.bytes_written - before_.bytes_written;
+        result_.bytes_read = after.bytes_read - before_.bytes_read;
+        uint64_t device_bytes = (after.flush_bytes - before_.flush_bytes) +
+                                (after.compaction_bytes - before_.compaction_bytes);
+        result_.write_amplification = result_.bytes_written == 0 ? 0 : double(device_bytes) / result_.bytes_written;
+    }
+};
+
+static uint64_t ElapsedNanos(std::chrono::steady_clock::time_point start) {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+static std::string ResultToJSON(const BenchResult& result) {
+    std::ostringstream json;
+    json << "{\"workload\":\"" << result.name << "\""
+         << ",\"operations\":" << result.operations
+         << ",\"seconds\":" << result.seconds
+         << ",\"ops_per_sec\":" << (result.seconds > 0 ? result.operations / result.seconds : 0)
+         << ",\"latency_ns\":{\"mean\":" << result.latency.Mean()
+         << ",\"p50\":" << result.latency.Percentile(50)
+         << ",\"p99\":" << result.latency.Percentile(99)
+         << ",\"p999\":" << result.latency.Percentile(99.9)
+         << ",\"max\":" << result.latency.Max() << "}"
+         << ",\"bytes_written\":" << result.bytes_written
+         << ",\"bytes_read\":" << result.bytes_read
+         << ",\"write_amplification\":" << result.write_amplification << "}";
+    return json.str();
+}
+
+// YCSB core workloads over the rucksdb:: key-value API
+static std::string UserKey(uint64_t id) {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "user%012llu", (unsigned long long)id);
+    return buffer;
+}
+
+struct YCSBWorkload {
+    const char* name;
+    int read, update, insert, scan, read_modify_write;
+    bool latest; // workload D reads recently inserted records
+};
+
+static const YCSBWorkload YCSB_WORKLOADS[] = {
+    {"ycsb-a", 50, 50, 0, 0, 0, false},
+    {"ycsb-b", 95, 5, 0, 0, 0, false},
+    {"ycsb-c", 100, 0, 0, 0, 0, false},
+    {"ycsb-d", 95, 0, 5, 0, 0, true},
+    {"ycsb-e", 0, 0, 5, 95, 0, false},
+    {"ycsb-f", 50, 0, 0, 0, 50, false},
+};
+
+static void LoadRecords(const BenchConfig& config, BenchResult& result) {
+    std::string payload(config.value_size, 'x');
+    Measurement measurement(result);
+    for (uint64_t i = 0; i < config.records; i++) {
+        auto start = std::chrono::steady_clock::now();
+        rucksdb::put(UserKey(i), payload);
+        result.latency.Record(ElapsedNanos(start));
+    }
+    result.operations = config.records;
+    measurement.Finish();
+}
+
+static void RunYCSB(const BenchConfig& config, const YCSBWorkload& workload, uint64_t& record_count,
+                    BenchResult& result) {
+    std::string payload(config.value_size, 'y');
+    duckdb::ZipfianGenerator keys(record_count);
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<int> op_dist(0, 99);
+    std::string value;
+
+    Measurement measurement(result);
+    for (uint64_t i = 0; i < config.operations; i++) {
+        uint64_t id = keys.Next();
+        if (workload.latest) {
+            id = record_count - 1 - std::min(id, record_count - 1);
+        }
+        std::string key = UserKey(id);
+        int op = op_dist(rng);
+
+        auto start = std::chrono::steady_clock::now();
+        if (op < workload.read) {
+            rucksdb::get(key, value);
+        } else if ((op -= workload.read) < workload.update) {
+            rucksdb::put(key, payload);
+        } else if ((op -= workload.update) < workload.insert) {
+            rucksdb::put(UserKey(record_count++), payload);
+        } else if ((op -= workload.insert) < workload.scan) {
+            // Short range scan: dropping the last digit of the key selects up to 10 neighbouring records
+            size_t scanned = 0;
+            rucksdb::scan_prefix(key.substr(0, key.size() - 1), [&scanned](const std::string&, const std::string&) {
+                return ++scanned < 10;
+            });
+        } else {
+            rucksdb::get(key, value);
+            rucksdb::put(key, payload);
+        }
+        result.latency.Record(ElapsedNanos(start));
+    }
+    result.operations = config.operations;
+    measurement.Finish();
+}
+
+// Concurrent mixed read/write: 50% get, 50% put from config.threads threads
+static void RunMixed(const BenchConfig& config, uint64_t record_count, BenchResult& result) {
+    uint64_t per_thread = config.operations / config.threads;
+
+    Measurement measurement(result);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < config.threads; t++) {
+        threads.emplace_back([&, t]() {
+            std::string payload(config.value_size, 'z');
+            duckdb::ZipfianGenerator keys(record_count, 0.99, 100 + t);
+            std::mt19937_64 rng(t);
+            std::string value;
+            for (uint64_t i = 0; i < per_thread; i++) {
+                std::string key = UserKey(keys.Next());
+                auto start = std::chrono::steady_clock::now();
+                if (rng() & 1) {
+                    rucksdb::get(key, value);
+                } else {
+                    rucksdb::put(key, payload);
+                }
+                result.latency.Record(ElapsedNanos(start));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    result.operations = per_thread * config.threads;
+    measurement.Finish();
+}
+
+// Analytical workloads on a RocksDB-backed table
+static const char* BENCH_TABLE = "bench_events";
+
+static duckdb::RucksDBTableStorage* CreateBenchTable() {
+    using namespace duckdb;
+
+    if (g_table_registry->TableExists(BENCH_TABLE)) {
+        g_table_registry->DropTable(BENCH_TABLE);
+    }
+    vector<ColumnDefinition> columns;
+    columns.emplace_back("id", LogicalType::INTEGER);
+    columns.emplace_back("name", LogicalType::VARCHAR);
+    columns.emplace_back("score", LogicalType::FLOAT);
+    g_table_registry->CreateTable(BENCH_TABLE, columns);
+    return g_table_registry->GetTable(BENCH_TABLE);
+}
+
+// Fills chunk with the rows starting at row, returns how many
+static duckdb::idx_t FillBenchChunk(const BenchConfig& config, duckdb::DataChunk& chunk, uint64_t row,
+                                    std::mt19937_64& rng) {
+    using namespace duckdb;
+
+    std::uniform_real_distribution<float> score_dist(0, 100);
+    idx_t count = std::min<uint64_t>(STANDARD_VECTOR_SIZE, config.records - row);
+    chunk.Reset();
+    for (idx_t i = 0; i < count; i++) {
+        chunk.SetValue(0, i, Value::INTEGER((int32_t)(row + i)));
+        chunk.SetValue(1, i, Value("event" + std::to_string(row + i)));
+        chunk.SetValue(2, i, Value::FLOAT(score_dist(rng)));
+    }
+    chunk.SetCardinality(count);
+    return count;
+}
+
+static void RunAppend(const BenchConfig& config, BenchResult& result) {
+    using namespace duckdb;
+
+    auto table = CreateBenchTable();
+    DataChunk chunk;
+    chunk.Initialize(Allocator::DefaultAllocator(), {LogicalType::INTEGER, LogicalType::VARCHAR, LogicalType::FLOAT});
+    std::mt19937_64 rng(42);
+
+    Measurement measurement(result);
+    for (uint64_t row = 0; row < config.records;) {
+        idx_t count = FillBenchChunk(config, chunk, row, rng);
+
+        // Latency is per appended chunk; operations count rows
+        auto start = std::chrono::steady_clock::now();
+        table->Append(chunk);
+        result.latency.Record(ElapsedNanos(start));
+        row += count;
+    }
+    result.operations = config.records;
+    measurement.Finish();
+}
+
+// The same rows appended by config.threads threads, each encoding into its own append state and
+// committing it at the end, as a parallel INSERT does
+static void RunAppendParallel(const BenchConfig& config, BenchResult& result) {
+    using namespace duckdb;
+
+    auto table = CreateBenchTable();
+    uint64_t chunk_count = (config.records + STANDARD_VECTOR_SIZE - 1) / STANDARD_VECTOR_SIZE;
+
+    Measurement measurement(result);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < config.threads; t++) {
+        threads.emplace_back([&, t]() {
+            DataChunk chunk;
+            chunk.Initialize(Allocator::DefaultAllocator(),
+                             {LogicalType::INTEGER, LogicalType::VARCHAR, LogicalType::FLOAT});
+            std::mt19937_64 rng(42 + t);
+            RucksDBAppendState state;
+            table->InitializeAppend(state);
+            // Chunks are dealt round-robin, so every thread appends the same amount
+            for (uint64_t c = t; c < chunk_count; c += config.threads) {
+                FillBenchChunk(config, chunk, c * STANDARD_VECTOR_SIZE, rng);
+                auto start = std::chrono::steady_clock::now();
+                table->Append(chunk, state);
+                result.latency.Record(ElapsedNanos(start));
+            }
+            table->FinalizeAppend(state);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    result.operations = config.records;
+    measurement.Finish();
+}
+
+// Time to first query after reopening a database of config.tables tables, with config.records
+// rows appended after the last flush so the open replays them from the WAL
+static const char* STARTUP_INSTANCE = "bench_startup";
+
+static void RunStartup(const BenchConfig& config, duckdb::Connection& con, BenchResult& result) {
+    using namespace duckdb;
+
+    std::string path = config.path + "_startup";
+    auto options = RocksDBStorageOptions::Parse(config.options);
+    {
+        auto instance = RucksDBInstanceRegistry::Open(STARTUP_INSTANCE, path, options);
+        vector<ColumnDefinition> columns;
+        columns.emplace_back("id", LogicalType::INTEGER);
+        columns.emplace_back("name", LogicalType::VARCHAR);
+        columns.emplace_back("score", LogicalType::FLOAT);
+        for (uint64_t t = 0; t < config.tables; t++) {
+            std::string name = "startup_" + std::to_string(t);
+            if (t == 0 && instance.registry->TableExists(name)) {
+                instance.registry->DropTable(name);
+            }
+            if (!instance.registry->TableExists(name)) {
+                instance.registry->CreateTable(name, columns);
+            }
+        }
+        instance.storage->Flush();
+
+        auto* table = instance.registry->GetTable("startup_0");
+        DataChunk chunk;
+        chunk.Initialize(Allocator::DefaultAllocator(), {LogicalType::INTEGER, LogicalType::VARCHAR, LogicalType::FLOAT});
+        std::mt19937_64 rng(42);
+        for (uint64_t row = 0; row < config.records;) {
+            row += FillBenchChunk(config, chunk, row, rng);
+            table->Append(chunk);
+        }
+        RucksDBInstanceRegistry::Close(STARTUP_INSTANCE);
+    }
+
+    std::string query = std::string("SELECT COUNT(*) FROM rocksdb_scan('startup_") +
+                        std::to_string(config.tables - 1) + "', database := '" + STARTUP_INSTANCE + "')";
+    Measurement measurement(result);
+    for (size_t i = 0; i < config.scan_iterations; i++) {
+        // Recovered memtables are not flushed at open by default, so every reopen replays the WAL
+        auto start = std::chrono::steady_clock::now();
+        RucksDBInstanceRegistry::Open(STARTUP_INSTANCE, path, options);
+        auto query_result = con.Query(query);
+        result.latency.Record(ElapsedNanos(start));
+        RucksDBInstanceRegistry::Close(STARTUP_INSTANCE);
+        if (query_result->HasError()) {
+            throw std::runtime_error("startup query failed: " + query_result->GetError());
+        }
+    }
+    result.operations = config.scan_iterations;
+    measurement.Finish();
+}
+
+// Empties the row cache and RocksDB's block cache, so the next scan reads from storage
+static void DropCaches() {
+    for (auto* shard : duckdb::g_rocksdb_storage->GetShards()) {
+        if (shard->GetCache()) {
+            shard->GetCache()->Clear();
+        }
+    }
+    duckdb::g_rocksdb_storage->DropBlockCache();
+}
+
+// rows is the rows each query reads, config.records when 0
+static void RunScan(const BenchConfig& config, duckdb::Connection& con, const std::string& name,
+                    const std::string& query, BenchResult& result, bool cold = false, uint64_t rows = 0) {
+    Measurement measurement(result);
+    for (size_t i = 0; i < config.scan_iterations; i++) {
+        if (cold) {
+            DropCaches();
+        }
+        auto start = std::chrono::steady_clock::now();
+        auto query_result = con.Query(query);
+        result.latency.Record(ElapsedNanos(start));
+        if (query_result->HasError()) {
+            throw std::runtime_error(name + " failed: " + query_result->GetError());
+        }
+    }
+    // Rows scanned per second
+    result.operations = config.scan_iterations * (rows ? rows : config.records);
+    measurement.Finish();
+}
+
+static bool ParseArgument(const std::string& arg, const std::string& name, std::string& value) {
+    std::string flag = "--" + name + "=";
+    if (arg.compare(0, flag.size(), flag) != 0) {
+        return false;
+    }
+    value = arg.substr(flag.size());
+    return true;
+}
+
+static BenchConfig ParseArguments(int argc, char** argv) {
+    BenchConfig config;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        std::string value;
+        if (ParseArgument(arg, "workload", value)) {
+            config.workload = value;
+        } else if (ParseArgument(arg, "records", value)) {
+            config.records = std::stoull(value);
+        } else if (ParseArgument(arg, "operations", value)) {
+            config.operations = std::stoull(value);
+        } else if (ParseArgument(arg, "value-size", value)) {
+            config.value_size = std::stoull(value);
+        } else if (ParseArgument(arg, "threads", value)) {
+            config.threads = std::max<size_t>(1, std::stoull(value));
+        } else if (ParseArgument(arg, "tables", value)) {
+            config.tables = std::max<uint64_t>(1, std::stoull(value));
+        } else if (ParseArgument(arg, "scan-iterations", value)) {
+            config.scan_iterations = std::max<size_t>(1, std::stoull(value));
+        } else if (ParseArgument(arg, "path", value)) {
+            config.path = value;
+        } else if (ParseArgument(arg, "options", value)) {
+            config.options = value;
+        } else if (ParseArgument(arg, "output", value)) {
+            config.output = value;
+        } else {
+            throw std::runtime_error("Unknown argument '" + arg + "'");
+        }
+    }
+    return config;
+}
+
+static bool Selected(const BenchConfig& config, const std::string& name) {
+    if (config.workload == "all" || config.workload == name) {
+        return true;
+    }
+    return config.workload == "ycsb" && name.compare(0, 5, "ycsb-") == 0;
+}
+
+int main(int argc, char** argv) {
+    BenchConfig config;
+    std::vector<std::unique_ptr<BenchResult>> results;
+    auto add_result = [&results](const std::string& name) -> BenchResult& {
+        results.push_back(std::make_unique<BenchResult>());
+        results.back()->name = name;
+        return *results.back();
+    };
+
+    try {
+        config = ParseArguments(argc, argv);
+        rucksdb_init_with_options(config.path.c_str(), config.options.c_str());
+
+        duckdb::DuckDB db(nullptr);
+        duckdb::Connection con(db);
+        duckdb::RucksDBExtension extension;
+        extension.Load(db);
+
+        uint64_t record_count = config.records;
+        bool needs_records = config.workload == "all" || config.workload == "mixed" ||
+                             config.workload.compare(0, 4, "ycsb") == 0;
+        if (needs_records) {
+            LoadRecords(config, add_result("ycsb-load"));
+        }
+        for (const auto& workload : YCSB_WORKLOADS) {
+            if (Selected(config, workload.name)) {
+                RunYCSB(config, workload, record_count, add_result(workload.name));
+            }
+        }
+        if (Selected(config, "mixed")) {
+            RunMixed(config, record_count, add_result("mixed-" + std::to_string(config.threads) + "t"));
+        }
+
+        bool scans = Selected(config, "scan");
+        bool cold_scans = Selected(config, "scan-cold");
+        bool range_scans = Selected(config, "scan-range");
+        if (Selected(config, "append") || scans || cold_scans || range_scans) {
+            RunAppend(config, add_result("append"));
+        }
+        if (Selected(config, "append-parallel")) {
+            // Rebuilds the table with the same rows, so the scans below read the same data
+            RunAppendParallel(config, add_result("append-parallel-" + std::to_string(config.threads) + "t"));
+        }
+        if (scans) {
+            // SUM is not answered from metadata, so both queries really scan
+            std::string table = std::string("rocksdb_scan('") + BENCH_TABLE + "')";
+            RunScan(config, con, "scan-full", "SELECT SUM(id), SUM(length(name)), SUM(score) FROM " + table,
+                    add_result("scan-full"));
+            RunScan(config, con, "scan-projected", "SELECT SUM(score) FROM " + table, add_result("scan-projected"));
+        }
+        if (cold_scans) {
+            // Rows still in the memtable would be read from memory
+            for (auto* shard : duckdb::g_rocksdb_storage->GetShards()) {
+                shard->Flush();
+            }
+            std::string query = std::string("SELECT SUM(id), SUM(length(name)), SUM(score) FROM rocksdb_scan('") +
+                                BENCH_TABLE + "', prefetch := ";
+            RunScan(config, con, "scan-cold-sync", query + "false)", add_result("scan-cold-sync"), true);
+            RunScan(config, con, "scan-cold-prefetch", query + "true)", add_result("scan-cold-prefetch"), true);
+        }
+        if (range_scans) {
+            uint64_t rows = std::max<uint64_t>(config.records / 100, 1);
+            uint64_t first = (config.records - rows) / 2;
+            std::string query = std::string("SELECT SUM(score) FROM rocksdb_scan('") + BENCH_TABLE +
+                                "') WHERE id BETWEEN " + std::to_string(first) + " AND " +
+                                std::to_string(first + rows - 1);
+            RunScan(config, con, "scan-range-rowid", query, add_result("scan-range-rowid"), false, rows);
+            duckdb::RucksDBClusterDefinition cluster;
+            cluster.key_columns = {"id"};
+            duckdb::g_table_registry->SetTableClustering(BENCH_TABLE, cluster);
+            duckdb::g_table_registry->ReclusterTable(BENCH_TABLE);
+            RunScan(config, con, "scan-range-clustered", query, add_result("scan-range-clustered"), false, rows);
+        }
+
+        // Not part of "all": creating the tables takes longer than the other workloads together
+        if (config.workload == "startup") {
+            RunStartup(config, con, add_result("startup-" + std::to_string(config.tables) + "tables"));
+        }
+
+        for (auto& result : results) {
+            std::cout << ResultToJSON(*result) << std::endl;
+        }
+
+        if (!config.output.empty()) {
+            std::ofstream out(config.output);
+            out << "{\"benchmark\":\"rucksdb\",\"config\":{\"records\":" << config.records
+                << ",\"operations\":" << config.operations << ",\"value_size\":" << config.value_size
+                << ",\"threads\":" << config.threads << ",\"tables\":" << config.tables
+                << ",\"options\":\"" << config.options << "\"},\"results\":[";
+            for (size_t i = 0; i < results.size(); i++) {
+                out << (i > 0 ? "," : "") << ResultToJSON(*results[i]);
+            }
+            out << "]}" << std::endl;
+        }
+
+        if (duckdb::g_table_registry && duckdb::g_table_registry->TableExists(BENCH_TABLE)) {
+            duckdb::g_table_registry->DropTable(BENCH_TABLE);
+        }
+        duckdb::g_table_registry.reset();
+        rucksdb_shutdown();
+    } catch (const std::exception& e) {
+        std::cerr << "rucksdb_bench: " << e.what() << std::endl;
+        rucksdb_shutdown();
+        return 1;
+    }
+    return 0;
+}